@@ -0,0 +1,110 @@
+#ifndef __FILE_BLOCK_DEVICE_HPP__
+#define __FILE_BLOCK_DEVICE_HPP__
+
+#include <stdio.h>
+
+#include "erdp_hal_block.hpp"
+
+namespace erdp
+{
+    // BlockDevice over a host file, to run storage code and measure its throughput off target
+    class FileBlockDevice : public BlockDevice
+    {
+    public:
+        FileBlockDevice() {}
+        FileBlockDevice(const FileBlockDevice &) = delete;
+        FileBlockDevice &operator=(const FileBlockDevice &) = delete;
+
+        FileBlockDevice(const char *path, uint32_t block_count, uint32_t block_size = 512)
+        {
+            open(path, block_count, block_size);
+        }
+
+        ~FileBlockDevice()
+        {
+            close();
+        }
+
+        // Open path, or create it, and make it block_count blocks long
+        bool open(const char *path, uint32_t block_count, uint32_t block_size = 512)
+        {
+            close();
+            __file = fopen(path, "r+b");
+            if (__file == nullptr)
+            {
+                __file = fopen(path, "w+b");
+            }
+            if (__file == nullptr)
+            {
+                return false;
+            }
+            __block_size = block_size;
+            __block_count = block_count;
+            /* Extend the file to its full size, reads past the end would fail otherwise */
+            if (fseek(__file, (long)block_count * block_size - 1, SEEK_SET) != 0 || fgetc(__file) == EOF)
+            {
+                fseek(__file, (long)block_count * block_size - 1, SEEK_SET);
+                fputc(0, __file);
+            }
+            return true;
+        }
+
+        void close()
+        {
+            if (__file != nullptr)
+            {
+                fclose(__file);
+                __file = nullptr;
+            }
+        }
+
+        bool read(uint32_t block, void *buf, uint32_t count) override
+        {
+            if (!__seek(block, count))
+            {
+                return false;
+            }
+            return fread(buf, __block_size, count, __file) == count;
+        }
+
+        bool write(uint32_t block, const void *buf, uint32_t count) override
+        {
+            if (!__seek(block, count))
+            {
+                return false;
+            }
+            return fwrite(buf, __block_size, count, __file) == count;
+        }
+
+        bool sync() override
+        {
+            return __file != nullptr && fflush(__file) == 0;
+        }
+
+        uint32_t block_size() const override
+        {
+            return __block_size;
+        }
+
+        uint32_t block_count() const override
+        {
+            return __block_count;
+        }
+
+    private:
+        FILE *__file = nullptr;
+        uint32_t __block_size = 512;
+        uint32_t __block_count = 0;
+
+        bool __seek(uint32_t block, uint32_t count)
+        {
+            if (__file == nullptr || block + count > __block_count || block + count < block)
+            {
+                return false;
+            }
+            return fseek(__file, (long)block * __block_size, SEEK_SET) == 0;
+        }
+    };
+} // namespace erdp
+
+#endif // __FILE_BLOCK_DEVICE_HPP__
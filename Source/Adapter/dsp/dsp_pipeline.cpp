@@ -0,0 +1,179 @@
+#include "dsp_pipeline.hpp"
+
+namespace erdp
+{
+    namespace dsp
+    {
+        static void shift_state(float *state, uint32_t keep, uint32_t n)
+        {
+            for (uint32_t i = 0; i < keep; i++)
+            {
+                state[i] = state[i + n];
+            }
+        }
+
+        void fir(const float *coeffs, float *state, uint32_t taps, const float *in, float *out, uint32_t n)
+        {
+            float *window = state + taps - 1;
+            for (uint32_t i = 0; i < n; i++)
+            {
+                window[i] = in[i];
+            }
+            for (uint32_t i = 0; i < n; i++)
+            {
+                float acc = 0.0f;
+                for (uint32_t k = 0; k < taps; k++)
+                {
+                    acc += coeffs[k] * state[i + k];
+                }
+                out[i] = acc;
+            }
+            shift_state(state, taps - 1, n);
+        }
+
+        void fir_decimate(const float *coeffs, float *state, uint32_t taps, uint32_t factor, const float *in,
+                          float *out, uint32_t n)
+        {
+            float *window = state + taps - 1;
+            for (uint32_t i = 0; i < n; i++)
+            {
+                window[i] = in[i];
+            }
+            for (uint32_t m = 0; m < n / factor; m++)
+            {
+                const float *x = state + m * factor;
+                float acc = 0.0f;
+                for (uint32_t k = 0; k < taps; k++)
+                {
+                    acc += coeffs[k] * x[k];
+                }
+                out[m] = acc;
+            }
+            shift_state(state, taps - 1, n);
+        }
+
+        void biquad_df2t(const float *coeffs, float *state, uint32_t sections, const float *in, float *out,
+                         uint32_t n)
+        {
+            const float *src = in;
+            for (uint32_t s = 0; s < sections; s++)
+            {
+                const float *c = coeffs + 5 * s;
+                float d1 = state[2 * s];
+                float d2 = state[2 * s + 1];
+                for (uint32_t i = 0; i < n; i++)
+                {
+                    float x = src[i];
+                    float y = c[0] * x + d1;
+                    d1 = c[1] * x + c[3] * y + d2;
+                    d2 = c[2] * x + c[4] * y;
+                    out[i] = y;
+                }
+                state[2 * s] = d1;
+                state[2 * s + 1] = d2;
+                src = out;
+            }
+        }
+
+        void rfft_twiddle_init(float *twiddle, uint32_t size)
+        {
+            const float pi = 3.14159265358979f;
+            for (uint32_t k = 0; k < size / 2; k++)
+            {
+                twiddle[2 * k] = cosf(2.0f * pi * (float)k / (float)size);
+                twiddle[2 * k + 1] = -sinf(2.0f * pi * (float)k / (float)size);
+            }
+        }
+
+        /* Complex FFT of size/2 points on the even/odd samples, then split into the real spectrum */
+        void rfft(const float *twiddle, float *buf, uint32_t size)
+        {
+            uint32_t half = size / 2;
+
+            for (uint32_t i = 1, j = 0; i < half; i++)
+            {
+                uint32_t bit = half >> 1;
+                for (; j & bit; bit >>= 1)
+                {
+                    j ^= bit;
+                }
+                j ^= bit;
+                if (i < j)
+                {
+                    float re = buf[2 * i];
+                    float im = buf[2 * i + 1];
+                    buf[2 * i] = buf[2 * j];
+                    buf[2 * i + 1] = buf[2 * j + 1];
+                    buf[2 * j] = re;
+                    buf[2 * j + 1] = im;
+                }
+            }
+
+            for (uint32_t len = 2; len <= half; len <<= 1)
+            {
+                uint32_t stride = size / len;
+                for (uint32_t i = 0; i < half; i += len)
+                {
+                    for (uint32_t j = 0; j < len / 2; j++)
+                    {
+                        float wr = twiddle[2 * j * stride];
+                        float wi = twiddle[2 * j * stride + 1];
+                        float *u = buf + 2 * (i + j);
+                        float *v = buf + 2 * (i + j + len / 2);
+                        float vr = v[0] * wr - v[1] * wi;
+                        float vi = v[0] * wi + v[1] * wr;
+                        v[0] = u[0] - vr;
+                        v[1] = u[1] - vi;
+                        u[0] += vr;
+                        u[1] += vi;
+                    }
+                }
+            }
+
+            float dc = buf[0] + buf[1];
+            float nyquist = buf[0] - buf[1];
+            buf[0] = dc;
+            buf[1] = nyquist;
+
+            /* X[k] = Fe + W^k * Fo and X[half - k] = conj(Fe - W^k * Fo) */
+            for (uint32_t k = 1; k <= half / 2; k++)
+            {
+                float *zk = buf + 2 * k;
+                float *zm = buf + 2 * (half - k);
+                float fe_r = 0.5f * (zk[0] + zm[0]);
+                float fe_i = 0.5f * (zk[1] - zm[1]);
+                float fo_r = 0.5f * (zk[1] + zm[1]);
+                float fo_i = -0.5f * (zk[0] - zm[0]);
+                float wr = twiddle[2 * k];
+                float wi = twiddle[2 * k + 1];
+                float t_r = wr * fo_r - wi * fo_i;
+                float t_i = wr * fo_i + wi * fo_r;
+                zk[0] = fe_r + t_r;
+                zk[1] = fe_i + t_i;
+                if (zm != zk)
+                {
+                    zm[0] = fe_r - t_r;
+                    zm[1] = -(fe_i - t_i);
+                }
+            }
+        }
+
+        void cmplx_mag(const float *in, float *out, uint32_t n)
+        {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                out[i] = sqrtf(in[2 * i] * in[2 * i] + in[2 * i + 1] * in[2 * i + 1]);
+            }
+        }
+
+        float rms(const float *in, uint32_t n)
+        {
+            float acc = 0.0f;
+            for (uint32_t i = 0; i < n; i++)
+            {
+                acc += in[i] * in[i];
+            }
+            return n ? sqrtf(acc / (float)n) : 0.0f;
+        }
+    } // namespace dsp
+} // namespace erdp
@@ -0,0 +1,347 @@
+#ifndef __DSP_PIPELINE_HPP__
+#define __DSP_PIPELINE_HPP__
+
+#include <stdint.h>
+#include <math.h>
+
+#include "erdp_config.h"
+#include "erdp_assert.h"
+
+#ifdef ERDP_ENABLE_DSP_CMSIS
+#include "arm_math.h"
+#endif
+
+namespace erdp
+{
+    /*
+     * Portable kernels, same data layout as CMSIS-DSP so both paths give the same results:
+     * FIR coefficients are stored time reversed (b[N-1] .. b[0]), biquad coefficients are
+     * {b0, b1, b2, a1, a2} per section with a1/a2 already negated, the real FFT output is
+     * packed as {X[0], X[N/2], Re X[1], Im X[1], ...}.
+     */
+    namespace dsp
+    {
+        void fir(const float *coeffs, float *state, uint32_t taps, const float *in, float *out, uint32_t n);
+        void fir_decimate(const float *coeffs, float *state, uint32_t taps, uint32_t factor, const float *in,
+                          float *out, uint32_t n);
+        void biquad_df2t(const float *coeffs, float *state, uint32_t sections, const float *in, float *out,
+                         uint32_t n);
+        void rfft(const float *twiddle, float *buf, uint32_t size);
+        void rfft_twiddle_init(float *twiddle, uint32_t size);
+        void cmplx_mag(const float *in, float *out, uint32_t n);
+        float rms(const float *in, uint32_t n);
+    } // namespace dsp
+
+    class DspStage
+    {
+    public:
+        virtual ~DspStage() = default;
+
+        // Process n input samples, returns the number of samples written to out
+        virtual uint32_t process(const float *in, float *out, uint32_t n) = 0;
+
+        // Number of output samples for n input samples
+        virtual uint32_t output_size(uint32_t n) const
+        {
+            return n;
+        }
+    };
+
+    template <uint32_t TAPS, uint32_t BLOCK>
+    class FirStage : public DspStage
+    {
+    public:
+        FirStage() {}
+
+        // coeffs in CMSIS order (time reversed), kept by reference
+        FirStage(const float *coeffs)
+        {
+            init(coeffs);
+        }
+
+        void init(const float *coeffs)
+        {
+            __coeffs = coeffs;
+            reset();
+#ifdef ERDP_ENABLE_DSP_CMSIS
+            arm_fir_init_f32(&__fir, TAPS, (float32_t *)__coeffs, __state, BLOCK);
+#endif
+        }
+
+        void reset()
+        {
+            for (auto &s : __state)
+            {
+                s = 0.0f;
+            }
+        }
+
+        uint32_t process(const float *in, float *out, uint32_t n) override
+        {
+            erdp_assert(n <= BLOCK);
+#ifdef ERDP_ENABLE_DSP_CMSIS
+            arm_fir_f32(&__fir, (float32_t *)in, out, n);
+#else
+            dsp::fir(__coeffs, __state, TAPS, in, out, n);
+#endif
+            return n;
+        }
+
+    private:
+        const float *__coeffs = nullptr;
+        float __state[TAPS + BLOCK - 1];
+#ifdef ERDP_ENABLE_DSP_CMSIS
+        arm_fir_instance_f32 __fir;
+#endif
+    };
+
+    template <uint32_t SECTIONS>
+    class BiquadStage : public DspStage
+    {
+    public:
+        BiquadStage() {}
+
+        // 5 * SECTIONS coefficients {b0, b1, b2, a1, a2}, a1/a2 negated, kept by reference
+        BiquadStage(const float *coeffs)
+        {
+            init(coeffs);
+        }
+
+        void init(const float *coeffs)
+        {
+            __coeffs = coeffs;
+            reset();
+#ifdef ERDP_ENABLE_DSP_CMSIS
+            arm_biquad_cascade_df2T_init_f32(&__biquad, SECTIONS, (float32_t *)__coeffs, __state);
+#endif
+        }
+
+        void reset()
+        {
+            for (auto &s : __state)
+            {
+                s = 0.0f;
+            }
+        }
+
+        uint32_t process(const float *in, float *out, uint32_t n) override
+        {
+#ifdef ERDP_ENABLE_DSP_CMSIS
+            arm_biquad_cascade_df2T_f32(&__biquad, (float32_t *)in, out, n);
+#else
+            dsp::biquad_df2t(__coeffs, __state, SECTIONS, in, out, n);
+#endif
+            return n;
+        }
+
+    private:
+        const float *__coeffs = nullptr;
+        float __state[2 * SECTIONS];
+#ifdef ERDP_ENABLE_DSP_CMSIS
+        arm_biquad_cascade_df2T_instance_f32 __biquad;
+#endif
+    };
+
+    // Anti-aliasing FIR followed by keeping one sample out of FACTOR, BLOCK must be a multiple of FACTOR
+    template <uint32_t TAPS, uint32_t FACTOR, uint32_t BLOCK>
+    class DecimateStage : public DspStage
+    {
+        static_assert(BLOCK % FACTOR == 0, "BLOCK must be a multiple of FACTOR");
+
+    public:
+        DecimateStage() {}
+
+        DecimateStage(const float *coeffs)
+        {
+            init(coeffs);
+        }
+
+        void init(const float *coeffs)
+        {
+            __coeffs = coeffs;
+            reset();
+#ifdef ERDP_ENABLE_DSP_CMSIS
+            arm_fir_decimate_init_f32(&__decimate, TAPS, FACTOR, (float32_t *)__coeffs, __state, BLOCK);
+#endif
+        }
+
+        void reset()
+        {
+            for (auto &s : __state)
+            {
+                s = 0.0f;
+            }
+        }
+
+        uint32_t process(const float *in, float *out, uint32_t n) override
+        {
+            erdp_assert(n == BLOCK);
+#ifdef ERDP_ENABLE_DSP_CMSIS
+            arm_fir_decimate_f32(&__decimate, (float32_t *)in, out, n);
+#else
+            dsp::fir_decimate(__coeffs, __state, TAPS, FACTOR, in, out, n);
+#endif
+            return n / FACTOR;
+        }
+
+        uint32_t output_size(uint32_t n) const override
+        {
+            return n / FACTOR;
+        }
+
+    private:
+        const float *__coeffs = nullptr;
+        float __state[TAPS + BLOCK - 1];
+#ifdef ERDP_ENABLE_DSP_CMSIS
+        arm_fir_decimate_instance_f32 __decimate;
+#endif
+    };
+
+    // Real FFT of SIZE samples (power of two, 32..4096); outputs SIZE/2 magnitudes or the packed spectrum
+    template <uint32_t SIZE>
+    class RfftStage : public DspStage
+    {
+        static_assert(SIZE >= 32 && SIZE <= 4096 && (SIZE & (SIZE - 1)) == 0, "SIZE must be a power of two");
+
+    public:
+        RfftStage(bool magnitude = true) : __magnitude(magnitude)
+        {
+#ifdef ERDP_ENABLE_DSP_CMSIS
+            arm_rfft_fast_init_f32(&__rfft, SIZE);
+#else
+            dsp::rfft_twiddle_init(__twiddle, SIZE);
+#endif
+        }
+
+        uint32_t process(const float *in, float *out, uint32_t n) override
+        {
+            erdp_assert(n == SIZE);
+            /* The transform works in place, keep the input of the previous stage intact */
+            for (uint32_t i = 0; i < SIZE; i++)
+            {
+                __work[i] = in[i];
+            }
+#ifdef ERDP_ENABLE_DSP_CMSIS
+            arm_rfft_fast_f32(&__rfft, __work, __magnitude ? __spectrum : out, 0);
+            float *spectrum = __magnitude ? __spectrum : out;
+#else
+            dsp::rfft(__twiddle, __work, SIZE);
+            float *spectrum = __work;
+            if (!__magnitude)
+            {
+                for (uint32_t i = 0; i < SIZE; i++)
+                {
+                    out[i] = __work[i];
+                }
+            }
+#endif
+            if (!__magnitude)
+            {
+                return SIZE;
+            }
+            /* Bin 0 holds DC and Nyquist as two real values, report |DC| */
+            float nyquist = spectrum[1];
+            spectrum[1] = 0.0f;
+#ifdef ERDP_ENABLE_DSP_CMSIS
+            arm_cmplx_mag_f32(spectrum, out, SIZE / 2);
+#else
+            dsp::cmplx_mag(spectrum, out, SIZE / 2);
+#endif
+            spectrum[1] = nyquist;
+            return SIZE / 2;
+        }
+
+        uint32_t output_size(uint32_t n) const override
+        {
+            return __magnitude ? n / 2 : n;
+        }
+
+    private:
+        bool __magnitude;
+        float __work[SIZE];
+#ifdef ERDP_ENABLE_DSP_CMSIS
+        float __spectrum[SIZE];
+        arm_rfft_fast_instance_f32 __rfft;
+#else
+        float __twiddle[SIZE];
+#endif
+    };
+
+    // Root mean square of each block, one output sample per block
+    class RmsStage : public DspStage
+    {
+    public:
+        uint32_t process(const float *in, float *out, uint32_t n) override
+        {
+#ifdef ERDP_ENABLE_DSP_CMSIS
+            arm_rms_f32((float32_t *)in, n, out);
+#else
+            out[0] = dsp::rms(in, n);
+#endif
+            return 1;
+        }
+
+        uint32_t output_size(uint32_t) const override
+        {
+            return 1;
+        }
+    };
+
+    /*
+     * Chain of stages over fixed-size blocks. The first stage reads the caller buffer directly
+     * (a float block, or the ADC DMA half-buffer converted on the fly), the next stages ping-pong
+     * between two scratch buffers of MAX_BLOCK samples.
+     */
+    template <uint32_t MAX_BLOCK, uint32_t MAX_STAGES = 8>
+    class DspPipeline
+    {
+    public:
+        DspPipeline &add(DspStage &stage)
+        {
+            erdp_assert(__stage_num < MAX_STAGES);
+            __stages[__stage_num++] = &stage;
+            return *this;
+        }
+
+        void clear()
+        {
+            __stage_num = 0;
+        }
+
+        // Returns the output of the last stage, n is updated to its sample count
+        const float *process(const float *in, uint32_t &n)
+        {
+            erdp_assert(n <= MAX_BLOCK);
+            const float *src = in;
+            for (uint32_t i = 0; i < __stage_num; i++)
+            {
+                float *dst = (src == __scratch[0]) ? __scratch[1] : __scratch[0];
+                n = __stages[i]->process(src, dst, n);
+                src = dst;
+            }
+            return src;
+        }
+
+        /**
+         * Convert raw ADC samples, picking one channel every stride samples of an interleaved
+         * scan buffer, then run the stages: sample = raw * scale + offset.
+         */
+        const float *process(const uint16_t *raw, uint32_t &n, uint32_t stride = 1, float scale = 1.0f,
+                             float offset = 0.0f)
+        {
+            erdp_assert(n <= MAX_BLOCK);
+            for (uint32_t i = 0; i < n; i++)
+            {
+                __scratch[0][i] = (float)raw[i * stride] * scale + offset;
+            }
+            return process((const float *)__scratch[0], n);
+        }
+
+    private:
+        DspStage *__stages[MAX_STAGES] = {nullptr};
+        uint32_t __stage_num = 0;
+        float __scratch[2][MAX_BLOCK];
+    };
+} // namespace erdp
+
+#endif // __DSP_PIPELINE_HPP__
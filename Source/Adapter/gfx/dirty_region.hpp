@@ -0,0 +1,166 @@
+#ifndef __DIRTY_REGION_HPP__
+#define __DIRTY_REGION_HPP__
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace erdp
+{
+    typedef struct
+    {
+        uint16_t x;
+        uint16_t y;
+        uint16_t w;
+        uint16_t h;
+    } Rect_t;
+
+    /*
+     * Set of rectangles that changed since the last flush. Rectangles are merged when sending
+     * their bounding box costs no more pixels than sending them apart plus the per-rectangle
+     * window setup (slack), and the two cheapest to merge are joined when the set is full.
+     * Platform free, the merge policy is tested on the host by Test/test_dirty_region.cpp.
+     */
+    template <size_t N>
+    class DirtyRegion
+    {
+        static_assert(N > 0, "DirtyRegion needs at least one rectangle");
+
+    public:
+        explicit DirtyRegion(uint32_t slack = 64) : __slack(slack) {}
+
+        void add(Rect_t rect)
+        {
+            if (rect.w == 0 || rect.h == 0)
+            {
+                return;
+            }
+
+            /* A grown rectangle may now be worth merging with one already checked */
+            size_t i = 0;
+            while (i < __count)
+            {
+                if (__merge_cost(__rect[i], rect) <= (int32_t)__slack)
+                {
+                    rect = bounding(__rect[i], rect);
+                    __remove(i);
+                    i = 0;
+                }
+                else
+                {
+                    i++;
+                }
+            }
+
+            if (__count == N)
+            {
+                size_t best = 0;
+                int32_t best_cost = __merge_cost(__rect[0], rect);
+                for (i = 1; i < __count; i++)
+                {
+                    int32_t cost = __merge_cost(__rect[i], rect);
+                    if (cost < best_cost)
+                    {
+                        best = i;
+                        best_cost = cost;
+                    }
+                }
+                rect = bounding(__rect[best], rect);
+                __remove(best);
+                add(rect);
+                return;
+            }
+            __rect[__count++] = rect;
+        }
+
+        void clear()
+        {
+            __count = 0;
+        }
+
+        bool empty() const
+        {
+            return __count == 0;
+        }
+
+        size_t size() const
+        {
+            return __count;
+        }
+
+        const Rect_t &operator[](size_t index) const
+        {
+            return __rect[index];
+        }
+
+        const Rect_t *begin() const
+        {
+            return __rect;
+        }
+
+        const Rect_t *end() const
+        {
+            return __rect + __count;
+        }
+
+        // Pixels to send for the whole set
+        uint32_t area() const
+        {
+            uint32_t sum = 0;
+            for (size_t i = 0; i < __count; i++)
+            {
+                sum += __area(__rect[i]);
+            }
+            return sum;
+        }
+
+        static Rect_t bounding(const Rect_t &a, const Rect_t &b)
+        {
+            uint32_t x0 = a.x < b.x ? a.x : b.x;
+            uint32_t y0 = a.y < b.y ? a.y : b.y;
+            uint32_t x1 = (a.x + a.w) > (b.x + b.w) ? (a.x + a.w) : (b.x + b.w);
+            uint32_t y1 = (a.y + a.h) > (b.y + b.h) ? (a.y + a.h) : (b.y + b.h);
+            return Rect_t{(uint16_t)x0, (uint16_t)y0, (uint16_t)(x1 - x0), (uint16_t)(y1 - y0)};
+        }
+
+        // Clip rect to a width x height screen, false if nothing is left
+        static bool clip(Rect_t &rect, uint16_t width, uint16_t height)
+        {
+            if (rect.x >= width || rect.y >= height)
+            {
+                return false;
+            }
+            if (rect.w > width - rect.x)
+            {
+                rect.w = width - rect.x;
+            }
+            if (rect.h > height - rect.y)
+            {
+                rect.h = height - rect.y;
+            }
+            return rect.w != 0 && rect.h != 0;
+        }
+
+    private:
+        Rect_t __rect[N];
+        size_t __count = 0;
+        uint32_t __slack;
+
+        static uint32_t __area(const Rect_t &rect)
+        {
+            return (uint32_t)rect.w * rect.h;
+        }
+
+        // Extra pixels sent if a and b are replaced by their bounding box, negative when they overlap
+        static int32_t __merge_cost(const Rect_t &a, const Rect_t &b)
+        {
+            return (int32_t)__area(bounding(a, b)) - (int32_t)__area(a) - (int32_t)__area(b);
+        }
+
+        void __remove(size_t index)
+        {
+            __rect[index] = __rect[--__count];
+        }
+    };
+} // namespace erdp
+
+#endif // __DIRTY_REGION_HPP__
@@ -0,0 +1,187 @@
+#ifndef __FRAMEBUFFER_HPP__
+#define __FRAMEBUFFER_HPP__
+
+#include "erdp_function.hpp"
+
+#include "dirty_region.hpp"
+#include "erdp_hal_lcd.hpp"
+
+namespace erdp
+{
+    // Full RGB565 frame in RAM, only the rectangles drawn since the last flush are sent
+    template <size_t N = 8>
+    class Framebuffer
+    {
+    public:
+        Framebuffer(uint16_t *pixels, uint16_t width, uint16_t height, uint32_t slack = 64)
+            : __pixels(pixels), __width(width), __height(height), __dirty(slack)
+        {
+        }
+
+        uint16_t *data()
+        {
+            return __pixels;
+        }
+
+        uint16_t width() const
+        {
+            return __width;
+        }
+
+        uint16_t height() const
+        {
+            return __height;
+        }
+
+        void set_pixel(uint16_t x, uint16_t y, uint16_t color)
+        {
+            if (x < __width && y < __height)
+            {
+                __pixels[(uint32_t)y * __width + x] = color;
+                __dirty.add(Rect_t{x, y, 1, 1});
+            }
+        }
+
+        void fill_rect(Rect_t rect, uint16_t color)
+        {
+            if (!DirtyRegion<N>::clip(rect, __width, __height))
+            {
+                return;
+            }
+            for (uint16_t y = rect.y; y < rect.y + rect.h; y++)
+            {
+                uint16_t *line = __pixels + (uint32_t)y * __width + rect.x;
+                for (uint16_t x = 0; x < rect.w; x++)
+                {
+                    line[x] = color;
+                }
+            }
+            __dirty.add(rect);
+        }
+
+        // Copy a rect.w x rect.h image, clipped to the screen
+        void blit(Rect_t rect, const uint16_t *src)
+        {
+            uint16_t src_width = rect.w;
+            if (!DirtyRegion<N>::clip(rect, __width, __height))
+            {
+                return;
+            }
+            for (uint16_t y = 0; y < rect.h; y++)
+            {
+                uint16_t *line = __pixels + (uint32_t)(rect.y + y) * __width + rect.x;
+                const uint16_t *src_line = src + (uint32_t)y * src_width;
+                for (uint16_t x = 0; x < rect.w; x++)
+                {
+                    line[x] = src_line[x];
+                }
+            }
+            __dirty.add(rect);
+        }
+
+        // Mark an area drawn through data()
+        void invalidate(Rect_t rect)
+        {
+            if (DirtyRegion<N>::clip(rect, __width, __height))
+            {
+                __dirty.add(rect);
+            }
+        }
+
+        void invalidate_all()
+        {
+            __dirty.clear();
+            __dirty.add(Rect_t{0, 0, __width, __height});
+        }
+
+        const DirtyRegion<N> &dirty() const
+        {
+            return __dirty;
+        }
+
+        // The last rectangle is still being sent on return, call lcd.wait() before drawing again
+        void flush(LcdDev &lcd)
+        {
+            for (const Rect_t &rect : __dirty)
+            {
+                lcd.draw(rect, __pixels + (uint32_t)rect.y * __width + rect.x, __width);
+            }
+            __dirty.clear();
+        }
+
+    private:
+        uint16_t *__pixels;
+        uint16_t __width;
+        uint16_t __height;
+        DirtyRegion<N> __dirty;
+    };
+
+    /*
+     * For screens too big for a frame in RAM (320x240 RGB565 is 150KiB): dirty rectangles are
+     * rendered band by band by the user into two small buffers, one is filled while the DMA
+     * sends the other.
+     */
+    template <size_t N = 8>
+    class LineBuffer
+    {
+    public:
+        // Render the pixels of band (band.w pixels per line) into pixels
+        using Render = InplaceFunction<void(const Rect_t &band, uint16_t *pixels)>;
+
+        // buf0 and buf1 hold size pixels each, at least one screen line; buf1 may be nullptr (no overlap)
+        LineBuffer(uint16_t *buf0, uint16_t *buf1, uint32_t size, uint32_t slack = 64) : __size(size), __dirty(slack)
+        {
+            __buf[0] = buf0;
+            __buf[1] = buf1;
+        }
+
+        void invalidate(const Rect_t &rect)
+        {
+            __dirty.add(rect);
+        }
+
+        const DirtyRegion<N> &dirty() const
+        {
+            return __dirty;
+        }
+
+        void flush(LcdDev &lcd, const Render &render)
+        {
+            uint8_t current = 0;
+
+            for (Rect_t rect : __dirty)
+            {
+                if (!DirtyRegion<N>::clip(rect, lcd.width(), lcd.height()))
+                {
+                    continue;
+                }
+                erdp_assert(rect.w <= __size);
+                uint16_t lines = (uint16_t)(__size / rect.w);
+                for (uint16_t y = rect.y; y < rect.y + rect.h; y += lines)
+                {
+                    uint16_t end = rect.y + rect.h;
+                    Rect_t band = {rect.x, y, rect.w, (uint16_t)((end - y < lines) ? (end - y) : lines)};
+                    if (__buf[1] == nullptr)
+                    {
+                        lcd.wait();
+                    }
+                    render(band, __buf[current]);
+                    lcd.draw(band, __buf[current]);
+                    if (__buf[1] != nullptr)
+                    {
+                        current ^= 1;
+                    }
+                }
+            }
+            lcd.wait();
+            __dirty.clear();
+        }
+
+    private:
+        uint16_t *__buf[2];
+        uint32_t __size;
+        DirtyRegion<N> __dirty;
+    };
+} // namespace erdp
+
+#endif // __FRAMEBUFFER_HPP__
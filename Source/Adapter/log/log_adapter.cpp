@@ -5,49 +5,22 @@
 log_t Logger::logger;
 bool Logger::log_en = false;
 #if (LOGGER_QUEUE_MODE == LOGGER_SINGLE_QUEUE_MODE)
-erdp::Queue<uint8_t> Logger::log_queue;
-erdp::Mutex Logger::log_mutex;
+erdp::StaticStreamBuffer<LOG_MESSAGE_LEN> Logger::log_queue;
 #elif (LOGGER_QUEUE_MODE == LOGGER_MULTI_QUEUE_MODE)
-Logger::MsgHandler Logger::message_handler[LOG_MESSAGE_NUM];
-erdp::Queue<uint8_t> Logger::order_queue;
+erdp::StaticMessageBuffer<LOG_MESSAGE_NUM *(LOG_MESSAGE_LEN + erdp::MessageBuffer::LENGTH_BYTES)> Logger::log_queue;
 #endif
+erdp::Mutex Logger::log_mutex;
 
 // Logger 类的静态方法，用于处理日志输出
 // 此方法可以访问 Logger 类的私有成员
 void Logger::log_output_impl(const uint8_t *message, uint32_t len) {
-    // 将日志信息输出到控制台
-#if LOGGER_QUEUE_MODE == LOGGER_SINGLE_QUEUE_MODE
-    log_mutex.lock();
-    if (message != nullptr && len > 0) {
-        while (len--) {
-            log_queue.push(*message++);
-        }
+    // 将日志信息一次拷贝进缓冲区，由日志线程输出到控制台，缓冲区满时丢弃
+    if (message == nullptr || len == 0) {
+        return;
     }
+    log_mutex.lock();
+    log_queue.send(message, len);
     log_mutex.unlock();
-#elif LOGGER_QUEUE_MODE == LOGGER_MULTI_QUEUE_MODE
-    uint8_t i = 0;
-    for (; i < LOG_MESSAGE_NUM; i++) {
-        if (message_handler[i].event && (message_handler[i].event->get() & MSG_EVENT_IDLE)) {
-            message_handler[i].event->clear(MSG_EVENT_IDLE);
-            while (len > 0) {
-                if (message_handler[i].log_queue.push(*message++)) {
-                    len--;
-                }
-                else {
-                    break;
-                }
-            }
-            message_handler[i].event->set(MSG_EVENT_WAITING);
-            order_queue.push(i);
-            if (len == 0) {
-                break;
-            }
-        }
-    }
-    if (i == LOG_MESSAGE_NUM) {
-        // printf("log queue full\n");
-    }
-#endif
 }
 
 // 用户自定义的日志输出函数实现
@@ -135,24 +108,14 @@ void Logger::t(const char *module, const uint8_t *data, uint32_t len) {
     }
 }
 void Logger::log_thread_code() {
-    uint8_t data;
+    uint8_t data[LOG_MSG_MAX_SIZE];
     const erdp::UartDev *const &uart_dev = erdp::UartDev::get_debug_com();
     while (!uart_dev);
     while (true) {
-#if LOGGER_QUEUE_MODE == LOGGER_SINGLE_QUEUE_MODE
-        while (log_queue.pop(data)) {
-            uart_dev->send(&data, 1);
+        // 阻塞等待日志，流模式每次取出最多一整块，消息模式每次取出一整条
+        size_t len = log_queue.recv(data, sizeof(data), OS_WAIT_FOREVER);
+        if (len > 0) {
+            uart_dev->send(data, len);
         }
-#elif LOGGER_QUEUE_MODE == LOGGER_MULTI_QUEUE_MODE
-        uint8_t index = 0;
-        while (order_queue.pop(index)) {
-            message_handler[index].event->clear(MSG_EVENT_WAITING);
-            while (message_handler[index].log_queue.pop(data)) {
-                uart_dev->send(&data, 1);
-            }
-            message_handler[index].event->set(MSG_EVENT_IDLE);
-        }
-#endif
-        erdp::Thread::delay_ms(2);    // 10ms
     }
 }
\ No newline at end of file
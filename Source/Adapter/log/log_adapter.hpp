@@ -21,14 +21,12 @@ extern "C" {
 #define LOGGER_QUEUE_MODE        LOGGER_MULTI_QUEUE_MODE
 
 #if (LOGGER_QUEUE_MODE == LOGGER_SINGLE_QUEUE_MODE)
+// 所有日志拼接成一个字节流，缓冲区大小
 #define LOG_MESSAGE_LEN 5 * 1024
 #elif (LOGGER_QUEUE_MODE == LOGGER_MULTI_QUEUE_MODE)
-
+// 每条日志作为一条消息整条存取，缓冲区按LOG_MESSAGE_NUM条平均LOG_MESSAGE_LEN字节的日志预留
 #define LOG_MESSAGE_NUM 50
 #define LOG_MESSAGE_LEN 102
-
-#define MSG_EVENT_IDLE    (OS_EventBits)((uint32_t)1 << 0)
-#define MSG_EVENT_WAITING (OS_EventBits)((uint32_t)1 << 1)
 #endif
 
 class Logger {
@@ -58,19 +56,7 @@ class Logger {
 
     static void set_pattern(const std::string &pattern) { log_set_pattern(&logger, pattern.c_str()); }
     static void log_output_impl(const uint8_t *message, uint32_t len);
-    void start() {
-#if (LOGGER_QUEUE_MODE == LOGGER_SINGLE_QUEUE_MODE)
-        log_queue.init(LOG_MESSAGE_LEN);
-#elif (LOGGER_QUEUE_MODE == LOGGER_MULTI_QUEUE_MODE)
-        order_queue.init(LOG_MESSAGE_NUM);
-        for (uint8_t i = 0; i < LOG_MESSAGE_NUM; i++) {
-            message_handler[i].log_queue.init(LOG_MESSAGE_LEN);
-            message_handler[i].event = new erdp::Event();
-            message_handler[i].event->set(MSG_EVENT_IDLE);
-        }
-#endif
-        log_thread.join();
-    }
+    void start() { log_thread.join(); }
 
     static void set_tag(log_level_t level, const std::string &tag) { log_set_tag(&logger, level, tag.c_str()); }
 
@@ -79,17 +65,11 @@ class Logger {
     static log_t logger;
     void log_thread_code();
 #if (LOGGER_QUEUE_MODE == LOGGER_SINGLE_QUEUE_MODE)
-    static erdp::Queue<uint8_t> log_queue;
-    static erdp::Mutex log_mutex;
+    static erdp::StaticStreamBuffer<LOG_MESSAGE_LEN> log_queue;
 #elif (LOGGER_QUEUE_MODE == LOGGER_MULTI_QUEUE_MODE)
-    typedef struct MsgHandler {
-        erdp::Event *event;
-        erdp::Queue<uint8_t> log_queue;
-        MsgHandler() : event(nullptr) {}
-    } MsgHandler;
-    static MsgHandler message_handler[LOG_MESSAGE_NUM];
-    static erdp::Queue<uint8_t> order_queue;
+    static erdp::StaticMessageBuffer<LOG_MESSAGE_NUM *(LOG_MESSAGE_LEN + erdp::MessageBuffer::LENGTH_BYTES)> log_queue;
 #endif
+    static erdp::Mutex log_mutex;    // 缓冲区只允许一个写者
     erdp::Thread log_thread;
 };
 
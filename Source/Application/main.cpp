@@ -50,9 +50,9 @@ void Thread::main_thread(void *parm)
 {
 
     LED sys_led(SYS_LED_PORT, SYS_LED_PIN, ERDP_RESET);
-    // lambda 表达式可以隐式转换为 std::function<void()>
-    // 注意：静态检查器可能无法正确推断 lambda 类型，但实际编译器可以正常编译
-    // Thread 构造函数接受 std::function<void()> 类型（定义在 erdp_osal.hpp 第118行）
+    // lambda 表达式可以隐式转换为 InplaceFunction<void()>，捕获内容存放在对象内部，不占用堆
+    // 捕获超过 ERDP_CONFIG_FUNCTION_CAPACITY 字节时编译报错
+    // Thread 构造函数接受 InplaceFunction<void()> 类型（定义在 erdp_osal.hpp）
 	erdp::Thread LED_thread(
         [&sys_led]() {
             while (1) {
@@ -0,0 +1,16 @@
+#include "erdp_hal_adc.hpp"
+namespace erdp
+{
+    AdcDev *AdcDev::__instance[ERDP_ADC_NUM] = {nullptr};
+
+    extern "C"
+    {
+        void erdp_adc_irq_handler(ERDP_Adc_t adc)
+        {
+            if (AdcDev::__instance[adc] != nullptr)
+            {
+                AdcDev::__instance[adc]->__irq_handler(adc);
+            }
+        }
+    }
+} // namespace erdp
@@ -0,0 +1,274 @@
+#ifndef __ERDP_HAL_ADC_HPP__
+#define __ERDP_HAL_ADC_HPP__
+#include "erdp_hal.hpp"
+#include "erdp_hal_dma.hpp"
+#include "erdp_if_adc.h"
+
+namespace erdp
+{
+    extern "C"
+    {
+        void erdp_adc_irq_handler(ERDP_Adc_t adc);
+    }
+
+    typedef struct
+    {
+        ERDP_Adc_t adc;      // ADC number, ADC1 for interleaved modes
+        ERDP_AdcMode_t mode; // Independent, dual or triple interleaved
+
+        const uint8_t *channels; // Regular sequence, converted by every ADC of an interleaved group
+        uint8_t channel_num;     // Number of channels of the sequence
+        ERDP_AdcSampleTime_t sample_time;
+        ERDP_AdcResolution_t resolution;
+
+        ERDP_AdcTrigger_t trigger; // Timer trigger, ERDP_ADC_TRIG_SOFTWARE for free running conversions
+        uint8_t sampling_delay;    // ADC clock cycles between two ADCs in interleaved modes (5..20)
+
+        uint8_t priority; // Priority for the DMA and overrun interrupts
+    } AdcConfig_t;
+
+    class AdcDev
+    {
+        friend void erdp_adc_irq_handler(ERDP_Adc_t adc);
+#ifdef ERDP_ENABLE_RTOS
+        using Notify = Queue<uint8_t>;
+#else
+        using Notify = RingBuffer<uint8_t>;
+#endif
+
+    public:
+        AdcDev() {}
+        AdcDev(const AdcDev &) = delete;
+        AdcDev &operator=(const AdcDev &) = delete;
+
+        AdcDev(const AdcConfig_t &config)
+        {
+            init(config);
+        }
+
+        ~AdcDev()
+        {
+            deinit();
+        }
+
+        void init(const AdcConfig_t &config)
+        {
+            erdp_assert(config.channel_num > 0 && config.channel_num <= ERDP_ADC_MAX_SEQUENCE);
+            erdp_assert(config.mode == ERDP_ADC_MODE_INDEPENDENT || config.adc == ERDP_ADC1);
+            __config = config;
+            __adc_num = (config.mode == ERDP_ADC_MODE_TRIPLE_INTERLEAVED) ? 3
+                        : (config.mode == ERDP_ADC_MODE_DUAL_INTERLEAVED) ? 2
+                                                                           : 1;
+            /* Two pending blocks: the half being processed and the one just completed */
+#ifdef ERDP_ENABLE_RTOS
+            __ready.init(2);
+#else
+            __ready.init(3);
+#endif
+            erdp_if_adc_common_init(__config.mode, __config.sampling_delay);
+            for (uint8_t i = 0; i < __adc_num; i++)
+            {
+                ERDP_Adc_t adc = (ERDP_Adc_t)(__config.adc + i);
+                __instance[adc] = this;
+                if (i == 0)
+                {
+                    erdp_if_adc_init(adc, __config.resolution, __config.trigger);
+                }
+                else
+                {
+                    /* Slaves of an interleaved group are started by the master, with its continuous setting */
+                    erdp_if_adc_slave_init(adc, __config.resolution, __config.trigger == ERDP_ADC_TRIG_SOFTWARE);
+                }
+                erdp_if_adc_set_sequence(adc, __config.channels, __config.channel_num, __config.sample_time);
+            }
+        }
+
+        void deinit()
+        {
+            if (__adc_num == 0)
+            {
+                return;
+            }
+            stop();
+            __dma.deinit();
+            for (uint8_t i = 0; i < __adc_num; i++)
+            {
+                __instance[__config.adc + i] = nullptr;
+            }
+            __adc_num = 0;
+        }
+
+        void gpio_init(ERDP_GpioPort_t port, ERDP_GpioPin_t pin)
+        {
+            erdp_if_adc_gpio_init(port, pin);
+        }
+
+        // Circular conversions into buffer, which holds two blocks of block_size samples ordered as the
+        // sequence (then by ADC in interleaved modes). block_size is a multiple of channel_num, even in
+        // interleaved modes. Each full block goes to wait_block() while the DMA fills the other one.
+        bool start(uint16_t *buffer, uint32_t block_size)
+        {
+            DmaConfig_t dma_cfg = {};
+            bool multi = __config.mode != ERDP_ADC_MODE_INDEPENDENT;
+
+            erdp_assert(block_size % __config.channel_num == 0);
+            erdp_assert(!multi || block_size % 2 == 0);
+            __buffer = buffer;
+            __block_size = block_size;
+            __dma_count = multi ? block_size : block_size * 2;
+            if (__dma_count > ERDP_DMA_MAX_COUNT)
+            {
+                return false;
+            }
+
+            /* Interleaved results are read as pairs from the common data register */
+            dma_cfg.dir = ERDP_DMA_DIR_P2M;
+            dma_cfg.periph_width = multi ? ERDP_DMA_WIDTH_32BIT : ERDP_DMA_WIDTH_16BIT;
+            dma_cfg.mem_width = dma_cfg.periph_width;
+            dma_cfg.mem_inc = true;
+            dma_cfg.circular = true;
+            dma_cfg.priority = ERDP_DMA_PRIO_VERY_HIGH;
+            dma_cfg.irq_flags = ERDP_DMA_FLAG_TC | ERDP_DMA_FLAG_HT | ERDP_DMA_FLAG_TE;
+            dma_cfg.irq_priority = __config.priority;
+            if (!__dma.claim(erdp_if_adc_get_dma_request(__config.adc), dma_cfg))
+            {
+                return false;
+            }
+            __dma.set_usr_irq_handler([this](uint32_t flags) { __dma_irq_handler(flags); });
+
+            uint8_t block;
+            while (__ready.pop(block))
+            {
+            }
+            __overrun_count = 0;
+            __restart();
+            return true;
+        }
+
+        void stop()
+        {
+            for (uint8_t i = 0; i < __adc_num; i++)
+            {
+                ERDP_Adc_t adc = (ERDP_Adc_t)(__config.adc + i);
+                erdp_if_adc_overrun_irq_enable(adc, __config.priority, false);
+                erdp_if_adc_enable(adc, false);
+            }
+            erdp_if_adc_dma_enable(__config.adc, __config.mode, false);
+            __dma.stop();
+        }
+
+        // Next full block, valid until the DMA wraps around to it again, nullptr after timeout ms
+        const uint16_t *wait_block(uint32_t timeout)
+        {
+            uint8_t block;
+#ifdef ERDP_ENABLE_RTOS
+            if (!__ready.pop(block, timeout))
+            {
+                return nullptr;
+            }
+#else
+            uint32_t start_time = erdp_if_rtos_get_1ms_timestamp();
+            while (!__ready.pop(block))
+            {
+                if (erdp_if_rtos_get_1ms_timestamp() - start_time >= timeout)
+                {
+                    return nullptr;
+                }
+            }
+#endif
+            return __buffer + block * __block_size;
+        }
+
+        // Called from the DMA interrupt with each full block, in addition to wait_block()
+        void set_usr_irq_handler(InplaceFunction<void(const uint16_t *block)> usr_irq_handler)
+        {
+            __usr_irq_handler = usr_irq_handler;
+        }
+
+        uint32_t get_block_size() const
+        {
+            return __block_size;
+        }
+
+        // Blocks dropped because the consumer was late, and ADC overruns
+        uint32_t get_overrun_count() const
+        {
+            return __overrun_count;
+        }
+
+    private:
+        static AdcDev *__instance[ERDP_ADC_NUM];
+        AdcConfig_t __config = {};
+        uint8_t __adc_num = 0;
+        DmaStream __dma;
+        Notify __ready;
+        uint16_t *__buffer = nullptr;
+        uint32_t __block_size = 0;
+        uint32_t __dma_count = 0;
+        volatile uint32_t __overrun_count = 0;
+        InplaceFunction<void(const uint16_t *block)> __usr_irq_handler = nullptr;
+
+        void __restart()
+        {
+            for (uint8_t i = 0; i < __adc_num; i++)
+            {
+                ERDP_Adc_t adc = (ERDP_Adc_t)(__config.adc + i);
+                erdp_if_adc_clear_overrun(adc);
+                erdp_if_adc_overrun_irq_enable(adc, __config.priority, true);
+            }
+            erdp_if_adc_dma_enable(__config.adc, __config.mode, false);
+            __dma.stop();
+            __dma.start(erdp_if_adc_get_data_addr(__config.adc, __config.mode), __buffer, __dma_count);
+            erdp_if_adc_dma_enable(__config.adc, __config.mode, true);
+            /* Slaves first, so they are ready when the master starts the group */
+            for (uint8_t i = __adc_num; i > 0; i--)
+            {
+                erdp_if_adc_enable((ERDP_Adc_t)(__config.adc + i - 1), true);
+            }
+            if (__config.trigger == ERDP_ADC_TRIG_SOFTWARE)
+            {
+                erdp_if_adc_software_start(__config.adc);
+            }
+        }
+
+        void __dma_irq_handler(uint32_t flags)
+        {
+            if (flags & ERDP_DMA_FLAG_HT)
+            {
+                __block_ready(0);
+            }
+            if (flags & ERDP_DMA_FLAG_TC)
+            {
+                __block_ready(1);
+            }
+        }
+
+        void __block_ready(uint8_t block)
+        {
+            if (!__ready.push(block))
+            {
+                __overrun_count++;
+            }
+            if (__usr_irq_handler != nullptr)
+            {
+                __usr_irq_handler(__buffer + block * __block_size);
+            }
+        }
+
+        void __irq_handler(ERDP_Adc_t adc)
+        {
+            /* DMA requests stop on overrun, restart the whole group from the first block */
+            if (erdp_if_adc_clear_overrun(adc))
+            {
+                __overrun_count++;
+                for (uint8_t i = 0; i < __adc_num; i++)
+                {
+                    erdp_if_adc_enable((ERDP_Adc_t)(__config.adc + i), false);
+                }
+                __restart();
+            }
+        }
+    };
+} // namespace erdp
+
+#endif // __ERDP_HAL_ADC_HPP__
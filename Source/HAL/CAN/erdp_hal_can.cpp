@@ -0,0 +1,32 @@
+#include "erdp_hal_can.hpp"
+namespace erdp
+{
+    CanDev *CanDev::__instance[ERDP_CAN_NUM] = {nullptr};
+
+    extern "C"
+    {
+        void erdp_can_tx_irq_handler(ERDP_Can_t can)
+        {
+            if (CanDev::__instance[can] != nullptr)
+            {
+                CanDev::__instance[can]->__tx_irq_handler();
+            }
+        }
+
+        void erdp_can_rx_irq_handler(ERDP_Can_t can, uint8_t fifo)
+        {
+            if (CanDev::__instance[can] != nullptr)
+            {
+                CanDev::__instance[can]->__rx_irq_handler(fifo);
+            }
+        }
+
+        void erdp_can_sce_irq_handler(ERDP_Can_t can)
+        {
+            if (CanDev::__instance[can] != nullptr)
+            {
+                CanDev::__instance[can]->__sce_irq_handler();
+            }
+        }
+    }
+} // namespace erdp
@@ -0,0 +1,413 @@
+#ifndef __ERDP_HAL_CAN_HPP__
+#define __ERDP_HAL_CAN_HPP__
+#include "erdp_hal.hpp"
+#include "erdp_if_can.h"
+
+namespace erdp
+{
+    extern "C"
+    {
+        void erdp_can_tx_irq_handler(ERDP_Can_t can);
+        void erdp_can_rx_irq_handler(ERDP_Can_t can, uint8_t fifo);
+        void erdp_can_sce_irq_handler(ERDP_Can_t can);
+    }
+
+    using CanFrame_t = ERDP_CanFrame_t;
+
+    typedef struct
+    {
+        ERDP_Can_t can;      // CAN number
+        uint32_t bitrate;    // Bit rate in bit/s, up to 1000000
+        ERDP_CanPins_t pins; // TX and RX pins
+        ERDP_CanMode_t mode; // Normal, loopback or silent
+        uint8_t priority;    // Priority for the CAN interrupts
+    } CanConfig_t;
+
+    typedef struct
+    {
+        uint32_t rx_frames;  // Frames received
+        uint32_t rx_dropped; // Frames lost because the RX ring was full
+        uint32_t rx_overrun; // Frames lost in a hardware FIFO
+        uint32_t tx_frames;  // Frames sent
+        uint32_t tx_dropped; // Frames refused because the TX queue was full
+        uint32_t tx_errors;  // Mailboxes completed without success (aborted or arbitration/error)
+        uint32_t bus_off;    // Bus-off entries
+        uint32_t passive;    // Error passive entries
+        uint32_t bus_errors; // Error codes reported (stuff, form, ack, bit, crc)
+    } CanStats_t;
+
+    class CanDev
+    {
+        friend void erdp_can_tx_irq_handler(ERDP_Can_t can);
+        friend void erdp_can_rx_irq_handler(ERDP_Can_t can, uint8_t fifo);
+        friend void erdp_can_sce_irq_handler(ERDP_Can_t can);
+
+    public:
+        static constexpr uint16_t RX_SIZE = ERDP_CONFIG_CAN_RX_SIZE; // Frames buffered between the RX interrupts and receive()
+        static constexpr uint16_t TX_SIZE = ERDP_CONFIG_CAN_TX_SIZE; // Frames waiting for a free mailbox
+
+        CanDev() {}
+        CanDev(const CanDev &) = delete;
+        CanDev &operator=(const CanDev &) = delete;
+
+        CanDev(const CanConfig_t &config)
+        {
+            init(config);
+        }
+
+        ~CanDev()
+        {
+            deinit();
+        }
+
+        bool init(const CanConfig_t &config)
+        {
+            erdp_assert(config.can > ERDP_CAN0 && config.can < ERDP_CAN_NUM);
+            erdp_assert(__instance[config.can] == nullptr || __instance[config.can] == this);
+            /* The RX interrupt must be off while the ring is cleared */
+            deinit();
+            __config = config;
+            __rx_ring.clear();
+            __tx_count = 0;
+            __stats = {};
+            __instance[__config.can] = this;
+            erdp_if_can_gpio_init(__config.can, &__config.pins);
+            if (!erdp_if_can_init(__config.can, __config.bitrate, __config.mode))
+            {
+                return false;
+            }
+            erdp_if_can_irq_enable(__config.can, __config.priority, true);
+            return true;
+        }
+
+        void deinit()
+        {
+            if (__config.can == ERDP_CAN0)
+            {
+                return;
+            }
+            erdp_if_can_deinit(__config.can);
+            __instance[__config.can] = nullptr;
+            __config.can = ERDP_CAN0;
+        }
+
+        /*
+         * Filter banks are shared: CAN1 owns banks below the split, CAN2 the others. A frame nobody
+         * accepts is dropped by the hardware, so at least one bank has to be set up to receive.
+         * The banks live in CAN1 and are reset by init()/deinit() of CAN1: set them up afterwards.
+         */
+        static void filter_split(uint8_t can2_start_bank)
+        {
+            erdp_if_can_filter_split(can2_start_bank);
+        }
+
+        // Accept frames whose identifier matches id on the bits set in mask
+        static void filter_mask(uint8_t bank, uint32_t id, uint32_t mask, bool ext, uint8_t fifo)
+        {
+            /* IDE is always compared so standard and extended identifiers never alias */
+            erdp_if_can_filter_config(bank, ERDP_CAN_FILTER_MASK, ERDP_CAN_FILTER_32BIT, fifo, filter_reg(id, ext),
+                                      filter_reg(mask, ext) | CAN_FILTER_IDE, true);
+        }
+
+        // Accept exactly id1 and id2
+        static void filter_list(uint8_t bank, uint32_t id1, uint32_t id2, bool ext, uint8_t fifo)
+        {
+            erdp_if_can_filter_config(bank, ERDP_CAN_FILTER_LIST, ERDP_CAN_FILTER_32BIT, fifo, filter_reg(id1, ext),
+                                      filter_reg(id2, ext), true);
+        }
+
+        // Accept exactly four standard identifiers
+        static void filter_list(uint8_t bank, const uint16_t ids[4], uint8_t fifo)
+        {
+            uint32_t fr1 = ((uint32_t)ids[1] << 21) | ((uint32_t)ids[0] << 5);
+            uint32_t fr2 = ((uint32_t)ids[3] << 21) | ((uint32_t)ids[2] << 5);
+            erdp_if_can_filter_config(bank, ERDP_CAN_FILTER_LIST, ERDP_CAN_FILTER_16BIT, fifo, fr1, fr2, true);
+        }
+
+        static void filter_accept_all(uint8_t bank, uint8_t fifo)
+        {
+            erdp_if_can_filter_config(bank, ERDP_CAN_FILTER_MASK, ERDP_CAN_FILTER_32BIT, fifo, 0, 0, true);
+        }
+
+        static void filter_disable(uint8_t bank)
+        {
+            erdp_if_can_filter_config(bank, ERDP_CAN_FILTER_MASK, ERDP_CAN_FILTER_32BIT, 0, 0, 0, false);
+        }
+
+        // 32 bit filter register layout of an identifier: STID[31:21] EXID[20:3] IDE[2] RTR[1]
+        static constexpr uint32_t filter_reg(uint32_t id, bool ext)
+        {
+            return ext ? ((id << 3) | CAN_FILTER_IDE) : (id << 21);
+        }
+
+        /*
+         * Queue a frame. Pending frames go to the mailboxes by bus priority (lowest identifier
+         * first, in submission order for equal identifiers) as soon as one is free, so all three
+         * stay loaded while the queue is not empty. Returns false if the queue is full.
+         */
+        bool send(const CanFrame_t &frame)
+        {
+            erdp_assert(frame.dlc <= 8);
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            bool queued = __tx_push(frame);
+            if (!queued)
+            {
+                __stats.tx_dropped++;
+            }
+            __tx_refill();
+            erdp_if_rtos_cpu_unlock(key);
+            return queued;
+        }
+
+        // Oldest received frame, waits at most timeout ms
+        bool receive(CanFrame_t &frame, uint32_t timeout = 0)
+        {
+#ifdef ERDP_ENABLE_RTOS
+            while (!__rx_ring.pop(frame))
+            {
+                if (!__rx_signal.take(timeout))
+                {
+                    return __rx_ring.pop(frame);
+                }
+            }
+            return true;
+#else
+            uint32_t start_time = erdp_if_rtos_get_1ms_timestamp();
+            while (!__rx_ring.pop(frame))
+            {
+                if (erdp_if_rtos_get_1ms_timestamp() - start_time >= timeout)
+                {
+                    return false;
+                }
+            }
+            return true;
+#endif
+        }
+
+        uint32_t rx_available() const
+        {
+            return __rx_ring.size();
+        }
+
+        uint32_t tx_pending() const
+        {
+            return __tx_count;
+        }
+
+        // Drop the queued frames and abort the mailboxes
+        void tx_flush()
+        {
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            __tx_count = 0;
+            erdp_if_can_tx_abort(__config.can);
+            erdp_if_rtos_cpu_unlock(key);
+        }
+
+        // Called from the RX interrupt with each frame, the frame is queued for receive() as well
+        void set_usr_irq_handler(InplaceFunction<void(const CanFrame_t &frame)> usr_irq_handler)
+        {
+            __usr_irq_handler = usr_irq_handler;
+        }
+
+        // Current error counters and state; the controller leaves bus-off by itself after 128 * 11 recessive bits
+        void get_error(ERDP_CanError_t &error) const
+        {
+            erdp_if_can_get_error(__config.can, &error);
+        }
+
+        // Reset the last error code so get_error() only reports errors seen from now on
+        void clear_error()
+        {
+            erdp_if_can_clear_error(__config.can);
+        }
+
+        bool is_bus_off() const
+        {
+            ERDP_CanError_t error;
+            erdp_if_can_get_error(__config.can, &error);
+            return error.bus_off;
+        }
+
+        CanStats_t get_stats() const
+        {
+            return __stats;
+        }
+
+        void clear_stats()
+        {
+            __stats = {};
+        }
+
+    private:
+        static constexpr uint32_t CAN_FILTER_IDE = 1U << 2;
+
+        typedef struct
+        {
+            uint32_t prio; // Arbitration field, lower wins
+            uint32_t seq;  // Submission order for equal priorities
+            CanFrame_t frame;
+        } TxEntry;
+
+        static CanDev *__instance[ERDP_CAN_NUM];
+        CanConfig_t __config = {};
+        RingBuffer<CanFrame_t, RX_SIZE> __rx_ring; // SPSC: the RX interrupt pushes, receive() pops
+#ifdef ERDP_ENABLE_RTOS
+        StaticSemaphore<BINARY_TAG> __rx_signal;
+#endif
+        TxEntry __tx_heap[TX_SIZE]; // Binary min-heap on (prio, seq)
+        volatile uint16_t __tx_count = 0;
+        uint32_t __tx_seq = 0;
+        bool __bus_off = false;
+        bool __passive = false;
+        CanStats_t __stats = {};
+        InplaceFunction<void(const CanFrame_t &frame)> __usr_irq_handler = nullptr;
+
+        static uint32_t __now()
+        {
+            return erdp_if_rtos_get_1ms_timestamp();
+        }
+
+        /* Same order as the bus arbitration: base identifier, then standard before extended */
+        static uint32_t __arbitration(const CanFrame_t &frame)
+        {
+            return frame.ext ? ((frame.id << 1) | 1U) : (frame.id << 19);
+        }
+
+        static bool __before(const TxEntry &a, const TxEntry &b)
+        {
+            return (a.prio != b.prio) ? (a.prio < b.prio) : ((int32_t)(a.seq - b.seq) < 0);
+        }
+
+        bool __tx_push(const CanFrame_t &frame)
+        {
+            if (__tx_count >= TX_SIZE)
+            {
+                return false;
+            }
+            uint16_t i = __tx_count++;
+            TxEntry entry = {__arbitration(frame), __tx_seq++, frame};
+            while (i > 0)
+            {
+                uint16_t parent = (i - 1) / 2;
+                if (!__before(entry, __tx_heap[parent]))
+                {
+                    break;
+                }
+                __tx_heap[i] = __tx_heap[parent];
+                i = parent;
+            }
+            __tx_heap[i] = entry;
+            return true;
+        }
+
+        void __tx_pop()
+        {
+            TxEntry last = __tx_heap[--__tx_count];
+            uint16_t i = 0;
+            while (true)
+            {
+                uint16_t child = 2 * i + 1;
+                if (child >= __tx_count)
+                {
+                    break;
+                }
+                if (child + 1 < __tx_count && __before(__tx_heap[child + 1], __tx_heap[child]))
+                {
+                    child++;
+                }
+                if (!__before(__tx_heap[child], last))
+                {
+                    break;
+                }
+                __tx_heap[i] = __tx_heap[child];
+                i = child;
+            }
+            __tx_heap[i] = last;
+        }
+
+        // Called with interrupts locked or from the TX interrupt
+        void __tx_refill()
+        {
+            while (__tx_count > 0 && erdp_if_can_transmit(__config.can, &__tx_heap[0].frame) != ERDP_CAN_NO_MAILBOX)
+            {
+                __tx_pop();
+            }
+        }
+
+        void __tx_irq_handler()
+        {
+            uint8_t ok_mask;
+            uint8_t done = erdp_if_can_tx_complete(__config.can, &ok_mask);
+            for (uint8_t i = 0; i < ERDP_CAN_MAILBOX_NUM; i++)
+            {
+                if (ok_mask & (1U << i))
+                {
+                    __stats.tx_frames++;
+                }
+                else if (done & (1U << i))
+                {
+                    __stats.tx_errors++;
+                }
+            }
+            __tx_refill();
+        }
+
+        // Empty the hardware FIFO (3 frames) into the ring, the only producer of __rx_ring
+        void __rx_irq_handler(uint8_t fifo)
+        {
+            CanFrame_t frame;
+            bool received = false;
+
+            if (erdp_if_can_rx_overrun(__config.can, fifo))
+            {
+                __stats.rx_overrun++;
+            }
+            while (erdp_if_can_rx_pending(__config.can, fifo) > 0)
+            {
+                erdp_if_can_receive(__config.can, fifo, &frame);
+                frame.timestamp = __now();
+                __stats.rx_frames++;
+                if (!__rx_ring.push(frame))
+                {
+                    __stats.rx_dropped++;
+                }
+                if (__usr_irq_handler != nullptr)
+                {
+                    __usr_irq_handler(frame);
+                }
+                received = true;
+            }
+#ifdef ERDP_ENABLE_RTOS
+            if (received)
+            {
+                __rx_signal.give();
+            }
+#else
+            (void)received;
+#endif
+        }
+
+        void __sce_irq_handler()
+        {
+            ERDP_CanError_t error;
+            erdp_if_can_get_error(__config.can, &error);
+            erdp_if_can_clear_error(__config.can);
+            if (error.bus_off && !__bus_off)
+            {
+                __stats.bus_off++;
+            }
+            if (error.passive && !__passive)
+            {
+                __stats.passive++;
+            }
+            if (error.lec != 0 && error.lec != 7)
+            {
+                __stats.bus_errors++;
+            }
+            __bus_off = error.bus_off;
+            __passive = error.passive;
+        }
+    };
+} // namespace erdp
+
+#endif // __ERDP_HAL_CAN_HPP__
@@ -0,0 +1,198 @@
+#ifndef __ERDP_HAL_CRC_HPP__
+#define __ERDP_HAL_CRC_HPP__
+#include "erdp_hal.hpp"
+#include "erdp_hal_dma.hpp"
+#include "erdp_if_crc.h"
+#include "crc32.hpp"
+
+namespace erdp
+{
+    /*
+     * CRC-32 on the CRC unit. Whole words go through the hardware, the 1..3 trailing bytes are
+     * finished in software from the hardware state, so results match Crc32Ieee / Crc32Mpeg2.
+     * Other polynomials and host builds use the software Crc32 directly.
+     */
+    class CrcDev
+    {
+    public:
+        // Below this many words the CPU loop finishes before the DMA would be set up
+        static constexpr uint32_t DMA_MIN_WORDS = 256;
+
+        CrcDev() {}
+        CrcDev(const CrcDev &) = delete;
+        CrcDev &operator=(const CrcDev &) = delete;
+
+        // use_dma: claim a DMA2 stream for words(), false to always feed with the CPU
+        CrcDev(bool use_dma, uint8_t priority)
+        {
+            init(use_dma, priority);
+        }
+
+        ~CrcDev()
+        {
+            deinit();
+        }
+
+        void init(bool use_dma = false, uint8_t priority = 0)
+        {
+            erdp_if_crc_init();
+            __use_dma = false;
+            if (use_dma)
+            {
+                DmaConfig_t dma_cfg = {};
+                dma_cfg.dir = ERDP_DMA_DIR_M2M;
+                dma_cfg.periph_width = ERDP_DMA_WIDTH_32BIT;
+                dma_cfg.mem_width = ERDP_DMA_WIDTH_32BIT;
+                dma_cfg.periph_inc = true;
+                dma_cfg.mem_inc = false;
+                dma_cfg.fifo = true;
+                dma_cfg.priority = ERDP_DMA_PRIO_LOW;
+                dma_cfg.irq_flags = ERDP_DMA_FLAG_TC | ERDP_DMA_FLAG_TE;
+                dma_cfg.irq_priority = priority;
+                /* Without a free stream the words are fed by the CPU */
+                __use_dma = __dma.claim(ERDP_DMA_REQ_MEM2MEM, dma_cfg);
+                __dma.set_usr_irq_handler([this](uint32_t flags) { __dma_irq_handler(flags); });
+            }
+        }
+
+        void deinit()
+        {
+            __dma.deinit();
+            __use_dma = false;
+            erdp_if_crc_deinit();
+        }
+
+        // CRC-32 as zlib and Ethernet, same result as Crc32Ieee::compute()
+        uint32_t ieee(const void *data, size_t len)
+        {
+            const uint8_t *p = (const uint8_t *)data;
+            uint32_t words = len / 4;
+            uint32_t state = Crc32Ieee::INIT;
+
+            if (words > 0)
+            {
+                __lock();
+                erdp_if_crc_reset();
+                state = erdp_if_crc_feed_reflected(p, words);
+                __unlock();
+            }
+            return Crc32Ieee::finish(Crc32Ieee::update(state, p + words * 4, len & 0x03U));
+        }
+
+        // CRC-32/MPEG-2 over a byte stream, same result as Crc32Mpeg2::compute()
+        uint32_t mpeg2(const void *data, size_t len)
+        {
+            const uint8_t *p = (const uint8_t *)data;
+            uint32_t words = len / 4;
+            uint32_t state = Crc32Mpeg2::INIT;
+
+            if (words > 0)
+            {
+                __lock();
+                erdp_if_crc_reset();
+                state = erdp_if_crc_feed_swapped(p, words);
+                __unlock();
+            }
+            return Crc32Mpeg2::finish(Crc32Mpeg2::update(state, p + words * 4, len & 0x03U));
+        }
+
+        /*
+         * Native CRC of the unit over words as stored in memory (little endian), what ST tools
+         * and bootloaders call the STM32 CRC. Large buffers are fed by DMA, the caller sleeps meanwhile.
+         * After a DMA transfer error the whole buffer is fed again by the CPU.
+         */
+        uint32_t words(const uint32_t *data, size_t count)
+        {
+            uint32_t result;
+
+            __lock();
+            erdp_if_crc_reset();
+            if (!__use_dma || count < DMA_MIN_WORDS || ((uintptr_t)data & 0xFFFF0000U) == 0x10000000U)
+            {
+                result = erdp_if_crc_feed(data, count);
+            }
+            else
+            {
+                const uint32_t *p = data;
+                size_t remain = count;
+                bool error = false;
+                while (remain > 0 && !error)
+                {
+                    uint32_t chunk = (remain > ERDP_DMA_MAX_COUNT) ? ERDP_DMA_MAX_COUNT : remain;
+                    __dma_done = false;
+                    __dma_error = false;
+                    __dma.start((uint32_t)(uintptr_t)p, erdp_if_crc_get_data_addr(), chunk);
+                    __dma_wait();
+                    error = __dma_error;
+                    p += chunk;
+                    remain -= chunk;
+                }
+                if (error)
+                {
+                    /* The unit holds an unknown part of the failed chunk */
+                    __dma.stop();
+                    erdp_if_crc_reset();
+                    result = erdp_if_crc_feed(data, count);
+                }
+                else
+                {
+                    result = erdp_if_crc_get();
+                }
+            }
+            __unlock();
+            return result;
+        }
+
+    private:
+        DmaStream __dma;
+        bool __use_dma = false;
+        volatile bool __dma_done = false;
+        volatile bool __dma_error = false; // TE seen in the last chunk
+#ifdef ERDP_ENABLE_RTOS
+        StaticMutex __mutex;
+        StaticSemaphore<BINARY_TAG> __dma_sem;
+#endif
+
+        void __lock()
+        {
+#ifdef ERDP_ENABLE_RTOS
+            __mutex.lock();
+#endif
+        }
+
+        void __unlock()
+        {
+#ifdef ERDP_ENABLE_RTOS
+            __mutex.unlock();
+#endif
+        }
+
+        void __dma_wait()
+        {
+#ifdef ERDP_ENABLE_RTOS
+            __dma_sem.take();
+#else
+            while (!__dma_done)
+            {
+            }
+#endif
+        }
+
+        void __dma_irq_handler(uint32_t flags)
+        {
+            if (flags & (ERDP_DMA_FLAG_TC | ERDP_DMA_FLAG_TE))
+            {
+                if (flags & ERDP_DMA_FLAG_TE)
+                {
+                    __dma_error = true;
+                }
+                __dma_done = true;
+#ifdef ERDP_ENABLE_RTOS
+                __dma_sem.give();
+#endif
+            }
+        }
+    };
+} // namespace erdp
+
+#endif // __ERDP_HAL_CRC_HPP__
@@ -0,0 +1,19 @@
+#include "erdp_hal_dac.hpp"
+namespace erdp
+{
+    DacDev *DacDev::__instance[ERDP_DAC_CH_NUM] = {nullptr};
+
+    extern "C"
+    {
+        void erdp_dac_irq_handler(void)
+        {
+            for (auto dac : DacDev::__instance)
+            {
+                if (dac != nullptr)
+                {
+                    dac->__irq_handler();
+                }
+            }
+        }
+    }
+} // namespace erdp
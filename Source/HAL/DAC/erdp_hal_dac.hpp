@@ -0,0 +1,258 @@
+#ifndef __ERDP_HAL_DAC_HPP__
+#define __ERDP_HAL_DAC_HPP__
+#include "erdp_hal.hpp"
+#include "erdp_hal_dma.hpp"
+#include "erdp_if_dac.h"
+#include <math.h>
+
+namespace erdp
+{
+    extern "C"
+    {
+        void erdp_dac_irq_handler(void);
+    }
+
+    typedef struct
+    {
+        ERDP_DacChannel_t channel; // DAC channel
+        ERDP_Tim_t trigger_tim;    // Sample clock, started with TimerDev::trigger_start(), ERDP_TIM0 for set_value() only
+        bool output_buffer;        // Enable the output buffer
+        uint8_t priority;          // Priority for the DMA and underrun interrupts
+    } DacConfig_t;
+
+    typedef enum
+    {
+        WAVE_SINE = 0,
+        WAVE_TRIANGLE,
+        WAVE_SQUARE,
+        WAVE_SAWTOOTH,
+    } WaveShape_t;
+
+    class WaveSynth
+    {
+    public:
+        static constexpr uint32_t TABLE_BITS = 8;
+        static constexpr uint32_t TABLE_SIZE = 1U << TABLE_BITS;
+
+        WaveSynth() {}
+        WaveSynth(WaveShape_t shape, uint16_t amplitude, uint16_t offset)
+        {
+            init(shape, amplitude, offset);
+        }
+
+        // One period of shape into table, swinging offset +/- amplitude
+        static void fill(uint16_t *table, uint32_t count, WaveShape_t shape, uint16_t amplitude, uint16_t offset)
+        {
+            const float pi = 3.14159265358979f;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                float phase = (float)i / (float)count;
+                float value;
+                switch (shape)
+                {
+                    case WAVE_TRIANGLE:
+                        value = (phase < 0.5f) ? (4.0f * phase - 1.0f) : (3.0f - 4.0f * phase);
+                        break;
+                    case WAVE_SQUARE:
+                        value = (phase < 0.5f) ? 1.0f : -1.0f;
+                        break;
+                    case WAVE_SAWTOOTH:
+                        value = 2.0f * phase - 1.0f;
+                        break;
+                    case WAVE_SINE:
+                    default:
+                        value = sinf(2.0f * pi * phase);
+                        break;
+                }
+                float code = (float)offset + value * (float)amplitude + 0.5f;
+                code = (code < 0.0f) ? 0.0f : (code > (float)ERDP_DAC_MAX_VALUE) ? (float)ERDP_DAC_MAX_VALUE : code;
+                table[i] = (uint16_t)code;
+            }
+        }
+
+        void init(WaveShape_t shape, uint16_t amplitude, uint16_t offset)
+        {
+            fill(__table, TABLE_SIZE, shape, amplitude, offset);
+            __phase = 0;
+        }
+
+        void set_frequency(float freq_hz, uint32_t sample_rate)
+        {
+            __phase_inc = (uint32_t)((double)freq_hz / (double)sample_rate * 4294967296.0);
+        }
+
+        // Render a block by phase accumulation, meant to be called from DacDev refill callbacks
+        void render(uint16_t *out, uint32_t count)
+        {
+            uint32_t phase = __phase;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                out[i] = __table[phase >> (32 - TABLE_BITS)];
+                phase += __phase_inc;
+            }
+            __phase = phase;
+        }
+
+    private:
+        uint16_t __table[TABLE_SIZE] = {0};
+        uint32_t __phase = 0;
+        uint32_t __phase_inc = 0;
+    };
+
+    class DacDev
+    {
+        friend void erdp_dac_irq_handler(void);
+
+    public:
+        using Refill = InplaceFunction<void(uint16_t *block, uint32_t count)>;
+
+        DacDev() {}
+        DacDev(const DacDev &) = delete;
+        DacDev &operator=(const DacDev &) = delete;
+
+        DacDev(const DacConfig_t &config)
+        {
+            init(config);
+        }
+
+        ~DacDev()
+        {
+            deinit();
+        }
+
+        // false if trigger_tim cannot pace the DAC
+        bool init(const DacConfig_t &config)
+        {
+            erdp_assert(config.channel < ERDP_DAC_CH_NUM);
+            __config = config;
+            if (!erdp_if_dac_init(__config.channel, __config.trigger_tim, __config.output_buffer))
+            {
+                return false;
+            }
+            __instance[__config.channel] = this;
+            erdp_if_dac_enable(__config.channel, true);
+            return true;
+        }
+
+        void deinit()
+        {
+            if (__instance[__config.channel] == this)
+            {
+                stop();
+                __dma.deinit();
+                erdp_if_dac_deinit(__config.channel);
+                __instance[__config.channel] = nullptr;
+            }
+        }
+
+        void set_value(uint16_t value)
+        {
+            erdp_if_dac_set_value(__config.channel, value);
+        }
+
+        // Loop over table forever, no CPU work per sample or per period
+        bool play(const uint16_t *table, uint32_t count)
+        {
+            __refill = nullptr;
+            return __start(table, count);
+        }
+
+        // Stream generated samples: buffer holds two blocks, refill is called from the DMA interrupt
+        // for the block just played while the DMA outputs the other one. Both blocks are filled first.
+        bool stream(uint16_t *buffer, uint32_t block_size, Refill refill)
+        {
+            erdp_assert(refill != nullptr);
+            __refill = refill;
+            __block = buffer;
+            __block_size = block_size;
+            __refill(buffer, block_size);
+            __refill(buffer + block_size, block_size);
+            return __start(buffer, block_size * 2);
+        }
+
+        void stop()
+        {
+            erdp_if_dac_dma_enable(__config.channel, __config.priority, false);
+            __dma.stop();
+        }
+
+        uint32_t get_underrun_count() const
+        {
+            return __underrun_count;
+        }
+
+    private:
+        static DacDev *__instance[ERDP_DAC_CH_NUM];
+        DacConfig_t __config = {ERDP_DAC_CH1, ERDP_TIM0, false, 0};
+        DmaStream __dma;
+        const uint16_t *__samples = nullptr;
+        uint32_t __sample_count = 0;
+        uint16_t *__block = nullptr;
+        uint32_t __block_size = 0;
+        Refill __refill = nullptr;
+        volatile uint32_t __underrun_count = 0;
+
+        bool __start(const uint16_t *samples, uint32_t count)
+        {
+            DmaConfig_t dma_cfg = {};
+            if (count == 0 || count > ERDP_DMA_MAX_COUNT)
+            {
+                return false;
+            }
+            __samples = samples;
+            __sample_count = count;
+            dma_cfg.dir = ERDP_DMA_DIR_M2P;
+            dma_cfg.periph_width = ERDP_DMA_WIDTH_16BIT;
+            dma_cfg.mem_width = ERDP_DMA_WIDTH_16BIT;
+            dma_cfg.mem_inc = true;
+            dma_cfg.circular = true;
+            dma_cfg.priority = ERDP_DMA_PRIO_HIGH;
+            dma_cfg.irq_flags = (__refill != nullptr) ? (ERDP_DMA_FLAG_HT | ERDP_DMA_FLAG_TC) : 0;
+            dma_cfg.irq_priority = __config.priority;
+            if (!__dma.claim(erdp_if_dac_get_dma_request(__config.channel), dma_cfg))
+            {
+                return false;
+            }
+            __dma.set_usr_irq_handler([this](uint32_t flags) { __dma_irq_handler(flags); });
+            __underrun_count = 0;
+            __restart();
+            return true;
+        }
+
+        void __restart()
+        {
+            erdp_if_dac_dma_enable(__config.channel, __config.priority, false);
+            __dma.stop();
+            __dma.start(erdp_if_dac_get_data_addr(__config.channel), __samples, __sample_count);
+            erdp_if_dac_dma_enable(__config.channel, __config.priority, true);
+        }
+
+        void __dma_irq_handler(uint32_t flags)
+        {
+            if (__refill == nullptr)
+            {
+                return;
+            }
+            if (flags & ERDP_DMA_FLAG_HT)
+            {
+                __refill(__block, __block_size);
+            }
+            if (flags & ERDP_DMA_FLAG_TC)
+            {
+                __refill(__block + __block_size, __block_size);
+            }
+        }
+
+        void __irq_handler()
+        {
+            /* The DMA request stops on underrun, resume from the start of the buffer */
+            if (erdp_if_dac_clear_underrun(__config.channel))
+            {
+                __underrun_count++;
+                __restart();
+            }
+        }
+    };
+} // namespace erdp
+
+#endif // __ERDP_HAL_DAC_HPP__
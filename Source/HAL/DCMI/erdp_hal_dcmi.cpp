@@ -0,0 +1,16 @@
+#include "erdp_hal_dcmi.hpp"
+namespace erdp
+{
+    DcmiDev *DcmiDev::__instance = nullptr;
+
+    extern "C"
+    {
+        void erdp_dcmi_irq_handler(void)
+        {
+            if (DcmiDev::__instance != nullptr)
+            {
+                DcmiDev::__instance->__irq_handler();
+            }
+        }
+    }
+} // namespace erdp
@@ -0,0 +1,341 @@
+#ifndef __ERDP_HAL_DCMI_HPP__
+#define __ERDP_HAL_DCMI_HPP__
+#include "erdp_hal.hpp"
+#include "erdp_hal_dma.hpp"
+#include "erdp_if_dcmi.h"
+
+namespace erdp
+{
+    extern "C"
+    {
+        void erdp_dcmi_irq_handler(void);
+    }
+
+    typedef struct
+    {
+        ERDP_DcmiPins_t pins;
+        bool snapshot;        // One frame per start() instead of continuous capture
+        bool pclk_rising;     // Sample data on the rising edge of PIXCLK
+        bool vsync_high;      // Data is not valid while VSYNC is high
+        bool hsync_high;      // Data is not valid while HSYNC is high
+        ERDP_DcmiRate_t rate; // Frame rate divider
+        uint32_t frame_size;  // Bytes per frame (e.g. width * height * 2 for RGB565), multiple of 4
+        uint8_t priority;     // Priority for the DCMI and DMA interrupts
+    } DcmiConfig_t;
+
+    typedef struct
+    {
+        uint32_t *data;     // Frame pixels, frame_size bytes
+        uint32_t size;      // Bytes
+        uint32_t sequence;  // Captured frame number, gaps show the dropped frames
+        uint32_t timestamp; // System 1ms ticks at the end of the frame
+    } DcmiFrame_t;
+
+    /*
+     * Camera capture into a pool of frame buffers. The DMA runs in double buffer mode over two
+     * pool frames; every completed frame is queued for the consumer and the freed DMA target is
+     * pointed to another pool frame. When the consumer holds or has not yet taken every other
+     * frame, the oldest queued frame is recycled so the capture never stalls.
+     */
+    class DcmiDev
+    {
+        friend void erdp_dcmi_irq_handler(void);
+
+    public:
+        static constexpr uint8_t FRAME_MAX = 8;
+
+        DcmiDev() {}
+        DcmiDev(const DcmiDev &) = delete;
+        DcmiDev &operator=(const DcmiDev &) = delete;
+
+        ~DcmiDev()
+        {
+            deinit();
+        }
+
+        // buffers holds count frames of config.frame_size bytes, at least 3 (2 DMA targets and 1 for the consumer)
+        void init(const DcmiConfig_t &config, uint32_t *const buffers[], uint8_t count)
+        {
+            erdp_assert(__instance == nullptr || __instance == this);
+            erdp_assert(count >= 3 && count <= FRAME_MAX);
+            erdp_assert((config.frame_size & 0x03U) == 0 && config.frame_size / 4 <= ERDP_DMA_MAX_COUNT);
+            __instance = this;
+            __config = config;
+            __count = count;
+            __free_count = 0;
+            __ready_head = 0;
+            __ready_count = 0;
+            __owned = 0;
+            for (uint8_t i = 0; i < count; i++)
+            {
+                __frame[i].data = buffers[i];
+                __frame[i].size = config.frame_size;
+                __frame[i].sequence = 0;
+                __frame[i].timestamp = 0;
+                __free[__free_count++] = i;
+            }
+
+            ERDP_DcmiCfg_t dcmi_cfg = {config.snapshot, config.pclk_rising, config.vsync_high,
+                                       config.hsync_high, config.rate, config.priority};
+            erdp_if_dcmi_gpio_init(&config.pins);
+            erdp_if_dcmi_init(&dcmi_cfg);
+            __dma_setup();
+        }
+
+        void deinit()
+        {
+            if (__instance != this)
+            {
+                return;
+            }
+            stop();
+            __dma.deinit();
+            erdp_if_dcmi_deinit();
+            __instance = nullptr;
+        }
+
+        // Start the continuous capture, or capture one frame in snapshot mode; two frames must not be held by the consumer
+        void start()
+        {
+            if (!__running)
+            {
+                __arm();
+            }
+            erdp_if_dcmi_capture(true);
+        }
+
+        void stop()
+        {
+            if (!__running)
+            {
+                return;
+            }
+            erdp_if_dcmi_capture(false);
+            __dma.stop();
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            __free[__free_count++] = __target[0];
+            __free[__free_count++] = __target[1];
+            __running = false;
+            erdp_if_rtos_cpu_unlock(key);
+        }
+
+        // Take the oldest captured frame, nullptr on timeout; give it back with release()
+        DcmiFrame_t *acquire(uint32_t timeout)
+        {
+#ifdef ERDP_ENABLE_RTOS
+            while (true)
+            {
+                DcmiFrame_t *frame = __pop_ready();
+                if (frame != nullptr || !__frame_ready.take(timeout))
+                {
+                    return frame;
+                }
+            }
+#else
+            uint32_t start_time = erdp_if_rtos_get_1ms_timestamp();
+            while (true)
+            {
+                DcmiFrame_t *frame = __pop_ready();
+                if (frame != nullptr || erdp_if_rtos_get_1ms_timestamp() - start_time >= timeout)
+                {
+                    return frame;
+                }
+            }
+#endif
+        }
+
+        // Only a frame returned by acquire(), once; a second release is ignored
+        void release(DcmiFrame_t *frame)
+        {
+            erdp_assert(frame >= __frame && frame < __frame + __count);
+            uint8_t index = (uint8_t)(frame - __frame);
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            bool owned = (__owned & (1U << index)) != 0;
+            erdp_assert(owned);
+            if (owned)
+            {
+                __owned &= (uint8_t)~(1U << index);
+                __free[__free_count++] = index;
+            }
+            erdp_if_rtos_cpu_unlock(key);
+        }
+
+        uint32_t get_frame_count() const
+        {
+            return __sequence;
+        }
+
+        // Frames overwritten before the consumer took them
+        uint32_t get_drop_count() const
+        {
+            return __drop_count;
+        }
+
+        // Overruns and DMA errors, each one loses the frame in progress
+        uint32_t get_error_count() const
+        {
+            return __error_count;
+        }
+
+        // Called from the DMA interrupt when a frame has been queued for the consumer
+        void set_usr_irq_handler(InplaceFunction<void(const DcmiFrame_t &frame)> usr_irq_handler)
+        {
+            __usr_irq_handler = usr_irq_handler;
+        }
+
+    private:
+        static DcmiDev *__instance;
+        DcmiConfig_t __config = {};
+        DmaStream __dma;
+        DcmiFrame_t __frame[FRAME_MAX];
+        uint8_t __count = 0;
+        uint8_t __free[FRAME_MAX];
+        uint8_t __free_count = 0;
+        uint8_t __ready[FRAME_MAX];
+        uint8_t __ready_head = 0;
+        uint8_t __ready_count = 0;
+        uint8_t __owned = 0; // Frames held by the consumer, bit n for __frame[n]
+        uint8_t __target[2] = {0, 0};
+        bool __running = false;
+        volatile uint32_t __sequence = 0;
+        volatile uint32_t __drop_count = 0;
+        volatile uint32_t __error_count = 0;
+        InplaceFunction<void(const DcmiFrame_t &frame)> __usr_irq_handler = nullptr;
+#ifdef ERDP_ENABLE_RTOS
+        StaticSemaphore<BINARY_TAG> __frame_ready;
+#endif
+
+        void __dma_setup()
+        {
+            DmaConfig_t dma_cfg = {};
+            bool claimed;
+
+            dma_cfg.dir = ERDP_DMA_DIR_P2M;
+            dma_cfg.periph_width = ERDP_DMA_WIDTH_32BIT;
+            dma_cfg.mem_width = ERDP_DMA_WIDTH_32BIT;
+            dma_cfg.mem_inc = true;
+            dma_cfg.fifo = true;
+            dma_cfg.priority = ERDP_DMA_PRIO_HIGH;
+            dma_cfg.irq_flags = ERDP_DMA_FLAG_TC | ERDP_DMA_FLAG_TE;
+            dma_cfg.irq_priority = __config.priority;
+            claimed = __dma.claim(erdp_if_dcmi_get_dma_request(), dma_cfg);
+            erdp_assert(claimed);
+            (void)claimed;
+            __dma.set_usr_irq_handler([this](uint32_t flags) { __dma_irq_handler(flags); });
+        }
+
+        void __arm()
+        {
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            __target[0] = __take_free();
+            __target[1] = __take_free();
+            __running = true;
+            erdp_if_rtos_cpu_unlock(key);
+            __dma.start_double_buffer(erdp_if_dcmi_get_data_addr(), __frame[__target[0]].data,
+                                      __frame[__target[1]].data, __config.frame_size / 4);
+        }
+
+        // Free frame, else the oldest queued one, with the lock held; the pool always has one of them while armed
+        uint8_t __take_free()
+        {
+            if (__free_count > 0)
+            {
+                return __free[--__free_count];
+            }
+            erdp_assert(__ready_count > 0);
+            uint8_t index = __ready[__ready_head];
+            __ready_head = (__ready_head + 1) % FRAME_MAX;
+            __ready_count--;
+            __drop_count++;
+            return index;
+        }
+
+        DcmiFrame_t *__pop_ready()
+        {
+            DcmiFrame_t *frame = nullptr;
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            if (__ready_count > 0)
+            {
+                frame = &__frame[__ready[__ready_head]];
+                __owned |= (uint8_t)(1U << __ready[__ready_head]);
+                __ready_head = (__ready_head + 1) % FRAME_MAX;
+                __ready_count--;
+            }
+            erdp_if_rtos_cpu_unlock(key);
+            return frame;
+        }
+
+        void __dma_irq_handler(uint32_t flags)
+        {
+            if (flags & ERDP_DMA_FLAG_TE)
+            {
+                __error_count++;
+                __restart();
+                return;
+            }
+            if (!(flags & ERDP_DMA_FLAG_TC))
+            {
+                return;
+            }
+
+            /* The stream has already switched, the other target holds the completed frame */
+            uint8_t done_target = __dma.current_target() ^ 1;
+            uint8_t done = __target[done_target];
+            __frame[done].sequence = __sequence++;
+            __frame[done].timestamp = erdp_if_rtos_get_1ms_timestamp();
+
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            uint8_t next;
+            if (__free_count == 0 && __ready_count == 0)
+            {
+                /* The consumer holds every other frame, overwrite this one */
+                next = done;
+                __drop_count++;
+            }
+            else
+            {
+                next = __take_free();
+                __ready[(__ready_head + __ready_count) % FRAME_MAX] = done;
+                __ready_count++;
+            }
+            __target[done_target] = next;
+            erdp_if_rtos_cpu_unlock(key);
+            __dma.set_memory(done_target, __frame[next].data);
+            if (next != done)
+            {
+#ifdef ERDP_ENABLE_RTOS
+                __frame_ready.give();
+#endif
+                if (__usr_irq_handler != nullptr)
+                {
+                    __usr_irq_handler(__frame[done]);
+                }
+            }
+        }
+
+        // Drop the frame in progress and resynchronize on the next VSYNC
+        void __restart()
+        {
+            erdp_if_dcmi_capture(false);
+            __dma.stop();
+            __dma.start_double_buffer(erdp_if_dcmi_get_data_addr(), __frame[__target[0]].data,
+                                      __frame[__target[1]].data, __config.frame_size / 4);
+            if (!__config.snapshot)
+            {
+                erdp_if_dcmi_capture(true);
+            }
+        }
+
+        void __irq_handler()
+        {
+            uint32_t flags = erdp_if_dcmi_get_flags();
+            if (flags & (ERDP_DCMI_FLAG_OVF | ERDP_DCMI_FLAG_ERR))
+            {
+                __error_count++;
+                __restart();
+            }
+        }
+    };
+} // namespace erdp
+
+#endif // __ERDP_HAL_DCMI_HPP__
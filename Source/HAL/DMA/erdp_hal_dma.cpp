@@ -0,0 +1,22 @@
+#include "erdp_hal_dma.hpp"
+namespace erdp
+{
+    DmaStream *DmaStream::__instance[ERDP_DMA_STREAM_NUM] = {nullptr};
+    DmaStats_t DmaStream::__stats[ERDP_DMA_STREAM_NUM] = {};
+    uint32_t DmaStream::__conflict_count = 0;
+
+    extern "C"
+    {
+        void erdp_dma_irq_handler(ERDP_DmaStream_t stream)
+        {
+            if (DmaStream::__instance[stream] != nullptr)
+            {
+                DmaStream::__instance[stream]->__irq_handler();
+            }
+            else
+            {
+                erdp_if_dma_clear_flags(stream, ERDP_DMA_FLAG_ALL);
+            }
+        }
+    }
+} // namespace erdp
@@ -0,0 +1,232 @@
+#ifndef __ERDP_HAL_DMA_HPP__
+#define __ERDP_HAL_DMA_HPP__
+#include "erdp_hal.hpp"
+#include "erdp_if_dma.h"
+
+namespace erdp
+{
+    extern "C"
+    {
+        void erdp_dma_irq_handler(ERDP_DmaStream_t stream);
+    }
+
+    using DmaConfig_t = ERDP_DmaCfg_t;
+
+    // Per stream utilization, kept across owners
+    typedef struct
+    {
+        ERDP_DmaRequest_t request; // Current or last owner, ERDP_DMA_REQ_NONE when set up by stream
+        uint32_t claims;
+        uint32_t starts;
+        uint64_t items; // Data items programmed
+        uint32_t completes;
+        uint32_t errors; // Transfer and direct mode errors
+    } DmaStats_t;
+
+    class DmaStream
+    {
+        friend void erdp_dma_irq_handler(ERDP_DmaStream_t stream);
+
+    public:
+        DmaStream() = default;
+        DmaStream(const DmaStream &) = delete;
+        DmaStream &operator=(const DmaStream &) = delete;
+
+        DmaStream(ERDP_DmaStream_t stream, const DmaConfig_t &config)
+        {
+            init(stream, config);
+        }
+
+        ~DmaStream()
+        {
+            deinit();
+        }
+
+        void init(ERDP_DmaStream_t stream, const DmaConfig_t &config)
+        {
+            erdp_assert(stream < ERDP_DMA_STREAM_NUM);
+            erdp_assert(__instance[stream] == nullptr || __instance[stream] == this);
+            if (__stream != stream)
+            {
+                deinit();
+            }
+            __stream = stream;
+            __instance[__stream] = this;
+            if (__request == ERDP_DMA_REQ_NONE)
+            {
+                __stats[__stream].request = ERDP_DMA_REQ_NONE;
+            }
+            erdp_if_dma_init(__stream, &config);
+        }
+
+        /*
+         * Take the first free stream able to serve request, in the order of the F407 request
+         * mapping, and set it up with config (channel is filled in). false when every candidate
+         * is owned by another DmaStream.
+         */
+        bool claim(ERDP_DmaRequest_t request, DmaConfig_t config)
+        {
+            ERDP_DmaStream_t stream;
+            uint8_t i = 0;
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            for (; erdp_if_dma_get_request_map(request, i, &stream, &config.channel); i++)
+            {
+                if (__instance[stream] == nullptr || __instance[stream] == this)
+                {
+                    if (__stream != stream)
+                    {
+                        deinit();
+                    }
+                    __stream = stream;
+                    __instance[__stream] = this;
+                    erdp_if_rtos_cpu_unlock(key);
+
+                    __request = request;
+                    __stats[__stream].request = request;
+                    __stats[__stream].claims++;
+                    erdp_if_dma_init(__stream, &config);
+                    return true;
+                }
+            }
+            if (i > 0)
+            {
+                __conflict_count++;
+            }
+            erdp_if_rtos_cpu_unlock(key);
+            return false;
+        }
+
+        void deinit()
+        {
+            if (__stream < ERDP_DMA_STREAM_NUM && __instance[__stream] == this)
+            {
+                erdp_if_dma_deinit(__stream);
+                __instance[__stream] = nullptr;
+            }
+            __stream = ERDP_DMA_STREAM_NUM;
+            __request = ERDP_DMA_REQ_NONE;
+        }
+
+        void start(uint32_t periph_addr, uint32_t mem_addr, uint32_t count)
+        {
+            erdp_assert(__stream < ERDP_DMA_STREAM_NUM && count <= ERDP_DMA_MAX_COUNT);
+            __stats[__stream].starts++;
+            __stats[__stream].items += count;
+            erdp_if_dma_start(__stream, periph_addr, mem_addr, count);
+        }
+
+        void start(uint32_t periph_addr, const void *mem, uint32_t count)
+        {
+            start(periph_addr, (uint32_t)(uintptr_t)mem, count);
+        }
+
+        void start_double_buffer(uint32_t periph_addr, const void *mem0, const void *mem1, uint32_t count)
+        {
+            erdp_assert(__stream < ERDP_DMA_STREAM_NUM);
+            erdp_if_dma_stop(__stream);
+            erdp_if_dma_double_buffer_config(__stream, (uint32_t)(uintptr_t)mem1, true);
+            start(periph_addr, (uint32_t)(uintptr_t)mem0, count);
+        }
+
+        // No-op on a stream that was never claimed or has been released
+        void stop()
+        {
+            if (__stream < ERDP_DMA_STREAM_NUM)
+            {
+                erdp_if_dma_stop(__stream);
+            }
+        }
+
+        bool busy() const
+        {
+            erdp_assert(__stream < ERDP_DMA_STREAM_NUM);
+            return erdp_if_dma_is_enabled(__stream);
+        }
+
+        uint32_t remaining() const
+        {
+            erdp_assert(__stream < ERDP_DMA_STREAM_NUM);
+            return erdp_if_dma_get_counter(__stream);
+        }
+
+        uint8_t current_target() const
+        {
+            erdp_assert(__stream < ERDP_DMA_STREAM_NUM);
+            return erdp_if_dma_get_current_target(__stream);
+        }
+
+        // Point the memory not currently accessed by a double buffered stream to mem
+        void set_memory(uint8_t target, const void *mem)
+        {
+            erdp_assert(__stream < ERDP_DMA_STREAM_NUM);
+            erdp_if_dma_set_memory(__stream, target, (uint32_t)(uintptr_t)mem);
+        }
+
+        ERDP_DmaStream_t get_stream() const
+        {
+            return __stream;
+        }
+
+        ERDP_DmaRequest_t get_request() const
+        {
+            return __request;
+        }
+
+        // true if a DmaStream owns stream
+        static bool is_claimed(ERDP_DmaStream_t stream)
+        {
+            erdp_assert(stream < ERDP_DMA_STREAM_NUM);
+            return __instance[stream] != nullptr;
+        }
+
+        static const DmaStats_t &get_stats(ERDP_DmaStream_t stream)
+        {
+            erdp_assert(stream < ERDP_DMA_STREAM_NUM);
+            return __stats[stream];
+        }
+
+        // claim() calls that found every candidate stream taken
+        static uint32_t get_conflict_count()
+        {
+            return __conflict_count;
+        }
+
+        void set_usr_irq_handler(InplaceFunction<void(uint32_t flags)> usr_irq_handler)
+        {
+            __usr_irq_handler = usr_irq_handler;
+        }
+
+        void clear_usr_irq_handler()
+        {
+            __usr_irq_handler = nullptr;
+        }
+
+    private:
+        static DmaStream *__instance[ERDP_DMA_STREAM_NUM];
+        static DmaStats_t __stats[ERDP_DMA_STREAM_NUM];
+        static uint32_t __conflict_count;
+        ERDP_DmaStream_t __stream = ERDP_DMA_STREAM_NUM;
+        ERDP_DmaRequest_t __request = ERDP_DMA_REQ_NONE;
+        InplaceFunction<void(uint32_t flags)> __usr_irq_handler = nullptr;
+
+        void __irq_handler()
+        {
+            uint32_t flags = erdp_if_dma_get_flags(__stream);
+            erdp_if_dma_clear_flags(__stream, flags);
+            if (flags & ERDP_DMA_FLAG_TC)
+            {
+                __stats[__stream].completes++;
+            }
+            if (flags & (ERDP_DMA_FLAG_TE | ERDP_DMA_FLAG_DME))
+            {
+                __stats[__stream].errors++;
+            }
+            if (__usr_irq_handler != nullptr)
+            {
+                __usr_irq_handler(flags);
+            }
+        }
+    };
+} // namespace erdp
+
+#endif // __ERDP_HAL_DMA_HPP__
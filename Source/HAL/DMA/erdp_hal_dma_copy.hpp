@@ -0,0 +1,401 @@
+#ifndef __ERDP_HAL_DMA_COPY_HPP__
+#define __ERDP_HAL_DMA_COPY_HPP__
+#include <string.h>
+
+#include "erdp_hal.hpp"
+#include "erdp_hal_dma.hpp"
+
+namespace erdp
+{
+    typedef enum
+    {
+        DMA_COPY_OK = 0,
+        DMA_COPY_BUSY,    // Queued or running
+        DMA_COPY_ERROR,   // DMA transfer error
+        DMA_COPY_TIMEOUT, // Cancelled by the waiting task
+        DMA_COPY_INVALID, // Address the DMA cannot reach (CCM RAM)
+    } DmaCopyResult_t;
+
+    // One copy or fill, queued on the service until done. Must stay alive until then.
+    class DmaCopyRequest
+    {
+        friend class DmaCopy;
+
+    public:
+        DmaCopyRequest() {}
+        DmaCopyRequest(const DmaCopyRequest &) = delete;
+        DmaCopyRequest &operator=(const DmaCopyRequest &) = delete;
+
+        void *dst = nullptr;
+        const void *src = nullptr; // nullptr to fill dst with value
+        size_t len = 0;            // Bytes
+        uint8_t value = 0;
+        InplaceFunction<void(DmaCopyResult_t result)> callback = nullptr; // Called when done, from the DMA interrupt or the task running the queue
+
+        DmaCopyResult_t result() const
+        {
+            return __result;
+        }
+
+    private:
+        volatile DmaCopyResult_t __result = DMA_COPY_OK;
+        DmaCopyRequest *__next = nullptr;
+        size_t __offset = 0;
+#ifdef ERDP_ENABLE_RTOS
+        StaticSemaphore<BINARY_TAG> __done;
+#endif
+    };
+
+    /*
+     * Memory to memory copies and fills on a DMA2 stream, served in order. Each request uses the
+     * widest item size its addresses and length allow and is split at ERDP_DMA_MAX_COUNT items.
+     * Requests under the CPU threshold are done with memcpy()/memset() in their turn, cheaper
+     * than programming the stream, by whoever finds them at the head (the submitting task, a
+     * waiting one or the DMA interrupt) with interrupts enabled.
+     */
+    class DmaCopy
+    {
+    public:
+        static constexpr size_t CPU_THRESHOLD = 256;
+
+        DmaCopy() {}
+        DmaCopy(const DmaCopy &) = delete;
+        DmaCopy &operator=(const DmaCopy &) = delete;
+
+        DmaCopy(uint8_t priority, size_t cpu_threshold = CPU_THRESHOLD)
+        {
+            init(priority, cpu_threshold);
+        }
+
+        ~DmaCopy()
+        {
+            deinit();
+        }
+
+        // Claims a DMA2 stream, false when none is free
+        bool init(uint8_t priority, size_t cpu_threshold = CPU_THRESHOLD)
+        {
+            __priority = priority;
+            __cpu_threshold = cpu_threshold;
+            return __dma.claim(ERDP_DMA_REQ_MEM2MEM, __dma_config(0, false));
+        }
+
+        void deinit()
+        {
+            __dma.deinit();
+        }
+
+        // false if [addr, addr + len) touches the CCM RAM, which is only on the CPU data bus
+        static bool reachable(const void *addr, size_t len)
+        {
+            uintptr_t begin = (uintptr_t)addr;
+            uintptr_t end = begin + len;
+            return end <= CCM_BEGIN || begin >= CCM_END;
+        }
+
+        // Queue req and return; completion through req.callback or wait()
+        DmaCopyResult_t submit(DmaCopyRequest &req)
+        {
+            erdp_assert(__dma.get_stream() < ERDP_DMA_STREAM_NUM);
+            if (!reachable(req.dst, req.len) || (req.src != nullptr && !reachable(req.src, req.len)))
+            {
+                req.__result = DMA_COPY_INVALID;
+                return DMA_COPY_INVALID;
+            }
+            req.__result = DMA_COPY_BUSY;
+            req.__next = nullptr;
+            req.__offset = 0;
+#ifdef ERDP_ENABLE_RTOS
+            req.__done.take(0);
+#endif
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            bool idle = (__head == nullptr);
+            if (idle)
+            {
+                __head = &req;
+            }
+            else
+            {
+                __tail->__next = &req;
+            }
+            __tail = &req;
+            erdp_if_rtos_cpu_unlock(key);
+            if (idle)
+            {
+                __run();
+            }
+            return req.__result;
+        }
+
+        // Wait for a submitted request, cancel it on timeout
+        DmaCopyResult_t wait(DmaCopyRequest &req, uint32_t timeout)
+        {
+            if (req.__result == DMA_COPY_BUSY && !__wait(req, timeout))
+            {
+                __cancel(req);
+            }
+            return req.__result;
+        }
+
+        DmaCopyResult_t copy(void *dst, const void *src, size_t len, uint32_t timeout = 100)
+        {
+            DmaCopyRequest req;
+            req.dst = dst;
+            req.src = src;
+            req.len = len;
+            submit(req);
+            return wait(req, timeout);
+        }
+
+        DmaCopyResult_t fill(void *dst, uint8_t value, size_t len, uint32_t timeout = 100)
+        {
+            DmaCopyRequest req;
+            req.dst = dst;
+            req.value = value;
+            req.len = len;
+            submit(req);
+            return wait(req, timeout);
+        }
+
+        // Requests done by the CPU and by the DMA
+        uint32_t get_cpu_count() const
+        {
+            return __cpu_count;
+        }
+
+        uint32_t get_dma_count() const
+        {
+            return __dma_count;
+        }
+
+    private:
+        static constexpr uintptr_t CCM_BEGIN = 0x10000000U;
+        static constexpr uintptr_t CCM_END = 0x10010000U;
+
+        DmaStream __dma;
+        uint8_t __priority = 0;
+        size_t __cpu_threshold = CPU_THRESHOLD;
+        DmaCopyRequest *volatile __head = nullptr; // Active request, then the pending ones in order
+        DmaCopyRequest *__tail = nullptr;
+        DmaCopyRequest *volatile __active = nullptr; // Head request once started, on the DMA or the CPU
+        volatile bool __on_cpu = false;
+        uint32_t __pattern = 0;                     // Fill source, must not be in CCM either
+        uint8_t __width_log2 = 0;
+        uint32_t __chunk = 0;
+        volatile uint32_t __cpu_count = 0;
+        volatile uint32_t __dma_count = 0;
+
+        bool __wait(DmaCopyRequest &req, uint32_t timeout)
+        {
+#ifdef ERDP_ENABLE_RTOS
+            return req.__done.take(timeout);
+#else
+            uint32_t start_time = erdp_if_rtos_get_1ms_timestamp();
+            while (req.__result == DMA_COPY_BUSY)
+            {
+                if (erdp_if_rtos_get_1ms_timestamp() - start_time >= timeout)
+                {
+                    return false;
+                }
+            }
+            return true;
+#endif
+        }
+
+        void __cancel(DmaCopyRequest &req)
+        {
+            bool run = false;
+            bool copying = false;
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            if (req.__result != DMA_COPY_BUSY)
+            {
+                /* Finished between the timeout and the lock, drop the completion */
+#ifdef ERDP_ENABLE_RTOS
+                req.__done.take(0);
+#endif
+            }
+            else if (__active == &req && __on_cpu)
+            {
+                copying = true;
+            }
+            else if (__active == &req)
+            {
+                __dma.stop();
+                __pop(DMA_COPY_TIMEOUT);
+                run = true;
+            }
+            else
+            {
+                /* Not started yet, possibly at the head */
+                DmaCopyRequest *prev = nullptr;
+                for (DmaCopyRequest *it = __head; it != &req; it = it->__next)
+                {
+                    prev = it;
+                }
+                if (prev == nullptr)
+                {
+                    __head = req.__next;
+                }
+                else
+                {
+                    prev->__next = req.__next;
+                }
+                if (__tail == &req)
+                {
+                    __tail = prev;
+                }
+                req.__result = DMA_COPY_TIMEOUT;
+            }
+            erdp_if_rtos_cpu_unlock(key);
+
+            if (copying)
+            {
+                /* Another task is copying it on the CPU, a short bounded job: let it finish */
+#ifdef ERDP_ENABLE_RTOS
+                req.__done.take();
+#endif
+            }
+            if (run)
+            {
+                __run();
+            }
+        }
+
+        // Start the head request, finishing the small ones on the CPU on the way. Only the queue is
+        // touched under the lock, the copies and the callbacks run with interrupts enabled.
+        void __run()
+        {
+            while (true)
+            {
+                uint32_t key = erdp_if_rtos_cpu_lock();
+                DmaCopyRequest *req = __head;
+                if (req == nullptr || __active != nullptr)
+                {
+                    erdp_if_rtos_cpu_unlock(key);
+                    return;
+                }
+                __active = req;
+                __on_cpu = (req->len < __cpu_threshold || req->len == 0);
+                if (!__on_cpu)
+                {
+                    __dma_start(*req);
+                    erdp_if_rtos_cpu_unlock(key);
+                    return;
+                }
+                erdp_if_rtos_cpu_unlock(key);
+
+                if (req->src != nullptr)
+                {
+                    memcpy(req->dst, req->src, req->len);
+                }
+                else
+                {
+                    memset(req->dst, req->value, req->len);
+                }
+
+                key = erdp_if_rtos_cpu_lock();
+                __cpu_count++;
+                __pop(DMA_COPY_OK);
+                erdp_if_rtos_cpu_unlock(key);
+                __notify(*req, DMA_COPY_OK);
+            }
+        }
+
+        DmaConfig_t __dma_config(uint8_t width_log2, bool src_inc) const
+        {
+            DmaConfig_t dma_cfg = {};
+            dma_cfg.dir = ERDP_DMA_DIR_M2M;
+            dma_cfg.periph_width = (ERDP_DmaWidth_t)width_log2;
+            dma_cfg.mem_width = (ERDP_DmaWidth_t)width_log2;
+            dma_cfg.periph_inc = src_inc;
+            dma_cfg.mem_inc = true;
+            dma_cfg.fifo = true;
+            dma_cfg.priority = ERDP_DMA_PRIO_LOW;
+            dma_cfg.irq_flags = ERDP_DMA_FLAG_TC | ERDP_DMA_FLAG_TE;
+            dma_cfg.irq_priority = __priority;
+            return dma_cfg;
+        }
+
+        void __dma_start(DmaCopyRequest &req)
+        {
+            uintptr_t align = (uintptr_t)req.dst | req.len | (uintptr_t)req.src;
+
+            __width_log2 = (align & 0x03U) == 0 ? 2 : ((align & 0x01U) == 0 ? 1 : 0);
+            __pattern = req.value * 0x01010101U;
+            __dma.init(__dma.get_stream(), __dma_config(__width_log2, req.src != nullptr));
+            __dma.set_usr_irq_handler([this](uint32_t flags) { __dma_irq_handler(flags); });
+            __dma_count++;
+            __next_chunk(req);
+        }
+
+        void __next_chunk(DmaCopyRequest &req)
+        {
+            size_t items = (req.len - req.__offset) >> __width_log2;
+            uint32_t src = (req.src != nullptr) ? (uint32_t)(uintptr_t)req.src + req.__offset
+                                                : (uint32_t)(uintptr_t)&__pattern;
+
+            __chunk = (items > ERDP_DMA_MAX_COUNT) ? ERDP_DMA_MAX_COUNT : items;
+            __dma.start(src, (uint32_t)(uintptr_t)req.dst + req.__offset, __chunk);
+        }
+
+        // Pop the active request, under the lock or from the DMA interrupt; the caller starts the next one
+        DmaCopyRequest *__pop(DmaCopyResult_t result)
+        {
+            DmaCopyRequest *req = __head;
+            __head = req->__next;
+            if (__head == nullptr)
+            {
+                __tail = nullptr;
+            }
+            __active = nullptr;
+            req->__result = result;
+            return req;
+        }
+
+        // Callback first, the owner may release req as soon as it is woken
+        void __notify(DmaCopyRequest &req, DmaCopyResult_t result)
+        {
+            if (req.callback != nullptr)
+            {
+                req.callback(result);
+            }
+#ifdef ERDP_ENABLE_RTOS
+            req.__done.give();
+#endif
+        }
+
+        // The DMA request is finished, from its interrupt
+        void __complete(DmaCopyResult_t result)
+        {
+            __notify(*__pop(result), result);
+            __run();
+        }
+
+        void __dma_irq_handler(uint32_t flags)
+        {
+            DmaCopyRequest *req = __head;
+            if (req == nullptr || req != __active || __on_cpu)
+            {
+                return;
+            }
+            if (flags & ERDP_DMA_FLAG_TE)
+            {
+                __complete(DMA_COPY_ERROR);
+                return;
+            }
+            if (!(flags & ERDP_DMA_FLAG_TC))
+            {
+                return;
+            }
+            req->__offset += __chunk << __width_log2;
+            if (req->__offset < req->len)
+            {
+                __next_chunk(*req);
+                return;
+            }
+            __complete(DMA_COPY_OK);
+        }
+    };
+} // namespace erdp
+
+#endif // __ERDP_HAL_DMA_COPY_HPP__
@@ -32,7 +32,7 @@ namespace erdp
         }
         ~Exti() = default;
 
-        void set_usr_irq_hendler(std::function<void()> usr_irq_hendler)
+        void set_usr_irq_hendler(InplaceFunction<void()> usr_irq_hendler)
         {
             __usr_irq_hendler = usr_irq_hendler;
         }
@@ -49,7 +49,7 @@ namespace erdp
 
     private:
         static Exti *__exti_instance[ERDP_GPIO_PIN_MAX];
-        std::function<void()> __usr_irq_hendler = nullptr;
+        InplaceFunction<void()> __usr_irq_hendler = nullptr;
         ERDP_GpioPort_t __port;
         ERDP_GpioPin_t __pin;
         void __irq_handler()
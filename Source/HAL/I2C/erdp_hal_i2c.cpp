@@ -0,0 +1,24 @@
+#include "erdp_hal_i2c.hpp"
+namespace erdp
+{
+    I2cDev *I2cDev::__instance[ERDP_I2C_NUM] = {nullptr};
+
+    extern "C"
+    {
+        void erdp_i2c_ev_irq_handler(ERDP_I2c_t i2c)
+        {
+            if (I2cDev::__instance[i2c] != nullptr)
+            {
+                I2cDev::__instance[i2c]->__ev_irq_handler();
+            }
+        }
+
+        void erdp_i2c_er_irq_handler(ERDP_I2c_t i2c)
+        {
+            if (I2cDev::__instance[i2c] != nullptr)
+            {
+                I2cDev::__instance[i2c]->__er_irq_handler();
+            }
+        }
+    }
+} // namespace erdp
@@ -0,0 +1,492 @@
+#ifndef __ERDP_HAL_I2C_HPP__
+#define __ERDP_HAL_I2C_HPP__
+#include "erdp_hal.hpp"
+#include "erdp_hal_dma.hpp"
+#include "erdp_hal_i2c_fsm.hpp"
+#include "erdp_if_i2c.h"
+
+namespace erdp
+{
+    extern "C"
+    {
+        void erdp_i2c_ev_irq_handler(ERDP_I2c_t i2c);
+        void erdp_i2c_er_irq_handler(ERDP_I2c_t i2c);
+    }
+
+    typedef struct
+    {
+        ERDP_I2c_t i2c;      // I2C number
+        uint32_t speed;      // Bus clock in Hz, 100000 or 400000
+        ERDP_I2cPins_t pins; // SCL and SDA, also driven as GPIO for bus recovery
+        uint8_t priority;    // Priority for the event, error and DMA interrupts
+    } I2cConfig_t;
+
+    // One transaction, queued on the bus until done. Keep one per task to avoid creating the
+    // completion semaphore on every call.
+    class I2cRequest
+    {
+        friend class I2cDev;
+
+    public:
+        I2cRequest() {}
+        I2cRequest(const I2cRequest &) = delete;
+        I2cRequest &operator=(const I2cRequest &) = delete;
+
+        I2cTransfer_t xfer = {};
+
+        I2cResult_t result() const
+        {
+            return __result;
+        }
+
+    private:
+        volatile I2cResult_t __result = I2C_OK;
+        I2cRequest *__next = nullptr;
+#ifdef ERDP_ENABLE_RTOS
+        StaticSemaphore<BINARY_TAG> __done;
+#endif
+    };
+
+    // Register level operations for I2cMasterFsm, on the peripheral and its two DMA streams
+    class I2cPort
+    {
+    public:
+        void init(const I2cConfig_t &config)
+        {
+            DmaConfig_t dma_cfg = {};
+            bool claimed;
+
+            __i2c = config.i2c;
+            dma_cfg.periph_width = ERDP_DMA_WIDTH_8BIT;
+            dma_cfg.mem_width = ERDP_DMA_WIDTH_8BIT;
+            dma_cfg.mem_inc = true;
+            dma_cfg.priority = ERDP_DMA_PRIO_HIGH;
+            dma_cfg.irq_flags = ERDP_DMA_FLAG_TC | ERDP_DMA_FLAG_TE;
+            dma_cfg.irq_priority = config.priority;
+
+            dma_cfg.dir = ERDP_DMA_DIR_M2P;
+            claimed = tx_dma.claim(erdp_if_i2c_get_dma_request(__i2c, false), dma_cfg);
+            erdp_assert(claimed);
+
+            dma_cfg.dir = ERDP_DMA_DIR_P2M;
+            claimed = rx_dma.claim(erdp_if_i2c_get_dma_request(__i2c, true), dma_cfg);
+            erdp_assert(claimed);
+            (void)claimed;
+        }
+
+        void start()
+        {
+            erdp_if_i2c_start(__i2c);
+        }
+
+        void stop()
+        {
+            erdp_if_i2c_stop(__i2c);
+        }
+
+        void send_address(uint8_t addr, bool read)
+        {
+            erdp_if_i2c_send_address(__i2c, addr, read);
+        }
+
+        void clear_addr()
+        {
+            erdp_if_i2c_clear_addr(__i2c);
+        }
+
+        void ack(bool enable)
+        {
+            erdp_if_i2c_ack(__i2c, enable);
+        }
+
+        void dma_last(bool enable)
+        {
+            erdp_if_i2c_dma_last(__i2c, enable);
+        }
+
+        void buffer_irq(bool enable)
+        {
+            erdp_if_i2c_buffer_irq(__i2c, enable);
+        }
+
+        uint8_t read_data()
+        {
+            return erdp_if_i2c_read_data(__i2c);
+        }
+
+        void tx_dma_start(const uint8_t *buf, uint16_t len)
+        {
+            tx_dma.stop();
+            tx_dma.start(erdp_if_i2c_get_data_addr(__i2c), buf, len);
+        }
+
+        void rx_dma_start(uint8_t *buf, uint16_t len)
+        {
+            rx_dma.stop();
+            rx_dma.start(erdp_if_i2c_get_data_addr(__i2c), buf, len);
+        }
+
+        void dma_stop()
+        {
+            tx_dma.stop();
+            rx_dma.stop();
+        }
+
+        DmaStream tx_dma;
+        DmaStream rx_dma;
+
+    private:
+        ERDP_I2c_t __i2c = ERDP_I2C0;
+    };
+
+    /*
+     * I2C master. Transactions from any number of tasks are queued per bus and chained from the
+     * interrupt, so the bus goes straight from one stop to the next start. A stuck bus (slave
+     * holding SDA, arbitration lost, bus error or timeout) is freed by clocking SCL before the
+     * next transaction. The interrupt only marks the bus; the clocking runs in the task whose
+     * transaction failed (or the one that found the bus held), outside the critical section.
+     */
+    class I2cDev
+    {
+        friend void erdp_i2c_ev_irq_handler(ERDP_I2c_t i2c);
+        friend void erdp_i2c_er_irq_handler(ERDP_I2c_t i2c);
+
+    public:
+        I2cDev() {}
+        I2cDev(const I2cDev &) = delete;
+        I2cDev &operator=(const I2cDev &) = delete;
+
+        I2cDev(const I2cConfig_t &config)
+        {
+            init(config);
+        }
+
+        ~I2cDev()
+        {
+            deinit();
+        }
+
+        void init(const I2cConfig_t &config)
+        {
+            erdp_assert(config.i2c > ERDP_I2C0 && config.i2c < ERDP_I2C_NUM);
+            erdp_assert(__instance[config.i2c] == nullptr || __instance[config.i2c] == this);
+            __config = config;
+            __instance[__config.i2c] = this;
+            /* Streams first, the recovery of a bus held at boot stops them */
+            __port.init(__config);
+            __port.tx_dma.set_usr_irq_handler([this](uint32_t flags) { __dma_irq_handler(flags, false); });
+            __port.rx_dma.set_usr_irq_handler([this](uint32_t flags) { __dma_irq_handler(flags, true); });
+            erdp_if_i2c_gpio_init(__config.i2c, &__config.pins);
+            if (erdp_if_i2c_is_busy(__config.i2c))
+            {
+                __recover();
+            }
+            else
+            {
+                erdp_if_i2c_init(__config.i2c, __config.speed, __config.priority);
+            }
+        }
+
+        void deinit()
+        {
+            if (__config.i2c == ERDP_I2C0)
+            {
+                return;
+            }
+            erdp_if_i2c_deinit(__config.i2c);
+            __port.tx_dma.deinit();
+            __port.rx_dma.deinit();
+            __instance[__config.i2c] = nullptr;
+            __config.i2c = ERDP_I2C0;
+        }
+
+        // Queue req and wait for it, at most timeout ms (queue time included)
+        I2cResult_t transfer(I2cRequest &req, uint32_t timeout = 100)
+        {
+            erdp_assert(req.xfer.tx_len == 0 || req.xfer.tx != nullptr);
+            erdp_assert(req.xfer.rx_len == 0 || req.xfer.rx != nullptr);
+            __submit(req);
+            if (!__wait(req, timeout))
+            {
+                __cancel(req);
+            }
+            __resume();
+            return req.__result;
+        }
+
+        I2cResult_t write(uint8_t addr, const uint8_t *data, uint16_t len, uint32_t timeout = 100)
+        {
+            I2cRequest req;
+            req.xfer = {addr, data, len, nullptr, 0};
+            return transfer(req, timeout);
+        }
+
+        I2cResult_t read(uint8_t addr, uint8_t *data, uint16_t len, uint32_t timeout = 100)
+        {
+            I2cRequest req;
+            req.xfer = {addr, nullptr, 0, data, len};
+            return transfer(req, timeout);
+        }
+
+        // Typically a register address followed by a read, without releasing the bus in between
+        I2cResult_t write_read(uint8_t addr, const uint8_t *tx, uint16_t tx_len, uint8_t *rx, uint16_t rx_len,
+                               uint32_t timeout = 100)
+        {
+            I2cRequest req;
+            req.xfer = {addr, tx, tx_len, rx, rx_len};
+            return transfer(req, timeout);
+        }
+
+        // Address only write, true if a device acknowledges addr
+        bool probe(uint8_t addr, uint32_t timeout = 10)
+        {
+            return write(addr, nullptr, 0, timeout) == I2C_OK;
+        }
+
+        uint32_t get_recover_count() const
+        {
+            return __recover_count;
+        }
+
+    private:
+        static I2cDev *__instance[ERDP_I2C_NUM];
+        I2cConfig_t __config = {};
+        I2cPort __port;
+        I2cMasterFsm<I2cPort> __fsm{__port};
+        I2cRequest *volatile __head = nullptr; // Active request, then the pending ones in order
+        I2cRequest *__tail = nullptr;
+        volatile uint32_t __recover_count = 0;
+        volatile bool __need_recover = false; // Set by an error, the queue is held until a task recovers the bus
+        bool __recovering = false;            // A task is clocking the bus, nothing may start
+
+        void __submit(I2cRequest &req)
+        {
+            req.__result = I2C_BUSY;
+            req.__next = nullptr;
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            bool idle = (__head == nullptr);
+            if (idle)
+            {
+                __head = &req;
+            }
+            else
+            {
+                __tail->__next = &req;
+            }
+            __tail = &req;
+            if (idle && !__need_recover && !__recovering)
+            {
+                if (erdp_if_i2c_is_busy(__config.i2c))
+                {
+                    __need_recover = true;
+                }
+                else
+                {
+                    __fsm.begin(req.xfer);
+                }
+            }
+            erdp_if_rtos_cpu_unlock(key);
+            __resume();
+        }
+
+        bool __wait(I2cRequest &req, uint32_t timeout)
+        {
+#ifdef ERDP_ENABLE_RTOS
+            return req.__done.take(timeout);
+#else
+            uint32_t start_time = erdp_if_rtos_get_1ms_timestamp();
+            while (req.__result == I2C_BUSY)
+            {
+                if (erdp_if_rtos_get_1ms_timestamp() - start_time >= timeout)
+                {
+                    return false;
+                }
+            }
+            return true;
+#endif
+        }
+
+        void __cancel(I2cRequest &req)
+        {
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            if (req.__result != I2C_BUSY)
+            {
+                /* Finished between the timeout and the lock, drop the completion */
+#ifdef ERDP_ENABLE_RTOS
+                req.__done.take(0);
+#endif
+            }
+            else if (__head == &req && __fsm.busy())
+            {
+                __fsm.abort();
+                __complete(I2C_TIMEOUT);
+            }
+            else
+            {
+                /* Still queued, or at the head waiting for the bus to be recovered */
+                I2cRequest *prev = nullptr;
+                for (I2cRequest *it = __head; it != &req; it = it->__next)
+                {
+                    prev = it;
+                }
+                if (prev == nullptr)
+                {
+                    __head = req.__next;
+                }
+                else
+                {
+                    prev->__next = req.__next;
+                }
+                if (__tail == &req)
+                {
+                    __tail = prev;
+                }
+                req.__result = I2C_TIMEOUT;
+            }
+            erdp_if_rtos_cpu_unlock(key);
+        }
+
+        // Pop the active request, wake its owner and chain the next one. Called from the interrupts
+        // or under the lock, so after an error the bus is only marked and the queue held for __resume.
+        void __complete(I2cResult_t result)
+        {
+            I2cRequest *req = __head;
+            __head = req->__next;
+            if (__head == nullptr)
+            {
+                __tail = nullptr;
+            }
+            req->__result = result;
+#ifdef ERDP_ENABLE_RTOS
+            if (result != I2C_TIMEOUT)
+            {
+                req->__done.give();
+            }
+#endif
+            if (result == I2C_BUS_ERROR || result == I2C_ARB_LOST || result == I2C_TIMEOUT)
+            {
+                __need_recover = true;
+            }
+            else if (__head != nullptr)
+            {
+                __fsm.begin(__head->xfer);
+            }
+        }
+
+        // Task side: recover a marked bus with interrupts enabled, then start the held queue
+        void __resume()
+        {
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            bool recover = __need_recover && !__recovering;
+            if (recover)
+            {
+                __need_recover = false;
+                __recovering = true;
+            }
+            erdp_if_rtos_cpu_unlock(key);
+            if (!recover)
+            {
+                return;
+            }
+
+            __recover();
+
+            key = erdp_if_rtos_cpu_lock();
+            __recovering = false;
+            if (__head != nullptr)
+            {
+                __fsm.begin(__head->xfer);
+            }
+            erdp_if_rtos_cpu_unlock(key);
+        }
+
+        void __recover()
+        {
+            __port.dma_stop();
+            erdp_if_i2c_bus_recover(__config.i2c, &__config.pins);
+            erdp_if_i2c_init(__config.i2c, __config.speed, __config.priority);
+            __recover_count++;
+        }
+
+        void __dma_irq_handler(uint32_t flags, bool rx)
+        {
+            bool done;
+            if (flags & ERDP_DMA_FLAG_TE)
+            {
+                done = __fsm.on_event(I2C_EVT_BUS_ERROR);
+            }
+            else if (flags & ERDP_DMA_FLAG_TC)
+            {
+                done = __fsm.on_event(rx ? I2C_EVT_RX_DMA_DONE : I2C_EVT_TX_DMA_DONE);
+            }
+            else
+            {
+                return;
+            }
+            if (done)
+            {
+                __complete(__fsm.result());
+            }
+        }
+
+        void __ev_irq_handler()
+        {
+            uint32_t status = erdp_if_i2c_get_status(__config.i2c);
+            I2cEvent_t event;
+
+            if (!__fsm.busy())
+            {
+                /* Stray event, clear it so it does not fire again */
+                if (status & ERDP_I2C_FLAG_ADDR)
+                {
+                    erdp_if_i2c_clear_addr(__config.i2c);
+                }
+                if (status & (ERDP_I2C_FLAG_BTF | ERDP_I2C_FLAG_RXNE))
+                {
+                    erdp_if_i2c_read_data(__config.i2c);
+                }
+                erdp_if_i2c_buffer_irq(__config.i2c, false);
+                return;
+            }
+            if (status & ERDP_I2C_FLAG_SB)
+            {
+                event = I2C_EVT_SB;
+            }
+            else if (status & ERDP_I2C_FLAG_ADDR)
+            {
+                event = I2C_EVT_ADDR;
+            }
+            else if (status & ERDP_I2C_FLAG_BTF)
+            {
+                event = I2C_EVT_BTF;
+            }
+            else if (status & ERDP_I2C_FLAG_RXNE)
+            {
+                event = I2C_EVT_RXNE;
+            }
+            else
+            {
+                return;
+            }
+            if (__fsm.on_event(event))
+            {
+                __complete(__fsm.result());
+            }
+        }
+
+        void __er_irq_handler()
+        {
+            uint32_t status = erdp_if_i2c_get_status(__config.i2c) & ERDP_I2C_FLAG_ERRORS;
+            erdp_if_i2c_clear_errors(__config.i2c, status);
+            I2cEvent_t event = (status & ERDP_I2C_FLAG_ARLO)  ? I2C_EVT_ARB_LOST
+                               : (status & ERDP_I2C_FLAG_AF) ? I2C_EVT_NACK
+                                                             : I2C_EVT_BUS_ERROR;
+            if (status != 0 && __fsm.on_event(event))
+            {
+                __complete(__fsm.result());
+            }
+        }
+    };
+} // namespace erdp
+
+#endif // __ERDP_HAL_I2C_HPP__
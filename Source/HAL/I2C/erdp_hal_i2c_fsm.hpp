@@ -0,0 +1,227 @@
+#ifndef __ERDP_HAL_I2C_FSM_HPP__
+#define __ERDP_HAL_I2C_FSM_HPP__
+#include <stdint.h>
+
+namespace erdp
+{
+    typedef enum
+    {
+        I2C_OK = 0,
+        I2C_BUSY,      // Queued or in progress
+        I2C_NACK,      // Address or data not acknowledged
+        I2C_BUS_ERROR, // Misplaced start/stop, overrun or DMA error, the bus is recovered
+        I2C_ARB_LOST,  // Another master won the bus, the bus is recovered
+        I2C_TIMEOUT,   // Aborted by the caller
+    } I2cResult_t;
+
+    typedef enum
+    {
+        I2C_EVT_SB = 0,      // Start condition sent
+        I2C_EVT_ADDR,        // Address acknowledged
+        I2C_EVT_BTF,         // Last byte shifted out
+        I2C_EVT_RXNE,        // Byte received (single byte reads only)
+        I2C_EVT_TX_DMA_DONE, // TX DMA transfer complete
+        I2C_EVT_RX_DMA_DONE, // RX DMA transfer complete
+        I2C_EVT_NACK,
+        I2C_EVT_BUS_ERROR,
+        I2C_EVT_ARB_LOST,
+    } I2cEvent_t;
+
+    // write (rx_len == 0), read (tx_len == 0) or write then read with a repeated start
+    typedef struct
+    {
+        uint8_t addr; // 7 bit slave address
+        const uint8_t *tx;
+        uint16_t tx_len;
+        uint8_t *rx;
+        uint16_t rx_len;
+    } I2cTransfer_t;
+
+    /*
+     * Master transfer sequencing, driven by the event/error interrupts and the DMA completions.
+     * Port only has to provide the register level operations below, so the same sequence runs
+     * on the peripheral and against the fake in Test/test_i2c_fsm.cpp:
+     *   start(), stop(), send_address(addr, read), clear_addr(), ack(en), dma_last(en),
+     *   buffer_irq(en), read_data(), tx_dma_start(buf, len), rx_dma_start(buf, len), dma_stop()
+     */
+    template <typename Port>
+    class I2cMasterFsm
+    {
+    public:
+        I2cMasterFsm(Port &port) : __port(port) {}
+
+        void begin(const I2cTransfer_t &xfer)
+        {
+            __xfer = xfer;
+            __result = I2C_BUSY;
+            __reading = (xfer.tx_len == 0 && xfer.rx_len > 0);
+            __state = STATE_START;
+            __port.start();
+        }
+
+        // Returns true when the transfer has just finished, see result()
+        bool on_event(I2cEvent_t event)
+        {
+            if (__state == STATE_IDLE)
+            {
+                return false;
+            }
+            switch (event)
+            {
+            case I2C_EVT_SB:
+                if (__state == STATE_START)
+                {
+                    __port.send_address(__xfer.addr, __reading);
+                    __state = STATE_ADDR;
+                }
+                break;
+
+            case I2C_EVT_ADDR:
+                if (__state != STATE_ADDR)
+                {
+                    break;
+                }
+                if (!__reading)
+                {
+                    if (__xfer.tx_len == 0)
+                    {
+                        /* Address only, used to probe a device */
+                        __port.clear_addr();
+                        __port.stop();
+                        return __finish(I2C_OK);
+                    }
+                    __port.tx_dma_start(__xfer.tx, __xfer.tx_len);
+                    __port.clear_addr();
+                    __state = STATE_TX;
+                }
+                else if (__xfer.rx_len == 1)
+                {
+                    /* NACK and stop must be set before ADDR is cleared for a single byte */
+                    __port.ack(false);
+                    __port.clear_addr();
+                    __port.stop();
+                    __port.buffer_irq(true);
+                    __state = STATE_RX_ONE;
+                }
+                else
+                {
+                    __port.ack(true);
+                    __port.dma_last(true);
+                    __port.rx_dma_start(__xfer.rx, __xfer.rx_len);
+                    __port.clear_addr();
+                    __state = STATE_RX;
+                }
+                break;
+
+            case I2C_EVT_TX_DMA_DONE:
+                if (__state == STATE_TX)
+                {
+                    __state = STATE_TX_WAIT;
+                }
+                break;
+
+            case I2C_EVT_BTF:
+                if (__state != STATE_TX && __state != STATE_TX_WAIT)
+                {
+                    break;
+                }
+                if (__xfer.rx_len > 0)
+                {
+                    __reading = true;
+                    __state = STATE_START;
+                    __port.start();
+                    break;
+                }
+                __port.stop();
+                return __finish(I2C_OK);
+
+            case I2C_EVT_RXNE:
+                if (__state == STATE_RX_ONE)
+                {
+                    __xfer.rx[0] = __port.read_data();
+                    __port.buffer_irq(false);
+                    __port.ack(true);
+                    return __finish(I2C_OK);
+                }
+                break;
+
+            case I2C_EVT_RX_DMA_DONE:
+                if (__state == STATE_RX)
+                {
+                    __port.stop();
+                    __port.dma_last(false);
+                    __port.ack(true);
+                    return __finish(I2C_OK);
+                }
+                break;
+
+            case I2C_EVT_NACK:
+                __port.dma_stop();
+                __port.buffer_irq(false);
+                __port.stop();
+                __port.ack(true);
+                return __finish(I2C_NACK);
+
+            case I2C_EVT_BUS_ERROR:
+                __port.dma_stop();
+                __port.buffer_irq(false);
+                return __finish(I2C_BUS_ERROR);
+
+            case I2C_EVT_ARB_LOST:
+                __port.dma_stop();
+                __port.buffer_irq(false);
+                return __finish(I2C_ARB_LOST);
+            }
+            return false;
+        }
+
+        // Stop the transfer in progress, the caller recovers the bus afterwards
+        void abort()
+        {
+            if (__state != STATE_IDLE)
+            {
+                __port.dma_stop();
+                __port.buffer_irq(false);
+                __port.stop();
+                __finish(I2C_TIMEOUT);
+            }
+        }
+
+        bool busy() const
+        {
+            return __state != STATE_IDLE;
+        }
+
+        I2cResult_t result() const
+        {
+            return __result;
+        }
+
+    private:
+        typedef enum
+        {
+            STATE_IDLE = 0,
+            STATE_START,   // Start or repeated start requested, waiting for SB
+            STATE_ADDR,    // Address sent, waiting for ADDR
+            STATE_TX,      // TX DMA running
+            STATE_TX_WAIT, // TX DMA done, waiting for the last byte to leave the shift register
+            STATE_RX,      // RX DMA running, NACK on the last byte
+            STATE_RX_ONE,  // Single byte read by the RXNE interrupt
+        } State_t;
+
+        Port &__port;
+        I2cTransfer_t __xfer = {};
+        State_t __state = STATE_IDLE;
+        I2cResult_t __result = I2C_OK;
+        bool __reading = false;
+
+        bool __finish(I2cResult_t result)
+        {
+            __result = result;
+            __state = STATE_IDLE;
+            return true;
+        }
+    };
+} // namespace erdp
+
+#endif // __ERDP_HAL_I2C_FSM_HPP__
@@ -0,0 +1,312 @@
+#ifndef __ERDP_HAL_LCD_HPP__
+#define __ERDP_HAL_LCD_HPP__
+#include "erdp_hal.hpp"
+#include "erdp_hal_dma.hpp"
+#include "erdp_if_fsmc.h"
+#include "dirty_region.hpp"
+
+namespace erdp
+{
+    typedef struct
+    {
+        ERDP_FsmcBank_t bank; // Chip select of the LCD
+        uint8_t rs_line;      // FSMC address line wired to RS (D/C), e.g. 16 for A16 on PD11
+        uint8_t write_addset; // Write cycle address setup, HCLK cycles
+        uint8_t write_datast; // Write cycle WR low time, HCLK cycles
+        uint16_t width;       // Pixels per line, in the orientation set by the controller init
+        uint16_t height;      // Lines
+        uint8_t priority;     // Priority for the DMA interrupt
+    } LcdConfig_t;
+
+    /*
+     * MIPI DCS controller (ILI9341, ST7789, ILI9488...) on a 16 bit 8080 bus through the FSMC.
+     * Pixels are RGB565, pushed by memory to memory DMA to the fixed data address.
+     * The controller specific init sequence is sent by the user with command().
+     */
+    class LcdDev
+    {
+    public:
+        static constexpr uint8_t CMD_COLUMN_SET = 0x2A;
+        static constexpr uint8_t CMD_PAGE_SET = 0x2B;
+        static constexpr uint8_t CMD_MEMORY_WRITE = 0x2C;
+
+        LcdDev() {}
+        LcdDev(const LcdDev &) = delete;
+        LcdDev &operator=(const LcdDev &) = delete;
+
+        LcdDev(const LcdConfig_t &config)
+        {
+            init(config);
+        }
+
+        ~LcdDev()
+        {
+            deinit();
+        }
+
+        void init(const LcdConfig_t &config)
+        {
+            __config = config;
+
+            ERDP_FsmcLcdCfg_t fsmc_cfg = {config.bank, config.rs_line, config.write_addset, config.write_datast};
+            erdp_if_fsmc_lcd_init(&fsmc_cfg);
+            __cmd = (volatile uint16_t *)erdp_if_fsmc_lcd_get_cmd_addr(config.bank);
+            __data = (volatile uint16_t *)erdp_if_fsmc_lcd_get_data_addr(config.bank, config.rs_line);
+            __busy = false;
+            bool claimed = __dma_setup(true);
+            erdp_assert(claimed);
+            (void)claimed;
+        }
+
+        void deinit()
+        {
+            if (__cmd == nullptr)
+            {
+                return;
+            }
+            __dma.deinit();
+            erdp_if_fsmc_lcd_deinit(__config.bank);
+            __cmd = nullptr;
+            __data = nullptr;
+        }
+
+        // Blocking command with 8 bit parameters, waits for a running push first
+        void command(uint8_t cmd, const uint8_t *params = nullptr, uint32_t count = 0)
+        {
+            wait();
+            *__cmd = cmd;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                *__data = params[i];
+            }
+        }
+
+        void write_data(uint16_t value)
+        {
+            *__data = value;
+        }
+
+        uint16_t read_data()
+        {
+            return *__data;
+        }
+
+        // Set the GRAM window and start a memory write, the next pixels fill it line by line
+        void set_window(const Rect_t &rect)
+        {
+            uint16_t x1 = rect.x + rect.w - 1;
+            uint16_t y1 = rect.y + rect.h - 1;
+            uint8_t column[4] = {(uint8_t)(rect.x >> 8), (uint8_t)rect.x, (uint8_t)(x1 >> 8), (uint8_t)x1};
+            uint8_t page[4] = {(uint8_t)(rect.y >> 8), (uint8_t)rect.y, (uint8_t)(y1 >> 8), (uint8_t)y1};
+
+            command(CMD_COLUMN_SET, column, 4);
+            command(CMD_PAGE_SET, page, 4);
+            command(CMD_MEMORY_WRITE);
+        }
+
+        /*
+         * Push rect from pixels, whose lines are stride pixels apart (rect.w if 0).
+         * Returns once the DMA is started, pixels must stay untouched until wait() returns.
+         */
+        void draw(const Rect_t &rect, const uint16_t *pixels, uint16_t stride = 0)
+        {
+            if (rect.w == 0 || rect.h == 0)
+            {
+                return;
+            }
+            if (stride == 0 || stride == rect.w)
+            {
+                __push(rect, pixels, true, (uint32_t)rect.w * rect.h, 1, 0);
+            }
+            else
+            {
+                __push(rect, pixels, true, rect.w, rect.h, stride);
+            }
+        }
+
+        // Fill rect with one color, returns once the DMA is started
+        void fill(const Rect_t &rect, uint16_t color)
+        {
+            if (rect.w == 0 || rect.h == 0)
+            {
+                return;
+            }
+            wait();
+            __fill_color = color;
+            __push(rect, &__fill_color, false, (uint32_t)rect.w * rect.h, 1, 0);
+        }
+
+        // Wait for the running push, false on timeout
+        bool wait(uint32_t timeout = WAIT_FOREVER)
+        {
+            if (!__busy)
+            {
+                return true;
+            }
+#ifdef ERDP_ENABLE_RTOS
+            return __done.take(timeout);
+#else
+            uint32_t start_time = erdp_if_rtos_get_1ms_timestamp();
+            while (__busy)
+            {
+                if (timeout != WAIT_FOREVER && erdp_if_rtos_get_1ms_timestamp() - start_time >= timeout)
+                {
+                    return false;
+                }
+            }
+            return true;
+#endif
+        }
+
+        bool busy() const
+        {
+            return __busy;
+        }
+
+        uint16_t width() const
+        {
+            return __config.width;
+        }
+
+        uint16_t height() const
+        {
+            return __config.height;
+        }
+
+        uint32_t get_error_count() const
+        {
+            return __error_count;
+        }
+
+        // Called from the DMA interrupt when a push has completed
+        void set_usr_irq_handler(InplaceFunction<void()> usr_irq_handler)
+        {
+            __usr_irq_handler = usr_irq_handler;
+        }
+
+    private:
+        static constexpr uint32_t WAIT_FOREVER = 0xFFFFFFFFU;
+
+        LcdConfig_t __config = {};
+        volatile uint16_t *__cmd = nullptr;
+        volatile uint16_t *__data = nullptr;
+        DmaStream __dma;
+        bool __src_inc = false;
+        uint16_t __fill_color = 0;
+        volatile bool __busy = false;
+        uint32_t __error_count = 0;
+        InplaceFunction<void()> __usr_irq_handler = nullptr;
+#ifdef ERDP_ENABLE_RTOS
+        StaticSemaphore<BINARY_TAG> __done;
+#endif
+
+        /* Transfer state, lines are sent one after the other in chunks of at most ERDP_DMA_MAX_COUNT */
+        const uint16_t *__line = nullptr;
+        uint32_t __line_len = 0;
+        uint32_t __line_offset = 0;
+        uint32_t __lines_left = 0;
+        uint32_t __stride = 0;
+        uint32_t __chunk = 0;
+
+        /*
+         * The FSMC side is the memory port, fixed on the data address; the source side walks the pixels.
+         * A DMA2 stream is claimed on the first call and kept, only DMA2 does memory to memory.
+         */
+        bool __dma_setup(bool src_inc)
+        {
+            DmaConfig_t dma_cfg = {};
+
+            dma_cfg.dir = ERDP_DMA_DIR_M2M;
+            dma_cfg.periph_width = ERDP_DMA_WIDTH_16BIT;
+            dma_cfg.mem_width = ERDP_DMA_WIDTH_16BIT;
+            dma_cfg.periph_inc = src_inc;
+            dma_cfg.mem_inc = false;
+            dma_cfg.fifo = true;
+            dma_cfg.priority = ERDP_DMA_PRIO_MEDIUM;
+            dma_cfg.irq_flags = ERDP_DMA_FLAG_TC | ERDP_DMA_FLAG_TE;
+            dma_cfg.irq_priority = __config.priority;
+            if (__dma.get_stream() < ERDP_DMA_STREAM_NUM)
+            {
+                __dma.init(__dma.get_stream(), dma_cfg);
+            }
+            else if (!__dma.claim(ERDP_DMA_REQ_MEM2MEM, dma_cfg))
+            {
+                return false;
+            }
+            __dma.set_usr_irq_handler([this](uint32_t flags) { __dma_irq_handler(flags); });
+            __src_inc = src_inc;
+            return true;
+        }
+
+        void __push(const Rect_t &rect, const uint16_t *src, bool src_inc, uint32_t line_len, uint32_t lines,
+                    uint32_t stride)
+        {
+            erdp_assert(((uintptr_t)src & 0xFFFF0000U) != 0x10000000U);
+            wait();
+            set_window(rect);
+            if (src_inc != __src_inc)
+            {
+                __dma_setup(src_inc);
+            }
+            __line = src;
+            __line_len = line_len;
+            __line_offset = 0;
+            __lines_left = lines;
+            __stride = stride;
+#ifdef ERDP_ENABLE_RTOS
+            __done.take(0);
+#endif
+            __busy = true;
+            __next_chunk();
+        }
+
+        void __next_chunk()
+        {
+            uint32_t left = __line_len - __line_offset;
+            const uint16_t *src = __src_inc ? (__line + __line_offset) : __line;
+
+            __chunk = (left > ERDP_DMA_MAX_COUNT) ? ERDP_DMA_MAX_COUNT : left;
+            __dma.start((uint32_t)(uintptr_t)src, (uint32_t)(uintptr_t)__data, __chunk);
+        }
+
+        void __finish()
+        {
+            __busy = false;
+#ifdef ERDP_ENABLE_RTOS
+            __done.give();
+#endif
+            if (__usr_irq_handler != nullptr)
+            {
+                __usr_irq_handler();
+            }
+        }
+
+        void __dma_irq_handler(uint32_t flags)
+        {
+            if (flags & ERDP_DMA_FLAG_TE)
+            {
+                __error_count++;
+                __finish();
+                return;
+            }
+            if (!(flags & ERDP_DMA_FLAG_TC))
+            {
+                return;
+            }
+            __line_offset += __chunk;
+            if (__line_offset >= __line_len)
+            {
+                if (--__lines_left == 0)
+                {
+                    __finish();
+                    return;
+                }
+                __line += __stride;
+                __line_offset = 0;
+            }
+            __next_chunk();
+        }
+    };
+} // namespace erdp
+
+#endif // __ERDP_HAL_LCD_HPP__
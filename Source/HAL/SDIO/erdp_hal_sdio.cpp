@@ -0,0 +1,16 @@
+#include "erdp_hal_sdio.hpp"
+namespace erdp
+{
+    SdioDev *SdioDev::__instance = nullptr;
+
+    extern "C"
+    {
+        void erdp_sdio_irq_handler(void)
+        {
+            if (SdioDev::__instance != nullptr)
+            {
+                SdioDev::__instance->__irq_handler();
+            }
+        }
+    }
+} // namespace erdp
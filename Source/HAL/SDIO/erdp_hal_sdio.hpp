@@ -0,0 +1,482 @@
+#ifndef __ERDP_HAL_SDIO_HPP__
+#define __ERDP_HAL_SDIO_HPP__
+#include "erdp_hal.hpp"
+#include "erdp_hal_block.hpp"
+#include "erdp_hal_dma.hpp"
+#include "erdp_if_sdio.h"
+
+namespace erdp
+{
+    extern "C"
+    {
+        void erdp_sdio_irq_handler(void);
+    }
+
+    // SD/SDHC/SDXC card on the SDIO peripheral, 4 bit bus, blocks moved by DMA2
+    class SdioDev : public BlockDevice
+    {
+        friend void erdp_sdio_irq_handler(void);
+
+    public:
+        SdioDev() {}
+        SdioDev(const SdioDev &) = delete;
+        SdioDev &operator=(const SdioDev &) = delete;
+
+        ~SdioDev()
+        {
+            deinit();
+        }
+
+        // Identify the card and switch it to the fastest bus it supports, false if no usable card answers
+        bool init(uint8_t priority, bool high_speed = true)
+        {
+            erdp_assert(__instance == nullptr || __instance == this);
+            __instance = this;
+            __priority = priority;
+            __ready = false;
+            erdp_if_sdio_gpio_init();
+            erdp_if_sdio_init(priority);
+            if (!__identify() || !__select_bus(high_speed))
+            {
+                return false;
+            }
+            __ready = true;
+            return true;
+        }
+
+        void deinit()
+        {
+            if (__instance != this)
+            {
+                return;
+            }
+            __dma.deinit();
+            erdp_if_sdio_deinit();
+            __instance = nullptr;
+            __ready = false;
+        }
+
+        // buf must be word aligned and outside the CCM RAM (not reachable by DMA)
+        bool read(uint32_t block, void *buf, uint32_t count) override
+        {
+            return __transfer(block, buf, count, false);
+        }
+
+        bool write(uint32_t block, const void *buf, uint32_t count) override
+        {
+            return __transfer(block, const_cast<void *>(buf), count, true);
+        }
+
+        // Wait until the card has finished programming
+        bool sync() override
+        {
+            return __wait_card_ready(WRITE_TIMEOUT_MS);
+        }
+
+        uint32_t block_size() const override
+        {
+            return ERDP_SDIO_BLOCK_SIZE;
+        }
+
+        uint32_t block_count() const override
+        {
+            return __block_count;
+        }
+
+        bool is_ready() const
+        {
+            return __ready;
+        }
+
+        bool is_high_capacity() const
+        {
+            return __high_capacity;
+        }
+
+        bool is_high_speed() const
+        {
+            return __high_speed;
+        }
+
+        bool is_wide_bus() const
+        {
+            return __wide;
+        }
+
+        // ERDP_SDIO_FLAG_* data errors of the last failed transfer
+        uint32_t get_last_error() const
+        {
+            return __last_error;
+        }
+
+    private:
+        static constexpr uint8_t CMD_GO_IDLE = 0;
+        static constexpr uint8_t CMD_ALL_SEND_CID = 2;
+        static constexpr uint8_t CMD_SEND_RCA = 3;
+        static constexpr uint8_t CMD_SWITCH_FUNC = 6;
+        static constexpr uint8_t CMD_SELECT = 7;
+        static constexpr uint8_t CMD_SEND_IF_COND = 8;
+        static constexpr uint8_t CMD_SEND_CSD = 9;
+        static constexpr uint8_t CMD_STOP = 12;
+        static constexpr uint8_t CMD_SEND_STATUS = 13;
+        static constexpr uint8_t CMD_SET_BLOCKLEN = 16;
+        static constexpr uint8_t CMD_READ_SINGLE = 17;
+        static constexpr uint8_t CMD_READ_MULTI = 18;
+        static constexpr uint8_t CMD_WRITE_SINGLE = 24;
+        static constexpr uint8_t CMD_WRITE_MULTI = 25;
+        static constexpr uint8_t CMD_APP = 55;
+        static constexpr uint8_t ACMD_SET_BUS_WIDTH = 6;
+        static constexpr uint8_t ACMD_SET_WR_ERASE_COUNT = 23;
+        static constexpr uint8_t ACMD_SEND_OP_COND = 41;
+        static constexpr uint8_t ACMD_SEND_SCR = 51;
+
+        static constexpr uint32_t R1_ERRORS = 0xFDFFE008U;
+        static constexpr uint32_t OCR_BUSY = 0x80000000U;  // Card power up finished
+        static constexpr uint32_t OCR_CCS = 0x40000000U;   // Card capacity status, block addressing
+        static constexpr uint32_t OCR_VOLTAGE = 0x00300000U; // 3.2-3.4V
+        static constexpr uint32_t OP_COND_TRIES = 4000;     // About 1s at 400kHz
+        static constexpr uint32_t READ_TIMEOUT_MS = 500;
+        static constexpr uint32_t WRITE_TIMEOUT_MS = 1000;
+        static constexpr uint32_t CARD_STATE_TRAN = 4;
+
+        static SdioDev *__instance;
+        uint8_t __priority = 0;
+        bool __ready = false;
+        bool __high_capacity = false;
+        bool __high_speed = false;
+        bool __wide = false;
+        uint16_t __rca = 0;
+        uint32_t __block_count = 0;
+        uint32_t __clock_hz = 0;
+        DmaStream __dma;
+        volatile uint32_t __data_status = 0;
+        uint32_t __last_error = 0;
+#ifdef ERDP_ENABLE_RTOS
+        StaticSemaphore<BINARY_TAG> __done;
+#else
+        volatile bool __done = false;
+#endif
+
+        bool __command_r1(uint8_t cmd, uint32_t arg)
+        {
+            if (erdp_if_sdio_command(cmd, arg, ERDP_SDIO_RESP_SHORT) != ERDP_SDIO_OK)
+            {
+                return false;
+            }
+            return (erdp_if_sdio_get_response(0) & R1_ERRORS) == 0;
+        }
+
+        bool __app_command(uint8_t acmd, uint32_t arg, ERDP_SdioResp_t resp)
+        {
+            if (!__command_r1(CMD_APP, (uint32_t)__rca << 16))
+            {
+                return false;
+            }
+            if (resp == ERDP_SDIO_RESP_SHORT)
+            {
+                return __command_r1(acmd, arg);
+            }
+            return erdp_if_sdio_command(acmd, arg, resp) == ERDP_SDIO_OK;
+        }
+
+        bool __identify()
+        {
+            /* At least 74 clocks after power up before the first command */
+            for (volatile uint32_t i = 0; i < 20000; i++)
+            {
+            }
+            erdp_if_sdio_command(CMD_GO_IDLE, 0, ERDP_SDIO_RESP_NONE);
+
+            /* Version 2 cards echo the check pattern, older cards do not answer */
+            bool v2 = erdp_if_sdio_command(CMD_SEND_IF_COND, 0x1AA, ERDP_SDIO_RESP_SHORT) == ERDP_SDIO_OK &&
+                      (erdp_if_sdio_get_response(0) & 0xFFFU) == 0x1AA;
+
+            uint32_t ocr = 0;
+            __rca = 0;
+            for (uint32_t i = 0; i < OP_COND_TRIES && !(ocr & OCR_BUSY); i++)
+            {
+                if (!__app_command(ACMD_SEND_OP_COND, OCR_VOLTAGE | (v2 ? OCR_CCS : 0), ERDP_SDIO_RESP_SHORT_NO_CRC))
+                {
+                    return false;
+                }
+                ocr = erdp_if_sdio_get_response(0);
+            }
+            if (!(ocr & OCR_BUSY))
+            {
+                return false;
+            }
+            __high_capacity = (ocr & OCR_CCS) != 0;
+
+            if (erdp_if_sdio_command(CMD_ALL_SEND_CID, 0, ERDP_SDIO_RESP_LONG) != ERDP_SDIO_OK ||
+                erdp_if_sdio_command(CMD_SEND_RCA, 0, ERDP_SDIO_RESP_SHORT) != ERDP_SDIO_OK)
+            {
+                return false;
+            }
+            __rca = (uint16_t)(erdp_if_sdio_get_response(0) >> 16);
+
+            if (erdp_if_sdio_command(CMD_SEND_CSD, (uint32_t)__rca << 16, ERDP_SDIO_RESP_LONG) != ERDP_SDIO_OK)
+            {
+                return false;
+            }
+            uint32_t csd[4];
+            for (uint8_t i = 0; i < 4; i++)
+            {
+                csd[i] = erdp_if_sdio_get_response(i);
+            }
+            __block_count = __csd_block_count(csd);
+
+            return __command_r1(CMD_SELECT, (uint32_t)__rca << 16) && __command_r1(CMD_SET_BLOCKLEN, ERDP_SDIO_BLOCK_SIZE);
+        }
+
+        // csd[0] holds bits 127:96
+        static uint32_t __csd_block_count(const uint32_t csd[4])
+        {
+            if ((csd[0] >> 30) == 1)
+            {
+                /* CSD 2.0: C_SIZE[69:48] in 512 KiB units */
+                uint32_t c_size = ((csd[1] & 0x3FU) << 16) | (csd[2] >> 16);
+                return (c_size + 1) * 1024;
+            }
+            /* CSD 1.0: (C_SIZE + 1) * 2^(C_SIZE_MULT + 2) blocks of 2^READ_BL_LEN bytes */
+            uint32_t read_bl_len = (csd[1] >> 16) & 0x0FU;
+            uint32_t c_size = ((csd[1] & 0x3FFU) << 2) | (csd[2] >> 30);
+            uint32_t c_size_mult = (csd[2] >> 15) & 0x07U;
+            return ((c_size + 1) << (c_size_mult + 2)) << read_bl_len >> 9;
+        }
+
+        bool __select_bus(bool high_speed)
+        {
+            uint32_t scr[2];
+
+            erdp_if_sdio_set_bus(ERDP_SDIO_TRANS_DIV, false, false);
+            __clock_hz = ERDP_SDIO_CLK_HZ / (ERDP_SDIO_TRANS_DIV + 2);
+            __wide = false;
+            __high_speed = false;
+
+            if (!__app_command_read(ACMD_SEND_SCR, 0, scr, 8))
+            {
+                return false;
+            }
+            /* SCR is sent MSB first: byte 0 holds SCR_STRUCTURE/SD_SPEC, byte 1 SD_BUS_WIDTHS */
+            uint8_t sd_spec = scr[0] & 0x0FU;
+            uint8_t bus_widths = (scr[0] >> 8) & 0x0FU;
+
+            if (bus_widths & 0x04U)
+            {
+                if (!__app_command(ACMD_SET_BUS_WIDTH, 2, ERDP_SDIO_RESP_SHORT))
+                {
+                    return false;
+                }
+                __wide = true;
+                erdp_if_sdio_set_bus(ERDP_SDIO_TRANS_DIV, false, true);
+            }
+
+            /* CMD6 exists from spec 1.10: switch function group 1 to high speed and check the result */
+            if (high_speed && sd_spec >= 1)
+            {
+                uint32_t status[16];
+                if (__command_read(CMD_SWITCH_FUNC, 0x80FFFFF1U, status, 64) &&
+                    (((const uint8_t *)status)[16] & 0x0FU) == 1)
+                {
+                    erdp_if_sdio_set_bus(0, true, __wide);
+                    __clock_hz = ERDP_SDIO_CLK_HZ;
+                    __high_speed = true;
+                }
+            }
+            return true;
+        }
+
+        // Short register reads (SCR, switch status) through the FIFO without DMA
+        bool __command_read(uint8_t cmd, uint32_t arg, uint32_t *buf, uint32_t bytes)
+        {
+            uint8_t log2 = 0;
+            while ((1U << log2) < bytes)
+            {
+                log2++;
+            }
+            erdp_if_sdio_data_config(bytes, log2, false, __clock_hz / 10, false);
+            if (!__command_r1(cmd, arg))
+            {
+                return false;
+            }
+            return __read_fifo(buf, bytes / 4);
+        }
+
+        bool __app_command_read(uint8_t acmd, uint32_t arg, uint32_t *buf, uint32_t bytes)
+        {
+            if (!__command_r1(CMD_APP, (uint32_t)__rca << 16))
+            {
+                return false;
+            }
+            return __command_read(acmd, arg, buf, bytes);
+        }
+
+        bool __read_fifo(uint32_t *buf, uint32_t words)
+        {
+            uint32_t count = 0;
+            uint32_t status;
+            uint32_t spin = 0;
+
+            do
+            {
+                status = erdp_if_sdio_get_status();
+                if ((status & ERDP_SDIO_FLAG_RXDAVL) && count < words)
+                {
+                    buf[count++] = erdp_if_sdio_read_fifo();
+                }
+            } while (!(status & (ERDP_SDIO_FLAG_DATAEND | ERDP_SDIO_FLAG_DATA_ERRORS)) && ++spin < 1000000U);
+
+            while ((erdp_if_sdio_get_status() & ERDP_SDIO_FLAG_RXDAVL) && count < words)
+            {
+                buf[count++] = erdp_if_sdio_read_fifo();
+            }
+            erdp_if_sdio_clear_flags(ERDP_SDIO_FLAG_STATIC);
+            return (status & ERDP_SDIO_FLAG_DATAEND) && !(status & ERDP_SDIO_FLAG_DATA_ERRORS) && count == words;
+        }
+
+        /*
+         * The DMA stream is set as flow follower (the SDIO ends the transfer) with 4-word bursts
+         * on both sides of its FIFO, matching the SDIO FIFO half-full request threshold.
+         */
+        bool __dma_setup(bool to_card)
+        {
+            DmaConfig_t dma_cfg = {};
+
+            dma_cfg.dir = to_card ? ERDP_DMA_DIR_M2P : ERDP_DMA_DIR_P2M;
+            dma_cfg.periph_width = ERDP_DMA_WIDTH_32BIT;
+            dma_cfg.mem_width = ERDP_DMA_WIDTH_32BIT;
+            dma_cfg.mem_inc = true;
+            dma_cfg.fifo = true;
+            dma_cfg.burst = ERDP_DMA_BURST_INC4;
+            dma_cfg.periph_flow = true;
+            dma_cfg.priority = ERDP_DMA_PRIO_VERY_HIGH;
+            return __dma.claim(erdp_if_sdio_get_dma_request(), dma_cfg);
+        }
+
+        bool __transfer(uint32_t block, void *buf, uint32_t count, bool to_card)
+        {
+            erdp_assert(((uintptr_t)buf & 0x03U) == 0);
+            erdp_assert(((uintptr_t)buf & 0xFFFF0000U) != 0x10000000U);
+            erdp_assert(count > 0 && count <= 0xFFFFU);
+            if (!__ready)
+            {
+                return false;
+            }
+
+            bool multi = count > 1;
+            uint32_t addr = __high_capacity ? block : block * ERDP_SDIO_BLOCK_SIZE;
+            uint32_t length = count * ERDP_SDIO_BLOCK_SIZE;
+            uint32_t timeout_ms = to_card ? WRITE_TIMEOUT_MS : READ_TIMEOUT_MS;
+
+            if (!__dma_setup(to_card))
+            {
+                return false;
+            }
+            __data_status = 0;
+#ifdef ERDP_ENABLE_RTOS
+            __done.take(0);
+#else
+            __done = false;
+#endif
+            __dma.start(erdp_if_sdio_get_fifo_addr(), buf, length / 4);
+
+            bool ok;
+            if (to_card)
+            {
+                /* Pre-erase lets the card program the blocks in one go */
+                if (multi)
+                {
+                    __app_command(ACMD_SET_WR_ERASE_COUNT, count, ERDP_SDIO_RESP_SHORT);
+                }
+                ok = __command_r1(multi ? CMD_WRITE_MULTI : CMD_WRITE_SINGLE, addr);
+                if (ok)
+                {
+                    erdp_if_sdio_data_config(length, 9, true, __clock_hz / 1000 * timeout_ms, true);
+                    erdp_if_sdio_data_irq(true);
+                }
+            }
+            else
+            {
+                erdp_if_sdio_data_config(length, 9, false, __clock_hz / 1000 * timeout_ms, true);
+                erdp_if_sdio_data_irq(true);
+                ok = __command_r1(multi ? CMD_READ_MULTI : CMD_READ_SINGLE, addr);
+            }
+
+            ok = ok && __wait_data(timeout_ms) && !(__data_status & ERDP_SDIO_FLAG_DATA_ERRORS);
+            erdp_if_sdio_data_irq(false);
+            if (multi)
+            {
+                __command_r1(CMD_STOP, 0);
+            }
+
+            /* The stream drains its FIFO after the last SDIO request */
+            for (uint32_t spin = 0; __dma.busy() && spin < 10000U; spin++)
+            {
+            }
+            if (!ok)
+            {
+                __dma.stop();
+                __last_error = __data_status ? __data_status : ERDP_SDIO_FLAG_DTIMEOUT;
+                return false;
+            }
+            return !to_card || __wait_card_ready(WRITE_TIMEOUT_MS);
+        }
+
+        bool __wait_data(uint32_t timeout)
+        {
+#ifdef ERDP_ENABLE_RTOS
+            return __done.take(timeout);
+#else
+            uint32_t start_time = erdp_if_rtos_get_1ms_timestamp();
+            while (!__done)
+            {
+                if (erdp_if_rtos_get_1ms_timestamp() - start_time >= timeout)
+                {
+                    return false;
+                }
+            }
+            return true;
+#endif
+        }
+
+        bool __wait_card_ready(uint32_t timeout)
+        {
+            uint32_t start_time = erdp_if_rtos_get_1ms_timestamp();
+            while (true)
+            {
+                if (!__command_r1(CMD_SEND_STATUS, (uint32_t)__rca << 16))
+                {
+                    return false;
+                }
+                uint32_t status = erdp_if_sdio_get_response(0);
+                if ((status & 0x100U) && ((status >> 9) & 0x0FU) == CARD_STATE_TRAN)
+                {
+                    return true;
+                }
+                if (erdp_if_rtos_get_1ms_timestamp() - start_time >= timeout)
+                {
+                    return false;
+                }
+            }
+        }
+
+        void __irq_handler()
+        {
+            uint32_t status = erdp_if_sdio_get_status() & (ERDP_SDIO_FLAG_DATAEND | ERDP_SDIO_FLAG_DATA_ERRORS);
+            if (status == 0)
+            {
+                return;
+            }
+            erdp_if_sdio_clear_flags(status);
+            erdp_if_sdio_data_irq(false);
+            __data_status = status;
+#ifdef ERDP_ENABLE_RTOS
+            __done.give();
+#else
+            __done = true;
+#endif
+        }
+    };
+} // namespace erdp
+
+#endif // __ERDP_HAL_SDIO_HPP__
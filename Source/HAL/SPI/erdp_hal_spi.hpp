@@ -233,7 +233,7 @@ namespace erdp
             return __tx_buffer.empty();
         }
 
-        void set_usr_rx_irq_handler(std::function<void(typename SpiDevBase<DATA_SIZE>::DataType)> handler)
+        void set_usr_rx_irq_handler(InplaceFunction<void(typename SpiDevBase<DATA_SIZE>::DataType)> handler)
         {
             __usr_rx_irq_handler = handler;
         }
@@ -254,7 +254,7 @@ namespace erdp
         uint32_t __tx_count = 0;
         typename SpiDevBase<DATA_SIZE>::DataType __data;
         typename SpiDevBase<DATA_SIZE>::Buffer __tx_buffer;
-        std::function<void(typename SpiDevBase<DATA_SIZE>::DataType)> __usr_rx_irq_handler = nullptr;
+        InplaceFunction<void(typename SpiDevBase<DATA_SIZE>::DataType)> __usr_rx_irq_handler = nullptr;
         bool __load_tx_buffer(typename SpiDevBase<DATA_SIZE>::DataType *data, uint32_t len)
         {
             __tx_count = 0;
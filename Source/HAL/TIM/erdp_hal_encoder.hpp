@@ -0,0 +1,184 @@
+#ifndef __ERDP_HAL_ENCODER_HPP__
+#define __ERDP_HAL_ENCODER_HPP__
+#include "erdp_hal_tim.hpp"
+
+namespace erdp
+{
+    class Encoder
+    {
+    public:
+        typedef struct
+        {
+            ERDP_Tim_t tim; // TIM1..TIM5 or TIM8
+
+            ERDP_GpioPort_t a_port; // GPIO port for phase A (CH1)
+            ERDP_GpioPin_t a_pin;   // GPIO pin for phase A (CH1)
+            ERDP_GpioPort_t b_port; // GPIO port for phase B (CH2)
+            ERDP_GpioPin_t b_pin;   // GPIO pin for phase B (CH2)
+
+            uint8_t filter;           // Input filter (0..15)
+            bool invert;              // Reverse the counting direction
+            uint8_t priority;         // Priority for the overflow and edge interrupts
+            const TimerDev *timebase; // Free running time base read at the phase A edges, e.g. start_timebase_us()
+            uint8_t edge_prescaler;   // Phase A edges per capture: 1, 2, 4 or 8, raise it for high line rates
+        } Config_t;
+
+        Encoder() {}
+        Encoder(const Encoder &) = delete;
+        Encoder &operator=(const Encoder &) = delete;
+
+        Encoder(const Config_t &config)
+        {
+            init(config);
+        }
+
+        void init(const Config_t &config)
+        {
+            erdp_assert(config.timebase != nullptr && config.timebase->get_tick_hz() > 0);
+            __timebase = config.timebase;
+            __stale_ms = __timebase->get_range_ms() / 2;
+            erdp_assert(__stale_ms > 0);
+            __high = 0;
+            __edges = 0;
+            __edge_ticks = 0;
+            __timer.init(config.tim, config.priority);
+            __timer.encoder_init(config.a_port, config.a_pin, config.b_port, config.b_pin, config.filter, config.invert);
+            if (!__timer.is_32bit())
+            {
+                __timer.set_update_handler([this]() { __high = extend_high(__high, __timer.get_counter()); });
+            }
+            /* CC1 latches the counter at the phase A edges in encoder mode */
+            erdp_if_tim_ic_prescaler(config.tim, ERDP_TIM_CH1, config.edge_prescaler);
+            __timer.set_capture_handler(ERDP_TIM_CH1, [this](uint32_t capture) { __edge_irq_handler(capture); });
+        }
+
+        void deinit()
+        {
+            __timer.deinit();
+        }
+
+        // Position in counts (4 per encoder line), extended to 32 bits on 16-bit timers.
+        // Never blocks: a single register read on TIM2/TIM5, otherwise the counter is read
+        // again only if the overflow interrupt hit in between. Callable from tasks and from
+        // interrupts of lower priority than the timer interrupt.
+        int32_t position() const
+        {
+            if (__timer.is_32bit())
+            {
+                return (int32_t)__timer.get_counter();
+            }
+            uint32_t high;
+            uint32_t counter;
+            bool pending;
+            do
+            {
+                high = __high;
+                pending = __timer.update_pending();
+                counter = __timer.get_counter();
+            } while (high != __high || pending != __timer.update_pending());
+            return extend(high, counter, pending);
+        }
+
+        // Only call while the encoder is not moving
+        void set_position(int32_t position)
+        {
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            __edges = 0;
+            __edge_ticks = 0;
+            erdp_if_rtos_cpu_unlock(key);
+            if (__timer.is_32bit())
+            {
+                __timer.set_counter((uint32_t)position);
+                return;
+            }
+            __high = (uint32_t)position & 0xFFFF0000U;
+            __timer.set_counter((uint32_t)position & 0xFFFFU);
+        }
+
+        // Counts per second from the counter latched at the last two captured edges and the time between
+        // them. While the next edge is overdue the speed is bounded by the time since the last one, and
+        // reads 0 once no edge came for half the time base range. Callable from tasks and interrupts.
+        float velocity() const
+        {
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            int32_t counts = __edge_counts;
+            uint32_t ticks = __edge_ticks;
+            uint32_t edge_time = __edge_time;
+            uint32_t edge_ms = __edge_ms;
+            erdp_if_rtos_cpu_unlock(key);
+
+            if (ticks == 0 || erdp_if_rtos_get_1ms_timestamp() - edge_ms >= __stale_ms)
+            {
+                return 0.0f;
+            }
+            uint32_t since = __timebase->counter_delta(__timebase->get_counter(), edge_time);
+            return edge_velocity(counts, (since > ticks) ? since : ticks, __timebase->get_tick_hz());
+        }
+
+        // Counts per second from the counts between two edges and the time base ticks between them
+        static float edge_velocity(int32_t counts, uint32_t ticks, uint32_t tick_hz)
+        {
+            return (ticks > 0) ? (float)counts * (float)tick_hz / (float)ticks : 0.0f;
+        }
+
+        // Counts between two captures of the encoder counter, captures at most half the counter range apart
+        static int32_t capture_counts(uint32_t later, uint32_t earlier, bool is_32bit)
+        {
+            return is_32bit ? (int32_t)(later - earlier) : (int32_t)(int16_t)(later - earlier);
+        }
+
+        // High half after an overflow/underflow of a 16-bit encoder counter. The counter is read after
+        // the update event, so it sits near 0 after counting up and near 0xFFFF after counting down.
+        static uint32_t extend_high(uint32_t high, uint32_t counter)
+        {
+            return (counter < 0x8000U) ? high + 0x10000U : high - 0x10000U;
+        }
+
+        // 32-bit position from the high half, the 16-bit counter and a not yet handled update event
+        static int32_t extend(uint32_t high, uint32_t counter, bool pending)
+        {
+            if (pending)
+            {
+                high = extend_high(high, counter);
+            }
+            return (int32_t)(high + (counter & 0xFFFFU));
+        }
+
+    private:
+        TimerDev __timer;
+        const TimerDev *__timebase = nullptr;
+        uint32_t __stale_ms = 0;
+        volatile uint32_t __high = 0;
+
+        /* Written by the edge interrupt */
+        uint32_t __edge_capture = 0; // Encoder counter latched at the last edge
+        uint32_t __edge_time = 0;    // Time base at the last edge
+        uint32_t __edge_ms = 0;
+        int32_t __edge_counts = 0;  // Counts between the last two edges
+        uint32_t __edge_ticks = 0;  // Time base ticks between the last two edges, 0 until known
+        uint8_t __edges = 0;
+
+        void __edge_irq_handler(uint32_t capture)
+        {
+            uint32_t now = __timebase->get_counter();
+            uint32_t now_ms = erdp_if_rtos_get_1ms_timestamp();
+
+            /* After a long stop the time base may have wrapped, start over from this edge */
+            if (__edges > 0 && now_ms - __edge_ms < __stale_ms)
+            {
+                __edge_counts = capture_counts(capture, __edge_capture, __timer.is_32bit());
+                __edge_ticks = __timebase->counter_delta(now, __edge_time);
+            }
+            else
+            {
+                __edges = 1;
+                __edge_ticks = 0;
+            }
+            __edge_capture = capture;
+            __edge_time = now;
+            __edge_ms = now_ms;
+        }
+    };
+} // namespace erdp
+
+#endif // __ERDP_HAL_ENCODER_HPP__
@@ -0,0 +1,16 @@
+#include "erdp_hal_tim.hpp"
+namespace erdp
+{
+    TimerDev *TimerDev::__instance[ERDP_TIM_NUM] = {nullptr};
+
+    extern "C"
+    {
+        void erdp_tim_irq_handler(ERDP_Tim_t tim)
+        {
+            if (TimerDev::__instance[tim] != nullptr)
+            {
+                TimerDev::__instance[tim]->__irq_handler();
+            }
+        }
+    }
+} // namespace erdp
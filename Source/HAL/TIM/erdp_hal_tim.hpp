@@ -0,0 +1,438 @@
+#ifndef __ERDP_HAL_TIM_HPP__
+#define __ERDP_HAL_TIM_HPP__
+#include "erdp_hal.hpp"
+#include "erdp_hal_dma.hpp"
+#include "erdp_if_tim.h"
+
+namespace erdp
+{
+    extern "C"
+    {
+        void erdp_tim_irq_handler(ERDP_Tim_t tim);
+    }
+
+    class TimerDev
+    {
+        friend void erdp_tim_irq_handler(ERDP_Tim_t tim);
+
+    public:
+        static constexpr uint32_t US_TICK_HZ = 1000000;
+
+        TimerDev() {}
+        TimerDev(const TimerDev &) = delete;
+        TimerDev &operator=(const TimerDev &) = delete;
+
+        TimerDev(ERDP_Tim_t tim, uint8_t priority)
+        {
+            init(tim, priority);
+        }
+
+        ~TimerDev()
+        {
+            deinit();
+        }
+
+        // Default time base: free running counter at 1 MHz
+        void init(ERDP_Tim_t tim, uint8_t priority)
+        {
+            erdp_assert(tim > ERDP_TIM0 && tim < ERDP_TIM_NUM);
+            __tim = tim;
+            __priority = priority;
+            __instance[__tim] = this;
+            __clock_hz = erdp_if_tim_get_clock(__tim);
+            __max_period = erdp_if_tim_is_32bit(__tim) ? 0xFFFFFFFFU : 0xFFFFU;
+            __timebase_init(__clock_hz / US_TICK_HZ - 1, __max_period, false);
+        }
+
+        void deinit()
+        {
+            if (__tim != ERDP_TIM0 && __instance[__tim] == this)
+            {
+                erdp_if_tim_deinit(__tim);
+                for (auto &dma : __dma)
+                {
+                    dma.deinit();
+                }
+                __instance[__tim] = nullptr;
+            }
+            __tim = ERDP_TIM0;
+        }
+
+        // Call callback every period_us from the timer interrupt, false if out of range
+        bool start_periodic_us(uint32_t period_us, InplaceFunction<void()> callback)
+        {
+            return __start_us(period_us, callback, false);
+        }
+
+        // Call callback once after delay_us from the timer interrupt, false if out of range
+        bool start_oneshot_us(uint32_t delay_us, InplaceFunction<void()> callback)
+        {
+            return __start_us(delay_us, callback, true);
+        }
+
+        // Free running 1 MHz counter, usable as a microsecond timestamp
+        void start_timebase_us()
+        {
+            __timebase_init(__clock_hz / US_TICK_HZ - 1, __max_period, false);
+            erdp_if_tim_enable(__tim, true);
+        }
+
+        void stop()
+        {
+            erdp_if_tim_enable(__tim, false);
+            erdp_if_tim_irq_enable(__tim, ERDP_TIM_EVENT_MASK(ERDP_TIM_EVENT_UPDATE), false);
+            for (auto &dma : __dma)
+            {
+                dma.stop();
+            }
+        }
+
+        uint32_t get_counter() const
+        {
+            return erdp_if_tim_get_counter(__tim);
+        }
+
+        void set_counter(uint32_t counter)
+        {
+            erdp_if_tim_set_counter(__tim, counter);
+        }
+
+        ERDP_Tim_t get_tim() const
+        {
+            return __tim;
+        }
+
+        uint32_t get_tick_hz() const
+        {
+            return __tick_hz;
+        }
+
+        uint32_t get_period() const
+        {
+            return __period;
+        }
+
+        // Ticks from earlier to later counter values, valid while less than one counter range apart
+        uint32_t counter_delta(uint32_t later, uint32_t earlier) const
+        {
+            return __capture_delta(later, earlier);
+        }
+
+        // Time the free running counter takes to wrap
+        uint32_t get_range_ms() const
+        {
+            uint64_t range_ms = ((uint64_t)__max_period + 1) * 1000 / __tick_hz;
+            return (range_ms > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (uint32_t)range_ms;
+        }
+
+        // Capture time base shared by all channels, tick_hz sets the resolution
+        void capture_init(uint32_t tick_hz = US_TICK_HZ)
+        {
+            erdp_assert(tick_hz > 0 && tick_hz <= __clock_hz);
+            __timebase_init(__clock_hz / tick_hz - 1, __max_period, false);
+        }
+
+        void capture_channel_init(ERDP_TimChannel_t channel, ERDP_GpioPort_t port, ERDP_GpioPin_t pin,
+                                  ERDP_TimEdge_t edge = ERDP_TIM_EDGE_RISING, uint8_t filter = 0)
+        {
+            erdp_if_tim_gpio_init(__tim, port, pin);
+            erdp_if_tim_ic_init(__tim, channel, edge, filter);
+        }
+
+        // Capture values are written to buffer by DMA, dma_handler gets ERDP_DMA_FLAG_* (HT/TC/TE)
+        bool capture_start(ERDP_TimChannel_t channel, uint32_t *buffer, uint32_t count, bool circular = false,
+                           InplaceFunction<void(uint32_t flags)> dma_handler = nullptr)
+        {
+            ERDP_TimEvent_t event = ERDP_TIM_EVENT_CC(channel);
+            DmaConfig_t dma_cfg = {};
+            dma_cfg.dir = ERDP_DMA_DIR_P2M;
+            dma_cfg.periph_width = ERDP_DMA_WIDTH_32BIT;
+            dma_cfg.mem_width = ERDP_DMA_WIDTH_32BIT;
+            dma_cfg.mem_inc = true;
+            dma_cfg.circular = circular;
+            dma_cfg.priority = ERDP_DMA_PRIO_HIGH;
+            dma_cfg.irq_flags = dma_handler ? (ERDP_DMA_FLAG_TC | ERDP_DMA_FLAG_HT | ERDP_DMA_FLAG_TE) : 0;
+            if (!__dma_init(event, dma_cfg, dma_handler))
+            {
+                return false;
+            }
+            __dma[event].start(erdp_if_tim_get_ccr_addr(__tim, channel), buffer, count);
+            erdp_if_tim_clear_flags(__tim, ERDP_TIM_EVENT_MASK(event));
+            erdp_if_tim_dma_enable(__tim, event, true);
+            erdp_if_tim_enable(__tim, true);
+            return true;
+        }
+
+        // Safe without a capture_start(), stop() skips a stream that was never claimed
+        void capture_stop(ERDP_TimChannel_t channel)
+        {
+            ERDP_TimEvent_t event = ERDP_TIM_EVENT_CC(channel);
+            erdp_if_tim_dma_enable(__tim, event, false);
+            __dma[event].stop();
+        }
+
+        // Number of values captured so far (non circular mode)
+        uint32_t capture_count(ERDP_TimChannel_t channel, uint32_t count) const
+        {
+            return count - __dma[ERDP_TIM_EVENT_CC(channel)].remaining();
+        }
+
+        // Average interval between consecutive same-edge captures, counter wrap handled
+        uint32_t capture_period_ticks(const uint32_t *buffer, uint32_t count) const
+        {
+            if (count < 2)
+            {
+                return 0;
+            }
+            uint64_t total = 0;
+            for (uint32_t i = 1; i < count; i++)
+            {
+                total += __capture_delta(buffer[i], buffer[i - 1]);
+            }
+            return (uint32_t)(total / (count - 1));
+        }
+
+        // Input frequency from same-edge captures
+        float capture_frequency(const uint32_t *buffer, uint32_t count) const
+        {
+            uint32_t ticks = capture_period_ticks(buffer, count);
+            return ticks ? (float)__tick_hz / (float)ticks : 0.0f;
+        }
+
+        // Average pulse width from both-edge captures, buffer[0] must be a leading edge
+        uint32_t capture_pulse_ticks(const uint32_t *buffer, uint32_t count) const
+        {
+            uint64_t total = 0;
+            uint32_t pulses = 0;
+            for (uint32_t i = 1; i < count; i += 2)
+            {
+                total += __capture_delta(buffer[i], buffer[i - 1]);
+                pulses++;
+            }
+            return pulses ? (uint32_t)(total / pulses) : 0;
+        }
+
+        // Largest period for freq_hz to get the finest duty resolution, false if out of range
+        bool pwm_init(uint32_t freq_hz)
+        {
+            return __timebase_freq(freq_hz);
+        }
+
+        void pwm_channel_init(ERDP_TimChannel_t channel, ERDP_GpioPort_t port, ERDP_GpioPin_t pin,
+                              bool active_high = true)
+        {
+            erdp_if_tim_gpio_init(__tim, port, pin);
+            erdp_if_tim_pwm_init(__tim, channel, 0, active_high);
+        }
+
+        void pwm_start()
+        {
+            erdp_if_tim_enable(__tim, true);
+        }
+
+        void set_compare(ERDP_TimChannel_t channel, uint32_t compare)
+        {
+            erdp_if_tim_set_compare(__tim, channel, compare);
+        }
+
+        // duty: 0.0 ~ 1.0
+        void set_duty(ERDP_TimChannel_t channel, float duty)
+        {
+            erdp_if_tim_set_compare(__tim, channel, duty_to_compare(duty));
+        }
+
+        uint32_t duty_to_compare(float duty) const
+        {
+            if (duty <= 0.0f)
+            {
+                return 0;
+            }
+            if (duty >= 1.0f)
+            {
+                return __period + 1;
+            }
+            return (uint32_t)(duty * (float)(__period + 1) + 0.5f);
+        }
+
+        // Update channels first_channel..first_channel+channels-1 at every update event through DMA burst,
+        // compares is laid out as [update][channel]; dma_handler (HT/TC) allows refilling half of a circular buffer
+        bool pwm_burst_start(ERDP_TimChannel_t first_channel, uint8_t channels, const uint16_t *compares,
+                             uint32_t updates, bool circular = false,
+                             InplaceFunction<void(uint32_t flags)> dma_handler = nullptr)
+        {
+            erdp_assert(channels >= 1 && first_channel + channels <= ERDP_TIM_CH_NUM);
+            DmaConfig_t dma_cfg = {};
+            dma_cfg.dir = ERDP_DMA_DIR_M2P;
+            dma_cfg.periph_width = ERDP_DMA_WIDTH_16BIT;
+            dma_cfg.mem_width = ERDP_DMA_WIDTH_16BIT;
+            dma_cfg.mem_inc = true;
+            dma_cfg.circular = circular;
+            dma_cfg.priority = ERDP_DMA_PRIO_HIGH;
+            dma_cfg.irq_flags = dma_handler ? (ERDP_DMA_FLAG_TC | ERDP_DMA_FLAG_HT | ERDP_DMA_FLAG_TE) : 0;
+            if (!__dma_init(ERDP_TIM_EVENT_UPDATE, dma_cfg, dma_handler))
+            {
+                return false;
+            }
+            uint32_t dmar = erdp_if_tim_dma_burst_config(__tim, first_channel, channels);
+            __dma[ERDP_TIM_EVENT_UPDATE].start(dmar, compares, updates * channels);
+            erdp_if_tim_dma_enable(__tim, ERDP_TIM_EVENT_UPDATE, true);
+            erdp_if_tim_enable(__tim, true);
+            return true;
+        }
+
+        // Safe without a pwm_burst_start(), stop() skips a stream that was never claimed
+        void pwm_burst_stop()
+        {
+            erdp_if_tim_dma_enable(__tim, ERDP_TIM_EVENT_UPDATE, false);
+            __dma[ERDP_TIM_EVENT_UPDATE].stop();
+        }
+
+        // Emit an update event on TRGO at freq_hz, the sample clock of timer triggered ADC/DAC conversions
+        bool trigger_start(uint32_t freq_hz)
+        {
+            if (!__timebase_freq(freq_hz))
+            {
+                return false;
+            }
+            erdp_if_tim_trgo_update(__tim, true);
+            erdp_if_tim_enable(__tim, true);
+            return true;
+        }
+
+        // Quadrature encoder mode on CH1/CH2, the counter wraps over the full 16/32-bit range
+        void encoder_init(ERDP_GpioPort_t a_port, ERDP_GpioPin_t a_pin, ERDP_GpioPort_t b_port, ERDP_GpioPin_t b_pin,
+                          uint8_t filter = 0, bool invert = false)
+        {
+            erdp_assert(__tim <= ERDP_TIM5 || __tim == ERDP_TIM8);
+            __timebase_init(0, __max_period, false);
+            erdp_if_tim_gpio_init(__tim, a_port, a_pin);
+            erdp_if_tim_gpio_init(__tim, b_port, b_pin);
+            erdp_if_tim_encoder_init(__tim, filter, invert);
+            erdp_if_tim_enable(__tim, true);
+        }
+
+        // Called from the timer interrupt with the captured value at every capture of channel
+        void set_capture_handler(ERDP_TimChannel_t channel, InplaceFunction<void(uint32_t capture)> handler)
+        {
+            uint32_t mask = ERDP_TIM_EVENT_MASK(ERDP_TIM_EVENT_CC(channel));
+            __capture_handler[channel] = handler;
+            erdp_if_tim_clear_flags(__tim, mask);
+            erdp_if_tim_irq_enable(__tim, mask, handler != nullptr);
+        }
+
+        // Called from the timer interrupt at every update event (overflow/underflow)
+        void set_update_handler(InplaceFunction<void()> handler)
+        {
+            __one_shot = false;
+            __usr_irq_handler = handler;
+            erdp_if_tim_irq_enable(__tim, ERDP_TIM_EVENT_MASK(ERDP_TIM_EVENT_UPDATE), handler != nullptr);
+        }
+
+        bool update_pending() const
+        {
+            return (erdp_if_tim_get_flags(__tim) & ERDP_TIM_EVENT_MASK(ERDP_TIM_EVENT_UPDATE)) != 0;
+        }
+
+        bool is_32bit() const
+        {
+            return __max_period == 0xFFFFFFFFU;
+        }
+
+    private:
+        static TimerDev *__instance[ERDP_TIM_NUM];
+        ERDP_Tim_t __tim = ERDP_TIM0;
+        uint8_t __priority = 0;
+        bool __one_shot = false;
+        uint32_t __clock_hz = 0;
+        uint32_t __tick_hz = 0;
+        uint32_t __period = 0;
+        uint32_t __max_period = 0xFFFF;
+        InplaceFunction<void()> __usr_irq_handler = nullptr;
+        InplaceFunction<void(uint32_t capture)> __capture_handler[ERDP_TIM_CH_NUM];
+        DmaStream __dma[ERDP_TIM_EVENT_NUM];
+
+        void __timebase_init(uint32_t prescaler, uint32_t period, bool one_pulse)
+        {
+            erdp_assert(prescaler <= 0xFFFF && period <= __max_period);
+            __tick_hz = __clock_hz / (prescaler + 1);
+            __period = period;
+            erdp_if_tim_base_init(__tim, prescaler, period, one_pulse, __priority);
+        }
+
+        bool __timebase_freq(uint32_t freq_hz)
+        {
+            erdp_assert(freq_hz > 0);
+            uint64_t ticks = (uint64_t)__clock_hz / freq_hz;
+            uint64_t prescaler = (ticks - 1) / ((uint64_t)__max_period + 1);
+            if (ticks < 2 || prescaler > 0xFFFF)
+            {
+                return false;
+            }
+            __timebase_init((uint32_t)prescaler, (uint32_t)(ticks / (prescaler + 1) - 1), false);
+            return true;
+        }
+
+        bool __start_us(uint32_t time_us, InplaceFunction<void()> callback, bool one_shot)
+        {
+            uint64_t ticks = (uint64_t)__clock_hz / US_TICK_HZ * time_us;
+            uint64_t prescaler = (ticks - 1) / ((uint64_t)__max_period + 1);
+            if (time_us == 0 || prescaler > 0xFFFF)
+            {
+                return false;
+            }
+            erdp_if_tim_enable(__tim, false);
+            __one_shot = one_shot;
+            __usr_irq_handler = callback;
+            __timebase_init((uint32_t)prescaler, (uint32_t)(ticks / (prescaler + 1) - 1), one_shot);
+            erdp_if_tim_irq_enable(__tim, ERDP_TIM_EVENT_MASK(ERDP_TIM_EVENT_UPDATE), true);
+            erdp_if_tim_enable(__tim, true);
+            return true;
+        }
+
+        bool __dma_init(ERDP_TimEvent_t event, DmaConfig_t &dma_cfg, InplaceFunction<void(uint32_t flags)> handler)
+        {
+            dma_cfg.irq_priority = __priority;
+            if (!__dma[event].claim(erdp_if_tim_get_dma_request(__tim, event), dma_cfg))
+            {
+                return false;
+            }
+            __dma[event].set_usr_irq_handler(handler);
+            return true;
+        }
+
+        uint32_t __capture_delta(uint32_t later, uint32_t earlier) const
+        {
+            return (later - earlier) & __max_period;
+        }
+
+        void __irq_handler()
+        {
+            uint32_t status = erdp_if_tim_get_irq_status(__tim);
+            if (status == 0)
+            {
+                return;
+            }
+            erdp_if_tim_clear_flags(__tim, status);
+            if (status & ERDP_TIM_EVENT_MASK(ERDP_TIM_EVENT_UPDATE))
+            {
+                if (__one_shot)
+                {
+                    erdp_if_tim_irq_enable(__tim, ERDP_TIM_EVENT_MASK(ERDP_TIM_EVENT_UPDATE), false);
+                }
+                if (__usr_irq_handler != nullptr)
+                {
+                    __usr_irq_handler();
+                }
+            }
+            for (uint8_t channel = 0; channel < ERDP_TIM_CH_NUM; channel++)
+            {
+                if ((status & ERDP_TIM_EVENT_MASK(ERDP_TIM_EVENT_CC(channel))) && __capture_handler[channel] != nullptr)
+                {
+                    __capture_handler[channel](erdp_if_tim_get_capture(__tim, (ERDP_TimChannel_t)channel));
+                }
+            }
+        }
+    };
+} // namespace erdp
+
+#endif // __ERDP_HAL_TIM_HPP__
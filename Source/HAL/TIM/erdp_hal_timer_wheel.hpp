@@ -0,0 +1,62 @@
+#ifndef __ERDP_HAL_TIMER_WHEEL_HPP__
+#define __ERDP_HAL_TIMER_WHEEL_HPP__
+#include "erdp_hal_tim.hpp"
+#include "erdp_timer_wheel.hpp"
+
+namespace erdp
+{
+    /*
+     * TimerWheel advanced from the update interrupt of a hardware timer, for deadlines finer than
+     * the 1 ms system tick. Callbacks run in that interrupt and must be short; tick_us trades
+     * resolution against interrupt load (each tick costs one interrupt even with no timer due).
+     */
+    template <uint8_t Levels = 4, uint8_t SlotBits = 6>
+    class TimerWheelDev : public TimerWheel<Levels, SlotBits>
+    {
+    public:
+        TimerWheelDev() {}
+        TimerWheelDev(const TimerWheelDev &) = delete;
+        TimerWheelDev &operator=(const TimerWheelDev &) = delete;
+
+        TimerWheelDev(ERDP_Tim_t tim, uint8_t priority, uint32_t tick_us)
+        {
+            init(tim, priority, tick_us);
+        }
+
+        // Start ticking every tick_us, false if the timer cannot reach that period
+        bool init(ERDP_Tim_t tim, uint8_t priority, uint32_t tick_us)
+        {
+            erdp_assert(tick_us > 0);
+            __tick_us = tick_us;
+            __tim.init(tim, priority);
+            return __tim.start_periodic_us(tick_us, [this]() { this->tick(); });
+        }
+
+        void deinit()
+        {
+            __tim.deinit();
+        }
+
+        // Delay and period rounded up to whole ticks, period_us 0 for a one-shot timer
+        void start_us(WheelTimer &timer, uint32_t delay_us, uint32_t period_us = 0)
+        {
+            this->start(timer, us_to_ticks(delay_us), us_to_ticks(period_us));
+        }
+
+        uint32_t us_to_ticks(uint32_t us) const
+        {
+            return (uint32_t)(((uint64_t)us + __tick_us - 1) / __tick_us);
+        }
+
+        uint32_t get_tick_us() const
+        {
+            return __tick_us;
+        }
+
+    private:
+        TimerDev __tim;
+        uint32_t __tick_us = 1;
+    };
+} // namespace erdp
+
+#endif // __ERDP_HAL_TIMER_WHEEL_HPP__
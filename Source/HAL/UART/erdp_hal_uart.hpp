@@ -37,7 +37,7 @@ namespace erdp
         friend void erdp_uart_irq_handler(ERDP_Uart_t uart);
 #ifdef ERDP_ENABLE_RTOS
 #define GET_SYS_TICK() Thread::get_system_1ms_ticks()
-        using Buffer = Queue<uint8_t>;
+        using Buffer = StreamQueue<uint8_t>;
 #else
         using Buffer = RingBuffer<uint8_t>;
 #define GET_SYS_TICK() erdp_if_rtos_get_system_1ms_ticks()
@@ -67,15 +67,16 @@ namespace erdp
         bool recv(std::vector<uint8_t> &buffer, uint32_t timeout = 5)
         {
             bool ret = false;
-            uint8_t data;
+            uint8_t data[32];
             buffer.clear();
             uint32_t start_time = GET_SYS_TICK();
 
             while (GET_SYS_TICK() - start_time < timeout)
             {
-                if (__recv_buffer.pop(data))
+                size_t count = __recv_buffer.pop_n(data, sizeof(data));
+                if (count > 0)
                 {
-                    buffer.push_back(data);
+                    buffer.insert(buffer.end(), data, data + count);
                     ret = true;
                     start_time = GET_SYS_TICK(); // Reset the timer on successful receive
                 }
@@ -88,7 +89,7 @@ namespace erdp
             return __recv_buffer.pop(data);
         }
 
-        void set_usr_irq_handler(std::function<void()> usr_irq_handler)
+        void set_usr_irq_handler(InplaceFunction<void()> usr_irq_handler)
         {
             __usr_irq_handler = usr_irq_handler;
         }
@@ -109,7 +110,7 @@ namespace erdp
         static UartDev *__debug_com;
         uint8_t __data;
         Buffer __recv_buffer;
-        std::function<void()> __usr_irq_handler = nullptr;
+        InplaceFunction<void()> __usr_irq_handler = nullptr;
 
         void __init(const UartConfig_t &config, size_t recv_buffer_size)
         {
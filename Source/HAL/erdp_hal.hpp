@@ -3,7 +3,6 @@
 
 #include "erdp_config.h"
 #include "erdp_osal.hpp"
-#include <functional>
 
 class VoidClass
 {
@@ -0,0 +1,33 @@
+#ifndef __ERDP_HAL_BLOCK_HPP__
+#define __ERDP_HAL_BLOCK_HPP__
+#include <stdint.h>
+
+namespace erdp
+{
+    /*
+     * Storage addressed by fixed-size blocks. Kept free of any platform header so the
+     * same code (file systems, loggers) runs over a card on the target or a file on the host.
+     */
+    class BlockDevice
+    {
+    public:
+        virtual ~BlockDevice() = default;
+
+        // Read count blocks starting at block into buf
+        virtual bool read(uint32_t block, void *buf, uint32_t count) = 0;
+
+        // Write count blocks starting at block from buf
+        virtual bool write(uint32_t block, const void *buf, uint32_t count) = 0;
+
+        // Wait until written data is stored
+        virtual bool sync()
+        {
+            return true;
+        }
+
+        virtual uint32_t block_size() const = 0;
+        virtual uint32_t block_count() const = 0;
+    };
+} // namespace erdp
+
+#endif // __ERDP_HAL_BLOCK_HPP__
@@ -0,0 +1,175 @@
+#ifndef __ERDP_IF_ADC_H__
+#define __ERDP_IF_ADC_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+#include "erdp_interface.h"
+#include "erdp_if_gpio.h"
+#include "erdp_if_dma.h"
+
+    typedef enum
+    {
+        ERDP_ADC0 = 0,
+        ERDP_ADC1,
+        ERDP_ADC2,
+        ERDP_ADC3,
+        ERDP_ADC_NUM, // Maximum number of ADC
+    } ERDP_Adc_t;
+
+    typedef enum
+    {
+        ERDP_ADC_MODE_INDEPENDENT = 0,    /* Each ADC converts on its own */
+        ERDP_ADC_MODE_DUAL_INTERLEAVED,   /* ADC1 and ADC2 convert the same sequence, shifted by the sampling delay */
+        ERDP_ADC_MODE_TRIPLE_INTERLEAVED, /* ADC1, ADC2 and ADC3 convert the same sequence, shifted by the sampling delay */
+    } ERDP_AdcMode_t;
+
+    typedef enum
+    {
+        ERDP_ADC_RES_12BIT = 0,
+        ERDP_ADC_RES_10BIT,
+        ERDP_ADC_RES_8BIT,
+        ERDP_ADC_RES_6BIT,
+    } ERDP_AdcResolution_t;
+
+    typedef enum
+    {
+        ERDP_ADC_SAMPLE_3CYCLES = 0,
+        ERDP_ADC_SAMPLE_15CYCLES,
+        ERDP_ADC_SAMPLE_28CYCLES,
+        ERDP_ADC_SAMPLE_56CYCLES,
+        ERDP_ADC_SAMPLE_84CYCLES,
+        ERDP_ADC_SAMPLE_112CYCLES,
+        ERDP_ADC_SAMPLE_144CYCLES,
+        ERDP_ADC_SAMPLE_480CYCLES,
+    } ERDP_AdcSampleTime_t;
+
+    typedef enum
+    {
+        ERDP_ADC_TRIG_SOFTWARE = 0, /* Continuous conversion started by software */
+        ERDP_ADC_TRIG_TIM1_CC1,
+        ERDP_ADC_TRIG_TIM1_CC2,
+        ERDP_ADC_TRIG_TIM1_CC3,
+        ERDP_ADC_TRIG_TIM2_CC2,
+        ERDP_ADC_TRIG_TIM2_CC3,
+        ERDP_ADC_TRIG_TIM2_CC4,
+        ERDP_ADC_TRIG_TIM2_TRGO,
+        ERDP_ADC_TRIG_TIM3_CC1,
+        ERDP_ADC_TRIG_TIM3_TRGO,
+        ERDP_ADC_TRIG_TIM4_CC4,
+        ERDP_ADC_TRIG_TIM5_CC1,
+        ERDP_ADC_TRIG_TIM5_CC2,
+        ERDP_ADC_TRIG_TIM5_CC3,
+        ERDP_ADC_TRIG_TIM8_CC1,
+        ERDP_ADC_TRIG_TIM8_TRGO,
+        ERDP_ADC_TRIG_NUM,
+    } ERDP_AdcTrigger_t;
+
+/* Maximum number of conversions of a regular sequence */
+#define ERDP_ADC_MAX_SEQUENCE 16U
+
+    /**
+     * @brief Configure a pin in analog mode
+     * @param[in] port GPIO port of the analog input
+     * @param[in] pin GPIO pin of the analog input
+     */
+    void erdp_if_adc_gpio_init(ERDP_GpioPort_t port, ERDP_GpioPin_t pin);
+
+    /**
+     * @brief Configure the settings shared by all ADCs
+     * @param[in] mode Independent or multi ADC interleaved mode
+     * @param[in] sampling_delay Delay between the conversions of two ADCs in interleaved mode (5..20 ADC clock cycles)
+     * @note The ADC clock is set to the highest PCLK2 division not above 36MHz
+     */
+    void erdp_if_adc_common_init(ERDP_AdcMode_t mode, uint8_t sampling_delay);
+
+    /**
+     * @brief Initialize an ADC for regular scan conversions
+     * @param[in] adc ADC identifier
+     * @param[in] resolution Conversion resolution
+     * @param[in] trigger Conversion trigger, ERDP_ADC_TRIG_SOFTWARE selects continuous conversion
+     * @note Leaves the ADC disabled, slave ADCs of an interleaved group use erdp_if_adc_slave_init()
+     */
+    void erdp_if_adc_init(ERDP_Adc_t adc, ERDP_AdcResolution_t resolution, ERDP_AdcTrigger_t trigger);
+
+    /**
+     * @brief Initialize a slave ADC of an interleaved group, started by the master conversions
+     * @param[in] adc ADC identifier (ADC2 or ADC3)
+     * @param[in] resolution Conversion resolution
+     * @param[in] continuous Continuous conversion setting of the master (true when the master is ERDP_ADC_TRIG_SOFTWARE)
+     * @note The external trigger is disabled, leaves the ADC disabled
+     */
+    void erdp_if_adc_slave_init(ERDP_Adc_t adc, ERDP_AdcResolution_t resolution, bool continuous);
+
+    /**
+     * @brief Reset all ADCs
+     */
+    void erdp_if_adc_deinit(void);
+
+    /**
+     * @brief Program the regular sequence of an ADC
+     * @param[in] adc ADC identifier
+     * @param[in] channels Channel numbers (0..18) in conversion order
+     * @param[in] count Number of conversions (1..ERDP_ADC_MAX_SEQUENCE)
+     * @param[in] sample_time Sampling time of every channel of the sequence
+     */
+    void erdp_if_adc_set_sequence(ERDP_Adc_t adc, const uint8_t *channels, uint8_t count,
+                                  ERDP_AdcSampleTime_t sample_time);
+
+    /**
+     * @brief Enable or disable DMA requests, the requests keep going in circular mode
+     * @param[in] adc ADC identifier, ADC1 in interleaved mode
+     * @param[in] mode Mode given to erdp_if_adc_common_init()
+     * @param[in] enable true to enable, false to disable
+     */
+    void erdp_if_adc_dma_enable(ERDP_Adc_t adc, ERDP_AdcMode_t mode, bool enable);
+
+    /**
+     * @brief Power an ADC on or off
+     * @param[in] adc ADC identifier
+     * @param[in] enable true to power on, false to power off
+     */
+    void erdp_if_adc_enable(ERDP_Adc_t adc, bool enable);
+
+    /**
+     * @brief Start the regular conversions by software
+     * @param[in] adc ADC identifier, ADC1 in interleaved mode
+     */
+    void erdp_if_adc_software_start(ERDP_Adc_t adc);
+
+    /**
+     * @brief Get the data register address used as DMA peripheral address
+     * @param[in] adc ADC identifier
+     * @param[in] mode Mode given to erdp_if_adc_common_init(), interleaved modes use the common data register
+     * @return Address of ADCx->DR or ADC->CDR
+     */
+    uint32_t erdp_if_adc_get_data_addr(ERDP_Adc_t adc, ERDP_AdcMode_t mode);
+
+    /**
+     * @brief Enable or disable the overrun interrupt
+     * @param[in] adc ADC identifier
+     * @param[in] priority Preemption priority of the ADC interrupt (shared by all ADCs)
+     * @param[in] enable true to enable, false to disable
+     */
+    void erdp_if_adc_overrun_irq_enable(ERDP_Adc_t adc, uint8_t priority, bool enable);
+
+    /**
+     * @brief Check and clear the overrun flag
+     * @param[in] adc ADC identifier
+     * @return true if an overrun occurred since the last call
+     */
+    bool erdp_if_adc_clear_overrun(ERDP_Adc_t adc);
+
+    /**
+     * @brief Get the DMA request of an ADC
+     * @param[in] adc ADC identifier
+     * @return DMA request, ERDP_DMA_REQ_NONE for an invalid ADC
+     */
+    ERDP_DmaRequest_t erdp_if_adc_get_dma_request(ERDP_Adc_t adc);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // __ERDP_IF_ADC_H__
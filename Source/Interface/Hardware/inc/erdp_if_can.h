@@ -0,0 +1,198 @@
+#ifndef __ERDP_IF_CAN_H__
+#define __ERDP_IF_CAN_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+#include "erdp_interface.h"
+#include "erdp_if_gpio.h"
+
+#define ERDP_CAN_FILTER_BANK_NUM 28   /* Filter banks shared by CAN1 and CAN2 */
+#define ERDP_CAN_MAILBOX_NUM     3    /* Transmit mailboxes per controller */
+#define ERDP_CAN_NO_MAILBOX      0xFF /* Returned when no transmit mailbox is free */
+
+    typedef enum
+    {
+        ERDP_CAN0 = 0,
+        ERDP_CAN1,
+        ERDP_CAN2,
+        ERDP_CAN_NUM, // Maximum number of CAN
+    } ERDP_Can_t;
+
+    typedef enum
+    {
+        ERDP_CAN_MODE_NORMAL = 0,
+        ERDP_CAN_MODE_LOOPBACK,        // TX looped back to RX, still sent on the bus
+        ERDP_CAN_MODE_SILENT,          // Listen only, no ACK and no error frames
+        ERDP_CAN_MODE_SILENT_LOOPBACK, // Self test, nothing on the bus
+    } ERDP_CanMode_t;
+
+    typedef enum
+    {
+        ERDP_CAN_FILTER_MASK = 0, // id/mask pairs
+        ERDP_CAN_FILTER_LIST,     // list of exact identifiers
+    } ERDP_CanFilterMode_t;
+
+    typedef enum
+    {
+        ERDP_CAN_FILTER_16BIT = 0, // Two id/mask pairs or four identifiers per bank (standard ids)
+        ERDP_CAN_FILTER_32BIT,     // One id/mask pair or two identifiers per bank
+    } ERDP_CanFilterScale_t;
+
+    typedef struct
+    {
+        ERDP_GpioPort_t tx_port; // GPIO port for TX pin
+        ERDP_GpioPin_t tx_pin;   // GPIO pin for TX pin
+        ERDP_GpioPort_t rx_port; // GPIO port for RX pin
+        ERDP_GpioPin_t rx_pin;   // GPIO pin for RX pin
+    } ERDP_CanPins_t;
+
+    typedef struct
+    {
+        uint32_t id;        // 11 bit standard or 29 bit extended identifier
+        bool ext;           // Extended identifier
+        bool rtr;           // Remote frame
+        uint8_t dlc;        // Data length (0..8)
+        uint8_t filter;     // Index of the matching filter (received frames)
+        uint16_t time;      // Start of frame capture in bit times (received frames)
+        uint32_t timestamp; // Reception time in ms, set by the driver
+        uint8_t data[8];
+    } ERDP_CanFrame_t;
+
+    typedef struct
+    {
+        uint8_t tec;  // Transmit error counter
+        uint8_t rec;  // Receive error counter
+        uint8_t lec;  // Last error code (0 none, 1 stuff, 2 form, 3 ack, 4 bit recessive, 5 bit dominant, 6 crc)
+        bool warning; // An error counter reached 96
+        bool passive; // An error counter exceeded 127
+        bool bus_off; // Transmit error counter exceeded 255
+    } ERDP_CanError_t;
+
+    /**
+     * @brief Initialize CAN TX and RX pins
+     * @param[in] can CAN identifier
+     * @param[in] pins TX and RX pins
+     */
+    void erdp_if_can_gpio_init(ERDP_Can_t can, const ERDP_CanPins_t *pins);
+
+    /**
+     * @brief Initialize a CAN controller
+     * @param[in] can CAN identifier
+     * @param[in] bitrate Bit rate in bit/s, sample point close to 87.5%
+     * @param[in] mode Operating mode
+     * @return true on success, false if the bit rate cannot be derived from APB1
+     * @note Automatic bus-off recovery and wakeup are enabled, mailboxes are sent in request order
+     *       and the time triggered mode is enabled to capture reception times
+     * @note The filter banks belong to CAN1: initializing or disabling CAN1 resets the banks of both
+     *       controllers, configure the filters after erdp_if_can_init(ERDP_CAN1)
+     */
+    bool erdp_if_can_init(ERDP_Can_t can, uint32_t bitrate, ERDP_CanMode_t mode);
+
+    /**
+     * @brief Disable a CAN controller and its interrupts
+     * @param[in] can CAN identifier
+     */
+    void erdp_if_can_deinit(ERDP_Can_t can);
+
+    /**
+     * @brief Enable or disable the TX, RX FIFO and status change interrupts
+     * @param[in] can CAN identifier
+     * @param[in] priority Preemption priority
+     * @param[in] enable true to enable, false to disable
+     */
+    void erdp_if_can_irq_enable(ERDP_Can_t can, uint8_t priority, bool enable);
+
+    /**
+     * @brief Set the first filter bank of CAN2, banks below belong to CAN1
+     * @param[in] can2_start_bank First CAN2 bank (1..27), 14 after reset
+     * @note Lost when CAN1 is initialized or disabled, see erdp_if_can_init()
+     */
+    void erdp_if_can_filter_split(uint8_t can2_start_bank);
+
+    /**
+     * @brief Configure a filter bank
+     * @param[in] bank Filter bank (0..27)
+     * @param[in] mode Mask or list mode
+     * @param[in] scale 16 or 32 bit scale
+     * @param[in] fifo Receive FIFO (0 or 1) for matching frames
+     * @param[in] fr1 First filter register (identifier)
+     * @param[in] fr2 Second filter register (mask, or second identifier in list mode)
+     * @param[in] enable true to activate the bank
+     * @note Lost when CAN1 is initialized or disabled, see erdp_if_can_init()
+     */
+    void erdp_if_can_filter_config(uint8_t bank, ERDP_CanFilterMode_t mode, ERDP_CanFilterScale_t scale,
+                                   uint8_t fifo, uint32_t fr1, uint32_t fr2, bool enable);
+
+    /**
+     * @brief Count free transmit mailboxes
+     * @param[in] can CAN identifier
+     * @return Number of empty mailboxes (0..3)
+     */
+    uint8_t erdp_if_can_tx_free(ERDP_Can_t can);
+
+    /**
+     * @brief Load a frame into an empty mailbox and request its transmission
+     * @param[in] can CAN identifier
+     * @param[in] frame Frame to send
+     * @return Mailbox number, ERDP_CAN_NO_MAILBOX if all mailboxes are pending
+     */
+    uint8_t erdp_if_can_transmit(ERDP_Can_t can, const ERDP_CanFrame_t *frame);
+
+    /**
+     * @brief Abort the pending transmissions
+     * @param[in] can CAN identifier
+     */
+    void erdp_if_can_tx_abort(ERDP_Can_t can);
+
+    /**
+     * @brief Get and clear the completed mailboxes
+     * @param[in] can CAN identifier
+     * @param[out] ok_mask Mailboxes (bit n for mailbox n) sent successfully
+     * @return Mailboxes (bit n for mailbox n) completed, sent or aborted
+     */
+    uint8_t erdp_if_can_tx_complete(ERDP_Can_t can, uint8_t *ok_mask);
+
+    /**
+     * @brief Count frames waiting in a receive FIFO
+     * @param[in] can CAN identifier
+     * @param[in] fifo Receive FIFO (0 or 1)
+     * @return Number of pending frames (0..3)
+     */
+    uint8_t erdp_if_can_rx_pending(ERDP_Can_t can, uint8_t fifo);
+
+    /**
+     * @brief Read the oldest frame of a receive FIFO and release it
+     * @param[in] can CAN identifier
+     * @param[in] fifo Receive FIFO (0 or 1)
+     * @param[out] frame Received frame, timestamp is left untouched
+     */
+    void erdp_if_can_receive(ERDP_Can_t can, uint8_t fifo, ERDP_CanFrame_t *frame);
+
+    /**
+     * @brief Check and clear the overrun flag of a receive FIFO
+     * @param[in] can CAN identifier
+     * @param[in] fifo Receive FIFO (0 or 1)
+     * @return true if a frame was lost because the FIFO was full
+     */
+    bool erdp_if_can_rx_overrun(ERDP_Can_t can, uint8_t fifo);
+
+    /**
+     * @brief Get the error counters and state, the registers are left untouched
+     * @param[in] can CAN identifier
+     * @param[out] error Error counters and state
+     */
+    void erdp_if_can_get_error(ERDP_Can_t can, ERDP_CanError_t *error);
+
+    /**
+     * @brief Reset the last error code and clear the error interrupt
+     * @param[in] can CAN identifier
+     */
+    void erdp_if_can_clear_error(ERDP_Can_t can);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // __ERDP_IF_CAN_H__
@@ -0,0 +1,70 @@
+#ifndef __ERDP_IF_CRC_H__
+#define __ERDP_IF_CRC_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+#include "erdp_interface.h"
+
+    /*
+     * The CRC unit computes CRC-32 with polynomial 0x04C11DB7, MSB first, over 32 bit words,
+     * starting from 0xFFFFFFFF. Its state can be reset but not loaded.
+     */
+
+    /**
+     * @brief Enable the CRC unit clock and reset its state
+     */
+    void erdp_if_crc_init(void);
+
+    /**
+     * @brief Disable the CRC unit clock
+     */
+    void erdp_if_crc_deinit(void);
+
+    /**
+     * @brief Reset the state to 0xFFFFFFFF
+     */
+    void erdp_if_crc_reset(void);
+
+    /**
+     * @brief Feed words as they are in memory
+     * @param[in] data Words
+     * @param[in] count Number of words
+     * @return State after the last word
+     */
+    uint32_t erdp_if_crc_feed(const uint32_t *data, uint32_t count);
+
+    /**
+     * @brief Feed bytes LSB first, 4 at a time, each word bit reversed (CRC-32 as zlib)
+     * @param[in] data Bytes, any alignment
+     * @param[in] words Number of 4 byte groups
+     * @return Bit reversed state, the running value of the LSB first algorithm
+     */
+    uint32_t erdp_if_crc_feed_reflected(const uint8_t *data, uint32_t words);
+
+    /**
+     * @brief Feed bytes MSB first, 4 at a time, each word byte swapped (CRC-32/MPEG-2)
+     * @param[in] data Bytes, any alignment
+     * @param[in] words Number of 4 byte groups
+     * @return State after the last word
+     */
+    uint32_t erdp_if_crc_feed_swapped(const uint8_t *data, uint32_t words);
+
+    /**
+     * @brief Get the current state
+     * @return CRC data register
+     */
+    uint32_t erdp_if_crc_get(void);
+
+    /**
+     * @brief Get the data register address, used as DMA destination
+     * @return Address of CRC->DR
+     */
+    uint32_t erdp_if_crc_get_data_addr(void);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // __ERDP_IF_CRC_H__
@@ -0,0 +1,84 @@
+#ifndef __ERDP_IF_DAC_H__
+#define __ERDP_IF_DAC_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+#include "erdp_interface.h"
+#include "erdp_if_dma.h"
+#include "erdp_if_tim.h"
+
+    typedef enum
+    {
+        ERDP_DAC_CH1 = 0, /* Output on PA4 */
+        ERDP_DAC_CH2,     /* Output on PA5 */
+        ERDP_DAC_CH_NUM,  // Maximum number of DAC channels
+    } ERDP_DacChannel_t;
+
+/* Largest 12 bit output code */
+#define ERDP_DAC_MAX_VALUE 4095U
+
+    /**
+     * @brief Initialize a DAC channel and its output pin
+     * @param[in] channel DAC channel
+     * @param[in] trigger_tim Timer whose TRGO paces the conversions (TIM2, TIM4..TIM8), ERDP_TIM0 for software writes
+     * @param[in] output_buffer true to enable the output buffer
+     * @return false if the timer cannot trigger the DAC
+     */
+    bool erdp_if_dac_init(ERDP_DacChannel_t channel, ERDP_Tim_t trigger_tim, bool output_buffer);
+
+    /**
+     * @brief Disable a DAC channel
+     * @param[in] channel DAC channel
+     */
+    void erdp_if_dac_deinit(ERDP_DacChannel_t channel);
+
+    /**
+     * @brief Enable or disable a DAC channel
+     * @param[in] channel DAC channel
+     * @param[in] enable true to enable, false to disable
+     */
+    void erdp_if_dac_enable(ERDP_DacChannel_t channel, bool enable);
+
+    /**
+     * @brief Write a 12 bit right aligned value
+     * @param[in] channel DAC channel
+     * @param[in] value Output code (0..ERDP_DAC_MAX_VALUE)
+     */
+    void erdp_if_dac_set_value(ERDP_DacChannel_t channel, uint16_t value);
+
+    /**
+     * @brief Get the 12 bit right aligned holding register address, used as DMA peripheral address
+     * @param[in] channel DAC channel
+     * @return Address of DHR12Rx
+     */
+    uint32_t erdp_if_dac_get_data_addr(ERDP_DacChannel_t channel);
+
+    /**
+     * @brief Enable or disable the DMA request and the DMA underrun interrupt of a channel
+     * @param[in] channel DAC channel
+     * @param[in] priority Preemption priority of the underrun interrupt (shared with TIM6)
+     * @param[in] enable true to enable, false to disable
+     */
+    void erdp_if_dac_dma_enable(ERDP_DacChannel_t channel, uint8_t priority, bool enable);
+
+    /**
+     * @brief Check and clear the DMA underrun flag
+     * @param[in] channel DAC channel
+     * @return true if the trigger came before the DMA delivered the sample
+     */
+    bool erdp_if_dac_clear_underrun(ERDP_DacChannel_t channel);
+
+    /**
+     * @brief Get the DMA request of a DAC channel
+     * @param[in] channel DAC channel
+     * @return DMA request
+     */
+    ERDP_DmaRequest_t erdp_if_dac_get_dma_request(ERDP_DacChannel_t channel);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // __ERDP_IF_DAC_H__
@@ -0,0 +1,95 @@
+#ifndef __ERDP_IF_DCMI_H__
+#define __ERDP_IF_DCMI_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+#include "erdp_interface.h"
+#include "erdp_if_gpio.h"
+#include "erdp_if_dma.h"
+
+    typedef enum
+    {
+        ERDP_DCMI_RATE_ALL = 0, // Capture every frame
+        ERDP_DCMI_RATE_HALF,    // Capture one frame out of 2
+        ERDP_DCMI_RATE_QUARTER, // Capture one frame out of 4
+    } ERDP_DcmiRate_t;
+
+    typedef struct
+    {
+        ERDP_GpioPort_t pixclk_port; // PA6
+        ERDP_GpioPin_t pixclk_pin;
+        ERDP_GpioPort_t hsync_port; // PA4 or PH8
+        ERDP_GpioPin_t hsync_pin;
+        ERDP_GpioPort_t vsync_port; // PB7, PG9 or PI5
+        ERDP_GpioPin_t vsync_pin;
+        ERDP_GpioPort_t data_port[8]; // D0..D7, e.g. PC6 PC7 PE0 PE1 PE4 PB6 PE5 PE6 to keep PC8..PC11 for the SDIO
+        ERDP_GpioPin_t data_pin[8];
+    } ERDP_DcmiPins_t;
+
+    typedef struct
+    {
+        bool snapshot;        // Stop after one frame instead of capturing continuously
+        bool pclk_rising;     // Sample data on the rising edge of PIXCLK
+        bool vsync_high;      // Data is not valid while VSYNC is high
+        bool hsync_high;      // Data is not valid while HSYNC is high
+        ERDP_DcmiRate_t rate; // Frame rate divider
+        uint8_t priority;     // Preemption priority of the DCMI interrupt
+    } ERDP_DcmiCfg_t;
+
+/* Interrupt flags, same bit positions as DCMI_MIS */
+#define ERDP_DCMI_FLAG_FRAME ((uint32_t)1 << 0) /* Frame captured */
+#define ERDP_DCMI_FLAG_OVF   ((uint32_t)1 << 1) /* Data overrun, the DMA did not keep up */
+#define ERDP_DCMI_FLAG_ERR   ((uint32_t)1 << 2) /* Synchronization error (embedded sync only) */
+#define ERDP_DCMI_FLAG_VSYNC ((uint32_t)1 << 3) /* Start of frame */
+#define ERDP_DCMI_FLAG_LINE  ((uint32_t)1 << 4) /* End of line */
+
+    /**
+     * @brief Initialize the PIXCLK, HSYNC, VSYNC and D0..D7 pins
+     * @param[in] pins DCMI pins
+     */
+    void erdp_if_dcmi_gpio_init(const ERDP_DcmiPins_t *pins);
+
+    /**
+     * @brief Initialize the DCMI with hardware synchronization on an 8 bit bus
+     * @param[in] cfg Capture mode, signal polarities and interrupt priority
+     * @note The overrun and error interrupts are enabled, the DMA request is raised on every 32 bit word
+     */
+    void erdp_if_dcmi_init(const ERDP_DcmiCfg_t *cfg);
+
+    /**
+     * @brief Disable the DCMI and its interrupt
+     */
+    void erdp_if_dcmi_deinit(void);
+
+    /**
+     * @brief Start or stop capturing
+     * @param[in] enable true to start capturing from the next frame, false to stop
+     * @note In snapshot mode the capture stops by itself after one frame
+     */
+    void erdp_if_dcmi_capture(bool enable);
+
+    /**
+     * @brief Get and clear the pending interrupt flags
+     * @return ERDP_DCMI_FLAG_* that were pending
+     */
+    uint32_t erdp_if_dcmi_get_flags(void);
+
+    /**
+     * @brief Get the data register address, used as DMA peripheral address
+     * @return Address of DCMI->DR
+     */
+    uint32_t erdp_if_dcmi_get_data_addr(void);
+
+    /**
+     * @brief Get the DMA request of the DCMI
+     * @return DMA request
+     */
+    ERDP_DmaRequest_t erdp_if_dcmi_get_dma_request(void);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // __ERDP_IF_DCMI_H__
@@ -0,0 +1,272 @@
+#ifndef __ERDP_IF_DMA_H__
+#define __ERDP_IF_DMA_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+#include "erdp_interface.h"
+
+    typedef enum
+    {
+        ERDP_DMA1_STREAM0 = 0,
+        ERDP_DMA1_STREAM1,
+        ERDP_DMA1_STREAM2,
+        ERDP_DMA1_STREAM3,
+        ERDP_DMA1_STREAM4,
+        ERDP_DMA1_STREAM5,
+        ERDP_DMA1_STREAM6,
+        ERDP_DMA1_STREAM7,
+        ERDP_DMA2_STREAM0,
+        ERDP_DMA2_STREAM1,
+        ERDP_DMA2_STREAM2,
+        ERDP_DMA2_STREAM3,
+        ERDP_DMA2_STREAM4,
+        ERDP_DMA2_STREAM5,
+        ERDP_DMA2_STREAM6,
+        ERDP_DMA2_STREAM7,
+        ERDP_DMA_STREAM_NUM, // Maximum number of DMA streams
+    } ERDP_DmaStream_t;
+
+    typedef enum
+    {
+        ERDP_DMA_DIR_P2M = 0, /* Peripheral to memory */
+        ERDP_DMA_DIR_M2P,     /* Memory to peripheral */
+        ERDP_DMA_DIR_M2M,     /* Memory to memory (DMA2 only) */
+    } ERDP_DmaDir_t;
+
+    typedef enum
+    {
+        ERDP_DMA_WIDTH_8BIT = 0,
+        ERDP_DMA_WIDTH_16BIT,
+        ERDP_DMA_WIDTH_32BIT,
+    } ERDP_DmaWidth_t;
+
+    typedef enum
+    {
+        ERDP_DMA_PRIO_LOW = 0,
+        ERDP_DMA_PRIO_MEDIUM,
+        ERDP_DMA_PRIO_HIGH,
+        ERDP_DMA_PRIO_VERY_HIGH,
+    } ERDP_DmaPriority_t;
+
+    typedef enum
+    {
+        ERDP_DMA_BURST_SINGLE = 0,
+        ERDP_DMA_BURST_INC4,
+        ERDP_DMA_BURST_INC8,
+        ERDP_DMA_BURST_INC16,
+    } ERDP_DmaBurst_t;
+
+    /* Peripheral DMA requests of the STM32F407 (RM0090 tables 42 and 43) */
+    typedef enum
+    {
+        ERDP_DMA_REQ_NONE = 0,
+        ERDP_DMA_REQ_MEM2MEM, // Any DMA2 stream
+        /* DMA1 */
+        ERDP_DMA_REQ_SPI2_RX,
+        ERDP_DMA_REQ_SPI2_TX,
+        ERDP_DMA_REQ_SPI3_RX,
+        ERDP_DMA_REQ_SPI3_TX,
+        ERDP_DMA_REQ_I2S2_EXT_RX,
+        ERDP_DMA_REQ_I2S2_EXT_TX,
+        ERDP_DMA_REQ_I2S3_EXT_RX,
+        ERDP_DMA_REQ_I2S3_EXT_TX,
+        ERDP_DMA_REQ_I2C1_RX,
+        ERDP_DMA_REQ_I2C1_TX,
+        ERDP_DMA_REQ_I2C2_RX,
+        ERDP_DMA_REQ_I2C2_TX,
+        ERDP_DMA_REQ_I2C3_RX,
+        ERDP_DMA_REQ_I2C3_TX,
+        ERDP_DMA_REQ_USART2_RX,
+        ERDP_DMA_REQ_USART2_TX,
+        ERDP_DMA_REQ_USART3_RX,
+        ERDP_DMA_REQ_USART3_TX,
+        ERDP_DMA_REQ_UART4_RX,
+        ERDP_DMA_REQ_UART4_TX,
+        ERDP_DMA_REQ_UART5_RX,
+        ERDP_DMA_REQ_UART5_TX,
+        ERDP_DMA_REQ_DAC1,
+        ERDP_DMA_REQ_DAC2,
+        ERDP_DMA_REQ_TIM2_UP,
+        ERDP_DMA_REQ_TIM2_CH1,
+        ERDP_DMA_REQ_TIM2_CH2,
+        ERDP_DMA_REQ_TIM2_CH3,
+        ERDP_DMA_REQ_TIM2_CH4,
+        ERDP_DMA_REQ_TIM3_UP,
+        ERDP_DMA_REQ_TIM3_CH1,
+        ERDP_DMA_REQ_TIM3_CH2,
+        ERDP_DMA_REQ_TIM3_CH3,
+        ERDP_DMA_REQ_TIM3_CH4,
+        ERDP_DMA_REQ_TIM4_UP,
+        ERDP_DMA_REQ_TIM4_CH1,
+        ERDP_DMA_REQ_TIM4_CH2,
+        ERDP_DMA_REQ_TIM4_CH3,
+        ERDP_DMA_REQ_TIM5_UP,
+        ERDP_DMA_REQ_TIM5_CH1,
+        ERDP_DMA_REQ_TIM5_CH2,
+        ERDP_DMA_REQ_TIM5_CH3,
+        ERDP_DMA_REQ_TIM5_CH4,
+        ERDP_DMA_REQ_TIM6_UP,
+        ERDP_DMA_REQ_TIM7_UP,
+        /* DMA2 */
+        ERDP_DMA_REQ_ADC1,
+        ERDP_DMA_REQ_ADC2,
+        ERDP_DMA_REQ_ADC3,
+        ERDP_DMA_REQ_SPI1_RX,
+        ERDP_DMA_REQ_SPI1_TX,
+        ERDP_DMA_REQ_USART1_RX,
+        ERDP_DMA_REQ_USART1_TX,
+        ERDP_DMA_REQ_USART6_RX,
+        ERDP_DMA_REQ_USART6_TX,
+        ERDP_DMA_REQ_SDIO,
+        ERDP_DMA_REQ_DCMI,
+        ERDP_DMA_REQ_TIM1_UP,
+        ERDP_DMA_REQ_TIM1_CH1,
+        ERDP_DMA_REQ_TIM1_CH2,
+        ERDP_DMA_REQ_TIM1_CH3,
+        ERDP_DMA_REQ_TIM1_CH4,
+        ERDP_DMA_REQ_TIM8_UP,
+        ERDP_DMA_REQ_TIM8_CH1,
+        ERDP_DMA_REQ_TIM8_CH2,
+        ERDP_DMA_REQ_TIM8_CH3,
+        ERDP_DMA_REQ_TIM8_CH4,
+        ERDP_DMA_REQ_NUM,
+    } ERDP_DmaRequest_t;
+
+/* Stream event flags, used both for interrupt enable and status */
+#define ERDP_DMA_FLAG_TC  ((uint32_t)1 << 0) /* Transfer complete */
+#define ERDP_DMA_FLAG_HT  ((uint32_t)1 << 1) /* Half transfer */
+#define ERDP_DMA_FLAG_TE  ((uint32_t)1 << 2) /* Transfer error */
+#define ERDP_DMA_FLAG_DME ((uint32_t)1 << 3) /* Direct mode error */
+#define ERDP_DMA_FLAG_FE  ((uint32_t)1 << 4) /* FIFO error */
+#define ERDP_DMA_FLAG_ALL (ERDP_DMA_FLAG_TC | ERDP_DMA_FLAG_HT | ERDP_DMA_FLAG_TE | ERDP_DMA_FLAG_DME | ERDP_DMA_FLAG_FE)
+
+/* Maximum number of data items of a single transfer (NDTR is 16 bit) */
+#define ERDP_DMA_MAX_COUNT 65535U
+
+/* Maximum number of streams able to serve one request (memory to memory excepted) */
+#define ERDP_DMA_REQ_ALT_MAX 3U
+
+    typedef struct
+    {
+        uint32_t channel;            // Request channel (0..7) of the stream
+        ERDP_DmaDir_t dir;           // Transfer direction
+        ERDP_DmaWidth_t periph_width; // Peripheral (or source for M2M) data width
+        ERDP_DmaWidth_t mem_width;   // Memory data width
+        bool periph_inc;             // Increment peripheral address
+        bool mem_inc;                // Increment memory address
+        bool circular;               // Circular mode
+        bool fifo;                   // Use FIFO instead of direct mode (required for width packing and M2M)
+        ERDP_DmaBurst_t burst;       // Memory and peripheral burst size, FIFO mode only
+        bool periph_flow;            // The peripheral ends the transfer (SDIO), the item count is ignored
+        ERDP_DmaPriority_t priority; // Stream arbitration priority
+        uint32_t irq_flags;          // ERDP_DMA_FLAG_* events that raise the stream interrupt
+        uint8_t irq_priority;        // NVIC preemption priority of the stream interrupt
+    } ERDP_DmaCfg_t;
+
+    /**
+     * @brief  Get the SOC DMA stream base address for a given ERDP DMA stream.
+     * @param[in]  stream: The ERDP DMA stream.
+     * @return  The base address of the SOC DMA stream.
+     */
+    uint32_t erdp_if_dma_get_base(ERDP_DmaStream_t stream);
+
+    /**
+     * @brief Get one of the streams that can serve a peripheral request
+     * @param[in] request Peripheral request
+     * @param[in] index 0 for the preferred stream, then the alternatives
+     * @param[out] stream DMA stream
+     * @param[out] channel Request channel of that stream
+     * @return false if the request has no stream at that index
+     */
+    bool erdp_if_dma_get_request_map(ERDP_DmaRequest_t request, uint8_t index, ERDP_DmaStream_t *stream,
+                                     uint32_t *channel);
+
+    /**
+     * @brief Initialize a DMA stream
+     * @param[in] stream DMA stream identifier
+     * @param[in] cfg Pointer to stream configuration structure
+     * @note The stream is left disabled, start it with erdp_if_dma_start()
+     */
+    void erdp_if_dma_init(ERDP_DmaStream_t stream, const ERDP_DmaCfg_t *cfg);
+
+    /**
+     * @brief Disable a DMA stream, its interrupt and reset its registers
+     * @param[in] stream DMA stream identifier
+     */
+    void erdp_if_dma_deinit(ERDP_DmaStream_t stream);
+
+    /**
+     * @brief Program addresses and item count, then enable the stream
+     * @param[in] stream DMA stream identifier
+     * @param[in] periph_addr Peripheral address (source address for M2M)
+     * @param[in] mem_addr Memory address (destination address for M2M)
+     * @param[in] count Number of data items, at most ERDP_DMA_MAX_COUNT
+     */
+    void erdp_if_dma_start(ERDP_DmaStream_t stream, uint32_t periph_addr, uint32_t mem_addr, uint32_t count);
+
+    /**
+     * @brief Disable a DMA stream and wait until the hardware has released it
+     * @param[in] stream DMA stream identifier
+     */
+    void erdp_if_dma_stop(ERDP_DmaStream_t stream);
+
+    /**
+     * @brief Check if a DMA stream is enabled
+     * @param[in] stream DMA stream identifier
+     * @return true if the stream is enabled (transfer in progress), false otherwise
+     */
+    bool erdp_if_dma_is_enabled(ERDP_DmaStream_t stream);
+
+    /**
+     * @brief Configure double buffer mode
+     * @param[in] stream DMA stream identifier
+     * @param[in] mem1_addr Address of the second memory buffer
+     * @param[in] enable true to enable double buffer mode, false to disable it
+     * @note Must be called while the stream is disabled. Double buffer mode implies circular mode.
+     */
+    void erdp_if_dma_double_buffer_config(ERDP_DmaStream_t stream, uint32_t mem1_addr, bool enable);
+
+    /**
+     * @brief Change one of the memory addresses of a double buffered stream on the fly
+     * @param[in] stream DMA stream identifier
+     * @param[in] target 0 for memory 0, 1 for memory 1
+     * @param[in] mem_addr New memory address
+     * @note Only the memory not currently accessed by the hardware may be changed
+     */
+    void erdp_if_dma_set_memory(ERDP_DmaStream_t stream, uint8_t target, uint32_t mem_addr);
+
+    /**
+     * @brief Get the memory currently used by a double buffered stream
+     * @param[in] stream DMA stream identifier
+     * @return 0 if memory 0 is being accessed, 1 if memory 1 is being accessed
+     */
+    uint8_t erdp_if_dma_get_current_target(ERDP_DmaStream_t stream);
+
+    /**
+     * @brief Get the number of data items remaining in the current transfer
+     * @param[in] stream DMA stream identifier
+     * @return Remaining item count (NDTR)
+     */
+    uint32_t erdp_if_dma_get_counter(ERDP_DmaStream_t stream);
+
+    /**
+     * @brief Get the event flags of a DMA stream
+     * @param[in] stream DMA stream identifier
+     * @return Bitwise OR of ERDP_DMA_FLAG_* currently set
+     */
+    uint32_t erdp_if_dma_get_flags(ERDP_DmaStream_t stream);
+
+    /**
+     * @brief Clear event flags of a DMA stream
+     * @param[in] stream DMA stream identifier
+     * @param[in] flags Bitwise OR of ERDP_DMA_FLAG_* to clear
+     */
+    void erdp_if_dma_clear_flags(ERDP_DmaStream_t stream, uint32_t flags);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // __ERDP_IF_DMA_H__
@@ -0,0 +1,63 @@
+#ifndef __ERDP_IF_FSMC_H__
+#define __ERDP_IF_FSMC_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+#include "erdp_interface.h"
+
+    typedef enum
+    {
+        ERDP_FSMC_NE1 = 0, // 0x60000000, NE1 on PD7
+        ERDP_FSMC_NE2,     // 0x64000000, NE2 on PG9 (144 pin packages)
+        ERDP_FSMC_NE3,     // 0x68000000, NE3 on PG10 (144 pin packages)
+        ERDP_FSMC_NE4,     // 0x6C000000, NE4 on PG12 (144 pin packages)
+        ERDP_FSMC_BANK_NUM,
+    } ERDP_FsmcBank_t;
+
+/* Highest FSMC address line, A16..A23 are the ones bonded out on 100 pin packages */
+#define ERDP_FSMC_ADDR_LINE_MAX 23U
+
+    typedef struct
+    {
+        ERDP_FsmcBank_t bank;  // Chip select wired to the LCD CS pin
+        uint8_t rs_line;       // Address line (0..23 for A0..A23) wired to the LCD RS (D/C) pin
+        uint8_t write_addset;  // Write cycle address setup, HCLK cycles (0..15)
+        uint8_t write_datast;  // Write cycle data phase (WR low), HCLK cycles (1..255)
+    } ERDP_FsmcLcdCfg_t;
+
+    /**
+     * @brief Initialize an FSMC NOR/SRAM bank as 16 bit 8080 interface for an LCD controller
+     * @param[in] cfg Bank, RS line and write timing
+     * @note D0..D15, NOE, NWE, the chip select and the RS address line are switched to the FSMC.
+     *       Reads use a fixed slow timing, controllers are much slower to read than to write.
+     */
+    void erdp_if_fsmc_lcd_init(const ERDP_FsmcLcdCfg_t *cfg);
+
+    /**
+     * @brief Disable an FSMC NOR/SRAM bank
+     * @param[in] bank FSMC bank identifier
+     */
+    void erdp_if_fsmc_lcd_deinit(ERDP_FsmcBank_t bank);
+
+    /**
+     * @brief Get the address that writes with RS low (command register)
+     * @param[in] bank FSMC bank identifier
+     * @return Command address
+     */
+    uint32_t erdp_if_fsmc_lcd_get_cmd_addr(ERDP_FsmcBank_t bank);
+
+    /**
+     * @brief Get the address that writes with RS high (parameters and pixel data), also the DMA target
+     * @param[in] bank FSMC bank identifier
+     * @param[in] rs_line Address line wired to the LCD RS pin
+     * @return Data address
+     */
+    uint32_t erdp_if_fsmc_lcd_get_data_addr(ERDP_FsmcBank_t bank, uint8_t rs_line);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // __ERDP_IF_FSMC_H__
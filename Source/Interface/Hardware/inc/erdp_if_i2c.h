@@ -0,0 +1,166 @@
+#ifndef __ERDP_IF_I2C_H__
+#define __ERDP_IF_I2C_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+#include "erdp_interface.h"
+#include "erdp_if_gpio.h"
+#include "erdp_if_dma.h"
+
+    typedef enum
+    {
+        ERDP_I2C0 = 0,
+        ERDP_I2C1,
+        ERDP_I2C2,
+        ERDP_I2C3,
+        ERDP_I2C_NUM, // Maximum number of I2C
+    } ERDP_I2c_t;
+
+    typedef struct
+    {
+        ERDP_GpioPort_t scl_port; // GPIO port for SCL pin
+        ERDP_GpioPin_t scl_pin;   // GPIO pin for SCL pin
+        ERDP_GpioPort_t sda_port; // GPIO port for SDA pin
+        ERDP_GpioPin_t sda_pin;   // GPIO pin for SDA pin
+    } ERDP_I2cPins_t;
+
+/* Status flags, same bit positions as I2C_SR1 */
+#define ERDP_I2C_FLAG_SB   ((uint32_t)1 << 0)  /* Start condition generated */
+#define ERDP_I2C_FLAG_ADDR ((uint32_t)1 << 1)  /* Address sent and acknowledged */
+#define ERDP_I2C_FLAG_BTF  ((uint32_t)1 << 2)  /* Byte transfer finished */
+#define ERDP_I2C_FLAG_RXNE ((uint32_t)1 << 6)  /* Receive data register not empty */
+#define ERDP_I2C_FLAG_TXE  ((uint32_t)1 << 7)  /* Transmit data register empty */
+#define ERDP_I2C_FLAG_BERR ((uint32_t)1 << 8)  /* Misplaced start or stop on the bus */
+#define ERDP_I2C_FLAG_ARLO ((uint32_t)1 << 9)  /* Arbitration lost */
+#define ERDP_I2C_FLAG_AF   ((uint32_t)1 << 10) /* No acknowledge */
+#define ERDP_I2C_FLAG_OVR  ((uint32_t)1 << 11) /* Overrun/underrun */
+#define ERDP_I2C_FLAG_ERRORS (ERDP_I2C_FLAG_BERR | ERDP_I2C_FLAG_ARLO | ERDP_I2C_FLAG_AF | ERDP_I2C_FLAG_OVR)
+
+    /**
+     * @brief Initialize SCL and SDA as open drain alternate function pins
+     * @param[in] i2c I2C identifier
+     * @param[in] pins SCL and SDA pins
+     */
+    void erdp_if_i2c_gpio_init(ERDP_I2c_t i2c, const ERDP_I2cPins_t *pins);
+
+    /**
+     * @brief Initialize an I2C peripheral as 7 bit addressing master
+     * @param[in] i2c I2C identifier
+     * @param[in] speed Bus clock in Hz (up to 400kHz)
+     * @param[in] priority Preemption priority of the event and error interrupts
+     * @note Event and error interrupts are enabled, DMA requests are enabled
+     */
+    void erdp_if_i2c_init(ERDP_I2c_t i2c, uint32_t speed, uint8_t priority);
+
+    /**
+     * @brief Disable an I2C peripheral and its interrupts
+     * @param[in] i2c I2C identifier
+     */
+    void erdp_if_i2c_deinit(ERDP_I2c_t i2c);
+
+    /**
+     * @brief Free a bus held by a slave: clock SCL until SDA is released, then generate a stop condition
+     * @param[in] i2c I2C identifier
+     * @param[in] pins SCL and SDA pins, driven as GPIO during the recovery and restored afterwards
+     * @return true if SDA is high after the recovery
+     * @note The peripheral is reset, call erdp_if_i2c_init() again afterwards
+     */
+    bool erdp_if_i2c_bus_recover(ERDP_I2c_t i2c, const ERDP_I2cPins_t *pins);
+
+    /**
+     * @brief Check if the bus is busy (SDA or SCL low, or communication ongoing)
+     * @param[in] i2c I2C identifier
+     * @return true if busy, false otherwise
+     */
+    bool erdp_if_i2c_is_busy(ERDP_I2c_t i2c);
+
+    /**
+     * @brief Generate a start (or repeated start) condition
+     * @param[in] i2c I2C identifier
+     */
+    void erdp_if_i2c_start(ERDP_I2c_t i2c);
+
+    /**
+     * @brief Generate a stop condition after the current byte
+     * @param[in] i2c I2C identifier
+     */
+    void erdp_if_i2c_stop(ERDP_I2c_t i2c);
+
+    /**
+     * @brief Send the slave address after a start condition
+     * @param[in] i2c I2C identifier
+     * @param[in] addr 7 bit slave address
+     * @param[in] read true for a read transfer, false for a write transfer
+     */
+    void erdp_if_i2c_send_address(ERDP_I2c_t i2c, uint8_t addr, bool read);
+
+    /**
+     * @brief Clear the ADDR flag (SR1 must have been read before)
+     * @param[in] i2c I2C identifier
+     */
+    void erdp_if_i2c_clear_addr(ERDP_I2c_t i2c);
+
+    /**
+     * @brief Enable or disable acknowledge of received bytes
+     * @param[in] i2c I2C identifier
+     * @param[in] enable true to acknowledge, false to send NACK
+     */
+    void erdp_if_i2c_ack(ERDP_I2c_t i2c, bool enable);
+
+    /**
+     * @brief Send NACK after the last byte received by DMA
+     * @param[in] i2c I2C identifier
+     * @param[in] enable true to set the LAST bit
+     */
+    void erdp_if_i2c_dma_last(ERDP_I2c_t i2c, bool enable);
+
+    /**
+     * @brief Enable or disable the buffer interrupt (TXE/RXNE)
+     * @param[in] i2c I2C identifier
+     * @param[in] enable true to enable, false to disable
+     */
+    void erdp_if_i2c_buffer_irq(ERDP_I2c_t i2c, bool enable);
+
+    /**
+     * @brief Read the data register
+     * @param[in] i2c I2C identifier
+     * @return Received byte
+     */
+    uint8_t erdp_if_i2c_read_data(ERDP_I2c_t i2c);
+
+    /**
+     * @brief Get the status flags
+     * @param[in] i2c I2C identifier
+     * @return ERDP_I2C_FLAG_* currently set
+     */
+    uint32_t erdp_if_i2c_get_status(ERDP_I2c_t i2c);
+
+    /**
+     * @brief Clear error flags
+     * @param[in] i2c I2C identifier
+     * @param[in] flags ERDP_I2C_FLAG_* error flags to clear
+     */
+    void erdp_if_i2c_clear_errors(ERDP_I2c_t i2c, uint32_t flags);
+
+    /**
+     * @brief Get the data register address, used as DMA peripheral address
+     * @param[in] i2c I2C identifier
+     * @return Address of I2Cx->DR
+     */
+    uint32_t erdp_if_i2c_get_data_addr(ERDP_I2c_t i2c);
+
+    /**
+     * @brief Get the DMA request of an I2C direction
+     * @param[in] i2c I2C identifier
+     * @param[in] rx true for the receive request, false for the transmit request
+     * @return DMA request, ERDP_DMA_REQ_NONE for an invalid I2C
+     */
+    ERDP_DmaRequest_t erdp_if_i2c_get_dma_request(ERDP_I2c_t i2c, bool rx);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // __ERDP_IF_I2C_H__
@@ -0,0 +1,139 @@
+#ifndef __ERDP_IF_SDIO_H__
+#define __ERDP_IF_SDIO_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+#include "erdp_interface.h"
+#include "erdp_if_dma.h"
+
+#define ERDP_SDIO_CLK_HZ     48000000U /* SDIOCLK from the PLL48 output */
+#define ERDP_SDIO_INIT_DIV   118U      /* 48MHz / (118 + 2) = 400kHz for card identification */
+#define ERDP_SDIO_TRANS_DIV  0U        /* 48MHz / (0 + 2) = 24MHz default speed */
+#define ERDP_SDIO_BLOCK_SIZE 512U
+
+/* Status flags, same bit positions as SDIO_STA */
+#define ERDP_SDIO_FLAG_CCRCFAIL ((uint32_t)1 << 0)  /* Command response CRC failed */
+#define ERDP_SDIO_FLAG_DCRCFAIL ((uint32_t)1 << 1)  /* Data block CRC failed */
+#define ERDP_SDIO_FLAG_CTIMEOUT ((uint32_t)1 << 2)  /* Command response timeout */
+#define ERDP_SDIO_FLAG_DTIMEOUT ((uint32_t)1 << 3)  /* Data timeout */
+#define ERDP_SDIO_FLAG_TXUNDERR ((uint32_t)1 << 4)  /* Transmit FIFO underrun */
+#define ERDP_SDIO_FLAG_RXOVERR  ((uint32_t)1 << 5)  /* Receive FIFO overrun */
+#define ERDP_SDIO_FLAG_CMDREND  ((uint32_t)1 << 6)  /* Command response received (CRC ok) */
+#define ERDP_SDIO_FLAG_CMDSENT  ((uint32_t)1 << 7)  /* Command sent (no response required) */
+#define ERDP_SDIO_FLAG_DATAEND  ((uint32_t)1 << 8)  /* Data counter reached zero */
+#define ERDP_SDIO_FLAG_STBITERR ((uint32_t)1 << 9)  /* Start bit not detected on all data lines */
+#define ERDP_SDIO_FLAG_RXDAVL   ((uint32_t)1 << 21) /* Data available in the receive FIFO */
+#define ERDP_SDIO_FLAG_DATA_ERRORS                                                                            \
+    (ERDP_SDIO_FLAG_DCRCFAIL | ERDP_SDIO_FLAG_DTIMEOUT | ERDP_SDIO_FLAG_TXUNDERR | ERDP_SDIO_FLAG_RXOVERR |      \
+     ERDP_SDIO_FLAG_STBITERR)
+#define ERDP_SDIO_FLAG_STATIC 0x000005FFU /* Flags cleared by erdp_if_sdio_clear_flags() */
+
+    typedef enum
+    {
+        ERDP_SDIO_RESP_NONE = 0,
+        ERDP_SDIO_RESP_SHORT,        // R1, R1b, R6, R7
+        ERDP_SDIO_RESP_SHORT_NO_CRC, // R3, the CRC field is not valid
+        ERDP_SDIO_RESP_LONG,         // R2
+    } ERDP_SdioResp_t;
+
+    typedef enum
+    {
+        ERDP_SDIO_OK = 0,
+        ERDP_SDIO_CMD_TIMEOUT,  // No response from the card
+        ERDP_SDIO_CMD_CRC_FAIL, // Corrupted response
+    } ERDP_SdioStatus_t;
+
+    /**
+     * @brief Initialize the SDIO pins: CK on PC12, CMD on PD2, D0..D3 on PC8..PC11
+     */
+    void erdp_if_sdio_gpio_init(void);
+
+    /**
+     * @brief Power the card, start the 400kHz identification clock on a 1 bit bus
+     * @param[in] priority Preemption priority of the SDIO interrupt
+     */
+    void erdp_if_sdio_init(uint8_t priority);
+
+    /**
+     * @brief Power off the card and stop the SDIO clock
+     */
+    void erdp_if_sdio_deinit(void);
+
+    /**
+     * @brief Set the bus clock and width
+     * @param[in] clk_div Divider, SDIO_CK = 48MHz / (clk_div + 2)
+     * @param[in] bypass true to drive SDIO_CK with 48MHz directly (high speed cards), clk_div is ignored
+     * @param[in] wide true for a 4 bit bus, false for a 1 bit bus
+     * @note Hardware flow control is left disabled (glitches on SDIO_CK, see the device errata)
+     */
+    void erdp_if_sdio_set_bus(uint8_t clk_div, bool bypass, bool wide);
+
+    /**
+     * @brief Send a command and wait for its response
+     * @param[in] cmd Command index
+     * @param[in] arg Command argument
+     * @param[in] resp Response type
+     * @return ERDP_SDIO_OK, or the command error
+     */
+    ERDP_SdioStatus_t erdp_if_sdio_command(uint8_t cmd, uint32_t arg, ERDP_SdioResp_t resp);
+
+    /**
+     * @brief Get a response register
+     * @param[in] index 0 for RESP1 (short response, bits 127:96 of a long one) to 3 for RESP4
+     * @return Response word
+     */
+    uint32_t erdp_if_sdio_get_response(uint8_t index);
+
+    /**
+     * @brief Configure and enable the data path
+     * @param[in] length Number of bytes, a multiple of the block size
+     * @param[in] block_size_log2 log2 of the block size (9 for 512 bytes)
+     * @param[in] to_card true to write to the card, false to read from it
+     * @param[in] timeout Data timeout in SDIO_CK periods
+     * @param[in] dma true to serve the FIFO with DMA requests
+     */
+    void erdp_if_sdio_data_config(uint32_t length, uint8_t block_size_log2, bool to_card, uint32_t timeout, bool dma);
+
+    /**
+     * @brief Read one word from the receive FIFO
+     * @return FIFO word
+     */
+    uint32_t erdp_if_sdio_read_fifo(void);
+
+    /**
+     * @brief Enable or disable the data end and data error interrupts
+     * @param[in] enable true to enable, false to disable
+     */
+    void erdp_if_sdio_data_irq(bool enable);
+
+    /**
+     * @brief Get the status flags
+     * @return ERDP_SDIO_FLAG_* currently set
+     */
+    uint32_t erdp_if_sdio_get_status(void);
+
+    /**
+     * @brief Clear status flags
+     * @param[in] flags ERDP_SDIO_FLAG_* to clear, within ERDP_SDIO_FLAG_STATIC
+     */
+    void erdp_if_sdio_clear_flags(uint32_t flags);
+
+    /**
+     * @brief Get the FIFO address, used as DMA peripheral address
+     * @return Address of SDIO->FIFO
+     */
+    uint32_t erdp_if_sdio_get_fifo_addr(void);
+
+    /**
+     * @brief Get the DMA request of the SDIO
+     * @return DMA request
+     */
+    ERDP_DmaRequest_t erdp_if_sdio_get_dma_request(void);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // __ERDP_IF_SDIO_H__
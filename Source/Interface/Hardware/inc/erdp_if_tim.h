@@ -0,0 +1,268 @@
+#ifndef __ERDP_IF_TIM_H__
+#define __ERDP_IF_TIM_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+#include "erdp_interface.h"
+#include "erdp_if_gpio.h"
+#include "erdp_if_dma.h"
+
+    typedef enum
+    {
+        ERDP_TIM0 = 0,
+        ERDP_TIM1,
+        ERDP_TIM2,
+        ERDP_TIM3,
+        ERDP_TIM4,
+        ERDP_TIM5,
+        ERDP_TIM6,
+        ERDP_TIM7,
+        ERDP_TIM8,
+        ERDP_TIM9,
+        ERDP_TIM10,
+        ERDP_TIM11,
+        ERDP_TIM12,
+        ERDP_TIM13,
+        ERDP_TIM14,
+        ERDP_TIM_NUM, // Maximum number of timers
+    } ERDP_Tim_t;
+
+    typedef enum
+    {
+        ERDP_TIM_CH1 = 0,
+        ERDP_TIM_CH2,
+        ERDP_TIM_CH3,
+        ERDP_TIM_CH4,
+        ERDP_TIM_CH_NUM,
+    } ERDP_TimChannel_t;
+
+    /* Timer events, usable as interrupt source, DMA request source and status flag */
+    typedef enum
+    {
+        ERDP_TIM_EVENT_UPDATE = 0, // Counter overflow/underflow
+        ERDP_TIM_EVENT_CC1,        // Capture/compare channel 1
+        ERDP_TIM_EVENT_CC2,        // Capture/compare channel 2
+        ERDP_TIM_EVENT_CC3,        // Capture/compare channel 3
+        ERDP_TIM_EVENT_CC4,        // Capture/compare channel 4
+        ERDP_TIM_EVENT_NUM,
+    } ERDP_TimEvent_t;
+
+#define ERDP_TIM_EVENT_MASK(event) ((uint32_t)1 << (event))
+#define ERDP_TIM_EVENT_CC(channel) ((ERDP_TimEvent_t)(ERDP_TIM_EVENT_CC1 + (channel)))
+
+    typedef enum
+    {
+        ERDP_TIM_EDGE_RISING = 0, // Capture on rising edge
+        ERDP_TIM_EDGE_FALLING,    // Capture on falling edge
+        ERDP_TIM_EDGE_BOTH,       // Capture on both edges
+    } ERDP_TimEdge_t;
+
+    /**
+     * @brief  Get the SOC timer base address for a given ERDP timer.
+     * @param[in]  tim: The ERDP timer.
+     * @return  The base address of the SOC timer.
+     */
+    uint32_t erdp_if_tim_get_base(ERDP_Tim_t tim);
+
+    /**
+     * @brief  Get the counter clock of a timer before the prescaler.
+     * @param[in]  tim: The ERDP timer.
+     * @return  Timer kernel clock in Hz (twice the APB clock when the APB prescaler is not 1).
+     */
+    uint32_t erdp_if_tim_get_clock(ERDP_Tim_t tim);
+
+    /**
+     * @brief  Check if a timer has a 32 bit counter.
+     * @param[in]  tim: The ERDP timer.
+     * @return  true for TIM2 and TIM5, false otherwise.
+     */
+    bool erdp_if_tim_is_32bit(ERDP_Tim_t tim);
+
+    /**
+     * @brief Initialize timer channel GPIO pin
+     * @param[in] tim Timer owning the pin
+     * @param[in] port GPIO port of the channel pin
+     * @param[in] pin GPIO pin of the channel pin
+     */
+    void erdp_if_tim_gpio_init(ERDP_Tim_t tim, ERDP_GpioPort_t port, ERDP_GpioPin_t pin);
+
+    /**
+     * @brief Initialize the time base of a timer (up counting)
+     * @param[in] tim Timer identifier
+     * @param[in] prescaler Prescaler value, the counter runs at clock / (prescaler + 1)
+     * @param[in] period Auto-reload value, the counter wraps after period + 1 ticks
+     * @param[in] one_pulse true to stop the counter at the next update event
+     * @param[in] priority Preemption priority of the timer interrupts
+     * @note The timer is left disabled, all interrupts masked and pending flags cleared
+     */
+    void erdp_if_tim_base_init(ERDP_Tim_t tim, uint32_t prescaler, uint32_t period, bool one_pulse, uint8_t priority);
+
+    /**
+     * @brief Disable a timer and reset its registers
+     * @param[in] tim Timer identifier
+     */
+    void erdp_if_tim_deinit(ERDP_Tim_t tim);
+
+    /**
+     * @brief Enable or disable the timer counter
+     * @param[in] tim Timer identifier
+     * @param[in] enable true to start counting, false to stop
+     */
+    void erdp_if_tim_enable(ERDP_Tim_t tim, bool enable);
+
+    /**
+     * @brief Change prescaler and period, the new values are applied immediately
+     * @param[in] tim Timer identifier
+     * @param[in] prescaler Prescaler value
+     * @param[in] period Auto-reload value
+     */
+    void erdp_if_tim_set_timebase(ERDP_Tim_t tim, uint32_t prescaler, uint32_t period);
+
+    /**
+     * @brief Select the update event as trigger output (TRGO), used to pace ADC and DAC conversions
+     * @param[in] tim Timer identifier
+     * @param[in] enable true to output update events, false to restore the reset source
+     */
+    void erdp_if_tim_trgo_update(ERDP_Tim_t tim, bool enable);
+
+    /**
+     * @brief Set the auto-reload value, applied at the next update event
+     * @param[in] tim Timer identifier
+     * @param[in] period Auto-reload value
+     */
+    void erdp_if_tim_set_period(ERDP_Tim_t tim, uint32_t period);
+
+    /**
+     * @brief Set the counter value
+     * @param[in] tim Timer identifier
+     * @param[in] counter New counter value
+     */
+    void erdp_if_tim_set_counter(ERDP_Tim_t tim, uint32_t counter);
+
+    /**
+     * @brief Get the counter value
+     * @param[in] tim Timer identifier
+     * @return Current counter value
+     */
+    uint32_t erdp_if_tim_get_counter(ERDP_Tim_t tim);
+
+    /**
+     * @brief Enable or disable timer interrupts
+     * @param[in] tim Timer identifier
+     * @param[in] event_mask Bitwise OR of ERDP_TIM_EVENT_MASK()
+     * @param[in] enable true to enable, false to disable
+     */
+    void erdp_if_tim_irq_enable(ERDP_Tim_t tim, uint32_t event_mask, bool enable);
+
+    /**
+     * @brief Get the pending and enabled timer interrupts
+     * @param[in] tim Timer identifier
+     * @return Bitwise OR of ERDP_TIM_EVENT_MASK() of the pending interrupts
+     */
+    uint32_t erdp_if_tim_get_irq_status(ERDP_Tim_t tim);
+
+    /**
+     * @brief Get the raw event flags of a timer, whether their interrupt is enabled or not
+     * @param[in] tim Timer identifier
+     * @return Bitwise OR of ERDP_TIM_EVENT_MASK() of the set flags
+     */
+    uint32_t erdp_if_tim_get_flags(ERDP_Tim_t tim);
+
+    /**
+     * @brief Clear timer event flags
+     * @param[in] tim Timer identifier
+     * @param[in] event_mask Bitwise OR of ERDP_TIM_EVENT_MASK()
+     */
+    void erdp_if_tim_clear_flags(ERDP_Tim_t tim, uint32_t event_mask);
+
+    /**
+     * @brief Configure a channel in input capture mode
+     * @param[in] tim Timer identifier
+     * @param[in] channel Timer channel
+     * @param[in] edge Active edge
+     * @param[in] filter Input filter (0..15)
+     */
+    void erdp_if_tim_ic_init(ERDP_Tim_t tim, ERDP_TimChannel_t channel, ERDP_TimEdge_t edge, uint8_t filter);
+
+    /**
+     * @brief Get the last captured value of a channel
+     * @param[in] tim Timer identifier
+     * @param[in] channel Timer channel
+     * @return Capture register value
+     */
+    uint32_t erdp_if_tim_get_capture(ERDP_Tim_t tim, ERDP_TimChannel_t channel);
+
+    /**
+     * @brief Set the input capture prescaler of a channel
+     * @param[in] tim Timer identifier
+     * @param[in] channel Timer channel
+     * @param[in] edges Active edges per capture: 1, 2, 4 or 8
+     */
+    void erdp_if_tim_ic_prescaler(ERDP_Tim_t tim, ERDP_TimChannel_t channel, uint8_t edges);
+
+    /**
+     * @brief Configure a timer in quadrature encoder mode (x4, counting on both TI1 and TI2 edges)
+     * @param[in] tim Timer identifier, TIM1..TIM5 or TIM8
+     * @param[in] filter Input filter of both channels (0..15)
+     * @param[in] invert true to reverse the counting direction
+     * @note Call after erdp_if_tim_base_init(), the prescaler must be 0
+     */
+    void erdp_if_tim_encoder_init(ERDP_Tim_t tim, uint8_t filter, bool invert);
+
+    /**
+     * @brief Configure a channel in PWM mode 1 with preloaded compare register
+     * @param[in] tim Timer identifier
+     * @param[in] channel Timer channel
+     * @param[in] pulse Initial compare value
+     * @param[in] active_high true for active high output, false for active low
+     */
+    void erdp_if_tim_pwm_init(ERDP_Tim_t tim, ERDP_TimChannel_t channel, uint32_t pulse, bool active_high);
+
+    /**
+     * @brief Set the compare value of a channel
+     * @param[in] tim Timer identifier
+     * @param[in] channel Timer channel
+     * @param[in] value Compare value
+     */
+    void erdp_if_tim_set_compare(ERDP_Tim_t tim, ERDP_TimChannel_t channel, uint32_t value);
+
+    /**
+     * @brief Get the address of a capture/compare register, used as DMA peripheral address
+     * @param[in] tim Timer identifier
+     * @param[in] channel Timer channel
+     * @return Address of CCRx
+     */
+    uint32_t erdp_if_tim_get_ccr_addr(ERDP_Tim_t tim, ERDP_TimChannel_t channel);
+
+    /**
+     * @brief Enable or disable a timer DMA request
+     * @param[in] tim Timer identifier
+     * @param[in] event Event generating the request
+     * @param[in] enable true to enable, false to disable
+     */
+    void erdp_if_tim_dma_enable(ERDP_Tim_t tim, ERDP_TimEvent_t event, bool enable);
+
+    /**
+     * @brief Configure DMA burst mode, each request transfers @p length registers through DMAR
+     * @param[in] tim Timer identifier
+     * @param[in] first_channel First compare register of the burst
+     * @param[in] length Number of consecutive compare registers (1..4)
+     * @return Address of the DMAR register, used as DMA peripheral address
+     */
+    uint32_t erdp_if_tim_dma_burst_config(ERDP_Tim_t tim, ERDP_TimChannel_t first_channel, uint8_t length);
+
+    /**
+     * @brief Get the DMA request of a timer event
+     * @param[in] tim Timer identifier
+     * @param[in] event Event generating the request
+     * @return DMA request, ERDP_DMA_REQ_NONE if the event has none on this device
+     */
+    ERDP_DmaRequest_t erdp_if_tim_get_dma_request(ERDP_Tim_t tim, ERDP_TimEvent_t event);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // __ERDP_IF_TIM_H__
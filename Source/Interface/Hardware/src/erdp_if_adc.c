@@ -0,0 +1,250 @@
+/* erdp include */
+#include "erdp_if_adc.h"
+
+/* platform include */
+#include "stm32f4xx.h"
+#include "stm32f4xx_adc.h"
+#include "stm32f4xx_gpio.h"
+#include "stm32f4xx_rcc.h"
+
+extern void erdp_adc_irq_handler(ERDP_Adc_t adc);
+
+/* ADC clock must not exceed 36MHz */
+#define ADC_CLOCK_MAX 36000000U
+
+const static uint32_t adc_instance[ERDP_ADC_NUM] = {
+    0,
+    (uint32_t)ADC1,
+    (uint32_t)ADC2,
+    (uint32_t)ADC3,
+};
+
+const static uint32_t adc_pclk[ERDP_ADC_NUM] = {
+    0,
+    RCC_APB2Periph_ADC1,
+    RCC_APB2Periph_ADC2,
+    RCC_APB2Periph_ADC3,
+};
+
+const static ERDP_DmaRequest_t adc_dma_request[ERDP_ADC_NUM] = {
+    ERDP_DMA_REQ_NONE,
+    ERDP_DMA_REQ_ADC1,
+    ERDP_DMA_REQ_ADC2,
+    ERDP_DMA_REQ_ADC3,
+};
+
+const static uint32_t adc_trigger[ERDP_ADC_TRIG_NUM] = {
+    0,
+    ADC_ExternalTrigConv_T1_CC1,
+    ADC_ExternalTrigConv_T1_CC2,
+    ADC_ExternalTrigConv_T1_CC3,
+    ADC_ExternalTrigConv_T2_CC2,
+    ADC_ExternalTrigConv_T2_CC3,
+    ADC_ExternalTrigConv_T2_CC4,
+    ADC_ExternalTrigConv_T2_TRGO,
+    ADC_ExternalTrigConv_T3_CC1,
+    ADC_ExternalTrigConv_T3_TRGO,
+    ADC_ExternalTrigConv_T4_CC4,
+    ADC_ExternalTrigConv_T5_CC1,
+    ADC_ExternalTrigConv_T5_CC2,
+    ADC_ExternalTrigConv_T5_CC3,
+    ADC_ExternalTrigConv_T8_CC1,
+    ADC_ExternalTrigConv_T8_TRGO,
+};
+
+const static uint32_t adc_resolution[] = {
+    ADC_Resolution_12b,
+    ADC_Resolution_10b,
+    ADC_Resolution_8b,
+    ADC_Resolution_6b,
+};
+
+const static uint8_t adc_sample_time[] = {
+    ADC_SampleTime_3Cycles,
+    ADC_SampleTime_15Cycles,
+    ADC_SampleTime_28Cycles,
+    ADC_SampleTime_56Cycles,
+    ADC_SampleTime_84Cycles,
+    ADC_SampleTime_112Cycles,
+    ADC_SampleTime_144Cycles,
+    ADC_SampleTime_480Cycles,
+};
+
+const static uint32_t adc_mode[] = {
+    ADC_Mode_Independent,
+    ADC_DualMode_Interl,
+    ADC_TripleMode_Interl,
+};
+
+void erdp_if_adc_gpio_init(ERDP_GpioPort_t port, ERDP_GpioPin_t pin)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+
+    RCC_AHB1PeriphClockCmd(erdp_if_gpio_get_PCLK(port), ENABLE);
+    GPIO_InitStructure.GPIO_Pin = erdp_if_gpio_get_pin(pin);
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AN;
+    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_NOPULL;
+    GPIO_Init((GPIO_TypeDef *)erdp_if_gpio_get_port(port), &GPIO_InitStructure);
+}
+
+void erdp_if_adc_common_init(ERDP_AdcMode_t mode, uint8_t sampling_delay)
+{
+    ADC_CommonInitTypeDef ADC_CommonInitStructure;
+    RCC_ClocksTypeDef clocks;
+    uint32_t div;
+
+    RCC_GetClocksFreq(&clocks);
+    for (div = 2; div < 8 && clocks.PCLK2_Frequency / div > ADC_CLOCK_MAX; div += 2)
+    {
+    }
+    if (sampling_delay < 5)
+    {
+        sampling_delay = 5;
+    }
+    else if (sampling_delay > 20)
+    {
+        sampling_delay = 20;
+    }
+
+    /* Every ADC shares the common registers, so the clock of ADC1 is always needed */
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_ADC1, ENABLE);
+    ADC_CommonInitStructure.ADC_Mode = adc_mode[mode];
+    ADC_CommonInitStructure.ADC_Prescaler = ((div / 2) - 1) << 16;    // ADC_Prescaler_DivN
+    /* Mode 2 packs two 12 bit results per word: ADC1/ADC2 (dual), ADC1/ADC2, ADC3/ADC1, ADC2/ADC3 (triple) */
+    ADC_CommonInitStructure.ADC_DMAAccessMode =
+        (mode == ERDP_ADC_MODE_INDEPENDENT) ? ADC_DMAAccessMode_Disabled : ADC_DMAAccessMode_2;
+    ADC_CommonInitStructure.ADC_TwoSamplingDelay = (uint32_t)(sampling_delay - 5) << 8;
+    ADC_CommonInit(&ADC_CommonInitStructure);
+}
+
+static void adc_init(ERDP_Adc_t adc, ERDP_AdcResolution_t resolution, bool continuous, bool external,
+                     uint32_t external_trigger)
+{
+    ADC_InitTypeDef ADC_InitStructure;
+    ADC_TypeDef *adc_periph = (ADC_TypeDef *)adc_instance[adc];
+
+    RCC_APB2PeriphClockCmd(adc_pclk[adc], ENABLE);
+    ADC_Cmd(adc_periph, DISABLE);
+
+    ADC_StructInit(&ADC_InitStructure);
+    ADC_InitStructure.ADC_Resolution = adc_resolution[resolution];
+    ADC_InitStructure.ADC_ScanConvMode = ENABLE;
+    ADC_InitStructure.ADC_ContinuousConvMode = continuous ? ENABLE : DISABLE;
+    ADC_InitStructure.ADC_ExternalTrigConvEdge = external ? ADC_ExternalTrigConvEdge_Rising : ADC_ExternalTrigConvEdge_None;
+    ADC_InitStructure.ADC_ExternalTrigConv = external_trigger;
+    ADC_InitStructure.ADC_DataAlign = ADC_DataAlign_Right;
+    ADC_InitStructure.ADC_NbrOfConversion = 1;
+    ADC_Init(adc_periph, &ADC_InitStructure);
+    adc_periph->SR = 0;
+}
+
+void erdp_if_adc_init(ERDP_Adc_t adc, ERDP_AdcResolution_t resolution, ERDP_AdcTrigger_t trigger)
+{
+    bool software = (trigger == ERDP_ADC_TRIG_SOFTWARE);
+    adc_init(adc, resolution, software, !software, adc_trigger[trigger]);
+}
+
+void erdp_if_adc_slave_init(ERDP_Adc_t adc, ERDP_AdcResolution_t resolution, bool continuous)
+{
+    /* In multi ADC mode the master conversions start the slaves, their own trigger stays off */
+    adc_init(adc, resolution, continuous, false, adc_trigger[ERDP_ADC_TRIG_SOFTWARE]);
+}
+
+void erdp_if_adc_deinit(void)
+{
+    ADC_DeInit();
+}
+
+void erdp_if_adc_set_sequence(ERDP_Adc_t adc, const uint8_t *channels, uint8_t count,
+                              ERDP_AdcSampleTime_t sample_time)
+{
+    ADC_TypeDef *adc_periph = (ADC_TypeDef *)adc_instance[adc];
+    uint8_t i;
+
+    if (count > ERDP_ADC_MAX_SEQUENCE)
+    {
+        count = ERDP_ADC_MAX_SEQUENCE;
+    }
+    for (i = 0; i < count; i++)
+    {
+        ADC_RegularChannelConfig(adc_periph, channels[i], i + 1, adc_sample_time[sample_time]);
+    }
+    adc_periph->SQR1 = (adc_periph->SQR1 & ~ADC_SQR1_L) | ((uint32_t)(count - 1) << 20);
+}
+
+void erdp_if_adc_dma_enable(ERDP_Adc_t adc, ERDP_AdcMode_t mode, bool enable)
+{
+    ADC_TypeDef *adc_periph = (ADC_TypeDef *)adc_instance[adc];
+
+    if (mode == ERDP_ADC_MODE_INDEPENDENT)
+    {
+        ADC_DMARequestAfterLastTransferCmd(adc_periph, enable ? ENABLE : DISABLE);
+        ADC_DMACmd(adc_periph, enable ? ENABLE : DISABLE);
+    }
+    else
+    {
+        ADC_MultiModeDMARequestAfterLastTransferCmd(enable ? ENABLE : DISABLE);
+    }
+}
+
+void erdp_if_adc_enable(ERDP_Adc_t adc, bool enable)
+{
+    ADC_Cmd((ADC_TypeDef *)adc_instance[adc], enable ? ENABLE : DISABLE);
+}
+
+void erdp_if_adc_software_start(ERDP_Adc_t adc)
+{
+    ADC_SoftwareStartConv((ADC_TypeDef *)adc_instance[adc]);
+}
+
+uint32_t erdp_if_adc_get_data_addr(ERDP_Adc_t adc, ERDP_AdcMode_t mode)
+{
+    if (mode != ERDP_ADC_MODE_INDEPENDENT)
+    {
+        return (uint32_t)(&ADC->CDR);
+    }
+    return (uint32_t)(&((ADC_TypeDef *)adc_instance[adc])->DR);
+}
+
+void erdp_if_adc_overrun_irq_enable(ERDP_Adc_t adc, uint8_t priority, bool enable)
+{
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    ADC_ITConfig((ADC_TypeDef *)adc_instance[adc], ADC_IT_OVR, enable ? ENABLE : DISABLE);
+    if (enable)
+    {
+        NVIC_InitStructure.NVIC_IRQChannel = ADC_IRQn;
+        NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = priority;
+        NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+        NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+        NVIC_Init(&NVIC_InitStructure);
+    }
+}
+
+bool erdp_if_adc_clear_overrun(ERDP_Adc_t adc)
+{
+    ADC_TypeDef *adc_periph = (ADC_TypeDef *)adc_instance[adc];
+    if (adc_periph->SR & ADC_SR_OVR)
+    {
+        adc_periph->SR = ~ADC_SR_OVR;
+        return true;
+    }
+    return false;
+}
+
+ERDP_DmaRequest_t erdp_if_adc_get_dma_request(ERDP_Adc_t adc)
+{
+    if (adc >= ERDP_ADC_NUM)
+    {
+        return ERDP_DMA_REQ_NONE;
+    }
+    return adc_dma_request[adc];
+}
+
+/* ADC1, ADC2 and ADC3 share one vector */
+void ADC_IRQHandler(void)
+{
+    erdp_adc_irq_handler(ERDP_ADC1);
+    erdp_adc_irq_handler(ERDP_ADC2);
+    erdp_adc_irq_handler(ERDP_ADC3);
+}
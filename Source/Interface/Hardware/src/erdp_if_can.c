@@ -0,0 +1,316 @@
+/* erdp include */
+#include "erdp_if_can.h"
+
+/* platform include */
+#include "stm32f4xx.h"
+#include "stm32f4xx_can.h"
+#include "stm32f4xx_gpio.h"
+#include "stm32f4xx_rcc.h"
+
+extern void erdp_can_tx_irq_handler(ERDP_Can_t can);
+extern void erdp_can_rx_irq_handler(ERDP_Can_t can, uint8_t fifo);
+extern void erdp_can_sce_irq_handler(ERDP_Can_t can);
+
+#define CAN_TQ_MIN 8U
+#define CAN_TQ_MAX 18U /* Keeps BS1 within 16 quanta at 87.5% */
+
+const static uint32_t can_instance[ERDP_CAN_NUM] = {
+    0,
+    (uint32_t)CAN1,
+    (uint32_t)CAN2,
+};
+
+const static uint32_t can_pclk[ERDP_CAN_NUM] = {
+    0,
+    RCC_APB1Periph_CAN1,
+    RCC_APB1Periph_CAN2,
+};
+
+const static uint8_t can_af[ERDP_CAN_NUM] = {
+    0,
+    GPIO_AF_CAN1,
+    GPIO_AF_CAN2,
+};
+
+/* {TX, RX0, RX1, SCE} */
+const static uint8_t can_irq[ERDP_CAN_NUM][4] = {
+    {0, 0, 0, 0},
+    {CAN1_TX_IRQn, CAN1_RX0_IRQn, CAN1_RX1_IRQn, CAN1_SCE_IRQn},
+    {CAN2_TX_IRQn, CAN2_RX0_IRQn, CAN2_RX1_IRQn, CAN2_SCE_IRQn},
+};
+
+const static uint32_t can_tsr_tme[ERDP_CAN_MAILBOX_NUM] = {CAN_TSR_TME0, CAN_TSR_TME1, CAN_TSR_TME2};
+const static uint32_t can_tsr_rqcp[ERDP_CAN_MAILBOX_NUM] = {CAN_TSR_RQCP0, CAN_TSR_RQCP1, CAN_TSR_RQCP2};
+const static uint32_t can_tsr_txok[ERDP_CAN_MAILBOX_NUM] = {CAN_TSR_TXOK0, CAN_TSR_TXOK1, CAN_TSR_TXOK2};
+
+static void erdp_if_can_pin_init(ERDP_Can_t can, ERDP_GpioPort_t port, ERDP_GpioPin_t pin)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+
+    RCC_AHB1PeriphClockCmd(erdp_if_gpio_get_PCLK(port), ENABLE);
+    GPIO_PinAFConfig((GPIO_TypeDef *)erdp_if_gpio_get_port(port), pin, can_af[can]);
+    GPIO_InitStructure.GPIO_Pin = erdp_if_gpio_get_pin(pin);
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;
+    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;
+    GPIO_Init((GPIO_TypeDef *)erdp_if_gpio_get_port(port), &GPIO_InitStructure);
+}
+
+void erdp_if_can_gpio_init(ERDP_Can_t can, const ERDP_CanPins_t *pins)
+{
+    erdp_if_can_pin_init(can, pins->tx_port, pins->tx_pin);
+    erdp_if_can_pin_init(can, pins->rx_port, pins->rx_pin);
+}
+
+bool erdp_if_can_init(ERDP_Can_t can, uint32_t bitrate, ERDP_CanMode_t mode)
+{
+    CAN_InitTypeDef CAN_InitStructure;
+    RCC_ClocksTypeDef clocks;
+    uint32_t tq;
+
+    RCC_GetClocksFreq(&clocks);
+    /* Most time quanta first for the finest sample point */
+    for (tq = CAN_TQ_MAX; tq >= CAN_TQ_MIN; tq--)
+    {
+        if (clocks.PCLK1_Frequency % (bitrate * tq) == 0 && clocks.PCLK1_Frequency / (bitrate * tq) <= 1024)
+        {
+            break;
+        }
+    }
+    if (tq < CAN_TQ_MIN)
+    {
+        return false;
+    }
+
+    /* Sample point at 87.5%: sync + bs1 = 7/8 of the bit */
+    uint32_t bs1 = (tq * 7 + 4) / 8 - 1;
+    uint32_t bs2 = tq - 1 - bs1;
+
+    /* Filters belong to CAN1, CAN2 needs its clock as well */
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_CAN1 | can_pclk[can], ENABLE);
+    CAN_DeInit((CAN_TypeDef *)can_instance[can]);
+
+    CAN_StructInit(&CAN_InitStructure);
+    CAN_InitStructure.CAN_TTCM = ENABLE;
+    CAN_InitStructure.CAN_ABOM = ENABLE;
+    CAN_InitStructure.CAN_AWUM = ENABLE;
+    CAN_InitStructure.CAN_NART = DISABLE;
+    CAN_InitStructure.CAN_RFLM = DISABLE;
+    CAN_InitStructure.CAN_TXFP = ENABLE;
+    CAN_InitStructure.CAN_Mode = (uint8_t)mode;
+    CAN_InitStructure.CAN_SJW = CAN_SJW_1tq;
+    CAN_InitStructure.CAN_BS1 = (uint8_t)(bs1 - 1);
+    CAN_InitStructure.CAN_BS2 = (uint8_t)(bs2 - 1);
+    CAN_InitStructure.CAN_Prescaler = (uint16_t)(clocks.PCLK1_Frequency / (bitrate * tq));
+    return CAN_Init((CAN_TypeDef *)can_instance[can], &CAN_InitStructure) == CAN_InitStatus_Success;
+}
+
+void erdp_if_can_deinit(ERDP_Can_t can)
+{
+    erdp_if_can_irq_enable(can, 0, false);
+    CAN_DeInit((CAN_TypeDef *)can_instance[can]);
+}
+
+void erdp_if_can_irq_enable(ERDP_Can_t can, uint8_t priority, bool enable)
+{
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    CAN_ITConfig((CAN_TypeDef *)can_instance[can],
+                 CAN_IT_TME | CAN_IT_FMP0 | CAN_IT_FOV0 | CAN_IT_FMP1 | CAN_IT_FOV1 | CAN_IT_EWG | CAN_IT_EPV |
+                     CAN_IT_BOF | CAN_IT_LEC | CAN_IT_ERR,
+                 enable ? ENABLE : DISABLE);
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        NVIC_InitStructure.NVIC_IRQChannel = can_irq[can][i];
+        NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = priority;
+        NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+        NVIC_InitStructure.NVIC_IRQChannelCmd = enable ? ENABLE : DISABLE;
+        NVIC_Init(&NVIC_InitStructure);
+    }
+}
+
+void erdp_if_can_filter_split(uint8_t can2_start_bank)
+{
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_CAN1, ENABLE);
+    CAN_SlaveStartBank(can2_start_bank);
+}
+
+void erdp_if_can_filter_config(uint8_t bank, ERDP_CanFilterMode_t mode, ERDP_CanFilterScale_t scale,
+                               uint8_t fifo, uint32_t fr1, uint32_t fr2, bool enable)
+{
+    CAN_FilterInitTypeDef CAN_FilterInitStructure;
+
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_CAN1, ENABLE);
+    CAN_FilterInitStructure.CAN_FilterNumber = bank;
+    CAN_FilterInitStructure.CAN_FilterMode = (mode == ERDP_CAN_FILTER_LIST) ? CAN_FilterMode_IdList
+                                                                            : CAN_FilterMode_IdMask;
+    CAN_FilterInitStructure.CAN_FilterScale = (scale == ERDP_CAN_FILTER_32BIT) ? CAN_FilterScale_32bit
+                                                                               : CAN_FilterScale_16bit;
+    CAN_FilterInitStructure.CAN_FilterIdHigh = (uint16_t)(fr1 >> 16);
+    CAN_FilterInitStructure.CAN_FilterIdLow = (uint16_t)fr1;
+    CAN_FilterInitStructure.CAN_FilterMaskIdHigh = (uint16_t)(fr2 >> 16);
+    CAN_FilterInitStructure.CAN_FilterMaskIdLow = (uint16_t)fr2;
+    CAN_FilterInitStructure.CAN_FilterFIFOAssignment = fifo ? CAN_Filter_FIFO1 : CAN_Filter_FIFO0;
+    CAN_FilterInitStructure.CAN_FilterActivation = enable ? ENABLE : DISABLE;
+    CAN_FilterInit(&CAN_FilterInitStructure);
+}
+
+uint8_t erdp_if_can_tx_free(ERDP_Can_t can)
+{
+    uint32_t tsr = ((CAN_TypeDef *)can_instance[can])->TSR;
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < ERDP_CAN_MAILBOX_NUM; i++)
+    {
+        if (tsr & can_tsr_tme[i])
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+uint8_t erdp_if_can_transmit(ERDP_Can_t can, const ERDP_CanFrame_t *frame)
+{
+    CAN_TypeDef *can_periph = (CAN_TypeDef *)can_instance[can];
+    uint32_t tsr = can_periph->TSR;
+    uint8_t mailbox;
+
+    for (mailbox = 0; mailbox < ERDP_CAN_MAILBOX_NUM; mailbox++)
+    {
+        if (tsr & can_tsr_tme[mailbox])
+        {
+            break;
+        }
+    }
+    if (mailbox == ERDP_CAN_MAILBOX_NUM)
+    {
+        return ERDP_CAN_NO_MAILBOX;
+    }
+
+    CAN_TxMailBox_TypeDef *box = &can_periph->sTxMailBox[mailbox];
+    uint32_t tir = frame->ext ? ((frame->id << 3) | CAN_Id_Extended) : (frame->id << 21);
+    if (frame->rtr)
+    {
+        tir |= CAN_RTR_Remote;
+    }
+    box->TDTR = (box->TDTR & ~(uint32_t)CAN_TDT0R_DLC) | (frame->dlc & 0x0FU);
+    box->TDLR = (uint32_t)frame->data[0] | ((uint32_t)frame->data[1] << 8) | ((uint32_t)frame->data[2] << 16) |
+                ((uint32_t)frame->data[3] << 24);
+    box->TDHR = (uint32_t)frame->data[4] | ((uint32_t)frame->data[5] << 8) | ((uint32_t)frame->data[6] << 16) |
+                ((uint32_t)frame->data[7] << 24);
+    box->TIR = tir | CAN_TI0R_TXRQ;
+    return mailbox;
+}
+
+void erdp_if_can_tx_abort(ERDP_Can_t can)
+{
+    ((CAN_TypeDef *)can_instance[can])->TSR = CAN_TSR_ABRQ0 | CAN_TSR_ABRQ1 | CAN_TSR_ABRQ2;
+}
+
+uint8_t erdp_if_can_tx_complete(ERDP_Can_t can, uint8_t *ok_mask)
+{
+    CAN_TypeDef *can_periph = (CAN_TypeDef *)can_instance[can];
+    uint32_t tsr = can_periph->TSR;
+    uint32_t clear = 0;
+    uint8_t done = 0;
+
+    *ok_mask = 0;
+    for (uint8_t i = 0; i < ERDP_CAN_MAILBOX_NUM; i++)
+    {
+        if (tsr & can_tsr_rqcp[i])
+        {
+            done |= (uint8_t)(1U << i);
+            clear |= can_tsr_rqcp[i];
+            if (tsr & can_tsr_txok[i])
+            {
+                *ok_mask |= (uint8_t)(1U << i);
+            }
+        }
+    }
+    /* Writing RQCP also clears TXOK, ALST and TERR of the mailbox */
+    can_periph->TSR = clear;
+    return done;
+}
+
+uint8_t erdp_if_can_rx_pending(ERDP_Can_t can, uint8_t fifo)
+{
+    CAN_TypeDef *can_periph = (CAN_TypeDef *)can_instance[can];
+    return (uint8_t)((fifo ? can_periph->RF1R : can_periph->RF0R) & CAN_RF0R_FMP0);
+}
+
+void erdp_if_can_receive(ERDP_Can_t can, uint8_t fifo, ERDP_CanFrame_t *frame)
+{
+    CAN_TypeDef *can_periph = (CAN_TypeDef *)can_instance[can];
+    CAN_FIFOMailBox_TypeDef *box = &can_periph->sFIFOMailBox[fifo];
+    uint32_t rir = box->RIR;
+    uint32_t rdtr = box->RDTR;
+    uint32_t rdlr = box->RDLR;
+    uint32_t rdhr = box->RDHR;
+
+    frame->ext = (rir & CAN_Id_Extended) != 0;
+    frame->rtr = (rir & CAN_RTR_Remote) != 0;
+    frame->id = frame->ext ? (rir >> 3) : (rir >> 21);
+    frame->dlc = (uint8_t)(rdtr & CAN_RDT0R_DLC);
+    frame->filter = (uint8_t)((rdtr & CAN_RDT0R_FMI) >> 8);
+    frame->time = (uint16_t)(rdtr >> 16);
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        frame->data[i] = (uint8_t)(rdlr >> (8 * i));
+        frame->data[4 + i] = (uint8_t)(rdhr >> (8 * i));
+    }
+
+    if (fifo)
+    {
+        can_periph->RF1R |= CAN_RF1R_RFOM1;
+    }
+    else
+    {
+        can_periph->RF0R |= CAN_RF0R_RFOM0;
+    }
+}
+
+bool erdp_if_can_rx_overrun(ERDP_Can_t can, uint8_t fifo)
+{
+    CAN_TypeDef *can_periph = (CAN_TypeDef *)can_instance[can];
+    volatile uint32_t *rfr = fifo ? &can_periph->RF1R : &can_periph->RF0R;
+
+    if (*rfr & CAN_RF0R_FOVR0)
+    {
+        *rfr = CAN_RF0R_FOVR0 | CAN_RF0R_FULL0;
+        return true;
+    }
+    return false;
+}
+
+void erdp_if_can_get_error(ERDP_Can_t can, ERDP_CanError_t *error)
+{
+    CAN_TypeDef *can_periph = (CAN_TypeDef *)can_instance[can];
+    uint32_t esr = can_periph->ESR;
+
+    error->tec = (uint8_t)((esr & CAN_ESR_TEC) >> 16);
+    error->rec = (uint8_t)((esr & CAN_ESR_REC) >> 24);
+    error->lec = (uint8_t)((esr & CAN_ESR_LEC) >> 4);
+    error->warning = (esr & CAN_ESR_EWGF) != 0;
+    error->passive = (esr & CAN_ESR_EPVF) != 0;
+    error->bus_off = (esr & CAN_ESR_BOFF) != 0;
+}
+
+void erdp_if_can_clear_error(ERDP_Can_t can)
+{
+    CAN_TypeDef *can_periph = (CAN_TypeDef *)can_instance[can];
+
+    /* Reset LEC so the next error code is seen as new, then acknowledge the interrupt */
+    can_periph->ESR = (can_periph->ESR & ~CAN_ESR_LEC) | CAN_ErrorCode_SoftwareSetErr;
+    can_periph->MSR = CAN_MSR_ERRI;
+}
+
+void CAN1_TX_IRQHandler(void) { erdp_can_tx_irq_handler(ERDP_CAN1); }
+void CAN1_RX0_IRQHandler(void) { erdp_can_rx_irq_handler(ERDP_CAN1, 0); }
+void CAN1_RX1_IRQHandler(void) { erdp_can_rx_irq_handler(ERDP_CAN1, 1); }
+void CAN1_SCE_IRQHandler(void) { erdp_can_sce_irq_handler(ERDP_CAN1); }
+void CAN2_TX_IRQHandler(void) { erdp_can_tx_irq_handler(ERDP_CAN2); }
+void CAN2_RX0_IRQHandler(void) { erdp_can_rx_irq_handler(ERDP_CAN2, 0); }
+void CAN2_RX1_IRQHandler(void) { erdp_can_rx_irq_handler(ERDP_CAN2, 1); }
+void CAN2_SCE_IRQHandler(void) { erdp_can_sce_irq_handler(ERDP_CAN2); }
@@ -0,0 +1,80 @@
+/* erdp include */
+#include "erdp_if_crc.h"
+
+/* platform include */
+#include <string.h>
+#include "stm32f4xx.h"
+#include "stm32f4xx_crc.h"
+#include "stm32f4xx_rcc.h"
+
+/* Cortex-M4 loads words from any address, memcpy() compiles to a single LDR */
+static inline uint32_t erdp_if_crc_load(const uint8_t *p)
+{
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+void erdp_if_crc_init(void)
+{
+    RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_CRC, ENABLE);
+    CRC_ResetDR();
+}
+
+void erdp_if_crc_deinit(void)
+{
+    RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_CRC, DISABLE);
+}
+
+void erdp_if_crc_reset(void)
+{
+    CRC_ResetDR();
+}
+
+uint32_t erdp_if_crc_feed(const uint32_t *data, uint32_t count)
+{
+    while (count >= 4)
+    {
+        CRC->DR = data[0];
+        CRC->DR = data[1];
+        CRC->DR = data[2];
+        CRC->DR = data[3];
+        data += 4;
+        count -= 4;
+    }
+    while (count--)
+    {
+        CRC->DR = *data++;
+    }
+    return CRC->DR;
+}
+
+uint32_t erdp_if_crc_feed_reflected(const uint8_t *data, uint32_t words)
+{
+    while (words--)
+    {
+        CRC->DR = __RBIT(erdp_if_crc_load(data));
+        data += 4;
+    }
+    return __RBIT(CRC->DR);
+}
+
+uint32_t erdp_if_crc_feed_swapped(const uint8_t *data, uint32_t words)
+{
+    while (words--)
+    {
+        CRC->DR = __REV(erdp_if_crc_load(data));
+        data += 4;
+    }
+    return CRC->DR;
+}
+
+uint32_t erdp_if_crc_get(void)
+{
+    return CRC->DR;
+}
+
+uint32_t erdp_if_crc_get_data_addr(void)
+{
+    return (uint32_t)(&CRC->DR);
+}
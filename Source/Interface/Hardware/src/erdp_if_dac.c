@@ -0,0 +1,147 @@
+/* erdp include */
+#include "erdp_if_dac.h"
+
+/* platform include */
+#include "stm32f4xx.h"
+#include "stm32f4xx_dac.h"
+#include "stm32f4xx_gpio.h"
+#include "stm32f4xx_rcc.h"
+
+const static uint32_t dac_channel[ERDP_DAC_CH_NUM] = {
+    DAC_Channel_1,
+    DAC_Channel_2,
+};
+
+const static uint16_t dac_pin[ERDP_DAC_CH_NUM] = {
+    GPIO_Pin_4,
+    GPIO_Pin_5,
+};
+
+const static uint32_t dac_underrun_flag[ERDP_DAC_CH_NUM] = {
+    DAC_SR_DMAUDR1,
+    DAC_SR_DMAUDR2,
+};
+
+const static ERDP_DmaRequest_t dac_dma_request[ERDP_DAC_CH_NUM] = {
+    ERDP_DMA_REQ_DAC1,
+    ERDP_DMA_REQ_DAC2,
+};
+
+static bool erdp_if_dac_get_trigger(ERDP_Tim_t tim, uint32_t *trigger)
+{
+    switch (tim)
+    {
+        case ERDP_TIM0:
+            *trigger = DAC_Trigger_None;
+            return true;
+        case ERDP_TIM2:
+            *trigger = DAC_Trigger_T2_TRGO;
+            return true;
+        case ERDP_TIM4:
+            *trigger = DAC_Trigger_T4_TRGO;
+            return true;
+        case ERDP_TIM5:
+            *trigger = DAC_Trigger_T5_TRGO;
+            return true;
+        case ERDP_TIM6:
+            *trigger = DAC_Trigger_T6_TRGO;
+            return true;
+        case ERDP_TIM7:
+            *trigger = DAC_Trigger_T7_TRGO;
+            return true;
+        case ERDP_TIM8:
+            *trigger = DAC_Trigger_T8_TRGO;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool erdp_if_dac_init(ERDP_DacChannel_t channel, ERDP_Tim_t trigger_tim, bool output_buffer)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+    DAC_InitTypeDef DAC_InitStructure;
+    uint32_t trigger;
+
+    if (!erdp_if_dac_get_trigger(trigger_tim, &trigger))
+    {
+        return false;
+    }
+
+    RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_GPIOA, ENABLE);
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_DAC, ENABLE);
+
+    GPIO_InitStructure.GPIO_Pin = dac_pin[channel];
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AN;
+    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_NOPULL;
+    GPIO_Init(GPIOA, &GPIO_InitStructure);
+
+    DAC_Cmd(dac_channel[channel], DISABLE);
+    DAC_StructInit(&DAC_InitStructure);
+    DAC_InitStructure.DAC_Trigger = trigger;
+    DAC_InitStructure.DAC_WaveGeneration = DAC_WaveGeneration_None;
+    DAC_InitStructure.DAC_OutputBuffer = output_buffer ? DAC_OutputBuffer_Enable : DAC_OutputBuffer_Disable;
+    DAC_Init(dac_channel[channel], &DAC_InitStructure);
+    return true;
+}
+
+void erdp_if_dac_deinit(ERDP_DacChannel_t channel)
+{
+    DAC_DMACmd(dac_channel[channel], DISABLE);
+    DAC_ITConfig(dac_channel[channel], DAC_IT_DMAUDR, DISABLE);
+    DAC_Cmd(dac_channel[channel], DISABLE);
+}
+
+void erdp_if_dac_enable(ERDP_DacChannel_t channel, bool enable)
+{
+    DAC_Cmd(dac_channel[channel], enable ? ENABLE : DISABLE);
+}
+
+void erdp_if_dac_set_value(ERDP_DacChannel_t channel, uint16_t value)
+{
+    if (channel == ERDP_DAC_CH1)
+    {
+        DAC_SetChannel1Data(DAC_Align_12b_R, value);
+    }
+    else
+    {
+        DAC_SetChannel2Data(DAC_Align_12b_R, value);
+    }
+}
+
+uint32_t erdp_if_dac_get_data_addr(ERDP_DacChannel_t channel)
+{
+    return (channel == ERDP_DAC_CH1) ? (uint32_t)(&DAC->DHR12R1) : (uint32_t)(&DAC->DHR12R2);
+}
+
+void erdp_if_dac_dma_enable(ERDP_DacChannel_t channel, uint8_t priority, bool enable)
+{
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    DAC->SR = dac_underrun_flag[channel];
+    DAC_ITConfig(dac_channel[channel], DAC_IT_DMAUDR, enable ? ENABLE : DISABLE);
+    DAC_DMACmd(dac_channel[channel], enable ? ENABLE : DISABLE);
+    if (enable)
+    {
+        NVIC_InitStructure.NVIC_IRQChannel = TIM6_DAC_IRQn;
+        NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = priority;
+        NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+        NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+        NVIC_Init(&NVIC_InitStructure);
+    }
+}
+
+bool erdp_if_dac_clear_underrun(ERDP_DacChannel_t channel)
+{
+    if ((DAC->SR & dac_underrun_flag[channel]) && (DAC->CR & (DAC_CR_DMAUDRIE1 << (channel * 16))))
+    {
+        DAC->SR = dac_underrun_flag[channel];    // rc_w1
+        return true;
+    }
+    return false;
+}
+
+ERDP_DmaRequest_t erdp_if_dac_get_dma_request(ERDP_DacChannel_t channel)
+{
+    return dac_dma_request[channel];
+}
@@ -0,0 +1,109 @@
+/* erdp include */
+#include "erdp_if_dcmi.h"
+
+/* platform include */
+#include "stm32f4xx.h"
+#include "stm32f4xx_dcmi.h"
+#include "stm32f4xx_gpio.h"
+#include "stm32f4xx_rcc.h"
+
+extern void erdp_dcmi_irq_handler(void);
+
+const static uint16_t dcmi_rate[] = {
+    DCMI_CaptureRate_All_Frame,
+    DCMI_CaptureRate_1of2_Frame,
+    DCMI_CaptureRate_1of4_Frame,
+};
+
+static void erdp_if_dcmi_pin_init(ERDP_GpioPort_t port, ERDP_GpioPin_t pin)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+
+    RCC_AHB1PeriphClockCmd(erdp_if_gpio_get_PCLK(port), ENABLE);
+    GPIO_PinAFConfig((GPIO_TypeDef *)erdp_if_gpio_get_port(port), pin, GPIO_AF_DCMI);
+    GPIO_InitStructure.GPIO_Pin = erdp_if_gpio_get_pin(pin);
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_100MHz;
+    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;
+    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;
+    GPIO_Init((GPIO_TypeDef *)erdp_if_gpio_get_port(port), &GPIO_InitStructure);
+}
+
+void erdp_if_dcmi_gpio_init(const ERDP_DcmiPins_t *pins)
+{
+    erdp_if_dcmi_pin_init(pins->pixclk_port, pins->pixclk_pin);
+    erdp_if_dcmi_pin_init(pins->hsync_port, pins->hsync_pin);
+    erdp_if_dcmi_pin_init(pins->vsync_port, pins->vsync_pin);
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        erdp_if_dcmi_pin_init(pins->data_port[i], pins->data_pin[i]);
+    }
+}
+
+void erdp_if_dcmi_init(const ERDP_DcmiCfg_t *cfg)
+{
+    DCMI_InitTypeDef DCMI_InitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    RCC_AHB2PeriphClockCmd(RCC_AHB2Periph_DCMI, ENABLE);
+    DCMI_DeInit();
+    DCMI_InitStructure.DCMI_CaptureMode = cfg->snapshot ? DCMI_CaptureMode_SnapShot : DCMI_CaptureMode_Continuous;
+    DCMI_InitStructure.DCMI_SynchroMode = DCMI_SynchroMode_Hardware;
+    DCMI_InitStructure.DCMI_PCKPolarity = cfg->pclk_rising ? DCMI_PCKPolarity_Rising : DCMI_PCKPolarity_Falling;
+    DCMI_InitStructure.DCMI_VSPolarity = cfg->vsync_high ? DCMI_VSPolarity_High : DCMI_VSPolarity_Low;
+    DCMI_InitStructure.DCMI_HSPolarity = cfg->hsync_high ? DCMI_HSPolarity_High : DCMI_HSPolarity_Low;
+    DCMI_InitStructure.DCMI_CaptureRate = dcmi_rate[cfg->rate];
+    DCMI_InitStructure.DCMI_ExtendedDataMode = DCMI_ExtendedDataMode_8b;
+    DCMI_Init(&DCMI_InitStructure);
+
+    DCMI_ClearITPendingBit(DCMI_IT_FRAME | DCMI_IT_OVF | DCMI_IT_ERR | DCMI_IT_VSYNC | DCMI_IT_LINE);
+    DCMI_ITConfig(DCMI_IT_OVF | DCMI_IT_ERR, ENABLE);
+    NVIC_InitStructure.NVIC_IRQChannel = DCMI_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = cfg->priority;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+    DCMI_Cmd(ENABLE);
+}
+
+void erdp_if_dcmi_deinit(void)
+{
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    NVIC_InitStructure.NVIC_IRQChannel = DCMI_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = DISABLE;
+    NVIC_Init(&NVIC_InitStructure);
+    DCMI_CaptureCmd(DISABLE);
+    DCMI_Cmd(DISABLE);
+    DCMI_DeInit();
+}
+
+void erdp_if_dcmi_capture(bool enable)
+{
+    DCMI_CaptureCmd(enable ? ENABLE : DISABLE);
+}
+
+uint32_t erdp_if_dcmi_get_flags(void)
+{
+    uint32_t flags = DCMI->MISR;
+
+    DCMI->ICR = flags;
+    return flags;
+}
+
+uint32_t erdp_if_dcmi_get_data_addr(void)
+{
+    return (uint32_t)(&DCMI->DR);
+}
+
+ERDP_DmaRequest_t erdp_if_dcmi_get_dma_request(void)
+{
+    return ERDP_DMA_REQ_DCMI;
+}
+
+void DCMI_IRQHandler(void)
+{
+    erdp_dcmi_irq_handler();
+}
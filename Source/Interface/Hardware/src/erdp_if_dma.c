@@ -0,0 +1,383 @@
+/* erdp include */
+#include "erdp_if_dma.h"
+
+/* platform include */
+#include "stm32f4xx.h"
+#include "stm32f4xx_dma.h"
+#include "stm32f4xx_rcc.h"
+
+extern void erdp_dma_irq_handler(ERDP_DmaStream_t stream);
+
+const static uint32_t dma_stream_instance[ERDP_DMA_STREAM_NUM] = {
+    (uint32_t)DMA1_Stream0, (uint32_t)DMA1_Stream1, (uint32_t)DMA1_Stream2, (uint32_t)DMA1_Stream3,
+    (uint32_t)DMA1_Stream4, (uint32_t)DMA1_Stream5, (uint32_t)DMA1_Stream6, (uint32_t)DMA1_Stream7,
+    (uint32_t)DMA2_Stream0, (uint32_t)DMA2_Stream1, (uint32_t)DMA2_Stream2, (uint32_t)DMA2_Stream3,
+    (uint32_t)DMA2_Stream4, (uint32_t)DMA2_Stream5, (uint32_t)DMA2_Stream6, (uint32_t)DMA2_Stream7,
+};
+
+const static uint8_t dma_irq_id[ERDP_DMA_STREAM_NUM] = {
+    DMA1_Stream0_IRQn, DMA1_Stream1_IRQn, DMA1_Stream2_IRQn, DMA1_Stream3_IRQn,
+    DMA1_Stream4_IRQn, DMA1_Stream5_IRQn, DMA1_Stream6_IRQn, DMA1_Stream7_IRQn,
+    DMA2_Stream0_IRQn, DMA2_Stream1_IRQn, DMA2_Stream2_IRQn, DMA2_Stream3_IRQn,
+    DMA2_Stream4_IRQn, DMA2_Stream5_IRQn, DMA2_Stream6_IRQn, DMA2_Stream7_IRQn,
+};
+
+/* Bit offset of each stream inside LISR/HISR (streams 0..3 in the low register, 4..7 in the high one) */
+const static uint8_t dma_flag_shift[4] = {0, 6, 16, 22};
+
+const static uint32_t dma_dir[] = {
+    DMA_DIR_PeripheralToMemory,
+    DMA_DIR_MemoryToPeripheral,
+    DMA_DIR_MemoryToMemory,
+};
+
+const static uint32_t dma_periph_width[] = {
+    DMA_PeripheralDataSize_Byte,
+    DMA_PeripheralDataSize_HalfWord,
+    DMA_PeripheralDataSize_Word,
+};
+
+const static uint32_t dma_mem_width[] = {
+    DMA_MemoryDataSize_Byte,
+    DMA_MemoryDataSize_HalfWord,
+    DMA_MemoryDataSize_Word,
+};
+
+const static uint32_t dma_priority[] = {
+    DMA_Priority_Low,
+    DMA_Priority_Medium,
+    DMA_Priority_High,
+    DMA_Priority_VeryHigh,
+};
+
+const static uint32_t dma_mem_burst[] = {
+    DMA_MemoryBurst_Single,
+    DMA_MemoryBurst_INC4,
+    DMA_MemoryBurst_INC8,
+    DMA_MemoryBurst_INC16,
+};
+
+const static uint32_t dma_periph_burst[] = {
+    DMA_PeripheralBurst_Single,
+    DMA_PeripheralBurst_INC4,
+    DMA_PeripheralBurst_INC8,
+    DMA_PeripheralBurst_INC16,
+};
+
+/* Stream and channel of each request, preferred stream first (RM0090 tables 42 and 43) */
+#define DMA_REQ_MAP(stream, chan) (uint8_t)(((stream) << 3) | (chan))
+
+const static uint8_t dma_request_map[ERDP_DMA_REQ_NUM][ERDP_DMA_REQ_ALT_MAX] = {
+    [ERDP_DMA_REQ_SPI2_RX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM3, 0)},
+    [ERDP_DMA_REQ_SPI2_TX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM4, 0)},
+    [ERDP_DMA_REQ_SPI3_RX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM0, 0), DMA_REQ_MAP(ERDP_DMA1_STREAM2, 0)},
+    [ERDP_DMA_REQ_SPI3_TX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM5, 0), DMA_REQ_MAP(ERDP_DMA1_STREAM7, 0)},
+    [ERDP_DMA_REQ_I2S2_EXT_RX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM3, 3)},
+    [ERDP_DMA_REQ_I2S2_EXT_TX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM4, 2)},
+    [ERDP_DMA_REQ_I2S3_EXT_RX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM2, 2), DMA_REQ_MAP(ERDP_DMA1_STREAM0, 3)},
+    [ERDP_DMA_REQ_I2S3_EXT_TX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM5, 2)},
+    [ERDP_DMA_REQ_I2C1_RX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM0, 1), DMA_REQ_MAP(ERDP_DMA1_STREAM5, 1)},
+    [ERDP_DMA_REQ_I2C1_TX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM6, 1), DMA_REQ_MAP(ERDP_DMA1_STREAM7, 1)},
+    [ERDP_DMA_REQ_I2C2_RX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM3, 7), DMA_REQ_MAP(ERDP_DMA1_STREAM2, 7)},
+    [ERDP_DMA_REQ_I2C2_TX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM7, 7)},
+    [ERDP_DMA_REQ_I2C3_RX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM2, 3)},
+    [ERDP_DMA_REQ_I2C3_TX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM4, 3)},
+    [ERDP_DMA_REQ_USART2_RX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM5, 4)},
+    [ERDP_DMA_REQ_USART2_TX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM6, 4)},
+    [ERDP_DMA_REQ_USART3_RX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM1, 4)},
+    [ERDP_DMA_REQ_USART3_TX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM3, 4), DMA_REQ_MAP(ERDP_DMA1_STREAM4, 7)},
+    [ERDP_DMA_REQ_UART4_RX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM2, 4)},
+    [ERDP_DMA_REQ_UART4_TX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM4, 4)},
+    [ERDP_DMA_REQ_UART5_RX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM0, 4)},
+    [ERDP_DMA_REQ_UART5_TX] = {DMA_REQ_MAP(ERDP_DMA1_STREAM7, 4)},
+    [ERDP_DMA_REQ_DAC1] = {DMA_REQ_MAP(ERDP_DMA1_STREAM5, 7)},
+    [ERDP_DMA_REQ_DAC2] = {DMA_REQ_MAP(ERDP_DMA1_STREAM6, 7)},
+    [ERDP_DMA_REQ_TIM2_UP] = {DMA_REQ_MAP(ERDP_DMA1_STREAM1, 3), DMA_REQ_MAP(ERDP_DMA1_STREAM7, 3)},
+    [ERDP_DMA_REQ_TIM2_CH1] = {DMA_REQ_MAP(ERDP_DMA1_STREAM5, 3)},
+    [ERDP_DMA_REQ_TIM2_CH2] = {DMA_REQ_MAP(ERDP_DMA1_STREAM6, 3)},
+    [ERDP_DMA_REQ_TIM2_CH3] = {DMA_REQ_MAP(ERDP_DMA1_STREAM1, 3)},
+    [ERDP_DMA_REQ_TIM2_CH4] = {DMA_REQ_MAP(ERDP_DMA1_STREAM7, 3), DMA_REQ_MAP(ERDP_DMA1_STREAM6, 3)},
+    [ERDP_DMA_REQ_TIM3_UP] = {DMA_REQ_MAP(ERDP_DMA1_STREAM2, 5)},
+    [ERDP_DMA_REQ_TIM3_CH1] = {DMA_REQ_MAP(ERDP_DMA1_STREAM4, 5)},
+    [ERDP_DMA_REQ_TIM3_CH2] = {DMA_REQ_MAP(ERDP_DMA1_STREAM5, 5)},
+    [ERDP_DMA_REQ_TIM3_CH3] = {DMA_REQ_MAP(ERDP_DMA1_STREAM7, 5)},
+    [ERDP_DMA_REQ_TIM3_CH4] = {DMA_REQ_MAP(ERDP_DMA1_STREAM2, 5)},
+    [ERDP_DMA_REQ_TIM4_UP] = {DMA_REQ_MAP(ERDP_DMA1_STREAM6, 2)},
+    [ERDP_DMA_REQ_TIM4_CH1] = {DMA_REQ_MAP(ERDP_DMA1_STREAM0, 2)},
+    [ERDP_DMA_REQ_TIM4_CH2] = {DMA_REQ_MAP(ERDP_DMA1_STREAM3, 2)},
+    [ERDP_DMA_REQ_TIM4_CH3] = {DMA_REQ_MAP(ERDP_DMA1_STREAM7, 2)},
+    [ERDP_DMA_REQ_TIM5_UP] = {DMA_REQ_MAP(ERDP_DMA1_STREAM6, 6), DMA_REQ_MAP(ERDP_DMA1_STREAM0, 6)},
+    [ERDP_DMA_REQ_TIM5_CH1] = {DMA_REQ_MAP(ERDP_DMA1_STREAM2, 6)},
+    [ERDP_DMA_REQ_TIM5_CH2] = {DMA_REQ_MAP(ERDP_DMA1_STREAM4, 6)},
+    [ERDP_DMA_REQ_TIM5_CH3] = {DMA_REQ_MAP(ERDP_DMA1_STREAM0, 6)},
+    [ERDP_DMA_REQ_TIM5_CH4] = {DMA_REQ_MAP(ERDP_DMA1_STREAM1, 6), DMA_REQ_MAP(ERDP_DMA1_STREAM3, 6)},
+    [ERDP_DMA_REQ_TIM6_UP] = {DMA_REQ_MAP(ERDP_DMA1_STREAM1, 7)},
+    [ERDP_DMA_REQ_TIM7_UP] = {DMA_REQ_MAP(ERDP_DMA1_STREAM2, 1), DMA_REQ_MAP(ERDP_DMA1_STREAM4, 1)},
+    [ERDP_DMA_REQ_ADC1] = {DMA_REQ_MAP(ERDP_DMA2_STREAM4, 0), DMA_REQ_MAP(ERDP_DMA2_STREAM0, 0)},
+    [ERDP_DMA_REQ_ADC2] = {DMA_REQ_MAP(ERDP_DMA2_STREAM2, 1), DMA_REQ_MAP(ERDP_DMA2_STREAM3, 1)},
+    [ERDP_DMA_REQ_ADC3] = {DMA_REQ_MAP(ERDP_DMA2_STREAM1, 2), DMA_REQ_MAP(ERDP_DMA2_STREAM0, 2)},
+    [ERDP_DMA_REQ_SPI1_RX] = {DMA_REQ_MAP(ERDP_DMA2_STREAM0, 3), DMA_REQ_MAP(ERDP_DMA2_STREAM2, 3)},
+    [ERDP_DMA_REQ_SPI1_TX] = {DMA_REQ_MAP(ERDP_DMA2_STREAM3, 3), DMA_REQ_MAP(ERDP_DMA2_STREAM5, 3)},
+    [ERDP_DMA_REQ_USART1_RX] = {DMA_REQ_MAP(ERDP_DMA2_STREAM2, 4), DMA_REQ_MAP(ERDP_DMA2_STREAM5, 4)},
+    [ERDP_DMA_REQ_USART1_TX] = {DMA_REQ_MAP(ERDP_DMA2_STREAM7, 4)},
+    [ERDP_DMA_REQ_USART6_RX] = {DMA_REQ_MAP(ERDP_DMA2_STREAM1, 5), DMA_REQ_MAP(ERDP_DMA2_STREAM2, 5)},
+    [ERDP_DMA_REQ_USART6_TX] = {DMA_REQ_MAP(ERDP_DMA2_STREAM6, 5), DMA_REQ_MAP(ERDP_DMA2_STREAM7, 5)},
+    [ERDP_DMA_REQ_SDIO] = {DMA_REQ_MAP(ERDP_DMA2_STREAM3, 4), DMA_REQ_MAP(ERDP_DMA2_STREAM6, 4)},
+    [ERDP_DMA_REQ_DCMI] = {DMA_REQ_MAP(ERDP_DMA2_STREAM7, 1), DMA_REQ_MAP(ERDP_DMA2_STREAM1, 1)},
+    [ERDP_DMA_REQ_TIM1_UP] = {DMA_REQ_MAP(ERDP_DMA2_STREAM5, 6)},
+    [ERDP_DMA_REQ_TIM1_CH1] = {DMA_REQ_MAP(ERDP_DMA2_STREAM1, 6), DMA_REQ_MAP(ERDP_DMA2_STREAM3, 6), DMA_REQ_MAP(ERDP_DMA2_STREAM6, 0)},
+    [ERDP_DMA_REQ_TIM1_CH2] = {DMA_REQ_MAP(ERDP_DMA2_STREAM2, 6), DMA_REQ_MAP(ERDP_DMA2_STREAM6, 0)},
+    [ERDP_DMA_REQ_TIM1_CH3] = {DMA_REQ_MAP(ERDP_DMA2_STREAM6, 6), DMA_REQ_MAP(ERDP_DMA2_STREAM6, 0)},
+    [ERDP_DMA_REQ_TIM1_CH4] = {DMA_REQ_MAP(ERDP_DMA2_STREAM4, 6)},
+    [ERDP_DMA_REQ_TIM8_UP] = {DMA_REQ_MAP(ERDP_DMA2_STREAM1, 7)},
+    [ERDP_DMA_REQ_TIM8_CH1] = {DMA_REQ_MAP(ERDP_DMA2_STREAM2, 7), DMA_REQ_MAP(ERDP_DMA2_STREAM2, 0)},
+    [ERDP_DMA_REQ_TIM8_CH2] = {DMA_REQ_MAP(ERDP_DMA2_STREAM3, 7), DMA_REQ_MAP(ERDP_DMA2_STREAM2, 0)},
+    [ERDP_DMA_REQ_TIM8_CH3] = {DMA_REQ_MAP(ERDP_DMA2_STREAM4, 7), DMA_REQ_MAP(ERDP_DMA2_STREAM2, 0)},
+    [ERDP_DMA_REQ_TIM8_CH4] = {DMA_REQ_MAP(ERDP_DMA2_STREAM7, 7)},
+};
+
+/* Memory to memory is DMA2 only; streams least wanted by peripherals first */
+const static uint8_t dma_mem2mem_order[] = {0, 6, 5, 7, 3, 1, 2, 4};
+
+static DMA_TypeDef *erdp_if_dma_get_controller(ERDP_DmaStream_t stream)
+{
+    return (stream < ERDP_DMA2_STREAM0) ? DMA1 : DMA2;
+}
+
+/* Convert ERDP_DMA_FLAG_* into the 6 bit hardware flag group of a stream */
+static uint32_t erdp_if_dma_flags_to_hw(uint32_t flags)
+{
+    uint32_t hw = 0;
+    if (flags & ERDP_DMA_FLAG_FE)
+    {
+        hw |= DMA_LISR_FEIF0;
+    }
+    if (flags & ERDP_DMA_FLAG_DME)
+    {
+        hw |= DMA_LISR_DMEIF0;
+    }
+    if (flags & ERDP_DMA_FLAG_TE)
+    {
+        hw |= DMA_LISR_TEIF0;
+    }
+    if (flags & ERDP_DMA_FLAG_HT)
+    {
+        hw |= DMA_LISR_HTIF0;
+    }
+    if (flags & ERDP_DMA_FLAG_TC)
+    {
+        hw |= DMA_LISR_TCIF0;
+    }
+    return hw;
+}
+
+uint32_t erdp_if_dma_get_base(ERDP_DmaStream_t stream) { return dma_stream_instance[stream]; }
+
+bool erdp_if_dma_get_request_map(ERDP_DmaRequest_t request, uint8_t index, ERDP_DmaStream_t *stream,
+                                 uint32_t *channel)
+{
+    if (request == ERDP_DMA_REQ_MEM2MEM)
+    {
+        if (index >= sizeof(dma_mem2mem_order))
+        {
+            return false;
+        }
+        *stream = (ERDP_DmaStream_t)(ERDP_DMA2_STREAM0 + dma_mem2mem_order[index]);
+        *channel = 0;
+        return true;
+    }
+    if (request <= ERDP_DMA_REQ_MEM2MEM || request >= ERDP_DMA_REQ_NUM || index >= ERDP_DMA_REQ_ALT_MAX)
+    {
+        return false;
+    }
+    /* Unused entries are zero, DMA1 stream 0 is always listed first when it serves a request */
+    uint8_t map = dma_request_map[request][index];
+    if (index > 0 && map == 0)
+    {
+        return false;
+    }
+    *stream = (ERDP_DmaStream_t)(map >> 3);
+    *channel = map & 0x07U;
+    return true;
+}
+
+void erdp_if_dma_init(ERDP_DmaStream_t stream, const ERDP_DmaCfg_t *cfg)
+{
+    DMA_InitTypeDef DMA_InitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+    DMA_Stream_TypeDef *dma_stream = (DMA_Stream_TypeDef *)dma_stream_instance[stream];
+
+    RCC_AHB1PeriphClockCmd((stream < ERDP_DMA2_STREAM0) ? RCC_AHB1Periph_DMA1 : RCC_AHB1Periph_DMA2, ENABLE);
+
+    erdp_if_dma_stop(stream);
+    DMA_DeInit(dma_stream);
+
+    DMA_InitStructure.DMA_Channel = (cfg->channel & 0x07U) << 25;
+    DMA_InitStructure.DMA_PeripheralBaseAddr = 0;
+    DMA_InitStructure.DMA_Memory0BaseAddr = 0;
+    DMA_InitStructure.DMA_DIR = dma_dir[cfg->dir];
+    DMA_InitStructure.DMA_BufferSize = 0;
+    DMA_InitStructure.DMA_PeripheralInc = cfg->periph_inc ? DMA_PeripheralInc_Enable : DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = cfg->mem_inc ? DMA_MemoryInc_Enable : DMA_MemoryInc_Disable;
+    DMA_InitStructure.DMA_PeripheralDataSize = dma_periph_width[cfg->periph_width];
+    DMA_InitStructure.DMA_MemoryDataSize = dma_mem_width[cfg->mem_width];
+    DMA_InitStructure.DMA_Mode = cfg->circular ? DMA_Mode_Circular : DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = dma_priority[cfg->priority];
+    DMA_InitStructure.DMA_FIFOMode = (cfg->fifo || cfg->dir == ERDP_DMA_DIR_M2M) ? DMA_FIFOMode_Enable
+                                                                                  : DMA_FIFOMode_Disable;
+    DMA_InitStructure.DMA_FIFOThreshold = DMA_FIFOThreshold_Full;
+    DMA_InitStructure.DMA_MemoryBurst = dma_mem_burst[cfg->burst];
+    DMA_InitStructure.DMA_PeripheralBurst = dma_periph_burst[cfg->burst];
+    DMA_Init(dma_stream, &DMA_InitStructure);
+    DMA_FlowControllerConfig(dma_stream, cfg->periph_flow ? DMA_FlowCtrl_Peripheral : DMA_FlowCtrl_Memory);
+
+    erdp_if_dma_clear_flags(stream, ERDP_DMA_FLAG_ALL);
+    DMA_ITConfig(dma_stream, DMA_IT_TC, (cfg->irq_flags & ERDP_DMA_FLAG_TC) ? ENABLE : DISABLE);
+    DMA_ITConfig(dma_stream, DMA_IT_HT, (cfg->irq_flags & ERDP_DMA_FLAG_HT) ? ENABLE : DISABLE);
+    DMA_ITConfig(dma_stream, DMA_IT_TE, (cfg->irq_flags & ERDP_DMA_FLAG_TE) ? ENABLE : DISABLE);
+    DMA_ITConfig(dma_stream, DMA_IT_DME, (cfg->irq_flags & ERDP_DMA_FLAG_DME) ? ENABLE : DISABLE);
+    DMA_ITConfig(dma_stream, DMA_IT_FE, (cfg->irq_flags & ERDP_DMA_FLAG_FE) ? ENABLE : DISABLE);
+
+    NVIC_InitStructure.NVIC_IRQChannel = dma_irq_id[stream];
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = cfg->irq_priority;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = cfg->irq_flags ? ENABLE : DISABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+
+void erdp_if_dma_deinit(ERDP_DmaStream_t stream)
+{
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    erdp_if_dma_stop(stream);
+    DMA_DeInit((DMA_Stream_TypeDef *)dma_stream_instance[stream]);
+
+    NVIC_InitStructure.NVIC_IRQChannel = dma_irq_id[stream];
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = DISABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+
+void erdp_if_dma_start(ERDP_DmaStream_t stream, uint32_t periph_addr, uint32_t mem_addr, uint32_t count)
+{
+    DMA_Stream_TypeDef *dma_stream = (DMA_Stream_TypeDef *)dma_stream_instance[stream];
+
+    erdp_if_dma_stop(stream);
+    erdp_if_dma_clear_flags(stream, ERDP_DMA_FLAG_ALL);
+    dma_stream->PAR = periph_addr;
+    dma_stream->M0AR = mem_addr;
+    dma_stream->NDTR = count;
+    dma_stream->CR |= DMA_SxCR_EN;
+}
+
+void erdp_if_dma_stop(ERDP_DmaStream_t stream)
+{
+    DMA_Stream_TypeDef *dma_stream = (DMA_Stream_TypeDef *)dma_stream_instance[stream];
+
+    dma_stream->CR &= ~DMA_SxCR_EN;
+    while (dma_stream->CR & DMA_SxCR_EN)
+    {
+        ; // Wait for the current data item to be completed
+    }
+}
+
+bool erdp_if_dma_is_enabled(ERDP_DmaStream_t stream)
+{
+    return (((DMA_Stream_TypeDef *)dma_stream_instance[stream])->CR & DMA_SxCR_EN) != 0;
+}
+
+void erdp_if_dma_double_buffer_config(ERDP_DmaStream_t stream, uint32_t mem1_addr, bool enable)
+{
+    DMA_Stream_TypeDef *dma_stream = (DMA_Stream_TypeDef *)dma_stream_instance[stream];
+
+    if (enable)
+    {
+        DMA_DoubleBufferModeConfig(dma_stream, mem1_addr, DMA_Memory_0);
+        DMA_DoubleBufferModeCmd(dma_stream, ENABLE);
+    }
+    else
+    {
+        DMA_DoubleBufferModeCmd(dma_stream, DISABLE);
+    }
+}
+
+void erdp_if_dma_set_memory(ERDP_DmaStream_t stream, uint8_t target, uint32_t mem_addr)
+{
+    DMA_MemoryTargetConfig((DMA_Stream_TypeDef *)dma_stream_instance[stream], mem_addr,
+                           target ? DMA_Memory_1 : DMA_Memory_0);
+}
+
+uint8_t erdp_if_dma_get_current_target(ERDP_DmaStream_t stream)
+{
+    return (uint8_t)DMA_GetCurrentMemoryTarget((DMA_Stream_TypeDef *)dma_stream_instance[stream]);
+}
+
+uint32_t erdp_if_dma_get_counter(ERDP_DmaStream_t stream)
+{
+    return ((DMA_Stream_TypeDef *)dma_stream_instance[stream])->NDTR;
+}
+
+uint32_t erdp_if_dma_get_flags(ERDP_DmaStream_t stream)
+{
+    DMA_TypeDef *dma = erdp_if_dma_get_controller(stream);
+    uint32_t index = (uint32_t)stream & 0x07U;
+    uint32_t isr = (index < 4) ? dma->LISR : dma->HISR;
+    uint32_t hw = (isr >> dma_flag_shift[index & 0x03U]) & 0x3DU;
+    uint32_t flags = 0;
+
+    if (hw & DMA_LISR_TCIF0)
+    {
+        flags |= ERDP_DMA_FLAG_TC;
+    }
+    if (hw & DMA_LISR_HTIF0)
+    {
+        flags |= ERDP_DMA_FLAG_HT;
+    }
+    if (hw & DMA_LISR_TEIF0)
+    {
+        flags |= ERDP_DMA_FLAG_TE;
+    }
+    if (hw & DMA_LISR_DMEIF0)
+    {
+        flags |= ERDP_DMA_FLAG_DME;
+    }
+    if (hw & DMA_LISR_FEIF0)
+    {
+        flags |= ERDP_DMA_FLAG_FE;
+    }
+    return flags;
+}
+
+void erdp_if_dma_clear_flags(ERDP_DmaStream_t stream, uint32_t flags)
+{
+    DMA_TypeDef *dma = erdp_if_dma_get_controller(stream);
+    uint32_t index = (uint32_t)stream & 0x07U;
+    uint32_t hw = erdp_if_dma_flags_to_hw(flags) << dma_flag_shift[index & 0x03U];
+
+    if (index < 4)
+    {
+        dma->LIFCR = hw;
+    }
+    else
+    {
+        dma->HIFCR = hw;
+    }
+}
+
+void DMA1_Stream0_IRQHandler(void) { erdp_dma_irq_handler(ERDP_DMA1_STREAM0); }
+void DMA1_Stream1_IRQHandler(void) { erdp_dma_irq_handler(ERDP_DMA1_STREAM1); }
+void DMA1_Stream2_IRQHandler(void) { erdp_dma_irq_handler(ERDP_DMA1_STREAM2); }
+void DMA1_Stream3_IRQHandler(void) { erdp_dma_irq_handler(ERDP_DMA1_STREAM3); }
+void DMA1_Stream4_IRQHandler(void) { erdp_dma_irq_handler(ERDP_DMA1_STREAM4); }
+void DMA1_Stream5_IRQHandler(void) { erdp_dma_irq_handler(ERDP_DMA1_STREAM5); }
+void DMA1_Stream6_IRQHandler(void) { erdp_dma_irq_handler(ERDP_DMA1_STREAM6); }
+void DMA1_Stream7_IRQHandler(void) { erdp_dma_irq_handler(ERDP_DMA1_STREAM7); }
+void DMA2_Stream0_IRQHandler(void) { erdp_dma_irq_handler(ERDP_DMA2_STREAM0); }
+void DMA2_Stream1_IRQHandler(void) { erdp_dma_irq_handler(ERDP_DMA2_STREAM1); }
+void DMA2_Stream2_IRQHandler(void) { erdp_dma_irq_handler(ERDP_DMA2_STREAM2); }
+void DMA2_Stream3_IRQHandler(void) { erdp_dma_irq_handler(ERDP_DMA2_STREAM3); }
+void DMA2_Stream4_IRQHandler(void) { erdp_dma_irq_handler(ERDP_DMA2_STREAM4); }
+void DMA2_Stream5_IRQHandler(void) { erdp_dma_irq_handler(ERDP_DMA2_STREAM5); }
+void DMA2_Stream6_IRQHandler(void) { erdp_dma_irq_handler(ERDP_DMA2_STREAM6); }
+void DMA2_Stream7_IRQHandler(void) { erdp_dma_irq_handler(ERDP_DMA2_STREAM7); }
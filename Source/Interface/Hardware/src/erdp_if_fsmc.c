@@ -0,0 +1,139 @@
+/* erdp include */
+#include "erdp_if_fsmc.h"
+#include "erdp_if_gpio.h"
+
+/* platform include */
+#include "stm32f4xx.h"
+#include "stm32f4xx_fsmc.h"
+#include "stm32f4xx_gpio.h"
+#include "stm32f4xx_rcc.h"
+
+/* Read timing, slow enough for the GRAM read cycle of common controllers (about 350ns) */
+#define FSMC_READ_ADDSET 15U
+#define FSMC_READ_DATAST 60U
+
+const static uint32_t fsmc_bank[ERDP_FSMC_BANK_NUM] = {
+    FSMC_Bank1_NORSRAM1,
+    FSMC_Bank1_NORSRAM2,
+    FSMC_Bank1_NORSRAM3,
+    FSMC_Bank1_NORSRAM4,
+};
+
+const static uint32_t fsmc_bank_addr[ERDP_FSMC_BANK_NUM] = {
+    0x60000000U,
+    0x64000000U,
+    0x68000000U,
+    0x6C000000U,
+};
+
+/* {port, pin} of the chip selects */
+const static uint8_t fsmc_ne_pin[ERDP_FSMC_BANK_NUM][2] = {
+    {ERDP_GPIOD, ERDP_GPIO_PIN_7},
+    {ERDP_GPIOG, ERDP_GPIO_PIN_9},
+    {ERDP_GPIOG, ERDP_GPIO_PIN_10},
+    {ERDP_GPIOG, ERDP_GPIO_PIN_12},
+};
+
+/* {port, pin} of A0..A23 */
+const static uint8_t fsmc_addr_pin[ERDP_FSMC_ADDR_LINE_MAX + 1][2] = {
+    {ERDP_GPIOF, ERDP_GPIO_PIN_0},  {ERDP_GPIOF, ERDP_GPIO_PIN_1},  {ERDP_GPIOF, ERDP_GPIO_PIN_2},
+    {ERDP_GPIOF, ERDP_GPIO_PIN_3},  {ERDP_GPIOF, ERDP_GPIO_PIN_4},  {ERDP_GPIOF, ERDP_GPIO_PIN_5},
+    {ERDP_GPIOF, ERDP_GPIO_PIN_12}, {ERDP_GPIOF, ERDP_GPIO_PIN_13}, {ERDP_GPIOF, ERDP_GPIO_PIN_14},
+    {ERDP_GPIOF, ERDP_GPIO_PIN_15}, {ERDP_GPIOG, ERDP_GPIO_PIN_0},  {ERDP_GPIOG, ERDP_GPIO_PIN_1},
+    {ERDP_GPIOG, ERDP_GPIO_PIN_2},  {ERDP_GPIOG, ERDP_GPIO_PIN_3},  {ERDP_GPIOG, ERDP_GPIO_PIN_4},
+    {ERDP_GPIOG, ERDP_GPIO_PIN_5},  {ERDP_GPIOD, ERDP_GPIO_PIN_11}, {ERDP_GPIOD, ERDP_GPIO_PIN_12},
+    {ERDP_GPIOD, ERDP_GPIO_PIN_13}, {ERDP_GPIOE, ERDP_GPIO_PIN_3},  {ERDP_GPIOE, ERDP_GPIO_PIN_4},
+    {ERDP_GPIOE, ERDP_GPIO_PIN_5},  {ERDP_GPIOE, ERDP_GPIO_PIN_6},  {ERDP_GPIOE, ERDP_GPIO_PIN_2},
+};
+
+/* D0..D15, NOE and NWE */
+const static uint8_t fsmc_bus_pin[18][2] = {
+    {ERDP_GPIOD, ERDP_GPIO_PIN_14}, {ERDP_GPIOD, ERDP_GPIO_PIN_15}, {ERDP_GPIOD, ERDP_GPIO_PIN_0},
+    {ERDP_GPIOD, ERDP_GPIO_PIN_1},  {ERDP_GPIOE, ERDP_GPIO_PIN_7},  {ERDP_GPIOE, ERDP_GPIO_PIN_8},
+    {ERDP_GPIOE, ERDP_GPIO_PIN_9},  {ERDP_GPIOE, ERDP_GPIO_PIN_10}, {ERDP_GPIOE, ERDP_GPIO_PIN_11},
+    {ERDP_GPIOE, ERDP_GPIO_PIN_12}, {ERDP_GPIOE, ERDP_GPIO_PIN_13}, {ERDP_GPIOE, ERDP_GPIO_PIN_14},
+    {ERDP_GPIOE, ERDP_GPIO_PIN_15}, {ERDP_GPIOD, ERDP_GPIO_PIN_8},  {ERDP_GPIOD, ERDP_GPIO_PIN_9},
+    {ERDP_GPIOD, ERDP_GPIO_PIN_10}, {ERDP_GPIOD, ERDP_GPIO_PIN_4},  {ERDP_GPIOD, ERDP_GPIO_PIN_5},
+};
+
+static void erdp_if_fsmc_pin_init(const uint8_t pin[2])
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+    ERDP_GpioPort_t port = (ERDP_GpioPort_t)pin[0];
+
+    RCC_AHB1PeriphClockCmd(erdp_if_gpio_get_PCLK(port), ENABLE);
+    GPIO_PinAFConfig((GPIO_TypeDef *)erdp_if_gpio_get_port(port), pin[1], GPIO_AF_FSMC);
+    GPIO_InitStructure.GPIO_Pin = erdp_if_gpio_get_pin((ERDP_GpioPin_t)pin[1]);
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_100MHz;
+    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;
+    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_NOPULL;
+    GPIO_Init((GPIO_TypeDef *)erdp_if_gpio_get_port(port), &GPIO_InitStructure);
+}
+
+void erdp_if_fsmc_lcd_init(const ERDP_FsmcLcdCfg_t *cfg)
+{
+    FSMC_NORSRAMInitTypeDef FSMC_NORSRAMInitStructure;
+    FSMC_NORSRAMTimingInitTypeDef read_timing;
+    FSMC_NORSRAMTimingInitTypeDef write_timing;
+
+    for (uint8_t i = 0; i < sizeof(fsmc_bus_pin) / sizeof(fsmc_bus_pin[0]); i++)
+    {
+        erdp_if_fsmc_pin_init(fsmc_bus_pin[i]);
+    }
+    erdp_if_fsmc_pin_init(fsmc_ne_pin[cfg->bank]);
+    erdp_if_fsmc_pin_init(fsmc_addr_pin[cfg->rs_line]);
+
+    RCC_AHB3PeriphClockCmd(RCC_AHB3Periph_FSMC, ENABLE);
+
+    read_timing.FSMC_AddressSetupTime = FSMC_READ_ADDSET;
+    read_timing.FSMC_AddressHoldTime = 0;
+    read_timing.FSMC_DataSetupTime = FSMC_READ_DATAST;
+    read_timing.FSMC_BusTurnAroundDuration = 0;
+    read_timing.FSMC_CLKDivision = 0;
+    read_timing.FSMC_DataLatency = 0;
+    read_timing.FSMC_AccessMode = FSMC_AccessMode_A;
+
+    write_timing.FSMC_AddressSetupTime = cfg->write_addset;
+    write_timing.FSMC_AddressHoldTime = 0;
+    write_timing.FSMC_DataSetupTime = cfg->write_datast;
+    write_timing.FSMC_BusTurnAroundDuration = 0;
+    write_timing.FSMC_CLKDivision = 0;
+    write_timing.FSMC_DataLatency = 0;
+    write_timing.FSMC_AccessMode = FSMC_AccessMode_A;
+
+    FSMC_NORSRAMInitStructure.FSMC_Bank = fsmc_bank[cfg->bank];
+    FSMC_NORSRAMInitStructure.FSMC_DataAddressMux = FSMC_DataAddressMux_Disable;
+    FSMC_NORSRAMInitStructure.FSMC_MemoryType = FSMC_MemoryType_SRAM;
+    FSMC_NORSRAMInitStructure.FSMC_MemoryDataWidth = FSMC_MemoryDataWidth_16b;
+    FSMC_NORSRAMInitStructure.FSMC_BurstAccessMode = FSMC_BurstAccessMode_Disable;
+    FSMC_NORSRAMInitStructure.FSMC_AsynchronousWait = FSMC_AsynchronousWait_Disable;
+    FSMC_NORSRAMInitStructure.FSMC_WaitSignalPolarity = FSMC_WaitSignalPolarity_Low;
+    FSMC_NORSRAMInitStructure.FSMC_WrapMode = FSMC_WrapMode_Disable;
+    FSMC_NORSRAMInitStructure.FSMC_WaitSignalActive = FSMC_WaitSignalActive_BeforeWaitState;
+    FSMC_NORSRAMInitStructure.FSMC_WriteOperation = FSMC_WriteOperation_Enable;
+    FSMC_NORSRAMInitStructure.FSMC_WaitSignal = FSMC_WaitSignal_Disable;
+    FSMC_NORSRAMInitStructure.FSMC_ExtendedMode = FSMC_ExtendedMode_Enable;
+    FSMC_NORSRAMInitStructure.FSMC_WriteBurst = FSMC_WriteBurst_Disable;
+    FSMC_NORSRAMInitStructure.FSMC_ReadWriteTimingStruct = &read_timing;
+    FSMC_NORSRAMInitStructure.FSMC_WriteTimingStruct = &write_timing;
+    FSMC_NORSRAMInit(&FSMC_NORSRAMInitStructure);
+    FSMC_NORSRAMCmd(fsmc_bank[cfg->bank], ENABLE);
+}
+
+void erdp_if_fsmc_lcd_deinit(ERDP_FsmcBank_t bank)
+{
+    FSMC_NORSRAMCmd(fsmc_bank[bank], DISABLE);
+    FSMC_NORSRAMDeInit(fsmc_bank[bank]);
+}
+
+uint32_t erdp_if_fsmc_lcd_get_cmd_addr(ERDP_FsmcBank_t bank)
+{
+    return fsmc_bank_addr[bank];
+}
+
+uint32_t erdp_if_fsmc_lcd_get_data_addr(ERDP_FsmcBank_t bank, uint8_t rs_line)
+{
+    /* With a 16 bit bus HADDR[25:1] drive A[24:0] */
+    return fsmc_bank_addr[bank] | ((uint32_t)1 << (rs_line + 1));
+}
@@ -0,0 +1,261 @@
+/* erdp include */
+#include "erdp_if_i2c.h"
+
+/* platform include */
+#include "stm32f4xx.h"
+#include "stm32f4xx_gpio.h"
+#include "stm32f4xx_i2c.h"
+#include "stm32f4xx_rcc.h"
+
+extern void erdp_i2c_ev_irq_handler(ERDP_I2c_t i2c);
+extern void erdp_i2c_er_irq_handler(ERDP_I2c_t i2c);
+
+#define I2C_RECOVER_CLOCKS 9U
+
+const static uint32_t i2c_instance[ERDP_I2C_NUM] = {
+    0,
+    (uint32_t)I2C1,
+    (uint32_t)I2C2,
+    (uint32_t)I2C3,
+};
+
+const static uint32_t i2c_pclk[ERDP_I2C_NUM] = {
+    0,
+    RCC_APB1Periph_I2C1,
+    RCC_APB1Periph_I2C2,
+    RCC_APB1Periph_I2C3,
+};
+
+const static uint8_t i2c_af[ERDP_I2C_NUM] = {
+    0,
+    GPIO_AF_I2C1,
+    GPIO_AF_I2C2,
+    GPIO_AF_I2C3,
+};
+
+const static uint8_t i2c_ev_irq[ERDP_I2C_NUM] = {
+    0,
+    I2C1_EV_IRQn,
+    I2C2_EV_IRQn,
+    I2C3_EV_IRQn,
+};
+
+const static uint8_t i2c_er_irq[ERDP_I2C_NUM] = {
+    0,
+    I2C1_ER_IRQn,
+    I2C2_ER_IRQn,
+    I2C3_ER_IRQn,
+};
+
+/* DMA requests {rx, tx} */
+const static ERDP_DmaRequest_t i2c_dma_request[ERDP_I2C_NUM][2] = {
+    {ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE},
+    {ERDP_DMA_REQ_I2C1_RX, ERDP_DMA_REQ_I2C1_TX},
+    {ERDP_DMA_REQ_I2C2_RX, ERDP_DMA_REQ_I2C2_TX},
+    {ERDP_DMA_REQ_I2C3_RX, ERDP_DMA_REQ_I2C3_TX},
+};
+
+static void erdp_if_i2c_delay_us(uint32_t us)
+{
+    volatile uint32_t count = us * (SystemCoreClock / 4000000U);
+    while (count--)
+    {
+    }
+}
+
+static void erdp_if_i2c_pin_config(ERDP_GpioPort_t port, ERDP_GpioPin_t pin, GPIOMode_TypeDef mode)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+
+    RCC_AHB1PeriphClockCmd(erdp_if_gpio_get_PCLK(port), ENABLE);
+    GPIO_InitStructure.GPIO_Pin = erdp_if_gpio_get_pin(pin);
+    GPIO_InitStructure.GPIO_Mode = mode;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_InitStructure.GPIO_OType = GPIO_OType_OD;
+    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;
+    GPIO_Init((GPIO_TypeDef *)erdp_if_gpio_get_port(port), &GPIO_InitStructure);
+}
+
+static void erdp_if_i2c_pin_write(ERDP_GpioPort_t port, ERDP_GpioPin_t pin, bool high)
+{
+    GPIO_WriteBit((GPIO_TypeDef *)erdp_if_gpio_get_port(port), erdp_if_gpio_get_pin(pin), high ? Bit_SET : Bit_RESET);
+}
+
+static bool erdp_if_i2c_pin_read(ERDP_GpioPort_t port, ERDP_GpioPin_t pin)
+{
+    return GPIO_ReadInputDataBit((GPIO_TypeDef *)erdp_if_gpio_get_port(port), erdp_if_gpio_get_pin(pin)) == Bit_SET;
+}
+
+static void erdp_if_i2c_nvic_init(uint8_t irq, uint8_t priority, bool enable)
+{
+    NVIC_InitTypeDef NVIC_InitStructure;
+    NVIC_InitStructure.NVIC_IRQChannel = irq;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = priority;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = enable ? ENABLE : DISABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+
+void erdp_if_i2c_gpio_init(ERDP_I2c_t i2c, const ERDP_I2cPins_t *pins)
+{
+    GPIO_PinAFConfig((GPIO_TypeDef *)erdp_if_gpio_get_port(pins->scl_port), pins->scl_pin, i2c_af[i2c]);
+    GPIO_PinAFConfig((GPIO_TypeDef *)erdp_if_gpio_get_port(pins->sda_port), pins->sda_pin, i2c_af[i2c]);
+    erdp_if_i2c_pin_config(pins->scl_port, pins->scl_pin, GPIO_Mode_AF);
+    erdp_if_i2c_pin_config(pins->sda_port, pins->sda_pin, GPIO_Mode_AF);
+}
+
+void erdp_if_i2c_init(ERDP_I2c_t i2c, uint32_t speed, uint8_t priority)
+{
+    I2C_InitTypeDef I2C_InitStructure;
+    I2C_TypeDef *i2c_periph = (I2C_TypeDef *)i2c_instance[i2c];
+
+    RCC_APB1PeriphClockCmd(i2c_pclk[i2c], ENABLE);
+    I2C_DeInit(i2c_periph);
+
+    I2C_StructInit(&I2C_InitStructure);
+    I2C_InitStructure.I2C_ClockSpeed = speed;
+    I2C_InitStructure.I2C_Mode = I2C_Mode_I2C;
+    I2C_InitStructure.I2C_DutyCycle = I2C_DutyCycle_2;
+    I2C_InitStructure.I2C_OwnAddress1 = 0;
+    I2C_InitStructure.I2C_Ack = I2C_Ack_Enable;
+    I2C_InitStructure.I2C_AcknowledgedAddress = I2C_AcknowledgedAddress_7bit;
+    I2C_Cmd(i2c_periph, ENABLE);
+    I2C_Init(i2c_periph, &I2C_InitStructure);
+
+    I2C_DMACmd(i2c_periph, ENABLE);
+    I2C_ITConfig(i2c_periph, I2C_IT_EVT | I2C_IT_ERR, ENABLE);
+    erdp_if_i2c_nvic_init(i2c_ev_irq[i2c], priority, true);
+    erdp_if_i2c_nvic_init(i2c_er_irq[i2c], priority, true);
+}
+
+void erdp_if_i2c_deinit(ERDP_I2c_t i2c)
+{
+    I2C_TypeDef *i2c_periph = (I2C_TypeDef *)i2c_instance[i2c];
+
+    erdp_if_i2c_nvic_init(i2c_ev_irq[i2c], 0, false);
+    erdp_if_i2c_nvic_init(i2c_er_irq[i2c], 0, false);
+    I2C_ITConfig(i2c_periph, I2C_IT_EVT | I2C_IT_ERR | I2C_IT_BUF, DISABLE);
+    I2C_DeInit(i2c_periph);
+}
+
+bool erdp_if_i2c_bus_recover(ERDP_I2c_t i2c, const ERDP_I2cPins_t *pins)
+{
+    I2C_TypeDef *i2c_periph = (I2C_TypeDef *)i2c_instance[i2c];
+    uint32_t i;
+
+    I2C_Cmd(i2c_periph, DISABLE);
+    erdp_if_i2c_pin_write(pins->scl_port, pins->scl_pin, true);
+    erdp_if_i2c_pin_write(pins->sda_port, pins->sda_pin, true);
+    erdp_if_i2c_pin_config(pins->scl_port, pins->scl_pin, GPIO_Mode_OUT);
+    erdp_if_i2c_pin_config(pins->sda_port, pins->sda_pin, GPIO_Mode_OUT);
+
+    /* A slave stuck in the middle of a byte releases SDA within 9 clocks */
+    for (i = 0; i < I2C_RECOVER_CLOCKS && !erdp_if_i2c_pin_read(pins->sda_port, pins->sda_pin); i++)
+    {
+        erdp_if_i2c_pin_write(pins->scl_port, pins->scl_pin, false);
+        erdp_if_i2c_delay_us(5);
+        erdp_if_i2c_pin_write(pins->scl_port, pins->scl_pin, true);
+        erdp_if_i2c_delay_us(5);
+    }
+
+    /* Stop condition: SDA rises while SCL is high */
+    erdp_if_i2c_pin_write(pins->scl_port, pins->scl_pin, false);
+    erdp_if_i2c_delay_us(5);
+    erdp_if_i2c_pin_write(pins->sda_port, pins->sda_pin, false);
+    erdp_if_i2c_delay_us(5);
+    erdp_if_i2c_pin_write(pins->scl_port, pins->scl_pin, true);
+    erdp_if_i2c_delay_us(5);
+    erdp_if_i2c_pin_write(pins->sda_port, pins->sda_pin, true);
+    erdp_if_i2c_delay_us(5);
+
+    bool released = erdp_if_i2c_pin_read(pins->sda_port, pins->sda_pin);
+
+    /* Clear a BUSY flag latched by the glitches above */
+    I2C_SoftwareResetCmd(i2c_periph, ENABLE);
+    I2C_SoftwareResetCmd(i2c_periph, DISABLE);
+    erdp_if_i2c_gpio_init(i2c, pins);
+    return released;
+}
+
+bool erdp_if_i2c_is_busy(ERDP_I2c_t i2c)
+{
+    return (((I2C_TypeDef *)i2c_instance[i2c])->SR2 & I2C_SR2_BUSY) != 0;
+}
+
+void erdp_if_i2c_start(ERDP_I2c_t i2c)
+{
+    I2C_TypeDef *i2c_periph = (I2C_TypeDef *)i2c_instance[i2c];
+    uint32_t timeout = SystemCoreClock / 10000U;
+
+    /* A start requested while the previous stop is still pending is lost, wait for the stop (a few us) */
+    while ((i2c_periph->CR1 & I2C_CR1_STOP) && timeout--)
+    {
+    }
+    i2c_periph->CR1 |= I2C_CR1_START;
+}
+
+void erdp_if_i2c_stop(ERDP_I2c_t i2c)
+{
+    ((I2C_TypeDef *)i2c_instance[i2c])->CR1 |= I2C_CR1_STOP;
+}
+
+void erdp_if_i2c_send_address(ERDP_I2c_t i2c, uint8_t addr, bool read)
+{
+    ((I2C_TypeDef *)i2c_instance[i2c])->DR = (uint8_t)((addr << 1) | (read ? 1U : 0U));
+}
+
+void erdp_if_i2c_clear_addr(ERDP_I2c_t i2c)
+{
+    (void)((I2C_TypeDef *)i2c_instance[i2c])->SR2;
+}
+
+void erdp_if_i2c_ack(ERDP_I2c_t i2c, bool enable)
+{
+    I2C_AcknowledgeConfig((I2C_TypeDef *)i2c_instance[i2c], enable ? ENABLE : DISABLE);
+}
+
+void erdp_if_i2c_dma_last(ERDP_I2c_t i2c, bool enable)
+{
+    I2C_DMALastTransferCmd((I2C_TypeDef *)i2c_instance[i2c], enable ? ENABLE : DISABLE);
+}
+
+void erdp_if_i2c_buffer_irq(ERDP_I2c_t i2c, bool enable)
+{
+    I2C_ITConfig((I2C_TypeDef *)i2c_instance[i2c], I2C_IT_BUF, enable ? ENABLE : DISABLE);
+}
+
+uint8_t erdp_if_i2c_read_data(ERDP_I2c_t i2c)
+{
+    return (uint8_t)((I2C_TypeDef *)i2c_instance[i2c])->DR;
+}
+
+uint32_t erdp_if_i2c_get_status(ERDP_I2c_t i2c)
+{
+    return ((I2C_TypeDef *)i2c_instance[i2c])->SR1;
+}
+
+void erdp_if_i2c_clear_errors(ERDP_I2c_t i2c, uint32_t flags)
+{
+    ((I2C_TypeDef *)i2c_instance[i2c])->SR1 = (uint16_t)~(flags & ERDP_I2C_FLAG_ERRORS);
+}
+
+uint32_t erdp_if_i2c_get_data_addr(ERDP_I2c_t i2c)
+{
+    return (uint32_t)(&((I2C_TypeDef *)i2c_instance[i2c])->DR);
+}
+
+ERDP_DmaRequest_t erdp_if_i2c_get_dma_request(ERDP_I2c_t i2c, bool rx)
+{
+    if (i2c >= ERDP_I2C_NUM)
+    {
+        return ERDP_DMA_REQ_NONE;
+    }
+    return i2c_dma_request[i2c][rx ? 0 : 1];
+}
+
+void I2C1_EV_IRQHandler(void) { erdp_i2c_ev_irq_handler(ERDP_I2C1); }
+void I2C1_ER_IRQHandler(void) { erdp_i2c_er_irq_handler(ERDP_I2C1); }
+void I2C2_EV_IRQHandler(void) { erdp_i2c_ev_irq_handler(ERDP_I2C2); }
+void I2C2_ER_IRQHandler(void) { erdp_i2c_er_irq_handler(ERDP_I2C2); }
+void I2C3_EV_IRQHandler(void) { erdp_i2c_ev_irq_handler(ERDP_I2C3); }
+void I2C3_ER_IRQHandler(void) { erdp_i2c_er_irq_handler(ERDP_I2C3); }
@@ -0,0 +1,186 @@
+/* erdp include */
+#include "erdp_if_sdio.h"
+
+/* platform include */
+#include "stm32f4xx.h"
+#include "stm32f4xx_gpio.h"
+#include "stm32f4xx_rcc.h"
+#include "stm32f4xx_sdio.h"
+
+extern void erdp_sdio_irq_handler(void);
+
+/* 64 SDIO_CK cycles at 400kHz plus margin, in SDIO_STA polls */
+#define SDIO_CMD_TIMEOUT 100000U
+
+const static uint32_t sdio_response[] = {
+    SDIO_Response_No,
+    SDIO_Response_Short,
+    SDIO_Response_Short,
+    SDIO_Response_Long,
+};
+
+const static uint32_t sdio_resp_reg[] = {
+    SDIO_RESP1,
+    SDIO_RESP2,
+    SDIO_RESP3,
+    SDIO_RESP4,
+};
+
+static void erdp_if_sdio_pin_init(GPIO_TypeDef *port, uint16_t pin, uint8_t pin_source)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+
+    GPIO_PinAFConfig(port, pin_source, GPIO_AF_SDIO);
+    GPIO_InitStructure.GPIO_Pin = pin;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_100MHz;
+    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;
+    GPIO_InitStructure.GPIO_PuPd = (pin == GPIO_Pin_12 && port == GPIOC) ? GPIO_PuPd_NOPULL : GPIO_PuPd_UP;
+    GPIO_Init(port, &GPIO_InitStructure);
+}
+
+void erdp_if_sdio_gpio_init(void)
+{
+    RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_GPIOC | RCC_AHB1Periph_GPIOD, ENABLE);
+    erdp_if_sdio_pin_init(GPIOC, GPIO_Pin_8, GPIO_PinSource8);
+    erdp_if_sdio_pin_init(GPIOC, GPIO_Pin_9, GPIO_PinSource9);
+    erdp_if_sdio_pin_init(GPIOC, GPIO_Pin_10, GPIO_PinSource10);
+    erdp_if_sdio_pin_init(GPIOC, GPIO_Pin_11, GPIO_PinSource11);
+    erdp_if_sdio_pin_init(GPIOC, GPIO_Pin_12, GPIO_PinSource12);
+    erdp_if_sdio_pin_init(GPIOD, GPIO_Pin_2, GPIO_PinSource2);
+}
+
+void erdp_if_sdio_init(uint8_t priority)
+{
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_SDIO, ENABLE);
+    SDIO_DeInit();
+    erdp_if_sdio_set_bus(ERDP_SDIO_INIT_DIV, false, false);
+    SDIO_SetPowerState(SDIO_PowerState_ON);
+    SDIO_ClockCmd(ENABLE);
+
+    NVIC_InitStructure.NVIC_IRQChannel = SDIO_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = priority;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+
+void erdp_if_sdio_deinit(void)
+{
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    NVIC_InitStructure.NVIC_IRQChannel = SDIO_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = DISABLE;
+    NVIC_Init(&NVIC_InitStructure);
+    SDIO_ClockCmd(DISABLE);
+    SDIO_SetPowerState(SDIO_PowerState_OFF);
+    SDIO_DeInit();
+}
+
+void erdp_if_sdio_set_bus(uint8_t clk_div, bool bypass, bool wide)
+{
+    SDIO_InitTypeDef SDIO_InitStructure;
+
+    SDIO_InitStructure.SDIO_ClockDiv = clk_div;
+    SDIO_InitStructure.SDIO_ClockEdge = SDIO_ClockEdge_Rising;
+    SDIO_InitStructure.SDIO_ClockBypass = bypass ? SDIO_ClockBypass_Enable : SDIO_ClockBypass_Disable;
+    SDIO_InitStructure.SDIO_ClockPowerSave = SDIO_ClockPowerSave_Disable;
+    SDIO_InitStructure.SDIO_BusWide = wide ? SDIO_BusWide_4b : SDIO_BusWide_1b;
+    SDIO_InitStructure.SDIO_HardwareFlowControl = SDIO_HardwareFlowControl_Disable;
+    SDIO_Init(&SDIO_InitStructure);
+}
+
+ERDP_SdioStatus_t erdp_if_sdio_command(uint8_t cmd, uint32_t arg, ERDP_SdioResp_t resp)
+{
+    SDIO_CmdInitTypeDef SDIO_CmdInitStructure;
+    uint32_t done = (resp == ERDP_SDIO_RESP_NONE) ? ERDP_SDIO_FLAG_CMDSENT
+                                                  : (ERDP_SDIO_FLAG_CMDREND | ERDP_SDIO_FLAG_CCRCFAIL |
+                                                     ERDP_SDIO_FLAG_CTIMEOUT);
+    uint32_t timeout = SDIO_CMD_TIMEOUT;
+    uint32_t status;
+
+    SDIO_ClearFlag(ERDP_SDIO_FLAG_CCRCFAIL | ERDP_SDIO_FLAG_CTIMEOUT | ERDP_SDIO_FLAG_CMDREND |
+                   ERDP_SDIO_FLAG_CMDSENT);
+    SDIO_CmdInitStructure.SDIO_Argument = arg;
+    SDIO_CmdInitStructure.SDIO_CmdIndex = cmd;
+    SDIO_CmdInitStructure.SDIO_Response = sdio_response[resp];
+    SDIO_CmdInitStructure.SDIO_Wait = SDIO_Wait_No;
+    SDIO_CmdInitStructure.SDIO_CPSM = SDIO_CPSM_Enable;
+    SDIO_SendCommand(&SDIO_CmdInitStructure);
+
+    do
+    {
+        status = SDIO->STA;
+    } while (!(status & done) && --timeout);
+
+    SDIO_ClearFlag(ERDP_SDIO_FLAG_CCRCFAIL | ERDP_SDIO_FLAG_CTIMEOUT | ERDP_SDIO_FLAG_CMDREND |
+                   ERDP_SDIO_FLAG_CMDSENT);
+    if (timeout == 0 || (status & ERDP_SDIO_FLAG_CTIMEOUT))
+    {
+        return ERDP_SDIO_CMD_TIMEOUT;
+    }
+    if ((status & ERDP_SDIO_FLAG_CCRCFAIL) && resp != ERDP_SDIO_RESP_SHORT_NO_CRC)
+    {
+        return ERDP_SDIO_CMD_CRC_FAIL;
+    }
+    return ERDP_SDIO_OK;
+}
+
+uint32_t erdp_if_sdio_get_response(uint8_t index)
+{
+    return SDIO_GetResponse(sdio_resp_reg[index & 0x03U]);
+}
+
+void erdp_if_sdio_data_config(uint32_t length, uint8_t block_size_log2, bool to_card, uint32_t timeout, bool dma)
+{
+    SDIO_DataInitTypeDef SDIO_DataInitStructure;
+
+    SDIO_ClearFlag(ERDP_SDIO_FLAG_DATA_ERRORS | ERDP_SDIO_FLAG_DATAEND);
+    SDIO_DataInitStructure.SDIO_DataTimeOut = timeout;
+    SDIO_DataInitStructure.SDIO_DataLength = length;
+    SDIO_DataInitStructure.SDIO_DataBlockSize = (uint32_t)block_size_log2 << 4;
+    SDIO_DataInitStructure.SDIO_TransferDir = to_card ? SDIO_TransferDir_ToCard : SDIO_TransferDir_ToSDIO;
+    SDIO_DataInitStructure.SDIO_TransferMode = SDIO_TransferMode_Block;
+    SDIO_DataInitStructure.SDIO_DPSM = SDIO_DPSM_Enable;
+    SDIO_DMACmd(dma ? ENABLE : DISABLE);
+    SDIO_DataConfig(&SDIO_DataInitStructure);
+}
+
+uint32_t erdp_if_sdio_read_fifo(void)
+{
+    return SDIO_ReadData();
+}
+
+void erdp_if_sdio_data_irq(bool enable)
+{
+    SDIO_ITConfig(ERDP_SDIO_FLAG_DATA_ERRORS | ERDP_SDIO_FLAG_DATAEND, enable ? ENABLE : DISABLE);
+}
+
+uint32_t erdp_if_sdio_get_status(void)
+{
+    return SDIO->STA;
+}
+
+void erdp_if_sdio_clear_flags(uint32_t flags)
+{
+    SDIO->ICR = flags & ERDP_SDIO_FLAG_STATIC;
+}
+
+uint32_t erdp_if_sdio_get_fifo_addr(void)
+{
+    return (uint32_t)(&SDIO->FIFO);
+}
+
+ERDP_DmaRequest_t erdp_if_sdio_get_dma_request(void)
+{
+    return ERDP_DMA_REQ_SDIO;
+}
+
+void SDIO_IRQHandler(void)
+{
+    erdp_sdio_irq_handler();
+}
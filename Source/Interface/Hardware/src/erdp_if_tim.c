@@ -0,0 +1,421 @@
+/* erdp include */
+#include "erdp_if_tim.h"
+
+/* platform include */
+#include "stm32f4xx.h"
+#include "stm32f4xx_gpio.h"
+#include "stm32f4xx_rcc.h"
+#include "stm32f4xx_tim.h"
+
+extern void erdp_tim_irq_handler(ERDP_Tim_t tim);
+extern void erdp_dac_irq_handler(void);
+
+const static uint32_t tim_instance[ERDP_TIM_NUM] = {
+    0,
+    (uint32_t)TIM1,  (uint32_t)TIM2,  (uint32_t)TIM3,  (uint32_t)TIM4,  (uint32_t)TIM5,
+    (uint32_t)TIM6,  (uint32_t)TIM7,  (uint32_t)TIM8,  (uint32_t)TIM9,  (uint32_t)TIM10,
+    (uint32_t)TIM11, (uint32_t)TIM12, (uint32_t)TIM13, (uint32_t)TIM14,
+};
+
+const static uint32_t tim_pclk[ERDP_TIM_NUM] = {
+    0,
+    RCC_APB2Periph_TIM1,
+    RCC_APB1Periph_TIM2,
+    RCC_APB1Periph_TIM3,
+    RCC_APB1Periph_TIM4,
+    RCC_APB1Periph_TIM5,
+    RCC_APB1Periph_TIM6,
+    RCC_APB1Periph_TIM7,
+    RCC_APB2Periph_TIM8,
+    RCC_APB2Periph_TIM9,
+    RCC_APB2Periph_TIM10,
+    RCC_APB2Periph_TIM11,
+    RCC_APB1Periph_TIM12,
+    RCC_APB1Periph_TIM13,
+    RCC_APB1Periph_TIM14,
+};
+
+typedef void (*rcc_clock_cmd_func_t)(uint32_t RCC_APBxPeriph, FunctionalState NewState);
+const static rcc_clock_cmd_func_t rcc_clock_cmd_func[ERDP_TIM_NUM] = {
+    NULL,
+    RCC_APB2PeriphClockCmd, RCC_APB1PeriphClockCmd, RCC_APB1PeriphClockCmd, RCC_APB1PeriphClockCmd,
+    RCC_APB1PeriphClockCmd, RCC_APB1PeriphClockCmd, RCC_APB1PeriphClockCmd, RCC_APB2PeriphClockCmd,
+    RCC_APB2PeriphClockCmd, RCC_APB2PeriphClockCmd, RCC_APB2PeriphClockCmd, RCC_APB1PeriphClockCmd,
+    RCC_APB1PeriphClockCmd, RCC_APB1PeriphClockCmd,
+};
+
+/* Vector of the update interrupt */
+const static uint8_t tim_up_irq[ERDP_TIM_NUM] = {
+    0,
+    TIM1_UP_TIM10_IRQn,      TIM2_IRQn,          TIM3_IRQn,          TIM4_IRQn,
+    TIM5_IRQn,               TIM6_DAC_IRQn,      TIM7_IRQn,          TIM8_UP_TIM13_IRQn,
+    TIM1_BRK_TIM9_IRQn,      TIM1_UP_TIM10_IRQn, TIM1_TRG_COM_TIM11_IRQn, TIM8_BRK_TIM12_IRQn,
+    TIM8_UP_TIM13_IRQn,      TIM8_TRG_COM_TIM14_IRQn,
+};
+
+/* Vector of the capture/compare interrupts, only advanced timers have a dedicated one */
+const static uint8_t tim_cc_irq[ERDP_TIM_NUM] = {
+    0,
+    TIM1_CC_IRQn,            TIM2_IRQn,          TIM3_IRQn,          TIM4_IRQn,
+    TIM5_IRQn,               TIM6_DAC_IRQn,      TIM7_IRQn,          TIM8_CC_IRQn,
+    TIM1_BRK_TIM9_IRQn,      TIM1_UP_TIM10_IRQn, TIM1_TRG_COM_TIM11_IRQn, TIM8_BRK_TIM12_IRQn,
+    TIM8_UP_TIM13_IRQn,      TIM8_TRG_COM_TIM14_IRQn,
+};
+
+const static uint8_t tim_af[ERDP_TIM_NUM] = {
+    0,
+    GPIO_AF_TIM1,  GPIO_AF_TIM2,  GPIO_AF_TIM3,  GPIO_AF_TIM4,  GPIO_AF_TIM5,
+    0,             0,             GPIO_AF_TIM8,  GPIO_AF_TIM9,  GPIO_AF_TIM10,
+    GPIO_AF_TIM11, GPIO_AF_TIM12, GPIO_AF_TIM13, GPIO_AF_TIM14,
+};
+
+/* DMA request of each timer event: update, CC1, CC2, CC3, CC4 */
+const static ERDP_DmaRequest_t tim_dma_request[ERDP_TIM_NUM][ERDP_TIM_EVENT_NUM] = {
+    {ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE},
+    /* TIM1 */
+    {ERDP_DMA_REQ_TIM1_UP, ERDP_DMA_REQ_TIM1_CH1, ERDP_DMA_REQ_TIM1_CH2,
+     ERDP_DMA_REQ_TIM1_CH3, ERDP_DMA_REQ_TIM1_CH4},
+    /* TIM2 */
+    {ERDP_DMA_REQ_TIM2_UP, ERDP_DMA_REQ_TIM2_CH1, ERDP_DMA_REQ_TIM2_CH2,
+     ERDP_DMA_REQ_TIM2_CH3, ERDP_DMA_REQ_TIM2_CH4},
+    /* TIM3 */
+    {ERDP_DMA_REQ_TIM3_UP, ERDP_DMA_REQ_TIM3_CH1, ERDP_DMA_REQ_TIM3_CH2,
+     ERDP_DMA_REQ_TIM3_CH3, ERDP_DMA_REQ_TIM3_CH4},
+    /* TIM4 */
+    {ERDP_DMA_REQ_TIM4_UP, ERDP_DMA_REQ_TIM4_CH1, ERDP_DMA_REQ_TIM4_CH2,
+     ERDP_DMA_REQ_TIM4_CH3, ERDP_DMA_REQ_NONE},
+    /* TIM5 */
+    {ERDP_DMA_REQ_TIM5_UP, ERDP_DMA_REQ_TIM5_CH1, ERDP_DMA_REQ_TIM5_CH2,
+     ERDP_DMA_REQ_TIM5_CH3, ERDP_DMA_REQ_TIM5_CH4},
+    /* TIM6 */
+    {ERDP_DMA_REQ_TIM6_UP, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE,
+     ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE},
+    /* TIM7 */
+    {ERDP_DMA_REQ_TIM7_UP, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE,
+     ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE},
+    /* TIM8 */
+    {ERDP_DMA_REQ_TIM8_UP, ERDP_DMA_REQ_TIM8_CH1, ERDP_DMA_REQ_TIM8_CH2,
+     ERDP_DMA_REQ_TIM8_CH3, ERDP_DMA_REQ_TIM8_CH4},
+    /* TIM9 .. TIM14 have no DMA requests */
+    {ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE},
+    {ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE},
+    {ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE},
+    {ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE},
+    {ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE},
+    {ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE, ERDP_DMA_REQ_NONE},
+};
+
+const static uint16_t tim_channel[ERDP_TIM_CH_NUM] = {
+    TIM_Channel_1,
+    TIM_Channel_2,
+    TIM_Channel_3,
+    TIM_Channel_4,
+};
+
+static bool erdp_if_tim_is_apb2(ERDP_Tim_t tim)
+{
+    return tim == ERDP_TIM1 || tim == ERDP_TIM8 || tim == ERDP_TIM9 || tim == ERDP_TIM10 || tim == ERDP_TIM11;
+}
+
+static bool erdp_if_tim_is_advanced(ERDP_Tim_t tim)
+{
+    return tim == ERDP_TIM1 || tim == ERDP_TIM8;
+}
+
+static void erdp_if_tim_nvic_init(uint8_t irq, uint8_t priority)
+{
+    NVIC_InitTypeDef NVIC_InitStructure;
+    NVIC_InitStructure.NVIC_IRQChannel = irq;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = priority;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+
+uint32_t erdp_if_tim_get_base(ERDP_Tim_t tim) { return tim_instance[tim]; }
+
+uint32_t erdp_if_tim_get_clock(ERDP_Tim_t tim)
+{
+    RCC_ClocksTypeDef clocks;
+    RCC_GetClocksFreq(&clocks);
+    if (erdp_if_tim_is_apb2(tim))
+    {
+        return (clocks.PCLK2_Frequency == clocks.HCLK_Frequency) ? clocks.PCLK2_Frequency
+                                                                 : clocks.PCLK2_Frequency * 2;
+    }
+    return (clocks.PCLK1_Frequency == clocks.HCLK_Frequency) ? clocks.PCLK1_Frequency : clocks.PCLK1_Frequency * 2;
+}
+
+bool erdp_if_tim_is_32bit(ERDP_Tim_t tim) { return tim == ERDP_TIM2 || tim == ERDP_TIM5; }
+
+void erdp_if_tim_gpio_init(ERDP_Tim_t tim, ERDP_GpioPort_t port, ERDP_GpioPin_t pin)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+    GPIO_TypeDef *gpio_periph = (GPIO_TypeDef *)erdp_if_gpio_get_port(port);
+
+    RCC_AHB1PeriphClockCmd(erdp_if_gpio_get_PCLK(port), ENABLE);
+    GPIO_PinAFConfig(gpio_periph, pin, tim_af[tim]);
+
+    GPIO_InitStructure.GPIO_Pin = erdp_if_gpio_get_pin(pin);
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_100MHz;
+    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;
+    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_NOPULL;
+    GPIO_Init(gpio_periph, &GPIO_InitStructure);
+}
+
+void erdp_if_tim_base_init(ERDP_Tim_t tim, uint32_t prescaler, uint32_t period, bool one_pulse, uint8_t priority)
+{
+    TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
+    TIM_TypeDef *tim_periph = (TIM_TypeDef *)tim_instance[tim];
+
+    rcc_clock_cmd_func[tim](tim_pclk[tim], ENABLE);
+    TIM_DeInit(tim_periph);
+
+    TIM_TimeBaseStructure.TIM_Prescaler = (uint16_t)prescaler;
+    TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
+    TIM_TimeBaseStructure.TIM_Period = period;
+    TIM_TimeBaseStructure.TIM_ClockDivision = TIM_CKD_DIV1;
+    TIM_TimeBaseStructure.TIM_RepetitionCounter = 0;
+    TIM_TimeBaseInit(tim_periph, &TIM_TimeBaseStructure);    // Also generates an update to load PSC
+
+    TIM_ARRPreloadConfig(tim_periph, ENABLE);
+    TIM_UpdateRequestConfig(tim_periph, TIM_UpdateSource_Regular);    // Only overflow raises update IRQ/DMA
+    TIM_SelectOnePulseMode(tim_periph, one_pulse ? TIM_OPMode_Single : TIM_OPMode_Repetitive);
+    tim_periph->DIER = 0;
+    tim_periph->SR = 0;
+
+    erdp_if_tim_nvic_init(tim_up_irq[tim], priority);
+    if (tim_cc_irq[tim] != tim_up_irq[tim])
+    {
+        erdp_if_tim_nvic_init(tim_cc_irq[tim], priority);
+    }
+}
+
+void erdp_if_tim_deinit(ERDP_Tim_t tim)
+{
+    TIM_TypeDef *tim_periph = (TIM_TypeDef *)tim_instance[tim];
+    TIM_Cmd(tim_periph, DISABLE);
+    tim_periph->DIER = 0;
+    TIM_DeInit(tim_periph);
+}
+
+void erdp_if_tim_enable(ERDP_Tim_t tim, bool enable)
+{
+    TIM_Cmd((TIM_TypeDef *)tim_instance[tim], enable ? ENABLE : DISABLE);
+}
+
+void erdp_if_tim_set_timebase(ERDP_Tim_t tim, uint32_t prescaler, uint32_t period)
+{
+    TIM_TypeDef *tim_periph = (TIM_TypeDef *)tim_instance[tim];
+    tim_periph->ARR = period;
+    tim_periph->PSC = (uint16_t)prescaler;
+    tim_periph->EGR = TIM_PSCReloadMode_Immediate;    // Reload PSC/ARR and reset the counter
+    tim_periph->SR = (uint16_t)~TIM_FLAG_Update;
+}
+
+void erdp_if_tim_trgo_update(ERDP_Tim_t tim, bool enable)
+{
+    TIM_SelectOutputTrigger((TIM_TypeDef *)tim_instance[tim], enable ? TIM_TRGOSource_Update : TIM_TRGOSource_Reset);
+}
+
+void erdp_if_tim_set_period(ERDP_Tim_t tim, uint32_t period) { ((TIM_TypeDef *)tim_instance[tim])->ARR = period; }
+
+void erdp_if_tim_set_counter(ERDP_Tim_t tim, uint32_t counter) { ((TIM_TypeDef *)tim_instance[tim])->CNT = counter; }
+
+uint32_t erdp_if_tim_get_counter(ERDP_Tim_t tim) { return ((TIM_TypeDef *)tim_instance[tim])->CNT; }
+
+void erdp_if_tim_irq_enable(ERDP_Tim_t tim, uint32_t event_mask, bool enable)
+{
+    /* ERDP_TIM_EVENT_MASK() matches the TIM_IT_Update/TIM_IT_CCx bit layout */
+    TIM_ITConfig((TIM_TypeDef *)tim_instance[tim], (uint16_t)(event_mask & 0x1FU), enable ? ENABLE : DISABLE);
+}
+
+uint32_t erdp_if_tim_get_irq_status(ERDP_Tim_t tim)
+{
+    TIM_TypeDef *tim_periph = (TIM_TypeDef *)tim_instance[tim];
+    return (uint32_t)(tim_periph->SR & tim_periph->DIER) & 0x1FU;
+}
+
+uint32_t erdp_if_tim_get_flags(ERDP_Tim_t tim) { return (uint32_t)((TIM_TypeDef *)tim_instance[tim])->SR & 0x1FU; }
+
+void erdp_if_tim_clear_flags(ERDP_Tim_t tim, uint32_t event_mask)
+{
+    ((TIM_TypeDef *)tim_instance[tim])->SR = (uint16_t)~(event_mask & 0x1FU);
+}
+
+void erdp_if_tim_ic_init(ERDP_Tim_t tim, ERDP_TimChannel_t channel, ERDP_TimEdge_t edge, uint8_t filter)
+{
+    TIM_ICInitTypeDef TIM_ICInitStructure;
+
+    switch (edge)
+    {
+        case ERDP_TIM_EDGE_FALLING:
+            TIM_ICInitStructure.TIM_ICPolarity = TIM_ICPolarity_Falling;
+            break;
+        case ERDP_TIM_EDGE_BOTH:
+            TIM_ICInitStructure.TIM_ICPolarity = TIM_ICPolarity_BothEdge;
+            break;
+        case ERDP_TIM_EDGE_RISING:
+        default:
+            TIM_ICInitStructure.TIM_ICPolarity = TIM_ICPolarity_Rising;
+            break;
+    }
+    TIM_ICInitStructure.TIM_Channel = tim_channel[channel];
+    TIM_ICInitStructure.TIM_ICSelection = TIM_ICSelection_DirectTI;
+    TIM_ICInitStructure.TIM_ICPrescaler = TIM_ICPSC_DIV1;
+    TIM_ICInitStructure.TIM_ICFilter = filter & 0x0FU;
+    TIM_ICInit((TIM_TypeDef *)tim_instance[tim], &TIM_ICInitStructure);
+}
+
+uint32_t erdp_if_tim_get_capture(ERDP_Tim_t tim, ERDP_TimChannel_t channel)
+{
+    return *(volatile uint32_t *)erdp_if_tim_get_ccr_addr(tim, channel);
+}
+
+void erdp_if_tim_ic_prescaler(ERDP_Tim_t tim, ERDP_TimChannel_t channel, uint8_t edges)
+{
+    TIM_TypeDef *tim_periph = (TIM_TypeDef *)tim_instance[tim];
+    uint16_t psc;
+
+    switch (edges)
+    {
+        case 2:
+            psc = TIM_ICPSC_DIV2;
+            break;
+        case 4:
+            psc = TIM_ICPSC_DIV4;
+            break;
+        case 8:
+            psc = TIM_ICPSC_DIV8;
+            break;
+        default:
+            psc = TIM_ICPSC_DIV1;
+            break;
+    }
+    switch (channel)
+    {
+        case ERDP_TIM_CH1:
+            TIM_SetIC1Prescaler(tim_periph, psc);
+            break;
+        case ERDP_TIM_CH2:
+            TIM_SetIC2Prescaler(tim_periph, psc);
+            break;
+        case ERDP_TIM_CH3:
+            TIM_SetIC3Prescaler(tim_periph, psc);
+            break;
+        case ERDP_TIM_CH4:
+            TIM_SetIC4Prescaler(tim_periph, psc);
+            break;
+        default:
+            break;
+    }
+}
+
+void erdp_if_tim_encoder_init(ERDP_Tim_t tim, uint8_t filter, bool invert)
+{
+    TIM_TypeDef *tim_periph = (TIM_TypeDef *)tim_instance[tim];
+
+    /* Filters first, the encoder configuration keeps the ICxF bits */
+    erdp_if_tim_ic_init(tim, ERDP_TIM_CH1, ERDP_TIM_EDGE_RISING, filter);
+    erdp_if_tim_ic_init(tim, ERDP_TIM_CH2, ERDP_TIM_EDGE_RISING, filter);
+    TIM_EncoderInterfaceConfig(tim_periph, TIM_EncoderMode_TI12,
+                               invert ? TIM_ICPolarity_Falling : TIM_ICPolarity_Rising, TIM_ICPolarity_Rising);
+    tim_periph->CNT = 0;
+}
+
+void erdp_if_tim_pwm_init(ERDP_Tim_t tim, ERDP_TimChannel_t channel, uint32_t pulse, bool active_high)
+{
+    TIM_OCInitTypeDef TIM_OCInitStructure;
+    TIM_TypeDef *tim_periph = (TIM_TypeDef *)tim_instance[tim];
+
+    TIM_OCStructInit(&TIM_OCInitStructure);
+    TIM_OCInitStructure.TIM_OCMode = TIM_OCMode_PWM1;
+    TIM_OCInitStructure.TIM_OutputState = TIM_OutputState_Enable;
+    TIM_OCInitStructure.TIM_Pulse = pulse;
+    TIM_OCInitStructure.TIM_OCPolarity = active_high ? TIM_OCPolarity_High : TIM_OCPolarity_Low;
+    TIM_OCInitStructure.TIM_OCIdleState = TIM_OCIdleState_Reset;
+
+    switch (channel)
+    {
+        case ERDP_TIM_CH1:
+            TIM_OC1Init(tim_periph, &TIM_OCInitStructure);
+            TIM_OC1PreloadConfig(tim_periph, TIM_OCPreload_Enable);
+            break;
+        case ERDP_TIM_CH2:
+            TIM_OC2Init(tim_periph, &TIM_OCInitStructure);
+            TIM_OC2PreloadConfig(tim_periph, TIM_OCPreload_Enable);
+            break;
+        case ERDP_TIM_CH3:
+            TIM_OC3Init(tim_periph, &TIM_OCInitStructure);
+            TIM_OC3PreloadConfig(tim_periph, TIM_OCPreload_Enable);
+            break;
+        case ERDP_TIM_CH4:
+            TIM_OC4Init(tim_periph, &TIM_OCInitStructure);
+            TIM_OC4PreloadConfig(tim_periph, TIM_OCPreload_Enable);
+            break;
+        default:
+            break;
+    }
+
+    if (erdp_if_tim_is_advanced(tim))
+    {
+        TIM_CtrlPWMOutputs(tim_periph, ENABLE);    // Main output enable
+    }
+}
+
+void erdp_if_tim_set_compare(ERDP_Tim_t tim, ERDP_TimChannel_t channel, uint32_t value)
+{
+    *(volatile uint32_t *)erdp_if_tim_get_ccr_addr(tim, channel) = value;
+}
+
+uint32_t erdp_if_tim_get_ccr_addr(ERDP_Tim_t tim, ERDP_TimChannel_t channel)
+{
+    return (uint32_t)(&((TIM_TypeDef *)tim_instance[tim])->CCR1 + channel);
+}
+
+void erdp_if_tim_dma_enable(ERDP_Tim_t tim, ERDP_TimEvent_t event, bool enable)
+{
+    /* TIM_DMA_Update/TIM_DMA_CCx are the event bits shifted by 8 */
+    TIM_DMACmd((TIM_TypeDef *)tim_instance[tim], (uint16_t)(ERDP_TIM_EVENT_MASK(event) << 8), enable ? ENABLE : DISABLE);
+}
+
+uint32_t erdp_if_tim_dma_burst_config(ERDP_Tim_t tim, ERDP_TimChannel_t first_channel, uint8_t length)
+{
+    TIM_TypeDef *tim_periph = (TIM_TypeDef *)tim_instance[tim];
+    TIM_DMAConfig(tim_periph, (uint16_t)(TIM_DMABase_CCR1 + first_channel), (uint16_t)((length - 1U) << 8));
+    return (uint32_t)(&tim_periph->DMAR);
+}
+
+ERDP_DmaRequest_t erdp_if_tim_get_dma_request(ERDP_Tim_t tim, ERDP_TimEvent_t event)
+{
+    return tim_dma_request[tim][event];
+}
+
+/* Shared vectors dispatch to every timer on the line, the HAL only acts on pending enabled events */
+void TIM1_BRK_TIM9_IRQHandler(void) { erdp_tim_irq_handler(ERDP_TIM9); }
+void TIM1_UP_TIM10_IRQHandler(void)
+{
+    erdp_tim_irq_handler(ERDP_TIM1);
+    erdp_tim_irq_handler(ERDP_TIM10);
+}
+void TIM1_TRG_COM_TIM11_IRQHandler(void) { erdp_tim_irq_handler(ERDP_TIM11); }
+void TIM1_CC_IRQHandler(void) { erdp_tim_irq_handler(ERDP_TIM1); }
+void TIM2_IRQHandler(void) { erdp_tim_irq_handler(ERDP_TIM2); }
+void TIM3_IRQHandler(void) { erdp_tim_irq_handler(ERDP_TIM3); }
+void TIM4_IRQHandler(void) { erdp_tim_irq_handler(ERDP_TIM4); }
+void TIM5_IRQHandler(void) { erdp_tim_irq_handler(ERDP_TIM5); }
+void TIM6_DAC_IRQHandler(void)
+{
+    erdp_tim_irq_handler(ERDP_TIM6);
+    erdp_dac_irq_handler();
+}
+void TIM7_IRQHandler(void) { erdp_tim_irq_handler(ERDP_TIM7); }
+void TIM8_BRK_TIM12_IRQHandler(void) { erdp_tim_irq_handler(ERDP_TIM12); }
+void TIM8_UP_TIM13_IRQHandler(void)
+{
+    erdp_tim_irq_handler(ERDP_TIM8);
+    erdp_tim_irq_handler(ERDP_TIM13);
+}
+void TIM8_TRG_COM_TIM14_IRQHandler(void) { erdp_tim_irq_handler(ERDP_TIM14); }
+void TIM8_CC_IRQHandler(void) { erdp_tim_irq_handler(ERDP_TIM8); }
@@ -12,6 +12,14 @@ OS_TaskHandle erdp_if_rtos_task_create(void (*task_function)(void *),
     return (OS_TaskHandle)xHandle;
 }
 
+OS_TaskHandle erdp_if_rtos_task_create_static(void (*task_function)(void *),
+                                              const char *name, uint32_t stack_size,
+                                              void *arg, uint32_t priority, OS_Stack *stack,
+                                              OS_TaskBuffer *task_buffer)
+{
+    return (OS_TaskHandle)xTaskCreateStatic(task_function, name, stack_size, arg, priority, stack, task_buffer);
+}
+
 void erdp_if_rtos_task_delete(OS_TaskHandle task_handle)
 {
     if (task_handle != NULL)
@@ -40,6 +48,80 @@ void erdp_if_rtos_task_resume(OS_TaskHandle task_handle)
     }
 }
 
+OS_TaskHandle erdp_if_rtos_task_get_current(void)
+{
+    return xTaskGetCurrentTaskHandle();
+}
+
+void erdp_if_rtos_task_notify_give(OS_TaskHandle task_handle, uint32_t index)
+{
+    if (xPortIsInsideInterrupt() == pdTRUE)
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        vTaskNotifyGiveIndexedFromISR(task_handle, index, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+        return;
+    }
+    xTaskNotifyGiveIndexed(task_handle, index);
+}
+
+uint32_t erdp_if_rtos_task_notify_take(uint32_t index, bool clear_on_exit, uint32_t ticks_to_wait)
+{
+    return (uint32_t)ulTaskNotifyTakeIndexed(index, clear_on_exit ? pdTRUE : pdFALSE, ticks_to_wait);
+}
+
+void erdp_if_rtos_task_notify_set_bits(OS_TaskHandle task_handle, uint32_t index, uint32_t bits)
+{
+    if (xPortIsInsideInterrupt() == pdTRUE)
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        xTaskNotifyIndexedFromISR(task_handle, index, bits, eSetBits, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+        return;
+    }
+    xTaskNotifyIndexed(task_handle, index, bits, eSetBits);
+}
+
+uint32_t erdp_if_rtos_task_notify_clear_bits(OS_TaskHandle task_handle, uint32_t index, uint32_t bits)
+{
+    return (uint32_t)ulTaskNotifyValueClearIndexed(task_handle, index, bits);
+}
+
+uint32_t erdp_if_rtos_task_notify_wait_bits(uint32_t index, uint32_t bits_to_wait, bool wait_for_all,
+                                            bool clear_on_exit, uint32_t ticks_to_wait)
+{
+    TimeOut_t timeout;
+    TickType_t remaining = ticks_to_wait;
+    uint32_t value;
+
+    vTaskSetTimeOutState(&timeout);
+    while (1)
+    {
+        /* Any notification since the last wait leaves the state pending, so a set between
+         * the read and the wait below makes the wait return at once */
+        value = (uint32_t)ulTaskNotifyValueClearIndexed(NULL, index, 0);
+        if (wait_for_all ? ((value & bits_to_wait) == bits_to_wait) : ((value & bits_to_wait) != 0))
+        {
+            if (clear_on_exit)
+            {
+                ulTaskNotifyValueClearIndexed(NULL, index, bits_to_wait);
+            }
+            return value;
+        }
+        if (xTaskCheckForTimeOut(&timeout, &remaining) == pdTRUE)
+        {
+            return value;
+        }
+        xTaskNotifyWaitIndexed(index, 0, 0, NULL, remaining);
+    }
+}
+
+void erdp_if_rtos_task_notify_reset(OS_TaskHandle task_handle, uint32_t index)
+{
+    ulTaskNotifyValueClearIndexed(task_handle, index, 0xFFFFFFFFU);
+    xTaskNotifyStateClearIndexed(task_handle, index);
+}
+
 void erdp_if_rtos_start_scheduler()
 {
     vTaskStartScheduler();
@@ -80,6 +162,12 @@ OS_Queue erdp_if_rtos_queue_create(uint32_t queue_length, uint32_t item_size)
     return xQueueCreate(queue_length, item_size);
 }
 
+OS_Queue erdp_if_rtos_queue_create_static(uint32_t queue_length, uint32_t item_size, uint8_t *storage,
+                                          OS_QueueBuffer *queue_buffer)
+{
+    return xQueueCreateStatic(queue_length, item_size, storage, queue_buffer);
+}
+
 bool erdp_if_rtos_queue_recv(OS_Queue os_queue, uint8_t *pxdata, uint32_t ticks_to_wait)
 {
     if (xPortIsInsideInterrupt() == pdTRUE)
@@ -119,8 +207,13 @@ bool erdp_if_rtos_queue_overwrite(OS_Queue os_queue, uint8_t *pxdata)
     return (bool)xQueueOverwrite(os_queue, pxdata);
 }
 
-void erdp_if_rtos_queue_index(OS_Queue os_queue, uint32_t index_base_tail)
+bool erdp_if_rtos_queue_peek(OS_Queue os_queue, uint8_t *pxdata, uint32_t ticks_to_wait)
 {
+    if (xPortIsInsideInterrupt() == pdTRUE)
+    {
+        return (bool)xQueuePeekFromISR(os_queue, pxdata);
+    }
+    return (bool)xQueuePeek(os_queue, pxdata, ticks_to_wait);
 }
 
 void erdp_if_rtos_queue_delet(OS_Queue os_queue)
@@ -128,6 +221,173 @@ void erdp_if_rtos_queue_delet(OS_Queue os_queue)
     vQueueDelete(os_queue);
 }
 
+OS_QueueSet erdp_if_rtos_queue_set_create(uint32_t length)
+{
+    return xQueueCreateSet(length);
+}
+
+OS_QueueSet erdp_if_rtos_queue_set_create_static(uint32_t length, uint8_t *storage, OS_QueueBuffer *queue_buffer)
+{
+    /* Same layout as xQueueCreateSet(), which has no static variant in this kernel version */
+    return (OS_QueueSet)xQueueGenericCreateStatic(length, sizeof(OS_QueueSetMember), storage, queue_buffer,
+                                                  queueQUEUE_TYPE_SET);
+}
+
+bool erdp_if_rtos_queue_set_add(OS_QueueSetMember member, OS_QueueSet queue_set)
+{
+    return (bool)xQueueAddToSet(member, queue_set);
+}
+
+bool erdp_if_rtos_queue_set_remove(OS_QueueSetMember member, OS_QueueSet queue_set)
+{
+    return (bool)xQueueRemoveFromSet(member, queue_set);
+}
+
+OS_QueueSetMember erdp_if_rtos_queue_set_select(OS_QueueSet queue_set, uint32_t ticks_to_wait)
+{
+    if (xPortIsInsideInterrupt() == pdTRUE)
+    {
+        return xQueueSelectFromSetFromISR(queue_set);
+    }
+    return xQueueSelectFromSet(queue_set, ticks_to_wait);
+}
+
+void erdp_if_rtos_queue_set_delete(OS_QueueSet queue_set)
+{
+    vQueueDelete((OS_Queue)queue_set);
+}
+
+OS_StreamBuffer erdp_if_rtos_stream_buffer_create(uint32_t size, uint32_t trigger_level)
+{
+    return xStreamBufferCreate(size, trigger_level);
+}
+
+OS_StreamBuffer erdp_if_rtos_stream_buffer_create_static(uint32_t size, uint32_t trigger_level, uint8_t *storage,
+                                                         OS_StreamBufferBuffer *stream_buffer)
+{
+    return xStreamBufferCreateStatic(size, trigger_level, storage, stream_buffer);
+}
+
+uint32_t erdp_if_rtos_stream_buffer_send(OS_StreamBuffer stream_buffer, const uint8_t *data, uint32_t len,
+                                         uint32_t ticks_to_wait)
+{
+    if (xPortIsInsideInterrupt() == pdTRUE)
+    {
+        uint32_t sent;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        sent = (uint32_t)xStreamBufferSendFromISR(stream_buffer, data, len, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+        return sent;
+    }
+    return (uint32_t)xStreamBufferSend(stream_buffer, data, len, ticks_to_wait);
+}
+
+uint32_t erdp_if_rtos_stream_buffer_recv(OS_StreamBuffer stream_buffer, uint8_t *data, uint32_t len,
+                                         uint32_t ticks_to_wait)
+{
+    if (xPortIsInsideInterrupt() == pdTRUE)
+    {
+        uint32_t received;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        received = (uint32_t)xStreamBufferReceiveFromISR(stream_buffer, data, len, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+        return received;
+    }
+    return (uint32_t)xStreamBufferReceive(stream_buffer, data, len, ticks_to_wait);
+}
+
+uint32_t erdp_if_rtos_stream_buffer_bytes_available(OS_StreamBuffer stream_buffer)
+{
+    return (uint32_t)xStreamBufferBytesAvailable(stream_buffer);
+}
+
+uint32_t erdp_if_rtos_stream_buffer_spaces_available(OS_StreamBuffer stream_buffer)
+{
+    return (uint32_t)xStreamBufferSpacesAvailable(stream_buffer);
+}
+
+bool erdp_if_rtos_stream_buffer_reset(OS_StreamBuffer stream_buffer)
+{
+    if (xPortIsInsideInterrupt() == pdTRUE)
+    {
+        return (bool)xStreamBufferResetFromISR(stream_buffer);
+    }
+    return (bool)xStreamBufferReset(stream_buffer);
+}
+
+bool erdp_if_rtos_stream_buffer_set_trigger_level(OS_StreamBuffer stream_buffer, uint32_t trigger_level)
+{
+    return (bool)xStreamBufferSetTriggerLevel(stream_buffer, trigger_level);
+}
+
+void erdp_if_rtos_stream_buffer_delete(OS_StreamBuffer stream_buffer)
+{
+    vStreamBufferDelete(stream_buffer);
+}
+
+OS_MessageBuffer erdp_if_rtos_message_buffer_create(uint32_t size)
+{
+    return xMessageBufferCreate(size);
+}
+
+OS_MessageBuffer erdp_if_rtos_message_buffer_create_static(uint32_t size, uint8_t *storage,
+                                                           OS_MessageBufferBuffer *message_buffer)
+{
+    return xMessageBufferCreateStatic(size, storage, message_buffer);
+}
+
+bool erdp_if_rtos_message_buffer_send(OS_MessageBuffer message_buffer, const uint8_t *data, uint32_t len,
+                                      uint32_t ticks_to_wait)
+{
+    if (xPortIsInsideInterrupt() == pdTRUE)
+    {
+        size_t sent;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        sent = xMessageBufferSendFromISR(message_buffer, data, len, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+        return sent == len;
+    }
+    return xMessageBufferSend(message_buffer, data, len, ticks_to_wait) == len;
+}
+
+uint32_t erdp_if_rtos_message_buffer_recv(OS_MessageBuffer message_buffer, uint8_t *data, uint32_t len,
+                                          uint32_t ticks_to_wait)
+{
+    if (xPortIsInsideInterrupt() == pdTRUE)
+    {
+        uint32_t received;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        received = (uint32_t)xMessageBufferReceiveFromISR(message_buffer, data, len, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+        return received;
+    }
+    return (uint32_t)xMessageBufferReceive(message_buffer, data, len, ticks_to_wait);
+}
+
+uint32_t erdp_if_rtos_message_buffer_next_length(OS_MessageBuffer message_buffer)
+{
+    return (uint32_t)xMessageBufferNextLengthBytes(message_buffer);
+}
+
+uint32_t erdp_if_rtos_message_buffer_spaces_available(OS_MessageBuffer message_buffer)
+{
+    return (uint32_t)xMessageBufferSpacesAvailable(message_buffer);
+}
+
+bool erdp_if_rtos_message_buffer_reset(OS_MessageBuffer message_buffer)
+{
+    if (xPortIsInsideInterrupt() == pdTRUE)
+    {
+        return (bool)xMessageBufferResetFromISR(message_buffer);
+    }
+    return (bool)xMessageBufferReset(message_buffer);
+}
+
+void erdp_if_rtos_message_buffer_delete(OS_MessageBuffer message_buffer)
+{
+    vMessageBufferDelete(message_buffer);
+}
+
 OS_List erdp_if_rtos_list_create(void)
 {
     OS_List list = (OS_List)erdp_if_rtos_malloc(sizeof(List_t));
@@ -218,6 +478,16 @@ OS_Event erdp_if_rtos_event_create(void)
     return xEventGroupCreate();
 }
 
+OS_Event erdp_if_rtos_event_create_static(OS_EventBuffer *event_buffer)
+{
+    return xEventGroupCreateStatic(event_buffer);
+}
+
+void erdp_if_rtos_event_delete(OS_Event event)
+{
+    vEventGroupDelete(event);
+}
+
 OS_EventBits erdp_if_rtos_set_event_bits(OS_Event event, OS_EventBits bits_to_set)
 {
     if (xPortIsInsideInterrupt() == pdTRUE)
@@ -288,6 +558,33 @@ OS_Semaphore erdp_if_rtos_counting_semaphore_creat(uint32_t max_count, uint32_t
     return xSemaphoreCreateCounting(max_count, initial_count);
 }
 
+OS_Semaphore erdp_if_rtos_semaphore_creat_static(Semaphore_tag tag, OS_SemaphoreBuffer *semaphore_buffer)
+{
+    switch (tag)
+    {
+    case BINARY_TAG:
+    {
+        return xSemaphoreCreateBinaryStatic(semaphore_buffer);
+    }
+    case MUTEX_TAG:
+    {
+        return xSemaphoreCreateMutexStatic(semaphore_buffer);
+    }
+    case RECURISIVE_TAG:
+    {
+        return xSemaphoreCreateRecursiveMutexStatic(semaphore_buffer);
+    }
+    default:break;
+    }
+    return NULL;
+}
+
+OS_Semaphore erdp_if_rtos_counting_semaphore_creat_static(uint32_t max_count, uint32_t initial_count,
+                                                          OS_SemaphoreBuffer *semaphore_buffer)
+{
+    return xSemaphoreCreateCountingStatic(max_count, initial_count, semaphore_buffer);
+}
+
 bool erdp_if_rtos_semaphore_take(OS_Semaphore semaphore, uint32_t ticks_to_wait)
 {
     if (xPortIsInsideInterrupt() == pdTRUE)
@@ -329,6 +626,120 @@ void erdp_if_rtos_semaphore_delet(OS_Semaphore semaphore)
     vSemaphoreDelete(semaphore);
 }
 
+OS_Timer erdp_if_rtos_timer_create_static(const char *name, uint32_t period_ticks, bool auto_reload, void *id,
+                                          void (*callback)(OS_Timer), OS_TimerBuffer *timer_buffer)
+{
+    return xTimerCreateStatic(name, period_ticks, auto_reload ? pdTRUE : pdFALSE, id, callback, timer_buffer);
+}
+
+void *erdp_if_rtos_timer_get_id(OS_Timer timer)
+{
+    return pvTimerGetTimerID(timer);
+}
+
+bool erdp_if_rtos_timer_start(OS_Timer timer, uint32_t ticks_to_wait)
+{
+    if (xPortIsInsideInterrupt() == pdTRUE)
+    {
+        bool os_sta;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        os_sta = (bool)xTimerStartFromISR(timer, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+        return os_sta;
+    }
+    return (bool)xTimerStart(timer, ticks_to_wait);
+}
+
+bool erdp_if_rtos_timer_stop(OS_Timer timer, uint32_t ticks_to_wait)
+{
+    if (xPortIsInsideInterrupt() == pdTRUE)
+    {
+        bool os_sta;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        os_sta = (bool)xTimerStopFromISR(timer, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+        return os_sta;
+    }
+    return (bool)xTimerStop(timer, ticks_to_wait);
+}
+
+bool erdp_if_rtos_timer_reset(OS_Timer timer, uint32_t ticks_to_wait)
+{
+    if (xPortIsInsideInterrupt() == pdTRUE)
+    {
+        bool os_sta;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        os_sta = (bool)xTimerResetFromISR(timer, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+        return os_sta;
+    }
+    return (bool)xTimerReset(timer, ticks_to_wait);
+}
+
+bool erdp_if_rtos_timer_change_period(OS_Timer timer, uint32_t period_ticks, uint32_t ticks_to_wait)
+{
+    if (xPortIsInsideInterrupt() == pdTRUE)
+    {
+        bool os_sta;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        os_sta = (bool)xTimerChangePeriodFromISR(timer, period_ticks, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+        return os_sta;
+    }
+    return (bool)xTimerChangePeriod(timer, period_ticks, ticks_to_wait);
+}
+
+bool erdp_if_rtos_timer_is_active(OS_Timer timer)
+{
+    return (bool)xTimerIsTimerActive(timer);
+}
+
+bool erdp_if_rtos_timer_delete(OS_Timer timer, uint32_t ticks_to_wait)
+{
+    return (bool)xTimerDelete(timer, ticks_to_wait);
+}
+
+static void erdp_if_rtos_timer_sync_callback(void *semaphore, uint32_t unused)
+{
+    (void)unused;
+    xSemaphoreGive((SemaphoreHandle_t)semaphore);
+}
+
+bool erdp_if_rtos_timer_sync(uint32_t ticks_to_wait)
+{
+    StaticSemaphore_t buffer;
+    SemaphoreHandle_t done;
+    bool os_sta = false;
+
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED)
+    {
+        return false;
+    }
+    /* The command queue is FIFO: the pended call runs after every command queued before it */
+    done = xSemaphoreCreateBinaryStatic(&buffer);
+    if (xTimerPendFunctionCall(erdp_if_rtos_timer_sync_callback, done, 0, ticks_to_wait) == pdPASS)
+    {
+        /* No timeout, the pended call refers to the semaphore on this stack */
+        os_sta = (bool)xSemaphoreTake(done, portMAX_DELAY);
+    }
+    vSemaphoreDelete(done);
+    return os_sta;
+}
+
+bool erdp_if_rtos_timer_in_task(void)
+{
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED)
+    {
+        return false;
+    }
+    return xTaskGetCurrentTaskHandle() == xTimerGetTimerDaemonTaskHandle();
+}
+
+bool erdp_if_rtos_in_isr(void)
+{
+    return xPortIsInsideInterrupt() == pdTRUE;
+}
+
 uint32_t erdp_if_rtos_cpu_lock(void)
 {
     if (xPortIsInsideInterrupt() == pdTRUE)
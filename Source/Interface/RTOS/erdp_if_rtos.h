@@ -12,6 +12,9 @@ extern "C"
 #include "queue.h"
 #include "task.h"
 #include "semphr.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "timers.h"
 #include "erdp_interface.h"
 
 /* Configuration Constants */
@@ -19,6 +22,8 @@ extern "C"
 #define OS_WAIT_FOREVER portMAX_DELAY /* Infinite blocking period */
 
     typedef TaskHandle_t OS_TaskHandle;
+    typedef StaticTask_t OS_TaskBuffer; /* Task control block storage for static creation */
+    typedef StackType_t OS_Stack;       /* Stack word */
 
     /* Task Control */
     /**
@@ -36,6 +41,23 @@ extern "C"
                                            const char *name, uint32_t stack_size, void *arg,
                                            uint32_t priority);
 
+    /**
+     * @brief Creates a new RTOS task in caller provided memory, without using the heap
+     * @param[in] task_function Pointer to the task entry function
+     * @param[in] name Descriptive name for the task (used for debugging)
+     * @param[in] stack_size Stack size in words (not bytes)
+     * @param[in] arg Pointer to be passed as parameter to the task function
+     * @param[in] priority Task priority (0=lowest, configMAX_PRIORITIES-1=highest)
+     * @param[in] stack Stack of stack_size words
+     * @param[in] task_buffer Storage for the task control block
+     * @return Task handle if created successfully, NULL otherwise
+     * @note stack and task_buffer must stay valid until the task is deleted
+     */
+    OS_TaskHandle erdp_if_rtos_task_create_static(void (*task_function)(void *),
+                                                  const char *name, uint32_t stack_size, void *arg,
+                                                  uint32_t priority, OS_Stack *stack,
+                                                  OS_TaskBuffer *task_buffer);
+
     /**
      * @brief Deletes a task and frees its memory.
      *        This function is used to remove a specific RTOS task from the system and
@@ -82,6 +104,74 @@ extern "C"
      */
     void erdp_if_rtos_task_resume(OS_TaskHandle task_handle);
 
+    /* Task Notification API */
+    /* Notification indexes per task, index 0 is used by the kernel stream and message buffers */
+#define OS_NOTIFY_INDEX_NUM configTASK_NOTIFICATION_ARRAY_ENTRIES
+
+    /**
+     * @brief Gets the handle of the calling task
+     * @return Handle of the running task
+     */
+    OS_TaskHandle erdp_if_rtos_task_get_current(void);
+
+    /**
+     * @brief Increments a notification value of a task, the task notification equivalent of a semaphore give
+     * @param[in] task_handle Task to notify
+     * @param[in] index Notification index, below OS_NOTIFY_INDEX_NUM
+     * @note Can be called from interrupts
+     */
+    void erdp_if_rtos_task_notify_give(OS_TaskHandle task_handle, uint32_t index);
+
+    /**
+     * @brief Waits for a notification value of the calling task to be non zero, then decrements or clears it
+     * @param[in] index Notification index, below OS_NOTIFY_INDEX_NUM
+     * @param[in] clear_on_exit true to clear the value (binary semaphore), false to decrement it (counting semaphore)
+     * @param[in] ticks_to_wait Maximum time to wait (in ticks)
+     * @return Value before it was cleared or decremented, 0 on timeout
+     * @note Task context only
+     */
+    uint32_t erdp_if_rtos_task_notify_take(uint32_t index, bool clear_on_exit, uint32_t ticks_to_wait);
+
+    /**
+     * @brief Sets bits in a notification value of a task
+     * @param[in] task_handle Task to notify
+     * @param[in] index Notification index, below OS_NOTIFY_INDEX_NUM
+     * @param[in] bits Bits to set
+     * @note Can be called from interrupts, the task is woken directly without the timer task
+     */
+    void erdp_if_rtos_task_notify_set_bits(OS_TaskHandle task_handle, uint32_t index, uint32_t bits);
+
+    /**
+     * @brief Clears bits in a notification value of a task
+     * @param[in] task_handle Task whose value is cleared, NULL for the calling task
+     * @param[in] index Notification index, below OS_NOTIFY_INDEX_NUM
+     * @param[in] bits Bits to clear, 0 to only read the value
+     * @return Value before the bits were cleared
+     * @note Task context only
+     */
+    uint32_t erdp_if_rtos_task_notify_clear_bits(OS_TaskHandle task_handle, uint32_t index, uint32_t bits);
+
+    /**
+     * @brief Waits for bits in a notification value of the calling task
+     * @param[in] index Notification index, below OS_NOTIFY_INDEX_NUM
+     * @param[in] bits_to_wait Bits to wait for
+     * @param[in] wait_for_all true to wait for all bits, false for any of them
+     * @param[in] clear_on_exit true to clear bits_to_wait when the wait succeeds
+     * @param[in] ticks_to_wait Maximum time to wait (in ticks)
+     * @return Value when the wait ended, before clearing; compare with bits_to_wait to detect a timeout
+     * @note Task context only
+     */
+    uint32_t erdp_if_rtos_task_notify_wait_bits(uint32_t index, uint32_t bits_to_wait, bool wait_for_all,
+                                                bool clear_on_exit, uint32_t ticks_to_wait);
+
+    /**
+     * @brief Clears a notification value and its pending state
+     * @param[in] task_handle Task whose notification is reset, NULL for the calling task
+     * @param[in] index Notification index, below OS_NOTIFY_INDEX_NUM
+     * @note Task context only
+     */
+    void erdp_if_rtos_task_notify_reset(OS_TaskHandle task_handle, uint32_t index);
+
     /* Scheduler Control */
     /**
      * @brief Starts the RTOS scheduler
@@ -144,6 +234,7 @@ extern "C"
 
     /* Queue API */
     typedef QueueHandle_t OS_Queue;
+    typedef StaticQueue_t OS_QueueBuffer; /* Queue control block storage for static creation */
 
     /**
      * @brief Creates a new queue instance
@@ -153,6 +244,17 @@ extern "C"
      */
     OS_Queue erdp_if_rtos_queue_create(uint32_t queue_length, uint32_t item_size);
 
+    /**
+     * @brief Creates a new queue instance in caller provided memory, without using the heap
+     * @param[in] queue_length Maximum number of items the queue can hold
+     * @param[in] item_size Size of each item in bytes
+     * @param[in] storage Item storage of queue_length * item_size bytes
+     * @param[in] queue_buffer Storage for the queue control block
+     * @return Handle to the created queue
+     */
+    OS_Queue erdp_if_rtos_queue_create_static(uint32_t queue_length, uint32_t item_size, uint8_t *storage,
+                                              OS_QueueBuffer *queue_buffer);
+
     /**
      * @brief Receives an item from a queue
      * @param[in] os_queue Handle to the queue
@@ -183,6 +285,15 @@ extern "C"
      */
     bool erdp_if_rtos_queue_overwrite(OS_Queue os_queue, uint8_t *pxdata);
 
+    /**
+     * @brief Copies the item at the front of a queue without removing it
+     * @param[in] os_queue Handle to the queue
+     * @param[out] pxdata Pointer to buffer that receives the item
+     * @param[in] ticks_to_wait Maximum time to wait for an item (in ticks), ignored in interrupts
+     * @return true if an item was copied, false if the queue stayed empty
+     */
+    bool erdp_if_rtos_queue_peek(OS_Queue os_queue, uint8_t *pxdata, uint32_t ticks_to_wait);
+
     /**
      * @brief Deletes a queue and frees its memory
      * @param[in] os_queue Handle to the queue to delete
@@ -190,6 +301,209 @@ extern "C"
      */
     void erdp_if_rtos_queue_delet(OS_Queue os_queue);
 
+    /* Queue Set API */
+    typedef QueueSetHandle_t OS_QueueSet;
+    typedef QueueSetMemberHandle_t OS_QueueSetMember; /* Queue or semaphore handle */
+
+    /**
+     * @brief Creates a queue set
+     * @param[in] length Sum of the lengths of the queues and the maximum counts of the semaphores to add
+     * @return Handle to the created queue set, NULL if out of memory
+     */
+    OS_QueueSet erdp_if_rtos_queue_set_create(uint32_t length);
+
+    /**
+     * @brief Creates a queue set in caller provided memory, without using the heap
+     * @param[in] length Sum of the lengths of the queues and the maximum counts of the semaphores to add
+     * @param[in] storage Storage of length * sizeof(OS_QueueSetMember) bytes
+     * @param[in] queue_buffer Storage for the queue set control block
+     * @return Handle to the created queue set
+     */
+    OS_QueueSet erdp_if_rtos_queue_set_create_static(uint32_t length, uint8_t *storage, OS_QueueBuffer *queue_buffer);
+
+    /**
+     * @brief Adds an empty queue or semaphore to a queue set
+     * @param[in] member Queue or semaphore, not a mutex; it must be empty and in no other set
+     * @param[in] queue_set Handle to the queue set
+     * @return true if added
+     */
+    bool erdp_if_rtos_queue_set_add(OS_QueueSetMember member, OS_QueueSet queue_set);
+
+    /**
+     * @brief Removes an empty queue or semaphore from a queue set
+     * @param[in] member Queue or semaphore to remove
+     * @param[in] queue_set Handle to the queue set
+     * @return true if removed, false if the member is not empty or not in the set
+     */
+    bool erdp_if_rtos_queue_set_remove(OS_QueueSetMember member, OS_QueueSet queue_set);
+
+    /**
+     * @brief Waits until a member of a queue set has data or can be taken
+     * @param[in] queue_set Handle to the queue set
+     * @param[in] ticks_to_wait Maximum time to wait (in ticks), ignored in interrupts
+     * @return Member that is ready, NULL on timeout
+     * @note The member must then be read or taken with a zero timeout, once per selection
+     */
+    OS_QueueSetMember erdp_if_rtos_queue_set_select(OS_QueueSet queue_set, uint32_t ticks_to_wait);
+
+    /**
+     * @brief Deletes a queue set, its members must have been removed
+     * @param[in] queue_set Handle to the queue set to delete
+     */
+    void erdp_if_rtos_queue_set_delete(OS_QueueSet queue_set);
+
+    /* Stream Buffer API */
+    typedef StreamBufferHandle_t OS_StreamBuffer;
+    typedef StaticStreamBuffer_t OS_StreamBufferBuffer; /* Stream buffer control block storage for static creation */
+
+    /**
+     * @brief Creates a stream buffer
+     * @param[in] size Capacity in bytes
+     * @param[in] trigger_level Bytes that must be available before a blocked receiver wakes
+     * @return Handle to the created stream buffer, NULL if out of memory
+     * @note One writer and one reader at a time, several writers or readers must be serialized
+     */
+    OS_StreamBuffer erdp_if_rtos_stream_buffer_create(uint32_t size, uint32_t trigger_level);
+
+    /**
+     * @brief Creates a stream buffer in caller provided memory, without using the heap
+     * @param[in] size Capacity in bytes
+     * @param[in] trigger_level Bytes that must be available before a blocked receiver wakes
+     * @param[in] storage Data storage of size + 1 bytes
+     * @param[in] stream_buffer Storage for the stream buffer control block
+     * @return Handle to the created stream buffer
+     */
+    OS_StreamBuffer erdp_if_rtos_stream_buffer_create_static(uint32_t size, uint32_t trigger_level, uint8_t *storage,
+                                                             OS_StreamBufferBuffer *stream_buffer);
+
+    /**
+     * @brief Copies bytes into a stream buffer
+     * @param[in] stream_buffer Handle to the stream buffer
+     * @param[in] data Bytes to send
+     * @param[in] len Number of bytes
+     * @param[in] ticks_to_wait Maximum time to wait for room for all bytes (in ticks), ignored in interrupts
+     * @return Number of bytes copied, as many as fit when the wait times out
+     */
+    uint32_t erdp_if_rtos_stream_buffer_send(OS_StreamBuffer stream_buffer, const uint8_t *data, uint32_t len,
+                                             uint32_t ticks_to_wait);
+
+    /**
+     * @brief Copies bytes out of a stream buffer
+     * @param[in] stream_buffer Handle to the stream buffer
+     * @param[out] data Buffer that receives the bytes
+     * @param[in] len Maximum number of bytes
+     * @param[in] ticks_to_wait Maximum time to wait for the trigger level (in ticks), ignored in interrupts
+     * @return Number of bytes copied, 0 on timeout
+     */
+    uint32_t erdp_if_rtos_stream_buffer_recv(OS_StreamBuffer stream_buffer, uint8_t *data, uint32_t len,
+                                             uint32_t ticks_to_wait);
+
+    /**
+     * @brief Gets the number of bytes waiting in a stream buffer
+     * @param[in] stream_buffer Handle to the stream buffer
+     * @return Bytes available to receive
+     */
+    uint32_t erdp_if_rtos_stream_buffer_bytes_available(OS_StreamBuffer stream_buffer);
+
+    /**
+     * @brief Gets the free room of a stream buffer
+     * @param[in] stream_buffer Handle to the stream buffer
+     * @return Bytes that can be sent without blocking
+     */
+    uint32_t erdp_if_rtos_stream_buffer_spaces_available(OS_StreamBuffer stream_buffer);
+
+    /**
+     * @brief Discards the content of a stream buffer
+     * @param[in] stream_buffer Handle to the stream buffer
+     * @return true if reset, false if a task is blocked on it
+     */
+    bool erdp_if_rtos_stream_buffer_reset(OS_StreamBuffer stream_buffer);
+
+    /**
+     * @brief Changes the number of bytes that wake a blocked receiver
+     * @param[in] stream_buffer Handle to the stream buffer
+     * @param[in] trigger_level New trigger level, 1 to the capacity
+     * @return true if set, false if trigger_level is larger than the capacity
+     */
+    bool erdp_if_rtos_stream_buffer_set_trigger_level(OS_StreamBuffer stream_buffer, uint32_t trigger_level);
+
+    /**
+     * @brief Deletes a stream buffer
+     * @param[in] stream_buffer Handle to the stream buffer to delete
+     */
+    void erdp_if_rtos_stream_buffer_delete(OS_StreamBuffer stream_buffer);
+
+    /* Message Buffer API */
+    typedef MessageBufferHandle_t OS_MessageBuffer;
+    typedef StaticMessageBuffer_t OS_MessageBufferBuffer; /* Message buffer control block storage for static creation */
+
+    /**
+     * @brief Creates a message buffer
+     * @param[in] size Capacity in bytes, each message also takes sizeof(size_t) bytes for its length
+     * @return Handle to the created message buffer, NULL if out of memory
+     * @note One writer and one reader at a time, several writers or readers must be serialized
+     */
+    OS_MessageBuffer erdp_if_rtos_message_buffer_create(uint32_t size);
+
+    /**
+     * @brief Creates a message buffer in caller provided memory, without using the heap
+     * @param[in] size Capacity in bytes, each message also takes sizeof(size_t) bytes for its length
+     * @param[in] storage Data storage of size + 1 bytes
+     * @param[in] message_buffer Storage for the message buffer control block
+     * @return Handle to the created message buffer
+     */
+    OS_MessageBuffer erdp_if_rtos_message_buffer_create_static(uint32_t size, uint8_t *storage,
+                                                               OS_MessageBufferBuffer *message_buffer);
+
+    /**
+     * @brief Copies one message into a message buffer
+     * @param[in] message_buffer Handle to the message buffer
+     * @param[in] data Message bytes
+     * @param[in] len Message length
+     * @param[in] ticks_to_wait Maximum time to wait for room for the message (in ticks), ignored in interrupts
+     * @return true if the whole message was copied, false on timeout (nothing is copied)
+     */
+    bool erdp_if_rtos_message_buffer_send(OS_MessageBuffer message_buffer, const uint8_t *data, uint32_t len,
+                                          uint32_t ticks_to_wait);
+
+    /**
+     * @brief Copies the oldest message out of a message buffer
+     * @param[in] message_buffer Handle to the message buffer
+     * @param[out] data Buffer that receives the message
+     * @param[in] len Size of data
+     * @param[in] ticks_to_wait Maximum time to wait for a message (in ticks), ignored in interrupts
+     * @return Message length, 0 on timeout or if the message is longer than len (it stays in the buffer)
+     */
+    uint32_t erdp_if_rtos_message_buffer_recv(OS_MessageBuffer message_buffer, uint8_t *data, uint32_t len,
+                                              uint32_t ticks_to_wait);
+
+    /**
+     * @brief Gets the length of the oldest message without removing it
+     * @param[in] message_buffer Handle to the message buffer
+     * @return Message length, 0 if the buffer is empty
+     */
+    uint32_t erdp_if_rtos_message_buffer_next_length(OS_MessageBuffer message_buffer);
+
+    /**
+     * @brief Gets the free room of a message buffer
+     * @param[in] message_buffer Handle to the message buffer
+     * @return Bytes free, the largest message that fits is sizeof(size_t) less
+     */
+    uint32_t erdp_if_rtos_message_buffer_spaces_available(OS_MessageBuffer message_buffer);
+
+    /**
+     * @brief Discards every message of a message buffer
+     * @param[in] message_buffer Handle to the message buffer
+     * @return true if reset, false if a task is blocked on it
+     */
+    bool erdp_if_rtos_message_buffer_reset(OS_MessageBuffer message_buffer);
+
+    /**
+     * @brief Deletes a message buffer
+     * @param[in] message_buffer Handle to the message buffer to delete
+     */
+    void erdp_if_rtos_message_buffer_delete(OS_MessageBuffer message_buffer);
+
     /* List API */
     typedef List_t *OS_List;
     typedef ListItem_t OS_ListItem;
@@ -245,6 +559,7 @@ extern "C"
     /* Event Group API */
     typedef EventGroupHandle_t OS_Event;
     typedef EventBits_t OS_EventBits;
+    typedef StaticEventGroup_t OS_EventBuffer; /* Event group storage for static creation */
 
     /**
      * @brief Creates a new event group
@@ -252,6 +567,20 @@ extern "C"
      */
     OS_Event erdp_if_rtos_event_create(void);
 
+    /**
+     * @brief Creates a new event group in caller provided memory, without using the heap
+     * @param[in] event_buffer Storage for the event group
+     * @return Handle to the created event group
+     */
+    OS_Event erdp_if_rtos_event_create_static(OS_EventBuffer *event_buffer);
+
+    /**
+     * @brief Deletes an event group
+     * @param[in] event Handle to the event group to delete
+     * @note Tasks blocked on the group are unblocked
+     */
+    void erdp_if_rtos_event_delete(OS_Event event);
+
     /**
      * @brief Sets specified bits in an event group
      * @param[in,out] event Handle to the event group
@@ -299,6 +628,7 @@ extern "C"
     } Semaphore_tag;
 
     typedef SemaphoreHandle_t OS_Semaphore;
+    typedef StaticSemaphore_t OS_SemaphoreBuffer; /* Semaphore storage for static creation */
 
     /**
      * @brief Creates a semaphore of specified type
@@ -316,6 +646,24 @@ extern "C"
      */
     OS_Semaphore erdp_if_rtos_counting_semaphore_creat(uint32_t max_count, uint32_t initial_count);
 
+    /**
+     * @brief Creates a semaphore of specified type in caller provided memory, without using the heap
+     * @param[in] tag Type of semaphore to create
+     * @param[in] semaphore_buffer Storage for the semaphore
+     * @return Handle to the created semaphore
+     */
+    OS_Semaphore erdp_if_rtos_semaphore_creat_static(Semaphore_tag tag, OS_SemaphoreBuffer *semaphore_buffer);
+
+    /**
+     * @brief Creates a counting semaphore in caller provided memory, without using the heap
+     * @param[in] max_count Maximum count value the semaphore can reach
+     * @param[in] initial_count Initial count value of the semaphore
+     * @param[in] semaphore_buffer Storage for the semaphore
+     * @return Handle to the created counting semaphore
+     */
+    OS_Semaphore erdp_if_rtos_counting_semaphore_creat_static(uint32_t max_count, uint32_t initial_count,
+                                                              OS_SemaphoreBuffer *semaphore_buffer);
+
     /**
      * @brief Attempts to take (acquire) a semaphore
      * @param[in] semaphore Handle to the semaphore to take
@@ -356,6 +704,99 @@ extern "C"
      */
     void erdp_if_rtos_semaphore_delet(OS_Semaphore semaphore);
 
+    /* Software Timer API */
+    typedef TimerHandle_t OS_Timer;
+    typedef StaticTimer_t OS_TimerBuffer; /* Timer control block storage for static creation */
+
+    /**
+     * @brief Creates a software timer in caller provided memory, without using the heap
+     * @param[in] name Descriptive name for the timer (used for debugging)
+     * @param[in] period_ticks Period, or delay of a one-shot timer (in ticks, at least 1)
+     * @param[in] auto_reload true for a periodic timer, false for a one-shot timer
+     * @param[in] id Value returned by erdp_if_rtos_timer_get_id() in the callback
+     * @param[in] callback Function called from the timer task on expiry, must not block
+     * @param[in] timer_buffer Storage for the timer control block
+     * @return Handle to the created timer, created dormant
+     */
+    OS_Timer erdp_if_rtos_timer_create_static(const char *name, uint32_t period_ticks, bool auto_reload, void *id,
+                                              void (*callback)(OS_Timer), OS_TimerBuffer *timer_buffer);
+
+    /**
+     * @brief Gets the id given when the timer was created
+     * @param[in] timer Handle to the timer
+     * @return Timer id
+     */
+    void *erdp_if_rtos_timer_get_id(OS_Timer timer);
+
+    /**
+     * @brief Starts a timer, or restarts it from now when already active
+     * @param[in] timer Handle to the timer
+     * @param[in] ticks_to_wait Maximum time to wait for room in the timer command queue (in ticks), ignored in interrupts
+     * @return true if the command was queued to the timer task
+     */
+    bool erdp_if_rtos_timer_start(OS_Timer timer, uint32_t ticks_to_wait);
+
+    /**
+     * @brief Stops a timer
+     * @param[in] timer Handle to the timer
+     * @param[in] ticks_to_wait Maximum time to wait for room in the timer command queue (in ticks), ignored in interrupts
+     * @return true if the command was queued to the timer task
+     */
+    bool erdp_if_rtos_timer_stop(OS_Timer timer, uint32_t ticks_to_wait);
+
+    /**
+     * @brief Restarts a timer from now, starting it when dormant
+     * @param[in] timer Handle to the timer
+     * @param[in] ticks_to_wait Maximum time to wait for room in the timer command queue (in ticks), ignored in interrupts
+     * @return true if the command was queued to the timer task
+     */
+    bool erdp_if_rtos_timer_reset(OS_Timer timer, uint32_t ticks_to_wait);
+
+    /**
+     * @brief Changes the period of a timer and restarts it from now, starting it when dormant
+     * @param[in] timer Handle to the timer
+     * @param[in] period_ticks New period (in ticks, at least 1)
+     * @param[in] ticks_to_wait Maximum time to wait for room in the timer command queue (in ticks), ignored in interrupts
+     * @return true if the command was queued to the timer task
+     */
+    bool erdp_if_rtos_timer_change_period(OS_Timer timer, uint32_t period_ticks, uint32_t ticks_to_wait);
+
+    /**
+     * @brief Checks whether a timer is running
+     * @param[in] timer Handle to the timer
+     * @return true if active, false if dormant
+     * @note Commands still waiting in the timer command queue are not taken into account
+     */
+    bool erdp_if_rtos_timer_is_active(OS_Timer timer);
+
+    /**
+     * @brief Deletes a timer
+     * @param[in] timer Handle to the timer
+     * @param[in] ticks_to_wait Maximum time to wait for room in the timer command queue (in ticks)
+     * @return true if the command was queued to the timer task
+     */
+    bool erdp_if_rtos_timer_delete(OS_Timer timer, uint32_t ticks_to_wait);
+
+    /**
+     * @brief Waits until the timer task has processed the commands queued before this call
+     * @param[in] ticks_to_wait Maximum time to wait for room in the timer command queue (in ticks)
+     * @return true once processed, false if the command queue stayed full or before the scheduler has started
+     * @note Must not be called from interrupts or from a timer callback
+     */
+    bool erdp_if_rtos_timer_sync(uint32_t ticks_to_wait);
+
+    /**
+     * @brief Checks whether the caller runs in the timer task, i.e. in a timer callback
+     * @return true in the timer task, false elsewhere or before the scheduler has started
+     */
+    bool erdp_if_rtos_timer_in_task(void);
+
+    /**
+     * @brief Checks whether the caller runs in an interrupt
+     * @return true in an interrupt, false in a task
+     */
+    bool erdp_if_rtos_in_isr(void);
+
     /* CPU Control */
     /**
      * @brief Locks the CPU by disabling interrupts
@@ -150,7 +150,7 @@ extern uint32_t SystemCoreClock;
  * configTASK_NOTIFICATION_ARRAY_ENTRIES sets the number of indexes in the array.
  * See https://www.freertos.org/RTOS-task-notifications.html  Defaults to 1 if
  * left undefined. */
-#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 3
 
 /* configQUEUE_REGISTRY_SIZE sets the maximum number of queues and semaphores
  * that can be referenced from the queue registry.  Only required when using a
@@ -637,7 +637,7 @@ extern uint32_t SystemCoreClock;
 #define configUSE_MUTEXES 1
 #define configUSE_RECURSIVE_MUTEXES 1
 #define configUSE_COUNTING_SEMAPHORES 1
-#define configUSE_QUEUE_SETS 0
+#define configUSE_QUEUE_SETS 1
 #define configUSE_APPLICATION_TASK_TAG 0
 
 /* Set the following INCLUDE_* constants to 1 to incldue the named API function,
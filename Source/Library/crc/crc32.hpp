@@ -0,0 +1,141 @@
+#ifndef __CRC32_HPP__
+#define __CRC32_HPP__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace erdp
+{
+    /*
+     * Table driven CRC-32, slicing by 8: eight bytes per step through eight 256 entry tables
+     * (8KiB, built at compile time and placed in flash). Any polynomial, both bit orders.
+     * Poly is given in normal (MSB first) form, Reflected selects the LSB first algorithm.
+     */
+    template <uint32_t Poly, bool Reflected, uint32_t Init, uint32_t XorOut>
+    class Crc32
+    {
+    public:
+        static constexpr uint32_t INIT = Init;
+
+        static uint32_t compute(const void *data, size_t len)
+        {
+            return finish(update(INIT, data, len));
+        }
+
+        // Continue a CRC, state starts at INIT and ends through finish()
+        static uint32_t update(uint32_t state, const void *data, size_t len)
+        {
+            const uint8_t *p = (const uint8_t *)data;
+            const uint32_t(&t)[8][256] = __table.t;
+
+            if constexpr (Reflected)
+            {
+                while (len >= 8)
+                {
+                    uint32_t a = __load(p) ^ state;
+                    uint32_t b = __load(p + 4);
+                    state = t[7][a & 0xFFU] ^ t[6][(a >> 8) & 0xFFU] ^ t[5][(a >> 16) & 0xFFU] ^ t[4][a >> 24] ^
+                            t[3][b & 0xFFU] ^ t[2][(b >> 8) & 0xFFU] ^ t[1][(b >> 16) & 0xFFU] ^ t[0][b >> 24];
+                    p += 8;
+                    len -= 8;
+                }
+                while (len--)
+                {
+                    state = t[0][(state ^ *p++) & 0xFFU] ^ (state >> 8);
+                }
+            }
+            else
+            {
+                while (len >= 8)
+                {
+                    uint32_t a = __swap(__load(p)) ^ state;
+                    uint32_t b = __swap(__load(p + 4));
+                    state = t[7][a >> 24] ^ t[6][(a >> 16) & 0xFFU] ^ t[5][(a >> 8) & 0xFFU] ^ t[4][a & 0xFFU] ^
+                            t[3][b >> 24] ^ t[2][(b >> 16) & 0xFFU] ^ t[1][(b >> 8) & 0xFFU] ^ t[0][b & 0xFFU];
+                    p += 8;
+                    len -= 8;
+                }
+                while (len--)
+                {
+                    state = t[0][((state >> 24) ^ *p++) & 0xFFU] ^ (state << 8);
+                }
+            }
+            return state;
+        }
+
+        static constexpr uint32_t finish(uint32_t state)
+        {
+            return state ^ XorOut;
+        }
+
+    private:
+        struct Table
+        {
+            uint32_t t[8][256];
+
+            constexpr Table() : t()
+            {
+                uint32_t poly = Reflected ? __reflect(Poly) : Poly;
+                for (uint32_t i = 0; i < 256; i++)
+                {
+                    uint32_t crc = Reflected ? i : (i << 24);
+                    for (uint8_t bit = 0; bit < 8; bit++)
+                    {
+                        if (Reflected)
+                        {
+                            crc = (crc & 1U) ? ((crc >> 1) ^ poly) : (crc >> 1);
+                        }
+                        else
+                        {
+                            crc = (crc & 0x80000000U) ? ((crc << 1) ^ poly) : (crc << 1);
+                        }
+                    }
+                    t[0][i] = crc;
+                }
+                for (uint32_t k = 1; k < 8; k++)
+                {
+                    for (uint32_t i = 0; i < 256; i++)
+                    {
+                        uint32_t prev = t[k - 1][i];
+                        t[k][i] = Reflected ? ((prev >> 8) ^ t[0][prev & 0xFFU]) : ((prev << 8) ^ t[0][prev >> 24]);
+                    }
+                }
+            }
+        };
+
+        static constexpr Table __table = Table();
+
+        static constexpr uint32_t __reflect(uint32_t value)
+        {
+            uint32_t result = 0;
+            for (uint8_t bit = 0; bit < 32; bit++)
+            {
+                result = (result << 1) | ((value >> bit) & 1U);
+            }
+            return result;
+        }
+
+        // Little endian load from any alignment
+        static uint32_t __load(const uint8_t *p)
+        {
+            uint32_t value;
+            memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        static uint32_t __swap(uint32_t value)
+        {
+            return (value >> 24) | ((value >> 8) & 0x0000FF00U) | ((value << 8) & 0x00FF0000U) | (value << 24);
+        }
+    };
+
+    // zlib, Ethernet, PNG
+    using Crc32Ieee = Crc32<0x04C11DB7U, true, 0xFFFFFFFFU, 0xFFFFFFFFU>;
+    // Same polynomial MSB first, what the STM32 CRC unit computes over big endian words
+    using Crc32Mpeg2 = Crc32<0x04C11DB7U, false, 0xFFFFFFFFU, 0x00000000U>;
+    // Castagnoli, iSCSI and ext4
+    using Crc32C = Crc32<0x1EDC6F41U, true, 0xFFFFFFFFU, 0xFFFFFFFFU>;
+} // namespace erdp
+
+#endif // __CRC32_HPP__
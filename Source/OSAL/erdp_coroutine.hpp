@@ -0,0 +1,380 @@
+#ifndef __ERDP_COROUTINE_HPP__
+#define __ERDP_COROUTINE_HPP__
+#include <new>
+#include "erdp_osal.hpp"
+
+/*
+ * 协程体的宏，只能在Coroutine::run()中使用，协程体以ERDP_CO_BEGIN()开始、ERDP_CO_END()结束
+ * 恢复点由switch实现：run()返回后局部变量不保留，跨等待的状态要放在协程对象的成员中；
+ * 等待宏不能写在协程体内另一个switch语句中，一行最多一个等待宏
+ */
+#define ERDP_CO_BEGIN()      \
+    switch (this->__co_line) \
+    {                        \
+    case 0:
+
+#define ERDP_CO_END()    \
+    }                    \
+    this->__co_line = 0; \
+    return CO_DONE
+
+// 让出，调度器运行完其他协程后继续
+#define ERDP_CO_YIELD()             \
+    do                              \
+    {                               \
+        this->__co_line = __LINE__; \
+        return CO_YIELD;            \
+    case __LINE__:;                 \
+    } while (0)
+
+// 等待cond为true，最多timeout_ms，之后用co_timed_out()判断是否超时；cond每轮求值一次，且至少每poll_ms求值一次
+#define ERDP_CO_AWAIT_FOR(cond, timeout_ms)     \
+    do                                          \
+    {                                           \
+        this->__co_wait((timeout_ms), true);    \
+        this->__co_line = __LINE__;             \
+        [[fallthrough]];                        \
+    case __LINE__:                              \
+        if (!this->__co_check((bool)(cond)))    \
+        {                                       \
+            return CO_WAIT;                     \
+        }                                       \
+    } while (0)
+
+#define ERDP_CO_AWAIT(cond) ERDP_CO_AWAIT_FOR(cond, OS_WAIT_FOREVER)
+
+// 等待CoSignal::notify()，最多timeout_ms；不轮询，只在信号或超时时恢复
+#define ERDP_CO_WAIT_SIGNAL_FOR(signal, timeout_ms)                      \
+    do                                                                   \
+    {                                                                    \
+        this->__co_wait((timeout_ms), false);                            \
+        this->__co_line = __LINE__;                                      \
+        [[fallthrough]];                                                 \
+    case __LINE__:                                                       \
+        if (!this->__co_check((signal).take(*this->__co_scheduler)))     \
+        {                                                                \
+            return CO_WAIT;                                              \
+        }                                                                \
+    } while (0)
+
+#define ERDP_CO_WAIT_SIGNAL(signal) ERDP_CO_WAIT_SIGNAL_FOR(signal, OS_WAIT_FOREVER)
+
+// 延时ms毫秒，其间不占用CPU
+#define ERDP_CO_DELAY(ms)                             \
+    do                                                \
+    {                                                 \
+        this->__co_wait((ms), false);                 \
+        this->__co_line = __LINE__;                   \
+        [[fallthrough]];                              \
+    case __LINE__:                                    \
+        if (!this->__co_check(false))                 \
+        {                                             \
+            return CO_WAIT;                           \
+        }                                             \
+    } while (0)
+
+namespace erdp
+{
+    class CoScheduler;
+
+    typedef enum
+    {
+        CO_YIELD, // 让出，下一轮继续
+        CO_WAIT,  // 等待条件、信号或超时
+        CO_DONE,  // 运行结束，从调度器中移除
+    } CoStatus_t;
+
+    /**
+     * @brief 无栈协程，多个协程在一个线程中轮流运行，每个协程只占用对象本身的内存
+     * 在派生类中实现run()，用ERDP_CO_*宏等待；协程体中不能调用阻塞的接口(会阻塞同一线程中的所有协程)，
+     * 队列等容器用不等待的pop/push作为等待条件
+     * @example
+     * class Blink : public Coroutine
+     * {
+     *     CoStatus_t run() override
+     *     {
+     *         ERDP_CO_BEGIN();
+     *         while (true)
+     *         {
+     *             ERDP_CO_AWAIT_FOR(cmd_queue.pop(cmd), 500); // 等待命令，最多500ms
+     *             if (!co_timed_out()) handle(cmd);
+     *             led.toggle();
+     *         }
+     *         ERDP_CO_END();
+     *     }
+     *     uint32_t cmd;                                     // 跨等待的状态放在成员中
+     * };
+     */
+    class Coroutine
+    {
+        friend class CoScheduler;
+
+    public:
+        Coroutine() {}
+        virtual ~Coroutine() {}
+
+        Coroutine(const Coroutine &) = delete;
+        Coroutine &operator=(const Coroutine &) = delete;
+
+        // 已加入调度器且尚未结束
+        bool running() const
+        {
+            return __co_scheduler != nullptr;
+        }
+
+    protected:
+        virtual CoStatus_t run() = 0;
+
+        // 上一个等待是否因超时结束
+        bool co_timed_out() const
+        {
+            return __co_timed_out;
+        }
+
+        /* 以下供ERDP_CO_*宏使用 */
+        CoScheduler *volatile __co_scheduler = nullptr;
+        uint16_t __co_line = 0; // 恢复点(行号)，0为协程体开头
+
+        void __co_wait(uint32_t timeout_ms, bool polling)
+        {
+            __co_polling = polling;
+            __co_timed = (timeout_ms != OS_WAIT_FOREVER);
+            __co_deadline = erdp_if_rtos_get_1ms_timestamp() + timeout_ms;
+        }
+
+        // ready为true或已超时时结束等待
+        bool __co_check(bool ready)
+        {
+            if (!ready && (!__co_timed || (int32_t)(erdp_if_rtos_get_1ms_timestamp() - __co_deadline) < 0))
+            {
+                return false;
+            }
+            __co_timed_out = !ready;
+            __co_timed = false;
+            __co_polling = false;
+            return true;
+        }
+
+    private:
+        Coroutine *__co_next = nullptr;
+        uint32_t __co_deadline = 0; // 等待的超时时间戳(ms)
+        bool __co_timed = false;    // 等待带超时
+        bool __co_polling = false;  // 等待条件需要轮询
+        bool __co_timed_out = false;
+    };
+
+    /**
+     * @brief 协程的唤醒信号，在任务或中断中notify，等待的协程用ERDP_CO_WAIT_SIGNAL恢复
+     * 用于把HAL的完成回调和定时器回调接到协程上，notify只记一次，协程取走后清除
+     * @example
+     * CoSignal dma_done, tick;
+     * req.callback = [](DmaCopyResult_t) { dma_done.notify(); };   // DMA完成
+     * WheelTimer timer([]() { tick.notify(); });                   // 亚毫秒定时
+     */
+    class CoSignal
+    {
+    public:
+        CoSignal() {}
+
+        CoSignal(const CoSignal &) = delete;
+        CoSignal &operator=(const CoSignal &) = delete;
+
+        inline void notify();
+
+        void clear()
+        {
+            __set.store(false);
+        }
+
+        // 记录等待的调度器并取走信号，由ERDP_CO_WAIT_SIGNAL调用
+        bool take(CoScheduler &scheduler)
+        {
+            __scheduler.store(&scheduler);
+            return __set.exchange(false);
+        }
+
+    private:
+        std::atomic<bool> __set{false};
+        std::atomic<CoScheduler *> __scheduler{nullptr};
+    };
+
+    /**
+     * @brief 协程调度器，在一个线程中按加入的顺序轮流运行协程
+     * 每轮运行所有协程，之后线程睡眠到最早的等待超时，或到CoSignal::notify()、spawn()唤醒；
+     * 有协程用ERDP_CO_AWAIT等待条件时，最多睡眠poll_ms后重新求值；一直让出的协程会使线程不睡眠
+     * 用法：在已有线程中调用run()，或使用自带线程的StaticCoScheduler；无RTOS时在主循环中调用poll()
+     */
+    class CoScheduler
+    {
+    public:
+        static constexpr uint32_t POLL_MS = 1;
+        static constexpr uint32_t NO_WAIT_LIMIT = 0xFFFFFFFFU;
+
+        CoScheduler(uint32_t poll_ms = POLL_MS) : __poll_ms(poll_ms) {}
+
+        CoScheduler(const CoScheduler &) = delete;
+        CoScheduler &operator=(const CoScheduler &) = delete;
+
+        // 加入协程，协程从头开始运行；可在任务或中断中调用，协程尚未结束时返回false
+        bool spawn(Coroutine &co)
+        {
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            if (co.__co_scheduler != nullptr)
+            {
+                erdp_if_rtos_cpu_unlock(key);
+                return false;
+            }
+            co.__co_scheduler = this;
+            co.__co_line = 0;
+            co.__co_timed = false;
+            co.__co_polling = false;
+            co.__co_next = __spawned;
+            __spawned = &co;
+            erdp_if_rtos_cpu_unlock(key);
+            wake();
+            return true;
+        }
+
+        // 唤醒调度线程重新运行所有协程，可在任务或中断中调用
+        void wake()
+        {
+#ifdef ERDP_ENABLE_RTOS
+            __wake.give();
+#endif
+        }
+
+        // 运行一轮，返回到下一次需要运行的时间(ms)，NO_WAIT_LIMIT为只等待信号
+        uint32_t poll()
+        {
+            uint32_t wait_ms = NO_WAIT_LIMIT;
+            __take_spawned();
+
+            Coroutine **link = &__list;
+            while (*link != nullptr)
+            {
+                Coroutine *co = *link;
+                CoStatus_t status = co->run();
+                if (status == CO_DONE)
+                {
+                    *link = co->__co_next;
+                    co->__co_next = nullptr;
+                    co->__co_scheduler = nullptr;
+                    continue;
+                }
+                if (status == CO_YIELD)
+                {
+                    wait_ms = 0;
+                }
+                else
+                {
+                    if (co->__co_polling && __poll_ms < wait_ms)
+                    {
+                        wait_ms = __poll_ms;
+                    }
+                    if (co->__co_timed)
+                    {
+                        int32_t remain = (int32_t)(co->__co_deadline - erdp_if_rtos_get_1ms_timestamp());
+                        uint32_t timeout_ms = (remain > 0) ? (uint32_t)remain : 0;
+                        if (timeout_ms < wait_ms)
+                        {
+                            wait_ms = timeout_ms;
+                        }
+                    }
+                }
+                link = &co->__co_next;
+            }
+            return wait_ms;
+        }
+
+#ifdef ERDP_ENABLE_RTOS
+        // 在当前线程中一直运行协程，不返回
+        void run()
+        {
+            __wake.bind();
+            while (true)
+            {
+                uint32_t wait_ms = poll();
+                if (wait_ms > 0)
+                {
+                    __wake.take((wait_ms == NO_WAIT_LIMIT) ? OS_WAIT_FOREVER : erdp_if_rtos_ms_to_ticks(wait_ms));
+                }
+            }
+        }
+#endif
+
+    private:
+        Coroutine *__list = nullptr;             // 只由调度线程访问
+        Coroutine *volatile __spawned = nullptr; // 新加入的协程，后加入的在前
+        uint32_t __poll_ms;
+#ifdef ERDP_ENABLE_RTOS
+        NotifySemaphore __wake;
+#endif
+
+        // 把新加入的协程按加入顺序接到链表尾部
+        void __take_spawned()
+        {
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            Coroutine *spawned = __spawned;
+            __spawned = nullptr;
+            erdp_if_rtos_cpu_unlock(key);
+
+            Coroutine *head = nullptr;
+            while (spawned != nullptr)
+            {
+                Coroutine *next = spawned->__co_next;
+                spawned->__co_next = head;
+                head = spawned;
+                spawned = next;
+            }
+            Coroutine **link = &__list;
+            while (*link != nullptr)
+            {
+                link = &(*link)->__co_next;
+            }
+            *link = head;
+        }
+    };
+
+    void CoSignal::notify()
+    {
+        __set.store(true);
+        CoScheduler *scheduler = __scheduler.load();
+        if (scheduler != nullptr)
+        {
+            scheduler->wake();
+        }
+    }
+
+#ifdef ERDP_ENABLE_RTOS
+    /**
+     * @brief 自带线程的协程调度器，所有协程共用一个StackWords字的线程栈
+     * @example
+     * StaticCoScheduler<> scheduler;
+     * Blink blink;
+     * scheduler.spawn(blink);
+     * scheduler.start(3);
+     */
+    template <size_t StackWords = DEFAULT_STACK_SIZE * 2>
+    class StaticCoScheduler : public CoScheduler
+    {
+    public:
+        StaticCoScheduler(uint32_t poll_ms = POLL_MS) : CoScheduler(poll_ms) {}
+
+        // 创建调度线程，线程不会退出，调度器需一直有效
+        void start(uint32_t priority, const char *name = "coroutine")
+        {
+            erdp_assert(!__started);
+            __started = true;
+            Worker *worker = new (__worker) Worker([this]() { run(); }, name, priority);
+            worker->join();
+        }
+
+    private:
+        using Worker = StaticThread<StackWords>;
+        alignas(Worker) uint8_t __worker[sizeof(Worker)];
+        bool __started = false;
+    };
+#endif // ERDP_ENABLE_RTOS
+} // namespace erdp
+
+#endif // __ERDP_COROUTINE_HPP__
@@ -0,0 +1,438 @@
+#ifndef __ERDP_EXECUTOR_HPP__
+#define __ERDP_EXECUTOR_HPP__
+#include <new>
+#include "erdp_osal.hpp"
+
+namespace erdp
+{
+    template <size_t QueueNum, size_t StackWords, size_t PoolSize>
+    class Executor;
+
+    typedef struct
+    {
+        uint32_t depth;         // 当前排队(就绪和延时)的工作项数
+        uint32_t max_depth;     // 排队数的历史最大值
+        uint32_t executed;      // 已执行次数
+        uint32_t dropped;       // 内部工作项用尽而未能投递的闭包数
+        uint32_t max_latency;   // 从到期到开始执行的最大延迟(ms)
+        uint64_t total_latency; // 延迟总和(ms)，除以executed得到平均延迟
+    } ExecutorStats_t;
+
+    /**
+     * @brief 由调用者持有的工作项，投递后直到执行完(周期工作项直到取消)都必须保持有效
+     */
+    class WorkItem
+    {
+        template <size_t, size_t, size_t>
+        friend class Executor;
+
+    public:
+        WorkItem() {}
+        WorkItem(InplaceFunction<void()> fn) : fn(fn) {}
+
+        WorkItem(const WorkItem &) = delete;
+        WorkItem &operator=(const WorkItem &) = delete;
+
+        InplaceFunction<void()> fn = nullptr;
+
+        // 已投递尚未执行完，周期工作项在取消前一直为true
+        bool pending() const
+        {
+            return __state != STATE_IDLE;
+        }
+
+    private:
+        enum : uint8_t
+        {
+            STATE_IDLE,
+            STATE_READY,
+            STATE_DELAYED,
+            STATE_RUNNING,
+        };
+
+        WorkItem *__next = nullptr;
+        uint32_t __due = 0;    // 到期时间(ms)
+        uint32_t __period = 0; // 周期(ms)，0为单次
+        volatile uint8_t __state = STATE_IDLE;
+        uint8_t __queue = 0;
+        bool __pooled = false; // 内部工作项，执行后归还
+    };
+
+    /**
+     * @brief 工作队列执行器，多个后台任务共用少数几个线程栈
+     * 每个队列由一个工作线程按投递顺序执行，线程优先级在start时指定；无RTOS时在主循环中调用poll
+     * 工作项和闭包可在任务或中断中投递，支持延时和周期执行；闭包使用内部的PoolSize个工作项，不占用堆
+     * 同一队列中的工作项串行执行，执行时间长的工作项会推迟后面的工作项
+     * @tparam QueueNum 队列(工作线程)个数
+     * @tparam StackWords 每个工作线程的栈大小(字)
+     * @tparam PoolSize 闭包投递可用的内部工作项个数
+     * @example
+     * Executor<2> executor;
+     * WorkItem blink([]() { led.toggle(); });
+     * executor.start({2, 5});                     // 队列0优先级2，队列1优先级5
+     * executor.post_periodic(blink, 500);         // 每500ms在队列0执行
+     * executor.post([]() { flush(); }, 1);        // 中断中投递闭包到队列1
+     */
+    template <size_t QueueNum = 1, size_t StackWords = DEFAULT_STACK_SIZE * 2, size_t PoolSize = 8>
+    class Executor
+    {
+        static_assert(QueueNum > 0 && QueueNum <= 0xFF, "Executor: QueueNum must be 1 to 255");
+
+    public:
+        Executor()
+        {
+            for (size_t i = 0; i < PoolSize; i++)
+            {
+                __pool[i].__pooled = true;
+                __pool[i].__next = __free;
+                __free = &__pool[i];
+            }
+        }
+
+        Executor(const Executor &) = delete;
+        Executor &operator=(const Executor &) = delete;
+
+#ifdef ERDP_ENABLE_RTOS
+        // 为每个队列创建工作线程，priorities[i]为队列i的线程优先级；工作线程不会退出，执行器需一直有效
+        void start(const uint32_t (&priorities)[QueueNum], const char *name = "executor")
+        {
+            erdp_assert(!__started);
+            __started = true;
+            for (uint8_t i = 0; i < QueueNum; i++)
+            {
+                Worker *worker = new (__workers[i]) Worker([this, i]() { __worker_loop(i); }, name, priorities[i]);
+                worker->join();
+            }
+        }
+#else
+        // 按队列编号顺序执行所有已到期的工作项，返回执行个数
+        size_t poll()
+        {
+            size_t count = 0;
+            for (uint8_t i = 0; i < QueueNum; i++)
+            {
+                uint32_t wait_ms;
+                WorkItem *item;
+                while ((item = __next_item(i, wait_ms)) != nullptr)
+                {
+                    __run(item);
+                    count++;
+                }
+            }
+            return count;
+        }
+#endif
+
+        // 投递工作项，工作项仍在排队或执行时返回false
+        bool post(WorkItem &item, uint8_t queue = 0)
+        {
+            return __post(item, queue, 0, 0);
+        }
+
+        bool post_delayed(WorkItem &item, uint32_t delay_ms, uint8_t queue = 0)
+        {
+            return __post(item, queue, delay_ms, 0);
+        }
+
+        // 周期执行，第一次在period_ms后，直到cancel；执行被推迟时不补执行错过的周期
+        bool post_periodic(WorkItem &item, uint32_t period_ms, uint8_t queue = 0)
+        {
+            erdp_assert(period_ms > 0);
+            return __post(item, queue, period_ms, period_ms);
+        }
+
+        // 投递闭包，内部工作项用尽时返回false并计入dropped
+        bool post(InplaceFunction<void()> fn, uint8_t queue = 0)
+        {
+            return post_delayed(fn, 0, queue);
+        }
+
+        bool post_delayed(InplaceFunction<void()> fn, uint32_t delay_ms, uint8_t queue = 0)
+        {
+            erdp_assert(queue < QueueNum);
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            WorkItem *item = __free;
+            if (item != nullptr)
+            {
+                __free = item->__next;
+            }
+            else
+            {
+                __queues[queue].stats.dropped++;
+            }
+            erdp_if_rtos_cpu_unlock(key);
+            if (item == nullptr)
+            {
+                return false;
+            }
+            item->fn = fn;
+            return __post(*item, queue, delay_ms, 0);
+        }
+
+        /**
+         * @brief 取消排队中的工作项，或停止周期工作项
+         * 正在执行的这一次不受影响，返回时可能仍在执行
+         * @return 工作项取消前是否在排队
+         */
+        bool cancel(WorkItem &item)
+        {
+            bool queued = false;
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            QueueState &q = __queues[item.__queue];
+            if (item.__state == WorkItem::STATE_READY)
+            {
+                __unlink(q.ready_head, &item);
+                if (q.ready_tail == &item)
+                {
+                    q.ready_tail = __last(q.ready_head);
+                }
+                queued = true;
+            }
+            else if (item.__state == WorkItem::STATE_DELAYED)
+            {
+                __unlink(q.delayed_head, &item);
+                queued = true;
+            }
+            if (queued)
+            {
+                item.__state = WorkItem::STATE_IDLE;
+                q.stats.depth--;
+            }
+            item.__period = 0;
+            erdp_if_rtos_cpu_unlock(key);
+            return queued;
+        }
+
+        ExecutorStats_t get_stats(uint8_t queue) const
+        {
+            erdp_assert(queue < QueueNum);
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            ExecutorStats_t stats = __queues[queue].stats;
+            erdp_if_rtos_cpu_unlock(key);
+            return stats;
+        }
+
+        void reset_stats(uint8_t queue)
+        {
+            erdp_assert(queue < QueueNum);
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            ExecutorStats_t &stats = __queues[queue].stats;
+            uint32_t depth = stats.depth;
+            stats = {};
+            stats.depth = depth;
+            stats.max_depth = depth;
+            erdp_if_rtos_cpu_unlock(key);
+        }
+
+    private:
+        static constexpr uint32_t NO_WAIT_LIMIT = 0xFFFFFFFFU;
+
+        struct QueueState
+        {
+            WorkItem *ready_head = nullptr; // 按投递顺序
+            WorkItem *ready_tail = nullptr;
+            WorkItem *delayed_head = nullptr; // 按到期时间排序
+            ExecutorStats_t stats = {};
+#ifdef ERDP_ENABLE_RTOS
+            NotifySemaphore wake;
+#endif
+        };
+
+        QueueState __queues[QueueNum];
+        WorkItem __pool[PoolSize];
+        WorkItem *__free = nullptr;
+#ifdef ERDP_ENABLE_RTOS
+        using Worker = StaticThread<StackWords>;
+        alignas(Worker) uint8_t __workers[QueueNum][sizeof(Worker)];
+        bool __started = false;
+#endif
+
+        // a早于b，按32位时间戳回绕比较
+        static bool __before(uint32_t a, uint32_t b)
+        {
+            return (int32_t)(a - b) < 0;
+        }
+
+        static void __unlink(WorkItem *&head, WorkItem *item)
+        {
+            WorkItem **link = &head;
+            while (*link != item)
+            {
+                link = &(*link)->__next;
+            }
+            *link = item->__next;
+            item->__next = nullptr;
+        }
+
+        static WorkItem *__last(WorkItem *head)
+        {
+            while (head != nullptr && head->__next != nullptr)
+            {
+                head = head->__next;
+            }
+            return head;
+        }
+
+        // 以下三个函数需持有锁
+        static void __append_ready(QueueState &q, WorkItem *item)
+        {
+            item->__next = nullptr;
+            item->__state = WorkItem::STATE_READY;
+            if (q.ready_tail == nullptr)
+            {
+                q.ready_head = item;
+            }
+            else
+            {
+                q.ready_tail->__next = item;
+            }
+            q.ready_tail = item;
+        }
+
+        static void __insert_delayed(QueueState &q, WorkItem *item)
+        {
+            WorkItem **link = &q.delayed_head;
+            while (*link != nullptr && !__before(item->__due, (*link)->__due))
+            {
+                link = &(*link)->__next;
+            }
+            item->__next = *link;
+            item->__state = WorkItem::STATE_DELAYED;
+            *link = item;
+        }
+
+        static void __enqueue(QueueState &q, WorkItem *item, uint32_t now)
+        {
+            if (__before(now, item->__due))
+            {
+                __insert_delayed(q, item);
+            }
+            else
+            {
+                __append_ready(q, item);
+            }
+            q.stats.depth++;
+            if (q.stats.depth > q.stats.max_depth)
+            {
+                q.stats.max_depth = q.stats.depth;
+            }
+        }
+
+        bool __post(WorkItem &item, uint8_t queue, uint32_t delay_ms, uint32_t period_ms)
+        {
+            erdp_assert(queue < QueueNum && item.fn != nullptr);
+            uint32_t now = erdp_if_rtos_get_1ms_timestamp();
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            if (item.__state != WorkItem::STATE_IDLE)
+            {
+                erdp_if_rtos_cpu_unlock(key);
+                return false;
+            }
+            item.__queue = queue;
+            item.__period = period_ms;
+            item.__due = now + delay_ms;
+            __enqueue(__queues[queue], &item, now);
+            erdp_if_rtos_cpu_unlock(key);
+#ifdef ERDP_ENABLE_RTOS
+            /* 延时工作项也唤醒工作线程，以便按更早的到期时间重新计算等待时间 */
+            __queues[queue].wake.give();
+#endif
+            return true;
+        }
+
+        // 把到期的延时工作项移入就绪队列并取出队头；wait_ms返回到下一个延时工作项到期的时间
+        WorkItem *__next_item(uint8_t queue, uint32_t &wait_ms)
+        {
+            QueueState &q = __queues[queue];
+            uint32_t now = erdp_if_rtos_get_1ms_timestamp();
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            while (q.delayed_head != nullptr && !__before(now, q.delayed_head->__due))
+            {
+                WorkItem *item = q.delayed_head;
+                q.delayed_head = item->__next;
+                __append_ready(q, item);
+            }
+            WorkItem *item = q.ready_head;
+            if (item != nullptr)
+            {
+                q.ready_head = item->__next;
+                if (q.ready_head == nullptr)
+                {
+                    q.ready_tail = nullptr;
+                }
+                item->__next = nullptr;
+                item->__state = WorkItem::STATE_RUNNING;
+                q.stats.depth--;
+            }
+            wait_ms = (q.delayed_head != nullptr) ? q.delayed_head->__due - now : NO_WAIT_LIMIT;
+            erdp_if_rtos_cpu_unlock(key);
+            return item;
+        }
+
+        void __run(WorkItem *item)
+        {
+            QueueState &q = __queues[item->__queue];
+            uint32_t start = erdp_if_rtos_get_1ms_timestamp();
+            uint32_t latency = __before(start, item->__due) ? 0 : start - item->__due;
+
+            item->fn();
+
+            if (item->__pooled)
+            {
+                item->fn.reset();
+            }
+            uint32_t now = erdp_if_rtos_get_1ms_timestamp();
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            q.stats.executed++;
+            q.stats.total_latency += latency;
+            if (latency > q.stats.max_latency)
+            {
+                q.stats.max_latency = latency;
+            }
+            if (item->__pooled)
+            {
+                item->__state = WorkItem::STATE_IDLE;
+                item->__next = __free;
+                __free = item;
+            }
+            else if (item->__period > 0)
+            {
+                item->__due += item->__period;
+                if (!__before(now, item->__due))
+                {
+                    /* 推迟超过一个周期，跳过错过的周期 */
+                    item->__due = now + item->__period;
+                }
+                __enqueue(q, item, now);
+            }
+            else
+            {
+                item->__state = WorkItem::STATE_IDLE;
+            }
+            erdp_if_rtos_cpu_unlock(key);
+        }
+
+#ifdef ERDP_ENABLE_RTOS
+        void __worker_loop(uint8_t queue)
+        {
+            QueueState &q = __queues[queue];
+            q.wake.bind();
+            while (true)
+            {
+                uint32_t wait_ms;
+                WorkItem *item = __next_item(queue, wait_ms);
+                if (item != nullptr)
+                {
+                    __run(item);
+                }
+                else
+                {
+                    q.wake.take((wait_ms == NO_WAIT_LIMIT) ? OS_WAIT_FOREVER : erdp_if_rtos_ms_to_ticks(wait_ms));
+                }
+            }
+        }
+#endif
+    };
+} // namespace erdp
+
+#endif // __ERDP_EXECUTOR_HPP__
@@ -0,0 +1,153 @@
+#ifndef __ERDP_FUNCTION_HPP__
+#define __ERDP_FUNCTION_HPP__
+#include <cstddef>
+#include <new>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+#include "erdp_assert.h"
+#include "erdp_config.h"
+
+namespace erdp
+{
+    template <typename Signature, size_t Capacity = ERDP_CONFIG_FUNCTION_CAPACITY>
+    class InplaceFunction;
+
+    /*
+     * Callable wrapper with the callable stored inside the object, never on the heap.
+     * A callable (lambda captures included) larger than Capacity bytes does not compile.
+     * Calls go through one function pointer; callables that are trivially copyable, such as
+     * lambdas capturing this or references, are copied and destroyed without any call.
+     */
+    template <typename R, typename... Args, size_t Capacity>
+    class InplaceFunction<R(Args...), Capacity>
+    {
+    public:
+        InplaceFunction() noexcept {}
+        InplaceFunction(std::nullptr_t) noexcept {}
+
+        template <typename F, typename Fn = std::decay_t<F>,
+                  typename = std::enable_if_t<!std::is_same<Fn, InplaceFunction>::value &&
+                                              std::is_invocable_r<R, Fn &, Args...>::value>>
+        InplaceFunction(F &&f)
+        {
+            static_assert(sizeof(Fn) <= Capacity, "InplaceFunction: callable too large, reduce the captures or raise Capacity");
+            static_assert(alignof(Fn) <= alignof(Storage), "InplaceFunction: callable over-aligned");
+            if constexpr (std::is_pointer<Fn>::value || std::is_member_pointer<Fn>::value)
+            {
+                if (f == nullptr)
+                {
+                    return;
+                }
+            }
+            new (&__storage) Fn(std::forward<F>(f));
+            __invoke = &__invoke_fn<Fn>;
+            if constexpr (!(std::is_trivially_copyable<Fn>::value && std::is_trivially_destructible<Fn>::value))
+            {
+                __manage = &__manage_fn<Fn>;
+            }
+        }
+
+        InplaceFunction(const InplaceFunction &other)
+        {
+            __copy_from(other);
+        }
+
+        InplaceFunction &operator=(const InplaceFunction &other)
+        {
+            if (this != &other)
+            {
+                reset();
+                __copy_from(other);
+            }
+            return *this;
+        }
+
+        InplaceFunction &operator=(std::nullptr_t) noexcept
+        {
+            reset();
+            return *this;
+        }
+
+        template <typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, InplaceFunction>::value>>
+        InplaceFunction &operator=(F &&f)
+        {
+            return *this = InplaceFunction(std::forward<F>(f));
+        }
+
+        ~InplaceFunction()
+        {
+            reset();
+        }
+
+        void reset() noexcept
+        {
+            if (__manage != nullptr)
+            {
+                __manage(&__storage, nullptr);
+            }
+            __invoke = nullptr;
+            __manage = nullptr;
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return __invoke != nullptr;
+        }
+
+        R operator()(Args... args) const
+        {
+            erdp_assert(__invoke != nullptr);
+            return __invoke(&__storage, std::forward<Args>(args)...);
+        }
+
+        friend bool operator==(const InplaceFunction &f, std::nullptr_t) noexcept { return !f; }
+        friend bool operator==(std::nullptr_t, const InplaceFunction &f) noexcept { return !f; }
+        friend bool operator!=(const InplaceFunction &f, std::nullptr_t) noexcept { return (bool)f; }
+        friend bool operator!=(std::nullptr_t, const InplaceFunction &f) noexcept { return (bool)f; }
+
+    private:
+        using Storage = std::aligned_storage_t<Capacity, alignof(std::max_align_t)>;
+        using Invoke = R (*)(const void *storage, Args &&...args);
+        using Manage = void (*)(void *dst, const void *src); // Copy src into dst, or destroy dst when src is nullptr
+
+        mutable Storage __storage;
+        Invoke __invoke = nullptr;
+        Manage __manage = nullptr; // nullptr for trivial callables
+
+        template <typename Fn>
+        static R __invoke_fn(const void *storage, Args &&...args)
+        {
+            return (*const_cast<Fn *>(static_cast<const Fn *>(storage)))(std::forward<Args>(args)...);
+        }
+
+        template <typename Fn>
+        static void __manage_fn(void *dst, const void *src)
+        {
+            if (src != nullptr)
+            {
+                new (dst) Fn(*static_cast<const Fn *>(src));
+            }
+            else
+            {
+                static_cast<Fn *>(dst)->~Fn();
+            }
+        }
+
+        void __copy_from(const InplaceFunction &other)
+        {
+            if (other.__manage != nullptr)
+            {
+                other.__manage(&__storage, &other.__storage);
+            }
+            else
+            {
+                memcpy(&__storage, &other.__storage, sizeof(__storage));
+            }
+            __invoke = other.__invoke;
+            __manage = other.__manage;
+        }
+    };
+} // namespace erdp
+
+#endif // __ERDP_FUNCTION_HPP__
@@ -114,12 +114,25 @@ namespace erdp
     {
         Thread *thead = static_cast<Thread *>(parm);
         thead->thread_code();
+        if (thead->__task_buffer != nullptr)
+        {
+            /* 控制块在对象中，自己删除时空闲任务回收前对象可能已释放，挂起等对象析构时删除 */
+            while (true)
+            {
+                erdp_if_rtos_task_suspend(erdp_if_rtos_task_get_current());
+            }
+        }
         thead->kill();
     }
 
+    // 主线程栈和控制块静态分配，启动不依赖堆状态
+    static OS_Stack main_task_stack[ERDP_CONFIG_MAIN_THREAD_STACK_SIZE];
+    static OS_TaskBuffer main_task_buffer;
+
     void create_main_task()
     {
-        Thread::__main_task = erdp_if_rtos_task_create(Thread::main_thread, "main", ERDP_CONFIG_MAIN_THREAD_STACK_SIZE, nullptr, 20);
+        Thread::__main_task = erdp_if_rtos_task_create_static(Thread::main_thread, "main", ERDP_CONFIG_MAIN_THREAD_STACK_SIZE, nullptr, 20,
+                                                              main_task_stack, &main_task_buffer);
     }
 } // namespace erdp
 int main(void)
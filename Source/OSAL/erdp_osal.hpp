@@ -6,8 +6,11 @@
 #include "erdp_heap.hpp"
 #include "string.h"
 
+#include <atomic>
 #include <cstddef>
-#include <functional>
+#include <new>
+#include <utility>
+#include "erdp_function.hpp"
 #include <queue>
 namespace erdp
 {
@@ -16,12 +19,42 @@ namespace erdp
         void erdp_task_run(void *parm);
     }
 
+    /**
+     * @brief 容器的编译期接口(CRTP)，派生类自行实现init/push/pop/size/empty/full
+     * 调用在编译期绑定到具体容器并可内联，容器不带虚表；HAL直接以具体容器类型作为缓冲区
+     * 需要在运行时切换容器时，用ContainerAdapter包装成ContainerBase
+     * @tparam _Derived 派生的容器类型
+     * @tparam _Type 元素类型
+     */
+    template <typename _Derived, typename _Type>
+    class Container
+    {
+    public:
+        using value_type = _Type;
+
+        bool init(size_t size) { return __derived().init(size); }
+        bool push(const _Type &elm) { return __derived().push(elm); }
+        bool pop(_Type &elm) { return __derived().pop(elm); }
+        uint32_t size() const noexcept { return __derived().size(); }
+        bool empty() const noexcept { return __derived().empty(); }
+        bool full() const noexcept { return __derived().full(); }
+
+    protected:
+        Container() {}
+        ~Container() {}
+
+    private:
+        _Derived &__derived() { return static_cast<_Derived &>(*this); }
+        const _Derived &__derived() const { return static_cast<const _Derived &>(*this); }
+    };
+
+    // 运行时多态的容器接口，由ContainerAdapter实现
     template <typename _Type>
     class ContainerBase
     {
     public:
         ContainerBase() {}
-        ~ContainerBase() {}
+        virtual ~ContainerBase() {}
 
         virtual bool init(size_t size) = 0;
         virtual bool push(const _Type &elm) = 0;
@@ -31,10 +64,35 @@ namespace erdp
         virtual bool full() const noexcept = 0;
     };
 
+    /**
+     * @brief 把任一容器包装成ContainerBase，虚函数调用只发生在经由适配器访问时
+     * 适配器只保存容器的引用，容器需比适配器存活更久
+     * @tparam _Container 具体容器类型，如Queue<uint8_t>、RingBuffer<uint8_t, 64>
+     */
+    template <typename _Container>
+    class ContainerAdapter : public ContainerBase<typename _Container::value_type>
+    {
+        using _Type = typename _Container::value_type;
+
+    public:
+        explicit ContainerAdapter(_Container &container) : __container(container) {}
+
+        bool init(size_t size) override { return __container.init(size); }
+        bool push(const _Type &elm) override { return __container.push(elm); }
+        bool pop(_Type &elm) override { return __container.pop(elm); }
+        uint32_t size() const noexcept override { return __container.size(); }
+        bool empty() const noexcept override { return __container.empty(); }
+        bool full() const noexcept override { return __container.full(); }
+
+    private:
+        _Container &__container;
+    };
+
 #ifdef ERDP_ENABLE_RTOS
     class Thread
     {
         friend void create_main_task();
+        friend void erdp_task_run(void *parm);
 
     public:
         /**
@@ -58,7 +116,7 @@ namespace erdp
          * }
          */
         Thread(void (*task_code)(void *p_arg), const char *name, uint32_t priority, size_t starck_size = DEFAULT_STACK_SIZE)
-            : __thread_code(task_code), __starck_size(starck_size)
+            : __thread_code(task_code), __priority(priority), __starck_size(starck_size)
         {
             strcpy(__name, name);
         }
@@ -86,7 +144,7 @@ namespace erdp
          * }
          */
         Thread(void (*task_code)(void *p_arg), void *p_arg, const char *name, uint32_t priority, size_t starck_size = DEFAULT_STACK_SIZE)
-            : __thread_code(task_code), __p_arg(p_arg), __starck_size(starck_size)
+            : __thread_code(task_code), __p_arg(p_arg), __priority(priority), __starck_size(starck_size)
         {
             strcpy(__name, name);
         }
@@ -115,7 +173,7 @@ namespace erdp
             strcpy(__name, name);
         }
 
-        Thread(std::function<void()> handle, const char *name, uint32_t priority, size_t stack_size = DEFAULT_STACK_SIZE)
+        Thread(InplaceFunction<void()> handle, const char *name, uint32_t priority, size_t stack_size = DEFAULT_STACK_SIZE)
             : __thread_code_lambda(handle), __priority(priority), __starck_size(stack_size)
         {
             strcpy(__name, name);
@@ -133,7 +191,15 @@ namespace erdp
             if (!__join_flag)
             {
                 __join_flag = 1;
-                __handler = erdp_if_rtos_task_create(erdp_task_run, __name, __starck_size, this, __priority);
+                if (__task_buffer != nullptr)
+                {
+                    __handler = erdp_if_rtos_task_create_static(erdp_task_run, __name, __starck_size, this, __priority,
+                                                                __stack, __task_buffer);
+                }
+                else
+                {
+                    __handler = erdp_if_rtos_task_create(erdp_task_run, __name, __starck_size, this, __priority);
+                }
                 erdp_assert(__handler!= nullptr);
             }
         }
@@ -195,22 +261,92 @@ namespace erdp
             }
         }
 
+    protected:
+        // Create the task in the given memory at join() instead of the heap
+        void __set_static_memory(OS_Stack *stack, OS_TaskBuffer *task_buffer)
+        {
+            __stack = stack;
+            __task_buffer = task_buffer;
+        }
+
+        // Delete the task created by join() from another task, the destructor then leaves it alone
+        void __delete_task()
+        {
+            if (__join_flag)
+            {
+                erdp_assert(erdp_if_rtos_task_get_current() != __handler);
+                erdp_if_rtos_task_delete(__handler);
+                __join_flag = 0;
+            }
+        }
+
     private:
         void (*__thread_code)(void *p_arg) = nullptr;
-        std::function<void()> __thread_code_lambda = nullptr;
+        InplaceFunction<void()> __thread_code_lambda = nullptr;
         void *__p_arg;
         char __name[configMAX_TASK_NAME_LEN + 1];
         uint32_t __priority;
         size_t __starck_size;
         OS_TaskHandle __handler;
         uint8_t __join_flag = 0;
+        OS_Stack *__stack = nullptr;
+        OS_TaskBuffer *__task_buffer = nullptr;
 
         static OS_TaskHandle __main_task;
         static void main_thread(void *parm);
     };
 
+    /**
+     * @brief 栈和任务控制块内嵌在对象中的线程，join时用静态API创建，不占用堆
+     * 线程代码结束后任务挂起而不删除自己，由析构删除任务；不能在该线程自身中析构
+     * @tparam StackWords 栈大小(字)
+     * @example
+     * StaticThread<256> TASK(task, "task", 1);
+     * TASK.join();
+     */
+    template <size_t StackWords>
+    class StaticThread : public Thread
+    {
+    public:
+        StaticThread(void (*task_code)(void *p_arg), const char *name, uint32_t priority)
+            : Thread(task_code, nullptr, name, priority, StackWords)
+        {
+            __set_static_memory(__stack_buffer, &__task_buffer);
+        }
+
+        StaticThread(void (*task_code)(void *p_arg), void *p_arg, const char *name, uint32_t priority)
+            : Thread(task_code, p_arg, name, priority, StackWords)
+        {
+            __set_static_memory(__stack_buffer, &__task_buffer);
+        }
+
+        // 作为基类使用时，在派生类中重写thread_code
+        StaticThread(const char *name, uint32_t priority) : Thread(name, priority, StackWords)
+        {
+            __set_static_memory(__stack_buffer, &__task_buffer);
+        }
+
+        StaticThread(InplaceFunction<void()> handle, const char *name, uint32_t priority)
+            : Thread(handle, name, priority, StackWords)
+        {
+            __set_static_memory(__stack_buffer, &__task_buffer);
+        }
+
+        ~StaticThread()
+        {
+            __delete_task();
+        }
+
+        StaticThread(const StaticThread &) = delete;
+        StaticThread &operator=(const StaticThread &) = delete;
+
+    private:
+        OS_Stack __stack_buffer[StackWords];
+        OS_TaskBuffer __task_buffer;
+    };
+
     template <typename _Type>
-    class Queue : public ContainerBase<_Type>
+    class Queue : public Container<Queue<_Type>, _Type>
     {
     public:
         Queue() {}
@@ -218,7 +354,7 @@ namespace erdp
         {
             init(queue_length);
         }
-        ~Queue() { erdp_if_rtos_queue_delet(__handler); }
+        ~Queue() { deinit(); }
 
         bool init(size_t queue_length)
         {
@@ -231,6 +367,29 @@ namespace erdp
             __queue_size = 0;
             return true;
         }
+
+        // 使用外部提供的存储区创建队列，storage大小为queue_length * sizeof(_Type)
+        bool init(size_t queue_length, uint8_t *storage, OS_QueueBuffer *queue_buffer)
+        {
+            erdp_assert(storage != nullptr && queue_buffer != nullptr);
+            __handler = erdp_if_rtos_queue_create_static(queue_length, sizeof(_Type), storage, queue_buffer);
+            if (__handler == nullptr)
+            {
+                return false;
+            }
+            __queue_length = queue_length;
+            __queue_size = 0;
+            return true;
+        }
+
+        void deinit()
+        {
+            if (__handler != nullptr)
+            {
+                erdp_if_rtos_queue_delet(__handler);
+                __handler = nullptr;
+            }
+        }
         bool push(const _Type &elm_to_push, uint32_t ticks_to_wait)
         {
             erdp_assert(__handler != nullptr);
@@ -275,6 +434,35 @@ namespace erdp
             return false;
         }
 
+        // 读取队首元素但不出队
+        bool peek(_Type &elm_recv, uint32_t ticks_to_wait = 0)
+        {
+            erdp_assert(__handler != nullptr);
+            return erdp_if_rtos_queue_peek(__handler, (uint8_t *)(&elm_recv), ticks_to_wait);
+        }
+
+        // 批量入队，最多等待ticks_to_wait让第一个元素入队，其余不等待，返回入队个数
+        size_t push_n(const _Type *elms, size_t count, uint32_t ticks_to_wait = 0)
+        {
+            size_t pushed = 0;
+            while (pushed < count && push(elms[pushed], pushed == 0 ? ticks_to_wait : 0))
+            {
+                pushed++;
+            }
+            return pushed;
+        }
+
+        // 批量出队，最多等待ticks_to_wait第一个元素，其余不等待，返回出队个数
+        size_t pop_n(_Type *elms, size_t count, uint32_t ticks_to_wait = 0)
+        {
+            size_t popped = 0;
+            while (popped < count && pop(elms[popped], popped == 0 ? ticks_to_wait : 0))
+            {
+                popped++;
+            }
+            return popped;
+        }
+
         bool empty() const noexcept
         {
             erdp_assert(__handler != nullptr);
@@ -301,240 +489,1736 @@ namespace erdp
             return __queue_size;
         }
 
+        OS_Queue get_queue_handler() const
+        {
+            return __handler;
+        }
+
     private:
-        OS_Queue __handler;
+        OS_Queue __handler = nullptr;
         uint32_t __queue_length;
         uint32_t __queue_size;
     };
 
-    template <Semaphore_tag T>
-    class Semaphore
+    /**
+     * @brief 存储区内嵌在对象中的队列，不占用堆
+     * @tparam _Type 元素类型
+     * @tparam N 队列长度
+     */
+    template <typename _Type, size_t N>
+    class StaticQueue : public Queue<_Type>
     {
     public:
-        template <Semaphore_tag U = T, typename = std::enable_if_t<U != COUNT_TAG>>
-        Semaphore()
-        {
-            if constexpr (U == BINARY_TAG)
-            {
-                __handler = erdp_if_rtos_semaphore_creat(BINARY_TAG);
-            }
-            else if constexpr (U == MUTEX_TAG)
-            {
-                __handler = erdp_if_rtos_semaphore_creat(MUTEX_TAG);
-            }
-            else if constexpr (U == RECURISIVE_TAG)
-            {
-                __handler = erdp_if_rtos_semaphore_creat(RECURISIVE_TAG);
-            }
-        }
-
-        template <Semaphore_tag U = T, typename = std::enable_if_t<U == COUNT_TAG>>
-        Semaphore(uint32_t max_count, uint32_t initial_count)
+        StaticQueue()
         {
-            __handler = erdp_if_rtos_counting_semaphore_creat(max_count, initial_count);
+            init(N);
         }
 
-        // 获取信号量
-        bool take(uint32_t ticks_to_wait = portMAX_DELAY)
+        ~StaticQueue()
         {
-            if constexpr (T == RECURISIVE_TAG)
-            {
-                return erdp_if_rtos_recursive_semaphore_take(__handler, ticks_to_wait);
-            }
-            else
-            {
-                return erdp_if_rtos_semaphore_take(__handler, ticks_to_wait);
-            }
+            this->deinit();
         }
 
-        // 释放信号量
-        bool give()
-        {
-            if constexpr (T == RECURISIVE_TAG)
-            {
-                return erdp_if_rtos_recursive_semaphore_give(__handler);
-            }
-            else
-            {
-                return erdp_if_rtos_semaphore_give(__handler);
-            }
-        }
+        StaticQueue(const StaticQueue &) = delete;
+        StaticQueue &operator=(const StaticQueue &) = delete;
 
-        ~Semaphore()
+        // 只能在内嵌存储区上重建，queue_length不超过N
+        bool init(size_t queue_length)
         {
-            if (__handler != nullptr)
-            {
-                erdp_if_rtos_semaphore_delet(__handler);
-            }
+            erdp_assert(queue_length > 0 && queue_length <= N);
+            this->deinit();
+            return Queue<_Type>::init(queue_length, __storage, &__queue_buffer);
         }
 
-        // 删除拷贝构造和赋值
-        Semaphore(const Semaphore &) = delete;
-        Semaphore &operator=(const Semaphore &) = delete;
-
     private:
-        OS_Semaphore __handler = nullptr;
+        alignas(_Type) uint8_t __storage[N * sizeof(_Type)];
+        OS_QueueBuffer __queue_buffer;
     };
 
-    class Mutex : private Semaphore<MUTEX_TAG>
+    /**
+     * @brief 基于流缓冲区的队列，元素按字节整块拷贝，push_n/pop_n一次内核调用完成
+     * 只支持一个写者和一个读者(可以是中断)，多个写者或读者需要自行互斥
+     * 容量和每次读写都是整数个元素，因此不会出现半个元素
+     * @tparam _Type 可平凡拷贝的元素类型
+     */
+    template <typename _Type>
+    class StreamQueue : public Container<StreamQueue<_Type>, _Type>
     {
+        static_assert(std::is_trivially_copyable<_Type>::value, "StreamQueue: elements are copied as bytes");
+
     public:
-        Mutex() : Semaphore<MUTEX_TAG>() {}
+        StreamQueue() {}
+        StreamQueue(uint32_t queue_length)
+        {
+            init(queue_length);
+        }
+        ~StreamQueue() { deinit(); }
 
-        bool lock(uint32_t ticks_to_wait = portMAX_DELAY)
+        StreamQueue(const StreamQueue &) = delete;
+        StreamQueue &operator=(const StreamQueue &) = delete;
+
+        bool init(size_t queue_length)
         {
-            return take(ticks_to_wait);
+            deinit();
+            __handler = erdp_if_rtos_stream_buffer_create(queue_length * sizeof(_Type), sizeof(_Type));
+            __queue_length = queue_length;
+            return __handler != nullptr;
         }
-        bool try_lock()
+
+        // 使用外部提供的存储区，storage大小为queue_length * sizeof(_Type) + 1
+        bool init(size_t queue_length, uint8_t *storage, OS_StreamBufferBuffer *stream_buffer)
         {
-            return take(0);
+            erdp_assert(storage != nullptr && stream_buffer != nullptr);
+            deinit();
+            __handler = erdp_if_rtos_stream_buffer_create_static(queue_length * sizeof(_Type), sizeof(_Type), storage,
+                                                                 stream_buffer);
+            __queue_length = queue_length;
+            return __handler != nullptr;
         }
-        bool unlock()
+
+        void deinit()
         {
-            return give();
+            if (__handler != nullptr)
+            {
+                erdp_if_rtos_stream_buffer_delete(__handler);
+                __handler = nullptr;
+            }
         }
-    };
 
-    class Event
-    {
+        bool push(const _Type &elm_to_push, uint32_t ticks_to_wait)
+        {
+            return push_n(&elm_to_push, 1, ticks_to_wait) == 1;
+        }
 
-    public:
-        Event() : __handler(erdp_if_rtos_event_create()) {}
+        bool push(const _Type &elm_to_push)
+        {
+            return push_n(&elm_to_push, 1, 0) == 1;
+        }
 
-        Event(const Event &) = delete;
-        Event &operator=(const Event &) = delete;
+        bool pop(_Type &elm_recv, uint32_t ticks_to_wait)
+        {
+            return pop_n(&elm_recv, 1, ticks_to_wait) == 1;
+        }
 
-        ~Event()
+        bool pop(_Type &elm_recv)
         {
-            vEventGroupDelete(__handler);
+            return pop_n(&elm_recv, 1, 0) == 1;
         }
-        OS_EventBits set(OS_EventBits bits_to_set)
+
+        // 批量入队，最多等待ticks_to_wait直到全部放得下，超时则放入能放下的部分，返回入队个数
+        size_t push_n(const _Type *elms, size_t count, uint32_t ticks_to_wait = 0)
         {
-            return erdp_if_rtos_set_event_bits(__handler, bits_to_set);
+            erdp_assert(__handler != nullptr);
+            return erdp_if_rtos_stream_buffer_send(__handler, (const uint8_t *)elms, count * sizeof(_Type),
+                                                   ticks_to_wait) /
+                   sizeof(_Type);
         }
 
-        OS_EventBits clear(OS_EventBits bits_to_clear)
+        // 批量出队，最多等待ticks_to_wait第一个元素，返回出队个数
+        size_t pop_n(_Type *elms, size_t count, uint32_t ticks_to_wait = 0)
         {
-            return erdp_if_rtos_clear_event_bits(__handler, bits_to_clear);
+            erdp_assert(__handler != nullptr);
+            return erdp_if_rtos_stream_buffer_recv(__handler, (uint8_t *)elms, count * sizeof(_Type), ticks_to_wait) /
+                   sizeof(_Type);
         }
 
-        OS_EventBits get()
+        void clear()
         {
-            return erdp_if_rtos_get_event_bits(__handler);
+            erdp_assert(__handler != nullptr);
+            erdp_if_rtos_stream_buffer_reset(__handler);
         }
 
-        OS_EventBits wait(OS_EventBits bits_to_wait, uint32_t ticks_to_wait = OS_WAIT_FOREVER, bool wait_for_all = true)
+        bool empty() const noexcept
         {
-            return xEventGroupWaitBits(__handler, bits_to_wait, false, wait_for_all, ticks_to_wait);
+            return size() == 0;
         }
 
-        OS_EventBits sync(OS_EventBits bits_to_set, OS_EventBits bits_wait_for, uint32_t ticks_to_wait = OS_WAIT_FOREVER)
+        bool full() const noexcept
         {
-            return erdp_if_rtos_event_sync(__handler, bits_to_set, bits_wait_for, ticks_to_wait);
+            return size() == __queue_length;
+        }
+
+        uint32_t size() const noexcept
+        {
+            erdp_assert(__handler != nullptr);
+            return erdp_if_rtos_stream_buffer_bytes_available(__handler) / sizeof(_Type);
         }
 
     private:
-        OS_Event __handler;
+        OS_StreamBuffer __handler = nullptr;
+        uint32_t __queue_length = 0;
     };
 
-#else // ERDP_ENABLE_RTOS
-    // 全局默认堆(需先初始化)
-    extern Heap4 *default_heap;
-
-#endif // ERDP_ENABLE_RTOS
-
-    template <typename T>
-    class RingBuffer : public ContainerBase<T>
+    // 存储区内嵌在对象中的StreamQueue，不占用堆
+    template <typename _Type, size_t N>
+    class StaticStreamQueue : public StreamQueue<_Type>
     {
     public:
-        RingBuffer(const RingBuffer &) = delete;
-        RingBuffer &operator=(const RingBuffer &) = delete;
-
-        RingBuffer() {}
-
-        RingBuffer(uint8_t *mempool, size_t mempool_size) noexcept
+        StaticStreamQueue()
         {
-            init(mempool, mempool_size);
+            init(N);
         }
 
-        RingBuffer(size_t size) noexcept
+        ~StaticStreamQueue()
         {
-            init(size);
+            this->deinit();
         }
 
-        bool init(uint8_t *mempool, size_t mempool_size)
+        // 只能在内嵌存储区上重建，queue_length不超过N
+        bool init(size_t queue_length)
         {
-            erdp_assert(mempool != nullptr);
-            erdp_assert(mempool_size % sizeof(T) == 0);
-            __buffer = reinterpret_cast<T *>(mempool);
-            __size = mempool_size / sizeof(T);
-            __head = 0;
-            __tail = 0;
-            return true;
+            erdp_assert(queue_length > 0 && queue_length <= N);
+            return StreamQueue<_Type>::init(queue_length, __storage, &__stream_buffer);
         }
 
-        bool init(uint32_t size) noexcept
+    private:
+        uint8_t __storage[N * sizeof(_Type) + 1];
+        OS_StreamBufferBuffer __stream_buffer;
+    };
+
+    /**
+     * @brief 流缓冲区，在任务和中断之间传递不定长的字节流，send/recv可在中断中调用
+     * 只支持一个写者和一个读者，多个写者或读者需要自行互斥
+     * 阻塞的读者在缓冲区中的字节数达到触发水平(trigger_level)时被唤醒
+     */
+    class StreamBuffer
+    {
+    public:
+        StreamBuffer() {}
+        StreamBuffer(size_t size, size_t trigger_level = 1)
         {
-            __buffer = new T[size];
-            if (__buffer == nullptr)
-            {
-                return false;
-            }
-            __size = size;
-            __head = 0;
-            __tail = 0;
-            return true;
+            init(size, trigger_level);
         }
+        ~StreamBuffer() { deinit(); }
 
-        bool full() const noexcept { return (__tail + 1) % __size == __head; }
+        StreamBuffer(const StreamBuffer &) = delete;
+        StreamBuffer &operator=(const StreamBuffer &) = delete;
 
-        bool empty() const noexcept { return __head == __tail; }
+        bool init(size_t size, size_t trigger_level = 1)
+        {
+            deinit();
+            __handler = erdp_if_rtos_stream_buffer_create(size, trigger_level);
+            return __handler != nullptr;
+        }
 
-        bool push(const T &item) noexcept
+        // 使用外部提供的存储区，storage大小为size + 1
+        bool init(size_t size, size_t trigger_level, uint8_t *storage, OS_StreamBufferBuffer *stream_buffer)
         {
-            if (full())
-            {
-                return false;
-            }
-            __buffer[__tail] = item;
-            __tail = (__tail + 1) % __size;
-            return true;
+            erdp_assert(storage != nullptr && stream_buffer != nullptr);
+            deinit();
+            __handler = erdp_if_rtos_stream_buffer_create_static(size, trigger_level, storage, stream_buffer);
+            return __handler != nullptr;
         }
 
-        bool pop(T &item) noexcept
+        void deinit()
         {
-            if (empty())
+            if (__handler != nullptr)
             {
-                return false;
+                erdp_if_rtos_stream_buffer_delete(__handler);
+                __handler = nullptr;
             }
-            item = __buffer[__head];
-            __head = (__head + 1) % __size;
-            return true;
         }
 
-        uint32_t size() const noexcept
+        // 最多等待ticks_to_wait直到全部放得下，超时则写入能放下的部分，返回写入字节数
+        size_t send(const void *data, size_t len, uint32_t ticks_to_wait = 0)
+        {
+            erdp_assert(__handler != nullptr);
+            return erdp_if_rtos_stream_buffer_send(__handler, (const uint8_t *)data, len, ticks_to_wait);
+        }
+
+        // 最多等待ticks_to_wait直到达到触发水平，返回读出字节数
+        size_t recv(void *data, size_t len, uint32_t ticks_to_wait = 0)
+        {
+            erdp_assert(__handler != nullptr);
+            return erdp_if_rtos_stream_buffer_recv(__handler, (uint8_t *)data, len, ticks_to_wait);
+        }
+
+        bool set_trigger_level(size_t trigger_level)
+        {
+            erdp_assert(__handler != nullptr);
+            return erdp_if_rtos_stream_buffer_set_trigger_level(__handler, trigger_level);
+        }
+
+        // 有读者或写者阻塞时不能清空，返回false
+        bool reset()
+        {
+            erdp_assert(__handler != nullptr);
+            return erdp_if_rtos_stream_buffer_reset(__handler);
+        }
+
+        size_t available() const
+        {
+            erdp_assert(__handler != nullptr);
+            return erdp_if_rtos_stream_buffer_bytes_available(__handler);
+        }
+
+        size_t space() const
+        {
+            erdp_assert(__handler != nullptr);
+            return erdp_if_rtos_stream_buffer_spaces_available(__handler);
+        }
+
+        bool empty() const
+        {
+            return available() == 0;
+        }
+
+        bool full() const
+        {
+            return space() == 0;
+        }
+
+    private:
+        OS_StreamBuffer __handler = nullptr;
+    };
+
+    // 存储区内嵌在对象中的StreamBuffer，不占用堆
+    template <size_t Size>
+    class StaticStreamBuffer : public StreamBuffer
+    {
+    public:
+        StaticStreamBuffer(size_t trigger_level = 1)
+        {
+            init(trigger_level);
+        }
+
+        ~StaticStreamBuffer()
+        {
+            this->deinit();
+        }
+
+        // 只能在内嵌存储区上重建
+        bool init(size_t trigger_level = 1)
+        {
+            return StreamBuffer::init(Size, trigger_level, __storage, &__stream_buffer);
+        }
+
+    private:
+        uint8_t __storage[Size + 1];
+        OS_StreamBufferBuffer __stream_buffer;
+    };
+
+    /**
+     * @brief 消息缓冲区，在任务和中断之间传递不定长的消息，send/recv可在中断中调用
+     * 消息整条写入、整条读出，每条消息在缓冲区中额外占用LENGTH_BYTES字节保存长度
+     * 只支持一个写者和一个读者，多个写者或读者需要自行互斥
+     */
+    class MessageBuffer
+    {
+    public:
+        static constexpr size_t LENGTH_BYTES = sizeof(size_t);
+
+        MessageBuffer() {}
+        MessageBuffer(size_t size)
+        {
+            init(size);
+        }
+        ~MessageBuffer() { deinit(); }
+
+        MessageBuffer(const MessageBuffer &) = delete;
+        MessageBuffer &operator=(const MessageBuffer &) = delete;
+
+        bool init(size_t size)
+        {
+            deinit();
+            __handler = erdp_if_rtos_message_buffer_create(size);
+            return __handler != nullptr;
+        }
+
+        // 使用外部提供的存储区，storage大小为size + 1
+        bool init(size_t size, uint8_t *storage, OS_MessageBufferBuffer *message_buffer)
+        {
+            erdp_assert(storage != nullptr && message_buffer != nullptr);
+            deinit();
+            __handler = erdp_if_rtos_message_buffer_create_static(size, storage, message_buffer);
+            return __handler != nullptr;
+        }
+
+        void deinit()
+        {
+            if (__handler != nullptr)
+            {
+                erdp_if_rtos_message_buffer_delete(__handler);
+                __handler = nullptr;
+            }
+        }
+
+        // 最多等待ticks_to_wait直到整条消息放得下，超时不写入任何字节
+        bool send(const void *data, size_t len, uint32_t ticks_to_wait = 0)
+        {
+            erdp_assert(__handler != nullptr);
+            return erdp_if_rtos_message_buffer_send(__handler, (const uint8_t *)data, len, ticks_to_wait);
+        }
+
+        // 读出最早的一条消息并返回其长度；超时或len小于消息长度时返回0，消息留在缓冲区中
+        size_t recv(void *data, size_t len, uint32_t ticks_to_wait = 0)
+        {
+            erdp_assert(__handler != nullptr);
+            return erdp_if_rtos_message_buffer_recv(__handler, (uint8_t *)data, len, ticks_to_wait);
+        }
+
+        // 最早一条消息的长度，缓冲区为空时返回0
+        size_t next_length() const
+        {
+            erdp_assert(__handler != nullptr);
+            return erdp_if_rtos_message_buffer_next_length(__handler);
+        }
+
+        // 有读者或写者阻塞时不能清空，返回false
+        bool reset()
+        {
+            erdp_assert(__handler != nullptr);
+            return erdp_if_rtos_message_buffer_reset(__handler);
+        }
+
+        // 不阻塞时能写入的最长消息
+        size_t space() const
+        {
+            erdp_assert(__handler != nullptr);
+            size_t free_bytes = erdp_if_rtos_message_buffer_spaces_available(__handler);
+            return free_bytes > LENGTH_BYTES ? free_bytes - LENGTH_BYTES : 0;
+        }
+
+        bool empty() const
+        {
+            return next_length() == 0;
+        }
+
+    private:
+        OS_MessageBuffer __handler = nullptr;
+    };
+
+    // 存储区内嵌在对象中的MessageBuffer，不占用堆
+    template <size_t Size>
+    class StaticMessageBuffer : public MessageBuffer
+    {
+    public:
+        StaticMessageBuffer()
+        {
+            init();
+        }
+
+        ~StaticMessageBuffer()
+        {
+            this->deinit();
+        }
+
+        // 只能在内嵌存储区上重建
+        bool init()
+        {
+            return MessageBuffer::init(Size, __storage, &__message_buffer);
+        }
+
+    private:
+        uint8_t __storage[Size + 1];
+        OS_MessageBufferBuffer __message_buffer;
+    };
+
+    template <Semaphore_tag T>
+    class Semaphore
+    {
+    public:
+        template <Semaphore_tag U = T, typename = std::enable_if_t<U != COUNT_TAG>>
+        Semaphore()
+        {
+            if constexpr (U == BINARY_TAG)
+            {
+                __handler = erdp_if_rtos_semaphore_creat(BINARY_TAG);
+            }
+            else if constexpr (U == MUTEX_TAG)
+            {
+                __handler = erdp_if_rtos_semaphore_creat(MUTEX_TAG);
+            }
+            else if constexpr (U == RECURISIVE_TAG)
+            {
+                __handler = erdp_if_rtos_semaphore_creat(RECURISIVE_TAG);
+            }
+        }
+
+        template <Semaphore_tag U = T, typename = std::enable_if_t<U == COUNT_TAG>>
+        Semaphore(uint32_t max_count, uint32_t initial_count)
+        {
+            __handler = erdp_if_rtos_counting_semaphore_creat(max_count, initial_count);
+        }
+
+        // 获取信号量
+        bool take(uint32_t ticks_to_wait = portMAX_DELAY)
+        {
+            if constexpr (T == RECURISIVE_TAG)
+            {
+                return erdp_if_rtos_recursive_semaphore_take(__handler, ticks_to_wait);
+            }
+            else
+            {
+                return erdp_if_rtos_semaphore_take(__handler, ticks_to_wait);
+            }
+        }
+
+        // 释放信号量
+        bool give()
+        {
+            if constexpr (T == RECURISIVE_TAG)
+            {
+                return erdp_if_rtos_recursive_semaphore_give(__handler);
+            }
+            else
+            {
+                return erdp_if_rtos_semaphore_give(__handler);
+            }
+        }
+
+        ~Semaphore()
+        {
+            if (__handler != nullptr)
+            {
+                erdp_if_rtos_semaphore_delet(__handler);
+            }
+        }
+
+        OS_Semaphore get_semaphore_handler() const
+        {
+            return __handler;
+        }
+
+        // 删除拷贝构造和赋值
+        Semaphore(const Semaphore &) = delete;
+        Semaphore &operator=(const Semaphore &) = delete;
+
+    protected:
+        // 由派生类创建句柄
+        explicit Semaphore(OS_Semaphore handler) : __handler(handler) {}
+
+        OS_Semaphore __handler = nullptr;
+    };
+
+    // 控制块内嵌在对象中的信号量，不占用堆
+    template <Semaphore_tag T>
+    class StaticSemaphore : public Semaphore<T>
+    {
+    public:
+        template <Semaphore_tag U = T, typename = std::enable_if_t<U != COUNT_TAG>>
+        StaticSemaphore() : Semaphore<T>(nullptr)
+        {
+            this->__handler = erdp_if_rtos_semaphore_creat_static(T, &__buffer);
+        }
+
+        template <Semaphore_tag U = T, typename = std::enable_if_t<U == COUNT_TAG>>
+        StaticSemaphore(uint32_t max_count, uint32_t initial_count) : Semaphore<T>(nullptr)
+        {
+            this->__handler = erdp_if_rtos_counting_semaphore_creat_static(max_count, initial_count, &__buffer);
+        }
+
+        // 先于__buffer析构删除
+        ~StaticSemaphore()
+        {
+            erdp_if_rtos_semaphore_delet(this->__handler);
+            this->__handler = nullptr;
+        }
+
+    private:
+        OS_SemaphoreBuffer __buffer;
+    };
+
+    class Mutex : private Semaphore<MUTEX_TAG>
+    {
+    public:
+        Mutex() : Semaphore<MUTEX_TAG>() {}
+
+        bool lock(uint32_t ticks_to_wait = portMAX_DELAY)
+        {
+            return take(ticks_to_wait);
+        }
+        bool try_lock()
+        {
+            return take(0);
+        }
+        bool unlock()
+        {
+            return give();
+        }
+    };
+
+    class StaticMutex : private StaticSemaphore<MUTEX_TAG>
+    {
+    public:
+        StaticMutex() : StaticSemaphore<MUTEX_TAG>() {}
+
+        bool lock(uint32_t ticks_to_wait = portMAX_DELAY)
+        {
+            return take(ticks_to_wait);
+        }
+        bool try_lock()
+        {
+            return take(0);
+        }
+        bool unlock()
+        {
+            return give();
+        }
+    };
+
+    class Event
+    {
+
+    public:
+        Event() : __handler(erdp_if_rtos_event_create()) {}
+
+        Event(const Event &) = delete;
+        Event &operator=(const Event &) = delete;
+
+        ~Event()
+        {
+            if (__handler != nullptr)
+            {
+                erdp_if_rtos_event_delete(__handler);
+            }
+        }
+        OS_EventBits set(OS_EventBits bits_to_set)
+        {
+            return erdp_if_rtos_set_event_bits(__handler, bits_to_set);
+        }
+
+        OS_EventBits clear(OS_EventBits bits_to_clear)
+        {
+            return erdp_if_rtos_clear_event_bits(__handler, bits_to_clear);
+        }
+
+        OS_EventBits get()
+        {
+            return erdp_if_rtos_get_event_bits(__handler);
+        }
+
+        OS_EventBits wait(OS_EventBits bits_to_wait, uint32_t ticks_to_wait = OS_WAIT_FOREVER, bool wait_for_all = true)
+        {
+            return xEventGroupWaitBits(__handler, bits_to_wait, false, wait_for_all, ticks_to_wait);
+        }
+
+        OS_EventBits sync(OS_EventBits bits_to_set, OS_EventBits bits_wait_for, uint32_t ticks_to_wait = OS_WAIT_FOREVER)
+        {
+            return erdp_if_rtos_event_sync(__handler, bits_to_set, bits_wait_for, ticks_to_wait);
+        }
+
+    protected:
+        // 由派生类创建句柄
+        explicit Event(OS_Event handler) : __handler(handler) {}
+
+        OS_Event __handler;
+    };
+
+    // 事件组内嵌在对象中，不占用堆
+    class StaticEvent : public Event
+    {
+    public:
+        StaticEvent() : Event(nullptr)
+        {
+            __handler = erdp_if_rtos_event_create_static(&__buffer);
+        }
+
+        // 先于__buffer析构删除
+        ~StaticEvent()
+        {
+            erdp_if_rtos_event_delete(__handler);
+            __handler = nullptr;
+        }
+
+    private:
+        OS_EventBuffer __buffer;
+    };
+
+    /**
+     * @brief 基于任务通知的信号量，不创建内核对象，give直接唤醒等待的线程
+     * 只有绑定的线程可以take，give可在任意任务或中断中调用，绑定前的give先记下，绑定时补上
+     * 每个对象占用绑定线程的一个通知索引(1到OS_NOTIFY_INDEX_NUM - 1)，同一线程的多个对象需使用不同索引，
+     * 索引0留给流缓冲区和消息缓冲区
+     * @example
+     * NotifySemaphore rx_done;           // 成员
+     * rx_done.bind();                    // 在接收线程中绑定
+     * rx_done.take(100);                 // 接收线程等待
+     * rx_done.give();                    // 中断中释放
+     */
+    class NotifySemaphore
+    {
+    public:
+        // counting为false时为二值信号量，多次give只计一次
+        NotifySemaphore(uint8_t index = 1, bool counting = false) : __index(index), __counting(counting)
+        {
+            erdp_assert(index > 0 && index < OS_NOTIFY_INDEX_NUM);
+        }
+
+        NotifySemaphore(const NotifySemaphore &) = delete;
+        NotifySemaphore &operator=(const NotifySemaphore &) = delete;
+
+        // 绑定take的线程并清零计数，owner为nullptr时绑定当前线程；第一次take时会自动绑定当前线程
+        void bind(OS_TaskHandle owner = nullptr)
+        {
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            __owner = (owner != nullptr) ? owner : erdp_if_rtos_task_get_current();
+            erdp_if_rtos_task_notify_reset(__owner, __index);
+            uint32_t pending = __pending;
+            __pending = 0;
+            erdp_if_rtos_cpu_unlock(key);
+            while (pending-- > 0)
+            {
+                erdp_if_rtos_task_notify_give(__owner, __index);
+            }
+        }
+
+        void bind(Thread &thread)
+        {
+            bind(thread.get_thread_handler());
+        }
+
+        // 获取信号量，只能在绑定的线程中调用
+        bool take(uint32_t ticks_to_wait = portMAX_DELAY)
+        {
+            if (__owner == nullptr)
+            {
+                bind();
+            }
+            erdp_assert(__owner == erdp_if_rtos_task_get_current());
+            return erdp_if_rtos_task_notify_take(__index, !__counting, ticks_to_wait) != 0;
+        }
+
+        // 释放信号量，尚未绑定线程时记下，返回false
+        bool give()
+        {
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            OS_TaskHandle owner = __owner;
+            if (owner == nullptr)
+            {
+                __pending = __counting ? __pending + 1 : 1;
+            }
+            erdp_if_rtos_cpu_unlock(key);
+            if (owner == nullptr)
+            {
+                return false;
+            }
+            erdp_if_rtos_task_notify_give(owner, __index);
+            return true;
+        }
+
+        OS_TaskHandle get_owner() const
+        {
+            return __owner;
+        }
+
+    private:
+        OS_TaskHandle volatile __owner = nullptr;
+        uint32_t __pending = 0; // 绑定前的give
+        uint8_t __index;
+        bool __counting;
+    };
+
+    /**
+     * @brief 基于任务通知的32位事件标志，不创建内核对象
+     * set在中断中调用时直接唤醒线程，不经过定时器任务(Event::set在中断中需要定时器任务代为置位)
+     * 只有绑定的线程可以wait，set可在任意任务或中断中调用，绑定前的set先记下，绑定时补上；clear/get只能在任务中调用
+     * 通知索引的规则同NotifySemaphore
+     */
+    class NotifyFlags
+    {
+    public:
+        NotifyFlags(uint8_t index = 1) : __index(index)
+        {
+            erdp_assert(index > 0 && index < OS_NOTIFY_INDEX_NUM);
+        }
+
+        NotifyFlags(const NotifyFlags &) = delete;
+        NotifyFlags &operator=(const NotifyFlags &) = delete;
+
+        // 绑定wait的线程并清除所有位，owner为nullptr时绑定当前线程；第一次wait时会自动绑定当前线程
+        void bind(OS_TaskHandle owner = nullptr)
+        {
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            __owner = (owner != nullptr) ? owner : erdp_if_rtos_task_get_current();
+            erdp_if_rtos_task_notify_reset(__owner, __index);
+            uint32_t pending = __pending;
+            __pending = 0;
+            erdp_if_rtos_cpu_unlock(key);
+            if (pending != 0)
+            {
+                erdp_if_rtos_task_notify_set_bits(__owner, __index, pending);
+            }
+        }
+
+        void bind(Thread &thread)
+        {
+            bind(thread.get_thread_handler());
+        }
+
+        // 置位，尚未绑定线程时记下，返回false
+        bool set(uint32_t bits_to_set)
+        {
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            OS_TaskHandle owner = __owner;
+            if (owner == nullptr)
+            {
+                __pending |= bits_to_set;
+            }
+            erdp_if_rtos_cpu_unlock(key);
+            if (owner == nullptr)
+            {
+                return false;
+            }
+            erdp_if_rtos_task_notify_set_bits(owner, __index, bits_to_set);
+            return true;
+        }
+
+        // 清除位，返回清除前的值
+        uint32_t clear(uint32_t bits_to_clear)
+        {
+            erdp_assert(__owner != nullptr);
+            return erdp_if_rtos_task_notify_clear_bits(__owner, __index, bits_to_clear);
+        }
+
+        uint32_t get()
+        {
+            erdp_assert(__owner != nullptr);
+            return erdp_if_rtos_task_notify_clear_bits(__owner, __index, 0);
+        }
+
+        /**
+         * @brief 等待位，只能在绑定的线程中调用
+         * @param[in] bits_to_wait 等待的位
+         * @param[in] ticks_to_wait 最长等待时间
+         * @param[in] wait_for_all true等待全部位，false等待任意一位
+         * @param[in] clear_on_exit 等到后清除bits_to_wait
+         * @return 等待结束时(清除前)的值，超时可通过与bits_to_wait比较判断
+         */
+        uint32_t wait(uint32_t bits_to_wait, uint32_t ticks_to_wait = OS_WAIT_FOREVER, bool wait_for_all = true,
+                      bool clear_on_exit = true)
+        {
+            if (__owner == nullptr)
+            {
+                bind();
+            }
+            erdp_assert(__owner == erdp_if_rtos_task_get_current());
+            return erdp_if_rtos_task_notify_wait_bits(__index, bits_to_wait, wait_for_all, clear_on_exit,
+                                                      ticks_to_wait);
+        }
+
+        OS_TaskHandle get_owner() const
+        {
+            return __owner;
+        }
+
+    private:
+        OS_TaskHandle volatile __owner = nullptr;
+        uint32_t __pending = 0; // 绑定前set的位
+        uint8_t __index;
+    };
+
+    /**
+     * @brief 软件定时器(FreeRTOS定时器)，控制块内嵌在对象中，不占用堆
+     * 回调在定时器任务中执行，不能阻塞；分辨率为一个系统节拍(1ms)，亚毫秒定时使用TimerWheel
+     * 命令经定时器命令队列送给定时器任务，ticks_to_wait为队列满时的等待时间，在回调中调用时必须为0
+     * 析构时等定时器任务处理完删除命令再返回，不能在中断或定时器回调中析构
+     * @example
+     * Timer led_timer([] { led.toggle(); }, 500, true); // 500ms周期定时器
+     * led_timer.start();
+     */
+    class Timer
+    {
+    public:
+        Timer() {}
+
+        Timer(const Timer &) = delete;
+        Timer &operator=(const Timer &) = delete;
+
+        // periodic为false时为单次定时器
+        Timer(InplaceFunction<void()> callback, uint32_t period_ticks, bool periodic = false, const char *name = "timer")
+        {
+            init(callback, period_ticks, periodic, name);
+        }
+
+        ~Timer()
+        {
+            deinit();
+        }
+
+        // 创建后处于停止状态，需调用start()
+        void init(InplaceFunction<void()> callback, uint32_t period_ticks, bool periodic = false, const char *name = "timer")
+        {
+            erdp_assert(__handler == nullptr);
+            __callback = callback;
+            __handler = erdp_if_rtos_timer_create_static(name, __ticks(period_ticks), periodic, this, __timer_callback,
+                                                         &__buffer);
+            erdp_assert(__handler != nullptr);
+        }
+
+        // 删除命令由定时器任务处理，等处理完再返回，之后定时器对象才可以释放；不能在中断或定时器回调中调用
+        void deinit()
+        {
+            if (__handler != nullptr)
+            {
+                erdp_assert(!erdp_if_rtos_in_isr());
+                erdp_assert(!erdp_if_rtos_timer_in_task());
+                erdp_if_rtos_timer_delete(__handler, OS_WAIT_FOREVER);
+                erdp_if_rtos_timer_sync(OS_WAIT_FOREVER);
+                __handler = nullptr;
+            }
+        }
+
+        // 启动定时器，已在运行时从现在重新计时；未创建时返回false
+        bool start(uint32_t ticks_to_wait = 0)
+        {
+            return (__handler != nullptr) && erdp_if_rtos_timer_start(__handler, ticks_to_wait);
+        }
+
+        bool stop(uint32_t ticks_to_wait = 0)
+        {
+            return (__handler != nullptr) && erdp_if_rtos_timer_stop(__handler, ticks_to_wait);
+        }
+
+        // 从现在重新计时，停止状态下会启动定时器
+        bool reset(uint32_t ticks_to_wait = 0)
+        {
+            return (__handler != nullptr) && erdp_if_rtos_timer_reset(__handler, ticks_to_wait);
+        }
+
+        // 修改周期并从现在重新计时，停止状态下会启动定时器
+        bool set_period(uint32_t period_ticks, uint32_t ticks_to_wait = 0)
+        {
+            return (__handler != nullptr) &&
+                   erdp_if_rtos_timer_change_period(__handler, __ticks(period_ticks), ticks_to_wait);
+        }
+
+        bool is_active()
+        {
+            return (__handler != nullptr) && erdp_if_rtos_timer_is_active(__handler);
+        }
+
+        OS_Timer get_timer_handler()
+        {
+            return __handler;
+        }
+
+    private:
+        OS_Timer __handler = nullptr;
+        OS_TimerBuffer __buffer;
+        InplaceFunction<void()> __callback = nullptr;
+
+        // FreeRTOS不接受0周期
+        static uint32_t __ticks(uint32_t period_ticks)
+        {
+            return (period_ticks > 0) ? period_ticks : 1;
+        }
+
+        static void __timer_callback(OS_Timer timer)
+        {
+            Timer *self = static_cast<Timer *>(erdp_if_rtos_timer_get_id(timer));
+            if (self->__callback != nullptr)
+            {
+                self->__callback();
+            }
+        }
+    };
+
+#else // ERDP_ENABLE_RTOS
+    // 全局默认堆(需先初始化)
+    extern Heap4 *default_heap;
+
+#endif // ERDP_ENABLE_RTOS
+
+    // N为0时容量在运行时指定，否则为编译期确定的2的幂，见下方两个实现
+    template <typename T, size_t N = 0>
+    class RingBuffer;
+
+    template <typename T>
+    class RingBuffer<T, 0> : public Container<RingBuffer<T, 0>, T>
+    {
+    public:
+        RingBuffer(const RingBuffer &) = delete;
+        RingBuffer &operator=(const RingBuffer &) = delete;
+
+        RingBuffer() {}
+
+        RingBuffer(uint8_t *mempool, size_t mempool_size) noexcept
+        {
+            init(mempool, mempool_size);
+        }
+
+        RingBuffer(size_t size) noexcept
+        {
+            init(size);
+        }
+
+        bool init(uint8_t *mempool, size_t mempool_size)
+        {
+            erdp_assert(mempool != nullptr);
+            erdp_assert(mempool_size % sizeof(T) == 0);
+            __buffer = reinterpret_cast<T *>(mempool);
+            __size = mempool_size / sizeof(T);
+            __head = 0;
+            __tail = 0;
+            return true;
+        }
+
+        bool init(size_t size) noexcept
+        {
+            __buffer = new T[size];
+            if (__buffer == nullptr)
+            {
+                return false;
+            }
+            __size = size;
+            __head = 0;
+            __tail = 0;
+            return true;
+        }
+
+        bool full() const noexcept { return (__tail + 1) % __size == __head; }
+
+        bool empty() const noexcept { return __head == __tail; }
+
+        bool push(const T &item) noexcept
+        {
+            if (full())
+            {
+                return false;
+            }
+            __buffer[__tail] = item;
+            __tail = (__tail + 1) % __size;
+            return true;
+        }
+
+        bool pop(T &item) noexcept
+        {
+            if (empty())
+            {
+                return false;
+            }
+            item = __buffer[__head];
+            __head = (__head + 1) % __size;
+            return true;
+        }
+
+        bool peek(T &item) const noexcept
+        {
+            if (empty())
+            {
+                return false;
+            }
+            item = __buffer[__head];
+            return true;
+        }
+
+        // 批量入队，返回入队个数
+        size_t push_n(const T *items, size_t count) noexcept
+        {
+            size_t pushed = 0;
+            while (pushed < count && push(items[pushed]))
+            {
+                pushed++;
+            }
+            return pushed;
+        }
+
+        // 批量出队，返回出队个数
+        size_t pop_n(T *items, size_t count) noexcept
+        {
+            size_t popped = 0;
+            while (popped < count && pop(items[popped]))
+            {
+                popped++;
+            }
+            return popped;
+        }
+
+        uint32_t size() const noexcept
         {
             return (__tail - __head + __size) % __size;
         }
 
-    private:
-        T *__buffer;
-        uint32_t __size;
-        volatile uint32_t __head;
-        volatile uint32_t __tail;
+        // 访问第index个未出队的元素，0为队头
+        T &operator[](uint32_t index)
+        {
+            erdp_assert(index < size());
+            return *reinterpret_cast<T *>(__buffer + ((__head + index) % __size));
+        }
+
+        const T &operator[](uint32_t index) const
+        {
+            erdp_assert(index < size());
+            return *reinterpret_cast<const T *>(__buffer + ((__head + index) % __size));
+        }
+
+    private:
+        T *__buffer;
+        uint32_t __size;
+        volatile uint32_t __head;
+        volatile uint32_t __tail;
+    };
+
+    /**
+     * @brief 容量为编译期2的幂的环形缓冲区，存储区内嵌在对象中，不占用堆
+     * 单生产者单消费者无锁：一端在中断、另一端在任务中使用是安全的，多个生产者或消费者需要自行互斥
+     * 读写下标自由增长，用掩码取位置，N个位置全部可用
+     * write_span/read_span给出一段连续的存储区，可直接交给DMA或memcpy，完成后commit_write/commit_read
+     * @tparam T 元素类型
+     * @tparam N 容量，2的幂
+     */
+    template <typename T, size_t N>
+    class RingBuffer : public Container<RingBuffer<T, N>, T>
+    {
+        static_assert(N > 0 && (N & (N - 1)) == 0, "RingBuffer: N must be a power of two");
+        static_assert(N <= 0x80000000U, "RingBuffer: N too large");
+
+    public:
+        // 一段连续的元素
+        template <typename U>
+        struct Span
+        {
+            U *data;
+            size_t size;
+        };
+
+        RingBuffer(const RingBuffer &) = delete;
+        RingBuffer &operator=(const RingBuffer &) = delete;
+
+        RingBuffer() noexcept {}
+
+        // 容量在编译期确定，只能清空，size不超过N
+        bool init(size_t size) noexcept
+        {
+            erdp_assert(size <= N);
+            (void)size;
+            clear();
+            return true;
+        }
+
+        static constexpr size_t capacity() noexcept { return N; }
+
+        // 只能在没有生产者和消费者访问时调用
+        void clear() noexcept
+        {
+            __head.store(0, std::memory_order_relaxed);
+            __tail.store(0, std::memory_order_release);
+        }
+
+        bool full() const noexcept { return size() == N; }
+
+        bool empty() const noexcept { return size() == 0; }
+
+        uint32_t size() const noexcept
+        {
+            return __tail.load(std::memory_order_acquire) - __head.load(std::memory_order_acquire);
+        }
+
+        // 生产者调用
+        bool push(const T &item) noexcept
+        {
+            uint32_t tail = __tail.load(std::memory_order_relaxed);
+            if (tail - __head.load(std::memory_order_acquire) == N)
+            {
+                return false;
+            }
+            __buffer[tail & MASK] = item;
+            __tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // 消费者调用
+        bool pop(T &item) noexcept
+        {
+            uint32_t head = __head.load(std::memory_order_relaxed);
+            if (__tail.load(std::memory_order_acquire) == head)
+            {
+                return false;
+            }
+            item = __buffer[head & MASK];
+            __head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool peek(T &item) const noexcept
+        {
+            uint32_t head = __head.load(std::memory_order_relaxed);
+            if (__tail.load(std::memory_order_acquire) == head)
+            {
+                return false;
+            }
+            item = __buffer[head & MASK];
+            return true;
+        }
+
+        // 批量入队，最多两段连续拷贝，返回入队个数
+        size_t push_n(const T *items, size_t count) noexcept
+        {
+            size_t pushed = 0;
+            for (uint8_t part = 0; part < 2 && pushed < count; part++)
+            {
+                Span<T> span = write_span();
+                size_t n = (span.size < count - pushed) ? span.size : count - pushed;
+                for (size_t i = 0; i < n; i++)
+                {
+                    span.data[i] = items[pushed + i];
+                }
+                commit_write(n);
+                pushed += n;
+            }
+            return pushed;
+        }
 
-        T &operator[](uint32_t index)
+        // 批量出队，最多两段连续拷贝，返回出队个数
+        size_t pop_n(T *items, size_t count) noexcept
+        {
+            size_t popped = 0;
+            for (uint8_t part = 0; part < 2 && popped < count; part++)
+            {
+                Span<const T> span = read_span();
+                size_t n = (span.size < count - popped) ? span.size : count - popped;
+                for (size_t i = 0; i < n; i++)
+                {
+                    items[popped + i] = span.data[i];
+                }
+                commit_read(n);
+                popped += n;
+            }
+            return popped;
+        }
+
+        // 生产者调用：从写位置到存储区末尾或队头之间的空闲区域，写入后用commit_write入队
+        Span<T> write_span() noexcept
+        {
+            uint32_t tail = __tail.load(std::memory_order_relaxed);
+            uint32_t free_count = N - (tail - __head.load(std::memory_order_acquire));
+            uint32_t to_end = N - (tail & MASK);
+            return {&__buffer[tail & MASK], (free_count < to_end) ? free_count : to_end};
+        }
+
+        // 生产者调用：将write_span中的前count个元素入队
+        void commit_write(size_t count) noexcept
+        {
+            uint32_t tail = __tail.load(std::memory_order_relaxed);
+            erdp_assert(count <= N - (tail - __head.load(std::memory_order_acquire)));
+            __tail.store(tail + (uint32_t)count, std::memory_order_release);
+        }
+
+        // 消费者调用：从队头到存储区末尾或队尾之间的元素，读完后用commit_read出队
+        Span<const T> read_span() const noexcept
+        {
+            uint32_t head = __head.load(std::memory_order_relaxed);
+            uint32_t used = __tail.load(std::memory_order_acquire) - head;
+            uint32_t to_end = N - (head & MASK);
+            return {&__buffer[head & MASK], (used < to_end) ? used : to_end};
+        }
+
+        // 消费者调用：将队头的count个元素出队
+        void commit_read(size_t count) noexcept
+        {
+            uint32_t head = __head.load(std::memory_order_relaxed);
+            erdp_assert(count <= __tail.load(std::memory_order_acquire) - head);
+            __head.store(head + (uint32_t)count, std::memory_order_release);
+        }
+
+        // 消费者调用：访问第index个未出队的元素，0为队头
+        T &operator[](uint32_t index) noexcept
         {
             erdp_assert(index < size());
-            return *reinterpret_cast<T *>(__buffer + ((__head + index) % __size));
+            return __buffer[(__head.load(std::memory_order_relaxed) + index) & MASK];
         }
 
-        const T &operator[](uint32_t index) const
+        const T &operator[](uint32_t index) const noexcept
         {
             erdp_assert(index < size());
-            return *reinterpret_cast<const T *>(__buffer + ((__head + index) % __size));
+            return __buffer[(__head.load(std::memory_order_relaxed) + index) & MASK];
+        }
+
+    private:
+        static constexpr uint32_t MASK = (uint32_t)(N - 1);
+
+        T __buffer[N];
+        std::atomic<uint32_t> __head{0}; // 只由消费者写
+        std::atomic<uint32_t> __tail{0}; // 只由生产者写
+    };
+
+    template <typename T>
+    class PoolBase;
+    template <typename T>
+    class PtrQueue;
+
+    /**
+     * @brief 对象池中一个对象的唯一所有权，只能移动不能拷贝，析构时把对象归还给所属的池
+     * 只能由PoolBase::make创建，或从PtrQueue中取出
+     */
+    template <typename T>
+    class PoolPtr
+    {
+        friend class PoolBase<T>;
+        friend class PtrQueue<T>;
+
+    public:
+        PoolPtr() noexcept {}
+        PoolPtr(std::nullptr_t) noexcept {}
+
+        PoolPtr(PoolPtr &&other) noexcept : __ptr(other.__ptr)
+        {
+            other.__ptr = nullptr;
+        }
+
+        PoolPtr &operator=(PoolPtr &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                __ptr = other.__ptr;
+                other.__ptr = nullptr;
+            }
+            return *this;
+        }
+
+        PoolPtr(const PoolPtr &) = delete;
+        PoolPtr &operator=(const PoolPtr &) = delete;
+
+        ~PoolPtr()
+        {
+            reset();
+        }
+
+        // 析构对象并归还给池
+        void reset() noexcept
+        {
+            if (__ptr != nullptr)
+            {
+                PoolBase<T>::__destroy(__ptr);
+                __ptr = nullptr;
+            }
+        }
+
+        T *get() const noexcept { return __ptr; }
+        T &operator*() const noexcept { return *__ptr; }
+        T *operator->() const noexcept { return __ptr; }
+        explicit operator bool() const noexcept { return __ptr != nullptr; }
+
+    private:
+        T *__ptr = nullptr;
+
+        explicit PoolPtr(T *ptr) noexcept : __ptr(ptr) {}
+
+        T *__release() noexcept
+        {
+            T *ptr = __ptr;
+            __ptr = nullptr;
+            return ptr;
+        }
+    };
+
+    /**
+     * @brief 定长对象池，分配和释放都是O(1)，可在中断中调用
+     * 每个块前有一个指针：空闲时链接空闲块，分配后指向所属的池，因此PoolPtr只需保存对象指针
+     * 存储区由派生类Pool<T, N>提供
+     */
+    template <typename T>
+    class PoolBase
+    {
+        friend class PoolPtr<T>;
+
+    public:
+        PoolBase(const PoolBase &) = delete;
+        PoolBase &operator=(const PoolBase &) = delete;
+
+        // 在池中构造一个对象，池已空时返回空的PoolPtr
+        template <typename... Args>
+        PoolPtr<T> make(Args &&...args)
+        {
+            void *mem = __allocate();
+            if (mem == nullptr)
+            {
+                return PoolPtr<T>();
+            }
+            return PoolPtr<T>(new (mem) T(std::forward<Args>(args)...));
+        }
+
+        size_t available() const
+        {
+            return __free_count;
+        }
+
+        size_t capacity() const
+        {
+            return __capacity;
+        }
+
+    protected:
+        struct Block
+        {
+            union
+            {
+                PoolBase *owner; // 已分配
+                Block *next;     // 空闲
+            };
+            alignas(T) uint8_t storage[sizeof(T)];
+        };
+
+        PoolBase(Block *blocks, size_t count) : __free_list(nullptr), __free_count(count), __capacity(count)
+        {
+            for (size_t i = count; i > 0; i--)
+            {
+                blocks[i - 1].next = __free_list;
+                __free_list = &blocks[i - 1];
+            }
+        }
+
+        // 所有对象都应已归还
+        ~PoolBase()
+        {
+            erdp_assert(__free_count == __capacity);
+        }
+
+    private:
+        Block *__free_list;
+        volatile size_t __free_count;
+        size_t __capacity;
+
+        void *__allocate()
+        {
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            Block *block = __free_list;
+            if (block != nullptr)
+            {
+                __free_list = block->next;
+                block->owner = this;
+                __free_count--;
+            }
+            erdp_if_rtos_cpu_unlock(key);
+            return (block != nullptr) ? block->storage : nullptr;
+        }
+
+        void __free(Block *block)
+        {
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            block->next = __free_list;
+            __free_list = block;
+            __free_count++;
+            erdp_if_rtos_cpu_unlock(key);
+        }
+
+        static void __destroy(T *ptr)
+        {
+            Block *block = reinterpret_cast<Block *>(reinterpret_cast<uint8_t *>(ptr) - offsetof(Block, storage));
+            ptr->~T();
+            block->owner->__free(block);
+        }
+    };
+
+    /**
+     * @brief 存储区内嵌在对象中的对象池，可容纳N个T
+     * @example
+     * Pool<Frame_t, 8> frame_pool;
+     * PoolPtr<Frame_t> frame = frame_pool.make();
+     * if (frame) { frame->len = 0; }
+     */
+    template <typename T, size_t N>
+    class Pool : public PoolBase<T>
+    {
+        static_assert(N > 0, "Pool: N must not be 0");
+
+    public:
+        Pool() : PoolBase<T>(__blocks, N) {}
+
+    private:
+        typename PoolBase<T>::Block __blocks[N];
+    };
+
+#ifdef ERDP_ENABLE_RTOS
+    /**
+     * @brief 传递PoolPtr的队列，入队出队只拷贝一个指针，对象本身留在池中
+     * push成功后所有权转入队列，传入的PoolPtr变为空；失败时所有权仍在调用者手中
+     * 队列析构或deinit时，剩余的对象归还给各自的池
+     */
+    template <typename T>
+    class PtrQueue
+    {
+    public:
+        PtrQueue() {}
+        PtrQueue(uint32_t queue_length)
+        {
+            init(queue_length);
+        }
+        ~PtrQueue() { deinit(); }
+
+        PtrQueue(const PtrQueue &) = delete;
+        PtrQueue &operator=(const PtrQueue &) = delete;
+
+        bool init(size_t queue_length)
+        {
+            deinit();
+            return __queue.init(queue_length);
+        }
+
+        // 使用外部提供的存储区，storage大小为queue_length * sizeof(T *)
+        bool init(size_t queue_length, uint8_t *storage, OS_QueueBuffer *queue_buffer)
+        {
+            deinit();
+            return __queue.init(queue_length, storage, queue_buffer);
+        }
+
+        void deinit()
+        {
+            clear();
+            __queue.deinit();
+        }
+
+        bool push(PoolPtr<T> &&ptr, uint32_t ticks_to_wait = 0)
+        {
+            erdp_assert(ptr);
+            T *raw = ptr.get();
+            if (!__queue.push(raw, ticks_to_wait))
+            {
+                return false;
+            }
+            ptr.__release();
+            return true;
+        }
+
+        bool pop(PoolPtr<T> &ptr, uint32_t ticks_to_wait = 0)
+        {
+            T *raw;
+            if (!__queue.pop(raw, ticks_to_wait))
+            {
+                return false;
+            }
+            ptr = PoolPtr<T>(raw);
+            return true;
+        }
+
+        // 取出并释放所有对象
+        void clear()
+        {
+            if (__queue.get_queue_handler() == nullptr)
+            {
+                return;
+            }
+            PoolPtr<T> ptr;
+            while (pop(ptr))
+            {
+                ptr.reset();
+            }
+        }
+
+        uint32_t size() const noexcept { return __queue.size(); }
+        bool empty() const noexcept { return __queue.empty(); }
+        bool full() const noexcept { return __queue.full(); }
+
+        OS_Queue get_queue_handler() const
+        {
+            return __queue.get_queue_handler();
+        }
+
+    private:
+        Queue<T *> __queue;
+    };
+
+    // 存储区内嵌在对象中的PtrQueue，不占用堆
+    template <typename T, size_t N>
+    class StaticPtrQueue : public PtrQueue<T>
+    {
+    public:
+        StaticPtrQueue()
+        {
+            init();
+        }
+
+        ~StaticPtrQueue()
+        {
+            this->deinit();
+        }
+
+        // 只能在内嵌存储区上重建
+        bool init()
+        {
+            return PtrQueue<T>::init(N, __storage, &__queue_buffer);
+        }
+
+    private:
+        alignas(T *) uint8_t __storage[N * sizeof(T *)];
+        OS_QueueBuffer __queue_buffer;
+    };
+
+    /**
+     * @brief 同时等待多个Queue/PtrQueue/Semaphore(基于FreeRTOS队列集)，任一就绪即返回其编号
+     * length为所有成员的队列长度与信号量最大计数之和；成员加入时必须为空，且不能同时属于其他Selector
+     * select返回某个成员后，需用0超时从该成员pop/take一次；互斥量、流缓冲区和任务通知不能加入
+     * @tparam MaxMembers 成员个数上限
+     * @example
+     * Selector<> sel(16 + 1);
+     * int rx = sel.add(rx_queue);      // Queue<uint8_t>，长度16
+     * int stop = sel.add(stop_sem);    // 二值信号量
+     * int ready = sel.select();
+     * if (ready == rx) rx_queue.pop(data);
+     */
+    template <size_t MaxMembers = 8>
+    class Selector
+    {
+    public:
+        static constexpr int TIMEOUT = -1;
+
+        Selector() {}
+        Selector(size_t length)
+        {
+            init(length);
+        }
+        ~Selector() { deinit(); }
+
+        Selector(const Selector &) = delete;
+        Selector &operator=(const Selector &) = delete;
+
+        bool init(size_t length)
+        {
+            deinit();
+            __handler = erdp_if_rtos_queue_set_create(length);
+            return __handler != nullptr;
+        }
+
+        // 使用外部提供的存储区，storage大小为length * sizeof(OS_QueueSetMember)
+        bool init(size_t length, uint8_t *storage, OS_QueueBuffer *queue_buffer)
+        {
+            erdp_assert(storage != nullptr && queue_buffer != nullptr);
+            deinit();
+            __handler = erdp_if_rtos_queue_set_create_static(length, storage, queue_buffer);
+            return __handler != nullptr;
+        }
+
+        // 移出所有成员(需为空)并删除队列集
+        void deinit()
+        {
+            if (__handler == nullptr)
+            {
+                return;
+            }
+            for (size_t i = 0; i < MaxMembers; i++)
+            {
+                if (__members[i] != nullptr)
+                {
+                    bool removed = erdp_if_rtos_queue_set_remove(__members[i], __handler);
+                    erdp_assert(removed); // 成员非空时移出失败，之后删除队列集会留下悬空引用
+                    (void)removed;
+                    __members[i] = nullptr;
+                }
+            }
+            erdp_if_rtos_queue_set_delete(__handler);
+            __handler = nullptr;
+        }
+
+        // 加入成员，返回其编号，失败返回TIMEOUT
+        template <typename T>
+        int add(Queue<T> &queue)
+        {
+            return __add(queue.get_queue_handler());
+        }
+
+        template <typename T>
+        int add(PtrQueue<T> &queue)
+        {
+            return __add(queue.get_queue_handler());
+        }
+
+        template <Semaphore_tag T>
+        int add(Semaphore<T> &semaphore)
+        {
+            static_assert(T == BINARY_TAG || T == COUNT_TAG, "Selector: mutexes cannot be selected");
+            return __add(semaphore.get_semaphore_handler());
+        }
+
+        // 移出成员，成员需为空
+        template <typename T>
+        bool remove(Queue<T> &queue)
+        {
+            return __remove(queue.get_queue_handler());
+        }
+
+        template <typename T>
+        bool remove(PtrQueue<T> &queue)
+        {
+            return __remove(queue.get_queue_handler());
+        }
+
+        template <Semaphore_tag T>
+        bool remove(Semaphore<T> &semaphore)
+        {
+            return __remove(semaphore.get_semaphore_handler());
+        }
+
+        // 等待任一成员就绪，返回其编号，超时返回TIMEOUT
+        int select(uint32_t ticks_to_wait = OS_WAIT_FOREVER)
+        {
+            erdp_assert(__handler != nullptr);
+            OS_QueueSetMember member = erdp_if_rtos_queue_set_select(__handler, ticks_to_wait);
+            if (member == nullptr)
+            {
+                return TIMEOUT;
+            }
+            return __find(member);
+        }
+
+    private:
+        OS_QueueSet __handler = nullptr;
+        OS_QueueSetMember __members[MaxMembers] = {};
+
+        int __find(OS_QueueSetMember member) const
+        {
+            for (size_t i = 0; i < MaxMembers; i++)
+            {
+                if (__members[i] == member)
+                {
+                    return (int)i;
+                }
+            }
+            return TIMEOUT;
+        }
+
+        // 编号在成员移出前保持不变，移出后的空位留给之后加入的成员
+        int __add(OS_QueueSetMember member)
+        {
+            erdp_assert(__handler != nullptr && member != nullptr);
+            int index = __find(nullptr);
+            if (index == TIMEOUT || !erdp_if_rtos_queue_set_add(member, __handler))
+            {
+                return TIMEOUT;
+            }
+            __members[index] = member;
+            return index;
+        }
+
+        bool __remove(OS_QueueSetMember member)
+        {
+            int index = __find(member);
+            if (index == TIMEOUT || !erdp_if_rtos_queue_set_remove(member, __handler))
+            {
+                return false;
+            }
+            __members[index] = nullptr;
+            return true;
+        }
+    };
+
+    // 队列集存储区内嵌在对象中的Selector，不占用堆
+    template <size_t Length, size_t MaxMembers = 8>
+    class StaticSelector : public Selector<MaxMembers>
+    {
+    public:
+        StaticSelector()
+        {
+            init();
+        }
+
+        ~StaticSelector()
+        {
+            this->deinit();
+        }
+
+        // 只能在内嵌存储区上重建
+        bool init()
+        {
+            return Selector<MaxMembers>::init(Length, __storage, &__queue_buffer);
         }
+
+    private:
+        alignas(OS_QueueSetMember) uint8_t __storage[Length * sizeof(OS_QueueSetMember)];
+        OS_QueueBuffer __queue_buffer;
     };
+#endif // ERDP_ENABLE_RTOS
 
 } // namespace erdp
 
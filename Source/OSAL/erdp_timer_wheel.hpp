@@ -0,0 +1,220 @@
+#ifndef __ERDP_TIMER_WHEEL_HPP__
+#define __ERDP_TIMER_WHEEL_HPP__
+#include "erdp_osal.hpp"
+
+namespace erdp
+{
+    template <uint8_t Levels, uint8_t SlotBits>
+    class TimerWheel;
+
+    /**
+     * @brief 由调用者持有的时间轮定时器，启动后直到到期(周期定时器直到取消)都必须保持有效
+     */
+    class WheelTimer
+    {
+        template <uint8_t, uint8_t>
+        friend class TimerWheel;
+
+    public:
+        WheelTimer() {}
+        WheelTimer(InplaceFunction<void()> fn) : fn(fn) {}
+
+        WheelTimer(const WheelTimer &) = delete;
+        WheelTimer &operator=(const WheelTimer &) = delete;
+
+        InplaceFunction<void()> fn = nullptr; // 到期时在调用tick()的上下文中执行
+
+        // 已启动尚未到期，周期定时器在取消前一直为true
+        bool pending() const
+        {
+            return __slot != nullptr;
+        }
+
+    private:
+        WheelTimer *__prev = nullptr;
+        WheelTimer *__next = nullptr;
+        WheelTimer **__slot = nullptr; // 所在槽的链表头，nullptr为未启动
+        uint32_t __expires = 0;        // 到期节拍
+        uint32_t __period = 0;         // 周期(节拍)，0为单次
+    };
+
+    /**
+     * @brief 分层时间轮，由tick()推进，通常在硬件定时器中断中调用(见TimerWheelDev)
+     * 共Levels层，每层2^SlotBits个槽，第n层一个槽跨2^(SlotBits*n)个节拍；定时器按剩余时间放入对应层的槽，
+     * 上层的槽在下层转完一圈时整体下移一层，到第0层的槽时到期
+     * 启动和取消只是双向链表的插入和删除，与定时器个数无关；tick()的开销与本节拍到期和下移的定时器个数成正比
+     * 启动和取消可在任务或中断中调用，tick()只能由一个上下文调用，回调执行时不关中断
+     * @tparam Levels 层数
+     * @tparam SlotBits 每层槽数的位数，超过2^(Levels*SlotBits)-1个节拍的延时在最高层多次下移
+     * @example
+     * TimerWheel<> wheel;                     // 定时器中断中调用wheel.tick()
+     * WheelTimer sample([]() { adc.trigger(); });
+     * wheel.start(sample, 5, 5);              // 5个节拍后开始，每5个节拍执行
+     */
+    template <uint8_t Levels = 4, uint8_t SlotBits = 6>
+    class TimerWheel
+    {
+        static_assert(Levels > 0 && SlotBits > 0 && Levels * SlotBits <= 31, "TimerWheel: Levels * SlotBits must be 1 to 31");
+
+    public:
+        static constexpr uint32_t SLOTS = 1U << SlotBits;
+        static constexpr uint32_t MASK = SLOTS - 1;
+        static constexpr uint32_t RANGE = (uint32_t)((1ULL << (Levels * SlotBits)) - 1); // 一次放入的最大延时(节拍)
+
+        TimerWheel() {}
+
+        TimerWheel(const TimerWheel &) = delete;
+        TimerWheel &operator=(const TimerWheel &) = delete;
+
+        /**
+         * @brief 启动定时器，已启动的从现在重新计时
+         * @param[in] timer 定时器
+         * @param[in] delay_ticks 第一次到期的节拍数，0按1处理；当前节拍已过去一部分，实际延时在delay_ticks-1到delay_ticks个节拍之间
+         * @param[in] period_ticks 周期，0为单次
+         */
+        void start(WheelTimer &timer, uint32_t delay_ticks, uint32_t period_ticks = 0)
+        {
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            if (timer.__slot != nullptr)
+            {
+                __unlink(timer);
+            }
+            else
+            {
+                __count++;
+            }
+            timer.__expires = __now + ((delay_ticks > 0) ? delay_ticks : 1);
+            timer.__period = period_ticks;
+            __insert(timer);
+            erdp_if_rtos_cpu_unlock(key);
+        }
+
+        // 取消定时器，未启动时返回false；不等待正在执行的回调
+        bool cancel(WheelTimer &timer)
+        {
+            bool pending;
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            pending = (timer.__slot != nullptr);
+            if (pending)
+            {
+                __unlink(timer);
+                __count--;
+            }
+            erdp_if_rtos_cpu_unlock(key);
+            return pending;
+        }
+
+        // 推进一个节拍并执行到期的定时器
+        void tick()
+        {
+            uint32_t key = erdp_if_rtos_cpu_lock();
+            uint32_t now = ++__now;
+            uint32_t index = now & MASK;
+
+            /* 下层转完一圈，把上层当前槽的定时器按剩余时间重新放入 */
+            for (uint8_t level = 1; index == 0 && level < Levels; level++)
+            {
+                index = (now >> (SlotBits * level)) & MASK;
+                WheelTimer *timer = __slots[level][index];
+                __slots[level][index] = nullptr;
+                while (timer != nullptr)
+                {
+                    WheelTimer *next = timer->__next;
+                    __insert(*timer);
+                    timer = next;
+                }
+            }
+
+            /* 回调中启动的定时器延时至少为1，不会放回当前槽 */
+            WheelTimer **slot = &__slots[0][now & MASK];
+            while (*slot != nullptr)
+            {
+                WheelTimer *timer = *slot;
+                __unlink(*timer);
+                if (timer->__period > 0)
+                {
+                    timer->__expires += timer->__period;
+                    __insert(*timer);
+                }
+                else
+                {
+                    __count--;
+                }
+                erdp_if_rtos_cpu_unlock(key);
+                if (timer->fn != nullptr)
+                {
+                    timer->fn();
+                }
+                key = erdp_if_rtos_cpu_lock();
+            }
+            erdp_if_rtos_cpu_unlock(key);
+        }
+
+        // 已推进的节拍数
+        uint32_t now() const
+        {
+            return __now;
+        }
+
+        // 已启动的定时器个数
+        uint32_t size() const
+        {
+            return __count;
+        }
+
+    private:
+        WheelTimer *__slots[Levels][SLOTS] = {};
+        volatile uint32_t __now = 0;
+        uint32_t __count = 0;
+
+        // 按到期时间放入所在层的槽，调用者持有锁
+        void __insert(WheelTimer &timer)
+        {
+            uint32_t delta = timer.__expires - __now;
+            uint32_t expires = timer.__expires;
+            uint8_t level = 0;
+
+            /* 超出范围的先放在最高层，下移时按真实到期时间重新放入 */
+            if (delta > RANGE)
+            {
+                delta = RANGE;
+                expires = __now + RANGE;
+            }
+            while (level < Levels - 1 && (delta >> (SlotBits * (level + 1))) != 0)
+            {
+                level++;
+            }
+
+            WheelTimer **slot = &__slots[level][(expires >> (SlotBits * level)) & MASK];
+            timer.__slot = slot;
+            timer.__prev = nullptr;
+            timer.__next = *slot;
+            if (*slot != nullptr)
+            {
+                (*slot)->__prev = &timer;
+            }
+            *slot = &timer;
+        }
+
+        void __unlink(WheelTimer &timer)
+        {
+            if (timer.__prev != nullptr)
+            {
+                timer.__prev->__next = timer.__next;
+            }
+            else
+            {
+                *timer.__slot = timer.__next;
+            }
+            if (timer.__next != nullptr)
+            {
+                timer.__next->__prev = timer.__prev;
+            }
+            timer.__slot = nullptr;
+            timer.__prev = nullptr;
+            timer.__next = nullptr;
+        }
+    };
+} // namespace erdp
+
+#endif // __ERDP_TIMER_WHEEL_HPP__
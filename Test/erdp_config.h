@@ -0,0 +1,43 @@
+#ifndef ERDP_HAL_CONFIG_H
+#define ERDP_HAL_CONFIG_H
+
+/* Host configuration of the tests: Source/erdp_config.h without the RTOS */
+
+/* ================================< user config >================================ */
+
+#define ERDP_CONFIG_HEAP_SIZE ((size_t)(10 * 1024))
+
+#define ERDP_CONFIG_ASSERT_ENABLED 1
+
+#define ERDP_CONFIG_RTOS_ENABLED 0
+
+#define ERDP_CONFIG_MAIN_THREAD_STACK_SIZE (1024)
+
+/* Inline storage in bytes of InplaceFunction callbacks (HAL interrupt handlers, Thread), captures must fit */
+#define ERDP_CONFIG_FUNCTION_CAPACITY (4 * sizeof(void *))
+
+/* CAN frames buffered between the RX interrupts and CanDev::receive() (power of two), and waiting for a TX mailbox */
+#define ERDP_CONFIG_CAN_RX_SIZE 32
+#define ERDP_CONFIG_CAN_TX_SIZE 16
+
+/* 1: DSP pipeline runs on CMSIS-DSP kernels (link libarm_cortexM4lf_math.a), 0: portable C kernels */
+#define ERDP_CONFIG_DSP_CMSIS_ENABLED 0
+/* =============================< end of user config >============================ */
+
+#if ERDP_CONFIG_RTOS_ENABLED == 1
+#define ERDP_ENABLE_RTOS 
+#endif
+
+#if ERDP_CONFIG_DSP_CMSIS_ENABLED == 1 && defined(ARM_MATH_CM4)
+#define ERDP_ENABLE_DSP_CMSIS
+#endif
+
+#if ERDP_CONFIG_ASSERT_ENABLED == 1
+#define ERDP_ENABLE_ASSERT
+#endif
+
+/* A failed assertion ends the test instead of spinning */
+#include <stdlib.h>
+#define erdp_assert(condition) ((condition) ? (void)0 : abort())
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef __ERDP_TEST_HPP__
+#define __ERDP_TEST_HPP__
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+
+/*
+ * Minimal checks for the host tests: a failed check is reported and the test goes on,
+ * main() returns erdp_test_result() so ctest sees the failure.
+ */
+extern int erdp_test_failures;
+extern uint32_t erdp_test_ms; // Returned by erdp_if_rtos_get_1ms_timestamp()
+
+#define ERDP_CHECK(condition)                                                  \
+    do                                                                         \
+    {                                                                          \
+        if (!(condition))                                                      \
+        {                                                                      \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            erdp_test_failures++;                                              \
+        }                                                                      \
+    } while (0)
+
+#define ERDP_CHECK_NEAR(actual, expected, tolerance)                                                        \
+    do                                                                                                      \
+    {                                                                                                       \
+        double __a = (double)(actual);                                                                      \
+        double __e = (double)(expected);                                                                    \
+        if (!(fabs(__a - __e) <= (double)(tolerance)))                                                      \
+        {                                                                                                   \
+            printf("%s:%d: %s = %g, expected %g\n", __FILE__, __LINE__, #actual, __a, __e);                 \
+            erdp_test_failures++;                                                                           \
+        }                                                                                                   \
+    } while (0)
+
+static inline int erdp_test_result(const char *name)
+{
+    printf("%s: %s\n", name, erdp_test_failures ? "FAILED" : "passed");
+    return erdp_test_failures ? 1 : 0;
+}
+
+// Seconds since an arbitrary origin, for the throughput figures
+static inline double erdp_test_seconds()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#endif // __ERDP_TEST_HPP__
@@ -0,0 +1,24 @@
+#include "erdp_test.hpp"
+#include "erdp_if_rtos.h"
+
+int erdp_test_failures = 0;
+uint32_t erdp_test_ms = 0;
+
+/* Single threaded host: no interrupts to lock out, time only moves when a test sets it */
+extern "C"
+{
+    uint32_t erdp_if_rtos_cpu_lock(void)
+    {
+        return 0;
+    }
+
+    void erdp_if_rtos_cpu_unlock(uint32_t key)
+    {
+        (void)key;
+    }
+
+    uint32_t erdp_if_rtos_get_1ms_timestamp(void)
+    {
+        return erdp_test_ms;
+    }
+}
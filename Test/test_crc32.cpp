@@ -0,0 +1,91 @@
+#include "erdp_test.hpp"
+#include "crc32.hpp"
+
+using namespace erdp;
+
+static const char CHECK[] = "123456789";
+
+// One byte per step, the tail loop of update() on its own
+template <typename Crc>
+static uint32_t bytewise(const void *data, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t state = Crc::INIT;
+    for (size_t i = 0; i < len; i++)
+    {
+        state = Crc::update(state, p + i, 1);
+    }
+    return Crc::finish(state);
+}
+
+static void test_check_values()
+{
+    ERDP_CHECK(Crc32Ieee::compute(CHECK, 9) == 0xCBF43926U);
+    ERDP_CHECK(Crc32Mpeg2::compute(CHECK, 9) == 0x0376E6E7U);
+    ERDP_CHECK(Crc32C::compute(CHECK, 9) == 0xE3069283U);
+    ERDP_CHECK(Crc32Ieee::compute(CHECK, 0) == 0);
+}
+
+// The 8 byte path, the byte tail, split updates and unaligned starts all agree
+template <typename Crc>
+static void test_consistency()
+{
+    static uint8_t buf[1024 + 8];
+    for (uint32_t i = 0; i < sizeof(buf); i++)
+    {
+        buf[i] = (uint8_t)(i * 7 + (i >> 5));
+    }
+    const size_t lens[] = {0, 1, 7, 8, 9, 63, 1024};
+    for (size_t offset = 0; offset < 8; offset++)
+    {
+        for (size_t len : lens)
+        {
+            uint32_t expected = bytewise<Crc>(buf + offset, len);
+            ERDP_CHECK(Crc::compute(buf + offset, len) == expected);
+            size_t split = len / 3;
+            uint32_t state = Crc::update(Crc::INIT, buf + offset, split);
+            ERDP_CHECK(Crc::finish(Crc::update(state, buf + offset + split, len - split)) == expected);
+        }
+    }
+}
+
+template <typename Crc>
+static double crc_mb_per_s(uint32_t (*crc)(const void *, size_t), const uint8_t *buf, size_t len, uint32_t rounds)
+{
+    uint32_t sink = 0;
+    double start = erdp_test_seconds();
+    for (uint32_t i = 0; i < rounds; i++)
+    {
+        sink ^= crc(buf, len);
+    }
+    double seconds = erdp_test_seconds() - start;
+    ERDP_CHECK(sink == ((rounds & 1) ? Crc::compute(buf, len) : 0));
+    return (double)len * rounds / seconds / 1e6;
+}
+
+// Host throughput of slicing by 8 against one table lookup per byte
+static void test_throughput()
+{
+    static uint8_t buf[64 * 1024];
+    for (uint32_t i = 0; i < sizeof(buf); i++)
+    {
+        buf[i] = (uint8_t)(i * 13);
+    }
+    const uint32_t ROUNDS = 101;
+    double sliced = crc_mb_per_s<Crc32Ieee>(Crc32Ieee::compute, buf, sizeof(buf), ROUNDS);
+    double bytes = crc_mb_per_s<Crc32Ieee>(bytewise<Crc32Ieee>, buf, sizeof(buf), ROUNDS);
+    double sliced_msb = crc_mb_per_s<Crc32Mpeg2>(Crc32Mpeg2::compute, buf, sizeof(buf), ROUNDS);
+    double bytes_msb = crc_mb_per_s<Crc32Mpeg2>(bytewise<Crc32Mpeg2>, buf, sizeof(buf), ROUNDS);
+    printf("crc32: ieee %.0f MB/s (bytewise %.0f), mpeg2 %.0f MB/s (bytewise %.0f)\n", sliced, bytes, sliced_msb,
+           bytes_msb);
+}
+
+int main()
+{
+    test_check_values();
+    test_consistency<Crc32Ieee>();
+    test_consistency<Crc32Mpeg2>();
+    test_consistency<Crc32C>();
+    test_throughput();
+    return erdp_test_result("test_crc32");
+}
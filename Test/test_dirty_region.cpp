@@ -0,0 +1,116 @@
+#include "erdp_test.hpp"
+#include "dirty_region.hpp"
+
+using namespace erdp;
+
+static bool same(const Rect_t &a, const Rect_t &b)
+{
+    return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+}
+
+template <size_t N>
+static bool contains(const DirtyRegion<N> &region, const Rect_t &rect)
+{
+    for (const Rect_t &r : region)
+    {
+        if (same(r, rect))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void test_merge()
+{
+    DirtyRegion<4> region;
+    ERDP_CHECK(region.empty());
+    region.add({5, 5, 0, 10});
+    region.add({5, 5, 10, 0});
+    ERDP_CHECK(region.empty());
+
+    /* Overlapping: the bounding box costs 25 extra pixels, within the slack */
+    region.add({0, 0, 10, 10});
+    region.add({5, 5, 10, 10});
+    ERDP_CHECK(region.size() == 1 && same(region[0], {0, 0, 15, 15}));
+
+    /* Far apart: kept as two rectangles */
+    region.add({100, 100, 10, 10});
+    ERDP_CHECK(region.size() == 2 && region.area() == 225 + 100);
+
+    region.clear();
+    ERDP_CHECK(region.empty() && region.area() == 0);
+}
+
+static void test_slack()
+{
+    /* A 2 pixel gap costs 20 pixels: merged only when the slack allows it */
+    DirtyRegion<4> tight(0), loose(64);
+    tight.add({0, 0, 10, 10});
+    tight.add({12, 0, 10, 10});
+    loose.add({0, 0, 10, 10});
+    loose.add({12, 0, 10, 10});
+    ERDP_CHECK(tight.size() == 2);
+    ERDP_CHECK(loose.size() == 1 && same(loose[0], {0, 0, 22, 10}));
+
+    /* Touching costs nothing */
+    tight.clear();
+    tight.add({0, 0, 10, 10});
+    tight.add({10, 0, 10, 10});
+    ERDP_CHECK(tight.size() == 1 && same(tight[0], {0, 0, 20, 10}));
+
+    /* Filling the gap merges with both sides, the grown rectangle is checked again */
+    tight.clear();
+    tight.add({0, 0, 10, 10});
+    tight.add({30, 0, 10, 10});
+    ERDP_CHECK(tight.size() == 2);
+    tight.add({10, 0, 20, 10});
+    ERDP_CHECK(tight.size() == 1 && same(tight[0], {0, 0, 40, 10}));
+}
+
+static void test_full()
+{
+    /* No room: merged with the rectangle that costs the fewest extra pixels */
+    DirtyRegion<2> region(0);
+    region.add({0, 0, 10, 10});
+    region.add({200, 0, 10, 10});
+    region.add({0, 30, 10, 10});
+    ERDP_CHECK(region.size() == 2);
+    ERDP_CHECK(contains(region, {0, 0, 10, 40}));
+    ERDP_CHECK(contains(region, {200, 0, 10, 10}));
+
+    region.add({200, 100, 10, 10});
+    ERDP_CHECK(region.size() == 2);
+    ERDP_CHECK(contains(region, {200, 0, 10, 110}));
+
+    uint32_t area = 0;
+    for (const Rect_t &r : region)
+    {
+        area += (uint32_t)r.w * r.h;
+    }
+    ERDP_CHECK(area == region.area() && area == 400 + 1100);
+}
+
+static void test_helpers()
+{
+    ERDP_CHECK(same(DirtyRegion<1>::bounding({10, 20, 5, 5}, {0, 30, 5, 5}), {0, 20, 15, 15}));
+    ERDP_CHECK(same(DirtyRegion<1>::bounding({0, 0, 50, 50}, {10, 10, 5, 5}), {0, 0, 50, 50}));
+
+    Rect_t rect = {300, 200, 50, 100};
+    ERDP_CHECK(DirtyRegion<1>::clip(rect, 320, 240) && same(rect, {300, 200, 20, 40}));
+    rect = {0, 0, 320, 240};
+    ERDP_CHECK(DirtyRegion<1>::clip(rect, 320, 240) && same(rect, {0, 0, 320, 240}));
+    rect = {320, 0, 10, 10};
+    ERDP_CHECK(!DirtyRegion<1>::clip(rect, 320, 240));
+    rect = {0, 239, 10, 0};
+    ERDP_CHECK(!DirtyRegion<1>::clip(rect, 320, 240));
+}
+
+int main()
+{
+    test_merge();
+    test_slack();
+    test_full();
+    test_helpers();
+    return erdp_test_result("test_dirty_region");
+}
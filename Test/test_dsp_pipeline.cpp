@@ -0,0 +1,251 @@
+#include "erdp_test.hpp"
+#include "dsp_pipeline.hpp"
+
+using namespace erdp;
+
+static const double PI = 3.14159265358979323846;
+
+// Pseudo random samples in [-1, 1), the same sequence on every run
+static float noise(uint32_t &seed)
+{
+    seed = seed * 1664525U + 1013904223U;
+    return (float)(seed >> 8) / 8388608.0f - 1.0f;
+}
+
+// Direct form FIR, b in natural order
+static double fir_ref(const float *b, uint32_t taps, const float *x, uint32_t i)
+{
+    double acc = 0.0;
+    for (uint32_t k = 0; k < taps && k <= i; k++)
+    {
+        acc += (double)b[k] * x[i - k];
+    }
+    return acc;
+}
+
+static void reverse(const float *b, float *reversed, uint32_t taps)
+{
+    for (uint32_t k = 0; k < taps; k++)
+    {
+        reversed[k] = b[taps - 1 - k];
+    }
+}
+
+static void test_fir()
+{
+    const uint32_t TAPS = 8, BLOCK = 64;
+    float b[TAPS], coeffs[TAPS];
+    for (uint32_t k = 0; k < TAPS; k++)
+    {
+        b[k] = 0.1f * (float)(k + 1);
+    }
+    reverse(b, coeffs, TAPS);
+
+    /* Impulse response is b in natural order */
+    FirStage<TAPS, BLOCK> fir(coeffs);
+    float in[2 * BLOCK] = {1.0f};
+    float out[2 * BLOCK];
+    fir.process(in, out, BLOCK);
+    for (uint32_t i = 0; i < BLOCK; i++)
+    {
+        ERDP_CHECK_NEAR(out[i], (i < TAPS) ? b[i] : 0.0f, 1e-6);
+    }
+
+    /* Blocks of any size up to BLOCK continue from the previous one */
+    uint32_t seed = 1;
+    for (auto &x : in)
+    {
+        x = noise(seed);
+    }
+    fir.reset();
+    fir.process(in, out, BLOCK);
+    fir.process(in + BLOCK, out + BLOCK, 5);
+    fir.process(in + BLOCK + 5, out + BLOCK + 5, BLOCK - 5);
+    for (uint32_t i = 0; i < 2 * BLOCK; i++)
+    {
+        ERDP_CHECK_NEAR(out[i], fir_ref(b, TAPS, in, i), 1e-5);
+    }
+}
+
+static void test_decimate()
+{
+    const uint32_t TAPS = 6, FACTOR = 4, BLOCK = 32;
+    float b[TAPS] = {0.05f, 0.2f, 0.25f, 0.25f, 0.2f, 0.05f};
+    float coeffs[TAPS];
+    reverse(b, coeffs, TAPS);
+
+    DecimateStage<TAPS, FACTOR, BLOCK> decimate(coeffs);
+    ERDP_CHECK(decimate.output_size(BLOCK) == BLOCK / FACTOR);
+    float in[2 * BLOCK];
+    float out[2 * BLOCK / FACTOR];
+    uint32_t seed = 2;
+    for (auto &x : in)
+    {
+        x = noise(seed);
+    }
+    ERDP_CHECK(decimate.process(in, out, BLOCK) == BLOCK / FACTOR);
+    ERDP_CHECK(decimate.process(in + BLOCK, out + BLOCK / FACTOR, BLOCK) == BLOCK / FACTOR);
+    for (uint32_t j = 0; j < 2 * BLOCK / FACTOR; j++)
+    {
+        ERDP_CHECK_NEAR(out[j], fir_ref(b, TAPS, in, j * FACTOR), 1e-5);
+    }
+}
+
+static void test_biquad()
+{
+    /* Two sections, {b0, b1, b2, a1, a2} with a1/a2 negated */
+    const float coeffs[10] = {0.2f, 0.4f, 0.2f, 0.6f, -0.2f, 1.0f, -1.0f, 0.0f, 0.9f, 0.0f};
+    BiquadStage<2> biquad(coeffs);
+    const uint32_t N = 100;
+    float in[N], out[N];
+    uint32_t seed = 3;
+    for (auto &x : in)
+    {
+        x = noise(seed);
+    }
+    biquad.process(in, out, 40);
+    biquad.process(in + 40, out + 40, N - 40);
+
+    /* Each section in direct form I, y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2] */
+    double x[2][2] = {}, y[2][2] = {};
+    for (uint32_t i = 0; i < N; i++)
+    {
+        double v = in[i];
+        for (uint32_t s = 0; s < 2; s++)
+        {
+            const float *c = coeffs + 5 * s;
+            double r = c[0] * v + c[1] * x[s][0] + c[2] * x[s][1] + c[3] * y[s][0] + c[4] * y[s][1];
+            x[s][1] = x[s][0], x[s][0] = v;
+            y[s][1] = y[s][0], y[s][0] = r;
+            v = r;
+        }
+        ERDP_CHECK_NEAR(out[i], v, 1e-4);
+    }
+}
+
+static void test_rfft()
+{
+    const uint32_t SIZE = 64;
+    float in[SIZE], out[SIZE];
+    uint32_t seed = 4;
+    for (auto &x : in)
+    {
+        x = noise(seed);
+    }
+
+    /* Packed {X[0], X[N/2], Re X[1], Im X[1], ...} against a plain DFT */
+    RfftStage<SIZE> packed(false);
+    ERDP_CHECK(packed.process(in, out, SIZE) == SIZE);
+    for (uint32_t k = 0; k <= SIZE / 2; k++)
+    {
+        double re = 0.0, im = 0.0;
+        for (uint32_t i = 0; i < SIZE; i++)
+        {
+            re += in[i] * cos(2.0 * PI * k * i / SIZE);
+            im -= in[i] * sin(2.0 * PI * k * i / SIZE);
+        }
+        if (k == 0)
+        {
+            ERDP_CHECK_NEAR(out[0], re, 1e-3);
+        }
+        else if (k == SIZE / 2)
+        {
+            ERDP_CHECK_NEAR(out[1], re, 1e-3);
+        }
+        else
+        {
+            ERDP_CHECK_NEAR(out[2 * k], re, 1e-3);
+            ERDP_CHECK_NEAR(out[2 * k + 1], im, 1e-3);
+        }
+    }
+
+    /* Magnitudes: a sine on bin 5 plus DC */
+    RfftStage<SIZE> magnitude;
+    for (uint32_t i = 0; i < SIZE; i++)
+    {
+        in[i] = 0.5f + (float)sin(2.0 * PI * 5 * i / SIZE);
+    }
+    ERDP_CHECK(magnitude.process(in, out, SIZE) == SIZE / 2);
+    ERDP_CHECK_NEAR(out[0], 0.5 * SIZE, 1e-3);
+    ERDP_CHECK_NEAR(out[5], SIZE / 2.0, 1e-3);
+    for (uint32_t k = 1; k < SIZE / 2; k++)
+    {
+        if (k != 5)
+        {
+            ERDP_CHECK_NEAR(out[k], 0.0, 1e-3);
+        }
+    }
+}
+
+static void test_pipeline()
+{
+    /* Every other sample of an interleaved two channel scan, scaled, then the RMS */
+    const uint32_t N = 16;
+    uint16_t raw[2 * N];
+    for (uint32_t i = 0; i < N; i++)
+    {
+        raw[2 * i] = (i & 1) ? 3000 : 1000;
+        raw[2 * i + 1] = 4095;
+    }
+    RmsStage rms;
+    ERDP_CHECK(rms.output_size(N) == 1);
+    DspPipeline<N> pipeline;
+    pipeline.add(rms);
+    uint32_t n = N;
+    const float *out = pipeline.process(raw, n, 2, 0.001f, -2.0f);
+    ERDP_CHECK(n == 1);
+    ERDP_CHECK_NEAR(out[0], 1.0, 1e-5);
+
+    /* Without stages the converted samples come back */
+    pipeline.clear();
+    n = N;
+    out = pipeline.process(raw, n, 2, 0.001f, -2.0f);
+    ERDP_CHECK(n == N);
+    ERDP_CHECK_NEAR(out[0], -1.0, 1e-5);
+    ERDP_CHECK_NEAR(out[1], 1.0, 1e-5);
+}
+
+// Host throughput of a decimate, FIR, RFFT chain; only a relative figure for comparing kernel changes
+static void test_throughput()
+{
+    const uint32_t BLOCK = 1024, FACTOR = 4, TAPS = 32;
+    static float coeffs[TAPS];
+    for (uint32_t k = 0; k < TAPS; k++)
+    {
+        coeffs[k] = 1.0f / TAPS;
+    }
+    static DecimateStage<TAPS, FACTOR, BLOCK> decimate(coeffs);
+    static FirStage<TAPS, BLOCK / FACTOR> fir(coeffs);
+    static RfftStage<BLOCK / FACTOR> rfft;
+    static DspPipeline<BLOCK> pipeline;
+    pipeline.add(decimate).add(fir).add(rfft);
+
+    static float in[BLOCK];
+    uint32_t seed = 5;
+    for (auto &x : in)
+    {
+        x = noise(seed);
+    }
+    const uint32_t BLOCKS = 2000;
+    float sink = 0.0f;
+    double start = erdp_test_seconds();
+    for (uint32_t i = 0; i < BLOCKS; i++)
+    {
+        uint32_t n = BLOCK;
+        sink += pipeline.process(in, n)[1];
+        ERDP_CHECK(n == BLOCK / FACTOR / 2);
+    }
+    double seconds = erdp_test_seconds() - start;
+    printf("dsp pipeline: %.1f Msamples/s (%g)\n", BLOCKS * BLOCK / seconds / 1e6, (double)sink);
+}
+
+int main()
+{
+    test_fir();
+    test_decimate();
+    test_biquad();
+    test_rfft();
+    test_pipeline();
+    test_throughput();
+    return erdp_test_result("test_dsp_pipeline");
+}
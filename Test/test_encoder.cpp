@@ -0,0 +1,233 @@
+#include "erdp_test.hpp"
+#include "erdp_hal_encoder.hpp"
+
+using namespace erdp;
+
+/* Register model of the timers: the test moves the counters and raises the flags, the ISR is called by hand */
+struct FakeTim
+{
+    uint32_t counter;
+    uint32_t capture[ERDP_TIM_CH_NUM];
+    uint32_t flags;
+    uint32_t irq_mask;
+    uint8_t ic_prescaler;
+};
+static FakeTim fake_tim[ERDP_TIM_NUM];
+
+extern "C"
+{
+    uint32_t erdp_if_tim_get_clock(ERDP_Tim_t tim)
+    {
+        (void)tim;
+        return 84000000;
+    }
+
+    bool erdp_if_tim_is_32bit(ERDP_Tim_t tim)
+    {
+        return tim == ERDP_TIM2 || tim == ERDP_TIM5;
+    }
+
+    void erdp_if_tim_base_init(ERDP_Tim_t tim, uint32_t prescaler, uint32_t period, bool one_pulse, uint8_t priority)
+    {
+        (void)prescaler, (void)period, (void)one_pulse, (void)priority;
+        fake_tim[tim] = FakeTim();
+    }
+
+    void erdp_if_tim_deinit(ERDP_Tim_t tim)
+    {
+        fake_tim[tim] = FakeTim();
+    }
+
+    void erdp_if_tim_enable(ERDP_Tim_t tim, bool enable)
+    {
+        (void)tim, (void)enable;
+    }
+
+    void erdp_if_tim_gpio_init(ERDP_Tim_t tim, ERDP_GpioPort_t port, ERDP_GpioPin_t pin)
+    {
+        (void)tim, (void)port, (void)pin;
+    }
+
+    void erdp_if_tim_encoder_init(ERDP_Tim_t tim, uint8_t filter, bool invert)
+    {
+        (void)tim, (void)filter, (void)invert;
+    }
+
+    void erdp_if_tim_ic_prescaler(ERDP_Tim_t tim, ERDP_TimChannel_t channel, uint8_t edges)
+    {
+        (void)channel;
+        fake_tim[tim].ic_prescaler = edges;
+    }
+
+    void erdp_if_tim_irq_enable(ERDP_Tim_t tim, uint32_t event_mask, bool enable)
+    {
+        fake_tim[tim].irq_mask = enable ? (fake_tim[tim].irq_mask | event_mask) : (fake_tim[tim].irq_mask & ~event_mask);
+    }
+
+    uint32_t erdp_if_tim_get_irq_status(ERDP_Tim_t tim)
+    {
+        return fake_tim[tim].flags & fake_tim[tim].irq_mask;
+    }
+
+    uint32_t erdp_if_tim_get_flags(ERDP_Tim_t tim)
+    {
+        return fake_tim[tim].flags;
+    }
+
+    void erdp_if_tim_clear_flags(ERDP_Tim_t tim, uint32_t event_mask)
+    {
+        fake_tim[tim].flags &= ~event_mask;
+    }
+
+    uint32_t erdp_if_tim_get_counter(ERDP_Tim_t tim)
+    {
+        return fake_tim[tim].counter;
+    }
+
+    void erdp_if_tim_set_counter(ERDP_Tim_t tim, uint32_t counter)
+    {
+        fake_tim[tim].counter = counter;
+    }
+
+    uint32_t erdp_if_tim_get_capture(ERDP_Tim_t tim, ERDP_TimChannel_t channel)
+    {
+        return fake_tim[tim].capture[channel];
+    }
+
+    void erdp_if_dma_deinit(ERDP_DmaStream_t stream)
+    {
+        (void)stream;
+    }
+
+    uint32_t erdp_if_dma_get_flags(ERDP_DmaStream_t stream)
+    {
+        (void)stream;
+        return 0;
+    }
+
+    void erdp_if_dma_clear_flags(ERDP_DmaStream_t stream, uint32_t flags)
+    {
+        (void)stream, (void)flags;
+    }
+}
+
+// Overflow (counting up) or underflow (counting down) of the encoder counter
+static void encoder_wrap(ERDP_Tim_t tim, uint32_t counter)
+{
+    fake_tim[tim].counter = counter;
+    fake_tim[tim].flags |= ERDP_TIM_EVENT_MASK(ERDP_TIM_EVENT_UPDATE);
+}
+
+// Phase A edge at timebase time now_us with the encoder counter latched in CC1
+static void encoder_edge(ERDP_Tim_t tim, ERDP_Tim_t timebase, uint32_t capture, uint32_t now_us)
+{
+    fake_tim[timebase].counter = now_us;
+    fake_tim[tim].capture[ERDP_TIM_CH1] = capture;
+    fake_tim[tim].flags |= ERDP_TIM_EVENT_MASK(ERDP_TIM_EVENT_CC1);
+    erdp_tim_irq_handler(tim);
+}
+
+static void test_helpers()
+{
+    ERDP_CHECK(Encoder::extend_high(0, 0x0005) == 0x10000U);
+    ERDP_CHECK(Encoder::extend_high(0x10000U, 0xFFF0) == 0);
+    ERDP_CHECK(Encoder::extend(0x10000U, 0x0003, false) == 0x10003);
+    ERDP_CHECK(Encoder::extend(0, 0x0003, true) == 0x10003);
+    ERDP_CHECK(Encoder::extend(0, 0xFFFF, true) == -1);
+
+    ERDP_CHECK(Encoder::capture_counts(0x0002, 0xFFFE, false) == 4);
+    ERDP_CHECK(Encoder::capture_counts(0xFFFE, 0x0002, false) == -4);
+    ERDP_CHECK(Encoder::capture_counts(0x00000001U, 0xFFFFFFFFU, true) == 2);
+    ERDP_CHECK(Encoder::capture_counts(0x00010000U, 0x0000FFFFU, true) == 1);
+
+    ERDP_CHECK_NEAR(Encoder::edge_velocity(100, 1000, 1000000), 100000.0, 0.5);
+    ERDP_CHECK_NEAR(Encoder::edge_velocity(-40, 2000, 1000000), -20000.0, 0.5);
+    ERDP_CHECK(Encoder::edge_velocity(100, 0, 1000000) == 0.0f);
+}
+
+static void test_position(Encoder &encoder)
+{
+    encoder.set_position(0xFFF0);
+    ERDP_CHECK(encoder.position() == 0xFFF0);
+
+    /* Overflow not yet handled by the ISR, then handled */
+    encoder_wrap(ERDP_TIM3, 0x0005);
+    ERDP_CHECK(encoder.position() == 0x10005);
+    erdp_tim_irq_handler(ERDP_TIM3);
+    ERDP_CHECK(fake_tim[ERDP_TIM3].flags == 0);
+    ERDP_CHECK(encoder.position() == 0x10005);
+
+    /* Back down through zero */
+    encoder.set_position(2);
+    encoder_wrap(ERDP_TIM3, 0xFFFD);
+    ERDP_CHECK(encoder.position() == -3);
+    erdp_tim_irq_handler(ERDP_TIM3);
+    ERDP_CHECK(encoder.position() == -3);
+
+    encoder.set_position(-100000);
+    ERDP_CHECK(encoder.position() == -100000);
+}
+
+static void test_velocity(Encoder &encoder, uint32_t stale_ms)
+{
+    encoder.set_position(0);
+    ERDP_CHECK(encoder.velocity() == 0.0f);
+
+    /* One edge gives no interval yet */
+    encoder_edge(ERDP_TIM3, ERDP_TIM2, 100, 1000);
+    ERDP_CHECK(encoder.velocity() == 0.0f);
+
+    /* 40 counts in 2000 us */
+    encoder_edge(ERDP_TIM3, ERDP_TIM2, 140, 3000);
+    ERDP_CHECK_NEAR(encoder.velocity(), 20000.0, 1.0);
+
+    /* Next edge overdue: bounded by the time since the last one */
+    fake_tim[ERDP_TIM2].counter = 9000;
+    ERDP_CHECK_NEAR(encoder.velocity(), 40.0 * 1000000.0 / 6000.0, 1.0);
+
+    /* Backwards across the 16-bit counter wrap, time base wrapping too */
+    encoder_edge(ERDP_TIM3, ERDP_TIM2, 0x0002, 0xFFFFFF00U);
+    encoder_edge(ERDP_TIM3, ERDP_TIM2, 0xFFFE, 0x00000100U);
+    ERDP_CHECK_NEAR(encoder.velocity(), -4.0 * 1000000.0 / 512.0, 1.0);
+
+    /* No edge for half the time base range reads as stopped, the next edge starts over */
+    erdp_test_ms += stale_ms;
+    ERDP_CHECK(encoder.velocity() == 0.0f);
+    encoder_edge(ERDP_TIM3, ERDP_TIM2, 0x0010, 0x00001000U);
+    ERDP_CHECK(encoder.velocity() == 0.0f);
+    erdp_test_ms += 1;
+    encoder_edge(ERDP_TIM3, ERDP_TIM2, 0x0020, 0x00001000U + 400);
+    ERDP_CHECK_NEAR(encoder.velocity(), 16.0 * 1000000.0 / 400.0, 1.0);
+
+    /* set_position() drops the edge history */
+    encoder.set_position(0);
+    ERDP_CHECK(encoder.velocity() == 0.0f);
+}
+
+int main()
+{
+    test_helpers();
+
+    TimerDev timebase;
+    timebase.init(ERDP_TIM2, 0);
+    timebase.start_timebase_us();
+
+    Encoder::Config_t config = {};
+    config.tim = ERDP_TIM3;
+    config.a_port = ERDP_GPIOA;
+    config.a_pin = ERDP_GPIO_PIN_6;
+    config.b_port = ERDP_GPIOA;
+    config.b_pin = ERDP_GPIO_PIN_7;
+    config.timebase = &timebase;
+    config.edge_prescaler = 4;
+    Encoder encoder(config);
+    ERDP_CHECK(fake_tim[ERDP_TIM3].ic_prescaler == 4);
+    ERDP_CHECK(fake_tim[ERDP_TIM3].irq_mask & ERDP_TIM_EVENT_MASK(ERDP_TIM_EVENT_CC1));
+
+    test_position(encoder);
+    test_velocity(encoder, timebase.get_range_ms() / 2);
+
+    encoder.deinit();
+    timebase.deinit();
+    return erdp_test_result("test_encoder");
+}
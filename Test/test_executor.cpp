@@ -0,0 +1,188 @@
+#include <string>
+
+#include "erdp_test.hpp"
+#include "erdp_executor.hpp"
+
+using namespace erdp;
+
+/* No RTOS: poll() runs what is due at erdp_test_ms, the tests move the time by hand */
+typedef Executor<2, 256, 4> TestExecutor;
+
+static std::string order;
+
+static void log_run(const char *name)
+{
+    order += name;
+}
+
+// Due items run in due time order after the ready ones, each queue in post order
+static void test_ordering()
+{
+    TestExecutor executor;
+    erdp_test_ms = 1000;
+    WorkItem a([]() { log_run("a"); }), b([]() { log_run("b"); }), c([]() { log_run("c"); });
+    WorkItem d([]() { log_run("d"); }), e([]() { log_run("e"); }), f([]() { log_run("f"); });
+    order.clear();
+
+    ERDP_CHECK(executor.post_delayed(a, 30));
+    ERDP_CHECK(executor.post_delayed(b, 10));
+    ERDP_CHECK(executor.post_delayed(c, 20));
+    ERDP_CHECK(executor.post(d));
+    ERDP_CHECK(executor.post(e, 1));
+    ERDP_CHECK(executor.post_delayed(f, 10, 1));
+    ERDP_CHECK(!executor.post(d)); // Still queued
+    ERDP_CHECK(executor.get_stats(0).depth == 4 && executor.get_stats(1).depth == 2);
+
+    ERDP_CHECK(executor.poll() == 2);
+    ERDP_CHECK(order == "de");
+    ERDP_CHECK(!d.pending() && a.pending());
+
+    erdp_test_ms += 9;
+    ERDP_CHECK(executor.poll() == 0);
+    erdp_test_ms += 25;
+    ERDP_CHECK(executor.poll() == 4);
+    ERDP_CHECK(order == "debcaf");
+
+    ExecutorStats_t stats = executor.get_stats(0);
+    ERDP_CHECK(stats.depth == 0 && stats.max_depth == 4 && stats.executed == 4);
+    ERDP_CHECK(stats.max_latency == 24 && stats.total_latency == 24 + 14 + 4);
+    executor.reset_stats(0);
+    ERDP_CHECK(executor.get_stats(0).executed == 0);
+}
+
+// Late by less than a period keeps the phase, later than a period skips the missed runs
+static void test_periodic()
+{
+    TestExecutor executor;
+    erdp_test_ms = 0;
+    uint32_t runs[8];
+    uint32_t count = 0;
+    uint32_t *p = runs, *n = &count;
+    WorkItem tick([p, n]() { p[(*n)++] = erdp_test_ms; });
+    ERDP_CHECK(executor.post_periodic(tick, 10));
+
+    const uint32_t polls[] = {9, 13, 19, 20, 45, 54, 55, 65};
+    for (uint32_t ms : polls)
+    {
+        erdp_test_ms = ms;
+        executor.poll();
+    }
+    ERDP_CHECK(count == 5);
+    ERDP_CHECK(runs[0] == 13 && runs[1] == 20 && runs[2] == 45 && runs[3] == 55 && runs[4] == 65);
+    ERDP_CHECK(tick.pending());
+    ERDP_CHECK(executor.get_stats(0).max_latency == 15);
+    ERDP_CHECK(executor.cancel(tick));
+    ERDP_CHECK(!tick.pending());
+}
+
+// Closures share PoolSize internal items; when they run out the post fails and is counted
+static void test_pool()
+{
+    TestExecutor executor;
+    erdp_test_ms = 0;
+    order.clear();
+    ERDP_CHECK(executor.post([]() { log_run("1"); }));
+    ERDP_CHECK(executor.post([]() { log_run("2"); }, 1));
+    ERDP_CHECK(executor.post_delayed([]() { log_run("3"); }, 5));
+    ERDP_CHECK(executor.post([]() { log_run("4"); }));
+    ERDP_CHECK(!executor.post([]() { log_run("x"); }, 1));
+    ERDP_CHECK(!executor.post([]() { log_run("x"); }));
+    ERDP_CHECK(executor.get_stats(0).dropped == 1 && executor.get_stats(1).dropped == 1);
+
+    ERDP_CHECK(executor.poll() == 3);
+    ERDP_CHECK(order == "142");
+
+    /* Items come back to the pool after running */
+    ERDP_CHECK(executor.post([]() { log_run("5"); }));
+    ERDP_CHECK(executor.post([]() { log_run("6"); }));
+    ERDP_CHECK(executor.post([]() { log_run("7"); }));
+    ERDP_CHECK(!executor.post([]() { log_run("x"); }));
+    erdp_test_ms = 5;
+    ERDP_CHECK(executor.poll() == 4);
+    ERDP_CHECK(order == "1425673"); // The delayed closure joins the ready list when it falls due
+    ERDP_CHECK(executor.get_stats(0).dropped == 2);
+}
+
+static void test_cancel()
+{
+    TestExecutor executor;
+    erdp_test_ms = 0;
+    order.clear();
+    WorkItem a([]() { log_run("a"); }), b([]() { log_run("b"); }), c([]() { log_run("c"); });
+    executor.post(a);
+    executor.post(b);
+    executor.post(c);
+    ERDP_CHECK(!executor.post_delayed(a, 5)); // Already queued
+
+    /* Middle and tail of the ready list, then a delayed item */
+    ERDP_CHECK(executor.cancel(c));
+    ERDP_CHECK(executor.cancel(b));
+    ERDP_CHECK(!executor.cancel(b));
+    ERDP_CHECK(executor.post(c));
+    ERDP_CHECK(executor.get_stats(0).depth == 2);
+    ERDP_CHECK(executor.poll() == 2);
+    ERDP_CHECK(order == "ac");
+
+    ERDP_CHECK(executor.post_delayed(b, 5));
+    ERDP_CHECK(executor.cancel(b));
+    erdp_test_ms = 10;
+    ERDP_CHECK(executor.poll() == 0);
+
+    /* A periodic item cancelling itself while it runs is not queued again */
+    static TestExecutor *running;
+    static WorkItem self;
+    static uint32_t self_runs = 0;
+    running = &executor;
+    self.fn = []() {
+        if (++self_runs == 2)
+        {
+            running->cancel(self);
+        }
+    };
+    ERDP_CHECK(executor.post_periodic(self, 1));
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        erdp_test_ms++;
+        executor.poll();
+    }
+    ERDP_CHECK(self_runs == 2 && !self.pending());
+    ERDP_CHECK(executor.get_stats(0).depth == 0);
+}
+
+// Due times are compared across the 32-bit millisecond wrap
+static void test_wrap()
+{
+    TestExecutor executor;
+    erdp_test_ms = 0xFFFFFFF0U;
+    order.clear();
+    WorkItem x([]() { log_run("x"); }), y([]() { log_run("y"); });
+    uint32_t runs = 0;
+    uint32_t *n = &runs;
+    WorkItem tick([n]() { (*n)++; });
+    ERDP_CHECK(executor.post_delayed(x, 32));
+    ERDP_CHECK(executor.post_delayed(y, 8));
+    ERDP_CHECK(executor.post_periodic(tick, 10, 1));
+
+    erdp_test_ms = 0xFFFFFFF7U;
+    ERDP_CHECK(executor.poll() == 0);
+    erdp_test_ms = 0xFFFFFFFFU;
+    ERDP_CHECK(executor.poll() == 2);
+    ERDP_CHECK(order == "y" && runs == 1);
+    erdp_test_ms = 0x0000000FU;
+    ERDP_CHECK(executor.poll() == 1 && runs == 2);
+    erdp_test_ms = 0x00000010U;
+    ERDP_CHECK(executor.poll() == 1);
+    ERDP_CHECK(order == "yx");
+    ERDP_CHECK(executor.get_stats(0).max_latency == 7);
+    executor.cancel(tick);
+}
+
+int main()
+{
+    test_ordering();
+    test_periodic();
+    test_pool();
+    test_cancel();
+    test_wrap();
+    return erdp_test_result("test_executor");
+}
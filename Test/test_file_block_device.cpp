@@ -0,0 +1,99 @@
+#include <string.h>
+
+#include "erdp_test.hpp"
+#include "file_block_device.hpp"
+
+using namespace erdp;
+
+static const char *PATH = "test_file_block_device.img";
+
+static void fill(uint8_t *buf, uint32_t size, uint32_t seed)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        buf[i] = (uint8_t)(i * 31 + seed);
+    }
+}
+
+static void test_round_trip()
+{
+    FileBlockDevice dev(PATH, 64);
+    ERDP_CHECK(dev.block_size() == 512 && dev.block_count() == 64);
+
+    /* A new file reads back as zeros up to the last block */
+    static uint8_t out[4 * 512], in[4 * 512];
+    ERDP_CHECK(dev.read(63, in, 1));
+    ERDP_CHECK(in[0] == 0 && in[511] == 0);
+
+    fill(out, sizeof(out), 1);
+    ERDP_CHECK(dev.write(10, out, 4));
+    ERDP_CHECK(dev.write(0, out, 1));
+    ERDP_CHECK(dev.read(10, in, 4));
+    ERDP_CHECK(memcmp(in, out, sizeof(out)) == 0);
+    ERDP_CHECK(dev.read(11, in, 1));
+    ERDP_CHECK(memcmp(in, out + 512, 512) == 0);
+    ERDP_CHECK(dev.sync());
+
+    /* Out of range and wrapping requests fail without touching the file */
+    ERDP_CHECK(!dev.read(63, in, 2));
+    ERDP_CHECK(!dev.write(64, out, 1));
+    ERDP_CHECK(!dev.read(0xFFFFFFFFU, in, 2));
+    ERDP_CHECK(dev.read(62, in, 2));
+
+    dev.close();
+    ERDP_CHECK(!dev.read(0, in, 1));
+    ERDP_CHECK(!dev.sync());
+}
+
+static void test_reopen()
+{
+    /* Data written before survives a reopen, other block sizes work the same */
+    static uint8_t out[4 * 512], in[4 * 512];
+    fill(out, sizeof(out), 1);
+    FileBlockDevice dev;
+    ERDP_CHECK(dev.open(PATH, 64));
+    ERDP_CHECK(dev.read(10, in, 4));
+    ERDP_CHECK(memcmp(in, out, sizeof(out)) == 0);
+
+    ERDP_CHECK(dev.open(PATH, 16, 2048));
+    ERDP_CHECK(dev.block_size() == 2048 && dev.block_count() == 16);
+    ERDP_CHECK(dev.read(2, in, 1)); // Bytes 4096..6143, block 10 of 512 starts at 5120
+    ERDP_CHECK(memcmp(in + 1024, out, 1024) == 0);
+}
+
+// Host file throughput in sequential 32 KiB requests; a baseline for code that runs on a BlockDevice
+static void test_throughput()
+{
+    const uint32_t BLOCKS = 64, REQUESTS = 128;
+    static uint8_t buf[BLOCKS * 512];
+    fill(buf, sizeof(buf), 7);
+    FileBlockDevice dev(PATH, BLOCKS * REQUESTS);
+
+    double start = erdp_test_seconds();
+    for (uint32_t i = 0; i < REQUESTS; i++)
+    {
+        ERDP_CHECK(dev.write(i * BLOCKS, buf, BLOCKS));
+    }
+    ERDP_CHECK(dev.sync());
+    double write_s = erdp_test_seconds() - start;
+
+    start = erdp_test_seconds();
+    for (uint32_t i = 0; i < REQUESTS; i++)
+    {
+        ERDP_CHECK(dev.read(i * BLOCKS, buf, BLOCKS));
+    }
+    double read_s = erdp_test_seconds() - start;
+
+    double mb = (double)sizeof(buf) * REQUESTS / 1e6;
+    printf("file block device: write %.1f MB/s, read %.1f MB/s\n", mb / write_s, mb / read_s);
+}
+
+int main()
+{
+    remove(PATH);
+    test_round_trip();
+    test_reopen();
+    test_throughput();
+    remove(PATH);
+    return erdp_test_result("test_file_block_device");
+}
@@ -0,0 +1,232 @@
+#include <string>
+
+#include "erdp_test.hpp"
+#include "I2C/erdp_hal_i2c_fsm.hpp"
+
+using namespace erdp;
+
+/* Records the register level operations in order, e.g. "start addr(0x50,w) tx_dma(2) clear_addr" */
+struct FakePort
+{
+    std::string log;
+    uint8_t data = 0;
+    const uint8_t *tx = nullptr;
+    uint8_t *rx = nullptr;
+
+    void __op(const std::string &op)
+    {
+        log += log.empty() ? op : " " + op;
+    }
+
+    void start()
+    {
+        __op("start");
+    }
+
+    void stop()
+    {
+        __op("stop");
+    }
+
+    void send_address(uint8_t addr, bool read)
+    {
+        char op[24];
+        snprintf(op, sizeof(op), "addr(0x%02x,%c)", addr, read ? 'r' : 'w');
+        __op(op);
+    }
+
+    void clear_addr()
+    {
+        __op("clear_addr");
+    }
+
+    void ack(bool enable)
+    {
+        __op(enable ? "ack" : "nack");
+    }
+
+    void dma_last(bool enable)
+    {
+        __op(enable ? "last" : "no_last");
+    }
+
+    void buffer_irq(bool enable)
+    {
+        __op(enable ? "buf_irq" : "no_buf_irq");
+    }
+
+    uint8_t read_data()
+    {
+        __op("read");
+        return data;
+    }
+
+    void tx_dma_start(const uint8_t *buf, uint16_t len)
+    {
+        tx = buf;
+        __op("tx_dma(" + std::to_string(len) + ")");
+    }
+
+    void rx_dma_start(uint8_t *buf, uint16_t len)
+    {
+        rx = buf;
+        __op("rx_dma(" + std::to_string(len) + ")");
+    }
+
+    void dma_stop()
+    {
+        __op("dma_stop");
+    }
+
+    // Log since the last call
+    std::string take()
+    {
+        std::string taken = log;
+        log.clear();
+        return taken;
+    }
+};
+
+static void test_write(FakePort &port, I2cMasterFsm<FakePort> &fsm)
+{
+    const uint8_t tx[2] = {0x10, 0x20};
+    fsm.begin({0x50, tx, 2, nullptr, 0});
+    ERDP_CHECK(fsm.busy() && fsm.result() == I2C_BUSY);
+    ERDP_CHECK(!fsm.on_event(I2C_EVT_SB));
+    ERDP_CHECK(!fsm.on_event(I2C_EVT_ADDR));
+    ERDP_CHECK(!fsm.on_event(I2C_EVT_TX_DMA_DONE));
+    ERDP_CHECK(fsm.on_event(I2C_EVT_BTF));
+    ERDP_CHECK(port.take() == "start addr(0x50,w) tx_dma(2) clear_addr stop");
+    ERDP_CHECK(port.tx == tx);
+    ERDP_CHECK(!fsm.busy() && fsm.result() == I2C_OK);
+
+    /* Events after the end are ignored */
+    ERDP_CHECK(!fsm.on_event(I2C_EVT_BTF));
+    ERDP_CHECK(!fsm.on_event(I2C_EVT_NACK));
+    ERDP_CHECK(port.take().empty());
+}
+
+static void test_read(FakePort &port, I2cMasterFsm<FakePort> &fsm)
+{
+    /* One byte: NACK and stop before ADDR is cleared, the byte comes by RXNE */
+    uint8_t rx[4] = {};
+    port.data = 0x5A;
+    fsm.begin({0x50, nullptr, 0, rx, 1});
+    fsm.on_event(I2C_EVT_SB);
+    fsm.on_event(I2C_EVT_ADDR);
+    ERDP_CHECK(fsm.on_event(I2C_EVT_RXNE));
+    ERDP_CHECK(port.take() == "start addr(0x50,r) nack clear_addr stop buf_irq read no_buf_irq ack");
+    ERDP_CHECK(rx[0] == 0x5A && fsm.result() == I2C_OK);
+
+    /* Several bytes by DMA, NACK on the last one */
+    fsm.begin({0x50, nullptr, 0, rx, 4});
+    fsm.on_event(I2C_EVT_SB);
+    fsm.on_event(I2C_EVT_ADDR);
+    ERDP_CHECK(!fsm.on_event(I2C_EVT_RXNE));
+    ERDP_CHECK(fsm.on_event(I2C_EVT_RX_DMA_DONE));
+    ERDP_CHECK(port.take() == "start addr(0x50,r) ack last rx_dma(4) clear_addr stop no_last ack");
+    ERDP_CHECK(port.rx == rx && fsm.result() == I2C_OK);
+}
+
+static void test_write_read(FakePort &port, I2cMasterFsm<FakePort> &fsm)
+{
+    const uint8_t reg = 0x0F;
+    uint8_t rx[2];
+    fsm.begin({0x68, &reg, 1, rx, 2});
+    fsm.on_event(I2C_EVT_SB);
+    fsm.on_event(I2C_EVT_ADDR);
+    fsm.on_event(I2C_EVT_TX_DMA_DONE);
+    ERDP_CHECK(!fsm.on_event(I2C_EVT_BTF));
+    ERDP_CHECK(port.take() == "start addr(0x68,w) tx_dma(1) clear_addr start");
+
+    /* Repeated start, then the read */
+    fsm.on_event(I2C_EVT_SB);
+    fsm.on_event(I2C_EVT_ADDR);
+    ERDP_CHECK(fsm.on_event(I2C_EVT_RX_DMA_DONE));
+    ERDP_CHECK(port.take() == "addr(0x68,r) ack last rx_dma(2) clear_addr stop no_last ack");
+    ERDP_CHECK(fsm.result() == I2C_OK);
+
+    /* BTF may come before the TX DMA completion is handled */
+    fsm.begin({0x68, &reg, 1, rx, 2});
+    fsm.on_event(I2C_EVT_SB);
+    fsm.on_event(I2C_EVT_ADDR);
+    ERDP_CHECK(!fsm.on_event(I2C_EVT_BTF));
+    ERDP_CHECK(port.take() == "start addr(0x68,w) tx_dma(1) clear_addr start");
+    fsm.abort();
+    port.take();
+}
+
+static void test_probe(FakePort &port, I2cMasterFsm<FakePort> &fsm)
+{
+    fsm.begin({0x3C, nullptr, 0, nullptr, 0});
+    fsm.on_event(I2C_EVT_SB);
+    ERDP_CHECK(fsm.on_event(I2C_EVT_ADDR));
+    ERDP_CHECK(port.take() == "start addr(0x3c,w) clear_addr stop");
+    ERDP_CHECK(fsm.result() == I2C_OK);
+
+    fsm.begin({0x3D, nullptr, 0, nullptr, 0});
+    fsm.on_event(I2C_EVT_SB);
+    ERDP_CHECK(fsm.on_event(I2C_EVT_NACK));
+    ERDP_CHECK(port.take() == "start addr(0x3d,w) dma_stop no_buf_irq stop ack");
+    ERDP_CHECK(fsm.result() == I2C_NACK);
+}
+
+// Every error stops the DMA and the buffer interrupt, and the next transfer runs normally
+static void test_errors(FakePort &port, I2cMasterFsm<FakePort> &fsm)
+{
+    const uint8_t tx[3] = {1, 2, 3};
+    uint8_t rx[3];
+
+    fsm.begin({0x50, tx, 3, nullptr, 0});
+    fsm.on_event(I2C_EVT_SB);
+    fsm.on_event(I2C_EVT_ADDR);
+    port.take();
+    ERDP_CHECK(fsm.on_event(I2C_EVT_NACK));
+    ERDP_CHECK(port.take() == "dma_stop no_buf_irq stop ack");
+    ERDP_CHECK(fsm.result() == I2C_NACK);
+
+    fsm.begin({0x50, nullptr, 0, rx, 1});
+    fsm.on_event(I2C_EVT_SB);
+    fsm.on_event(I2C_EVT_ADDR);
+    port.take();
+    ERDP_CHECK(fsm.on_event(I2C_EVT_BUS_ERROR));
+    ERDP_CHECK(port.take() == "dma_stop no_buf_irq");
+    ERDP_CHECK(fsm.result() == I2C_BUS_ERROR && !fsm.busy());
+
+    fsm.begin({0x50, nullptr, 0, rx, 3});
+    fsm.on_event(I2C_EVT_SB);
+    port.take();
+    ERDP_CHECK(fsm.on_event(I2C_EVT_ARB_LOST));
+    ERDP_CHECK(port.take() == "dma_stop no_buf_irq");
+    ERDP_CHECK(fsm.result() == I2C_ARB_LOST);
+
+    /* Out of order events do not move the sequence */
+    fsm.begin({0x50, tx, 3, nullptr, 0});
+    ERDP_CHECK(!fsm.on_event(I2C_EVT_ADDR));
+    ERDP_CHECK(!fsm.on_event(I2C_EVT_BTF));
+    ERDP_CHECK(!fsm.on_event(I2C_EVT_RX_DMA_DONE));
+    ERDP_CHECK(port.take() == "start");
+
+    /* Timeout: the caller aborts, a second abort does nothing */
+    fsm.abort();
+    ERDP_CHECK(port.take() == "dma_stop no_buf_irq stop");
+    ERDP_CHECK(fsm.result() == I2C_TIMEOUT && !fsm.busy());
+    fsm.abort();
+    ERDP_CHECK(port.take().empty());
+
+    test_write(port, fsm);
+}
+
+int main()
+{
+    FakePort port;
+    I2cMasterFsm<FakePort> fsm(port);
+    ERDP_CHECK(!fsm.busy());
+
+    test_write(port, fsm);
+    test_read(port, fsm);
+    test_write_read(port, fsm);
+    test_probe(port, fsm);
+    test_errors(port, fsm);
+    return erdp_test_result("test_i2c_fsm");
+}
@@ -0,0 +1,206 @@
+#include <thread>
+
+#include "erdp_test.hpp"
+#include "erdp_osal.hpp"
+
+using namespace erdp;
+
+// Spans stop at the end of the storage and the indexes keep counting across it
+static void test_span_wrap()
+{
+    RingBuffer<uint32_t, 8> ring;
+    ERDP_CHECK(ring.capacity() == 8 && ring.empty());
+
+    auto w = ring.write_span();
+    uint32_t *storage = w.data;
+    ERDP_CHECK(w.size == 8);
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        w.data[i] = i;
+    }
+    ring.commit_write(6);
+    ERDP_CHECK(ring.size() == 6);
+
+    auto r = ring.read_span();
+    ERDP_CHECK(r.size == 6 && r.data[0] == 0 && r.data[5] == 5);
+    ring.commit_read(5);
+
+    /* Write position 6: 2 slots to the end, then 5 more from the start */
+    w = ring.write_span();
+    ERDP_CHECK(w.size == 2);
+    w.data[0] = 6, w.data[1] = 7;
+    ring.commit_write(2);
+    w = ring.write_span();
+    ERDP_CHECK(w.size == 5 && w.data == storage);
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        w.data[i] = 8 + i;
+    }
+    ring.commit_write(5);
+    ERDP_CHECK(ring.full() && ring.write_span().size == 0);
+
+    /* Read position 5: 3 to the end, then the wrapped part */
+    r = ring.read_span();
+    ERDP_CHECK(r.size == 3 && r.data[0] == 5 && r.data[2] == 7);
+    ring.commit_read(3);
+    r = ring.read_span();
+    ERDP_CHECK(r.size == 5 && r.data[0] == 8 && r.data[4] == 12);
+    ERDP_CHECK(ring[4] == 12);
+    ring.commit_read(5);
+    ERDP_CHECK(ring.empty() && ring.read_span().size == 0);
+}
+
+static void test_push_pop_n()
+{
+    RingBuffer<uint16_t, 16> ring;
+    uint16_t in[40], out[40];
+    for (uint16_t i = 0; i < 40; i++)
+    {
+        in[i] = i;
+    }
+
+    /* Full: only the free slots are taken, nothing more fits */
+    ERDP_CHECK(ring.push_n(in, 10) == 10);
+    ERDP_CHECK(ring.push_n(in + 10, 10) == 6);
+    ERDP_CHECK(ring.full());
+    ERDP_CHECK(ring.push_n(in, 1) == 0);
+    ERDP_CHECK(!ring.push(in[0]));
+
+    /* Empty: only what is there comes out */
+    ERDP_CHECK(ring.pop_n(out, 12) == 12);
+    ERDP_CHECK(ring.pop_n(out + 12, 12) == 4);
+    ERDP_CHECK(ring.empty());
+    ERDP_CHECK(ring.pop_n(out, 1) == 0);
+    uint16_t item;
+    ERDP_CHECK(!ring.pop(item) && !ring.peek(item));
+    for (uint16_t i = 0; i < 16; i++)
+    {
+        ERDP_CHECK(out[i] == i);
+    }
+
+    /* Across the end of the storage in two parts, mixed with single items */
+    ERDP_CHECK(ring.push_n(in, 10) == 10);
+    ERDP_CHECK(ring.pop_n(out, 10) == 10);
+    ERDP_CHECK(ring.push(in[39]));
+    ERDP_CHECK(ring.push_n(in, 15) == 15);
+    ERDP_CHECK(ring.full() && ring.peek(item) && item == 39);
+    ERDP_CHECK(ring.pop(item) && item == 39);
+    ERDP_CHECK(ring.pop_n(out, 40) == 15);
+    for (uint16_t i = 0; i < 15; i++)
+    {
+        ERDP_CHECK(out[i] == i);
+    }
+
+    ring.push_n(in, 5);
+    ring.clear();
+    ERDP_CHECK(ring.empty() && ring.init(16));
+}
+
+// One producer and one consumer thread, single items and batches; the sequence must come out in order
+static void test_spsc()
+{
+    static RingBuffer<uint32_t, 64> ring;
+    const uint32_t COUNT = 2000000;
+    uint32_t errors = 0;
+
+    std::thread producer([]() {
+        uint32_t next = 0;
+        uint32_t batch[7];
+        while (next < COUNT)
+        {
+            if (next % 3 == 0)
+            {
+                while (!ring.push(next))
+                {
+                    std::this_thread::yield();
+                }
+                next++;
+                continue;
+            }
+            uint32_t n = (COUNT - next < 7) ? COUNT - next : 7;
+            for (uint32_t i = 0; i < n; i++)
+            {
+                batch[i] = next + i;
+            }
+            size_t pushed = ring.push_n(batch, n);
+            next += (uint32_t)pushed;
+            if (pushed == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    uint32_t batch[11];
+    while (expected < COUNT)
+    {
+        size_t n = ring.pop_n(batch, 11);
+        if (n == 0)
+        {
+            std::this_thread::yield();
+        }
+        for (size_t i = 0; i < n; i++)
+        {
+            errors += (batch[i] != expected++);
+        }
+    }
+    producer.join();
+    ERDP_CHECK(errors == 0);
+    ERDP_CHECK(ring.empty());
+}
+
+// Single thread push/pop of one item and of batches, legacy runtime sized buffer against the N > 0 one
+template <typename Ring>
+static double ring_ns_per_item(Ring &ring, bool batched)
+{
+    const uint32_t ROUNDS = 200000, BATCH = 32;
+    uint32_t in[BATCH], out[BATCH];
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < BATCH; i++)
+    {
+        in[i] = i;
+    }
+    double start = erdp_test_seconds();
+    for (uint32_t round = 0; round < ROUNDS; round++)
+    {
+        if (batched)
+        {
+            ring.push_n(in, BATCH);
+            ring.pop_n(out, BATCH);
+        }
+        else
+        {
+            for (uint32_t i = 0; i < BATCH; i++)
+            {
+                ring.push(in[i]);
+                ring.pop(out[i]);
+            }
+        }
+        sum += out[round % BATCH];
+    }
+    double seconds = erdp_test_seconds() - start;
+    ERDP_CHECK(sum == (ROUNDS / BATCH) * (BATCH * (BATCH - 1) / 2));
+    return seconds * 1e9 / ((double)ROUNDS * BATCH);
+}
+
+static void test_throughput()
+{
+    static RingBuffer<uint32_t> legacy(256);
+    static RingBuffer<uint32_t, 256> ring;
+    double legacy_one = ring_ns_per_item(legacy, false);
+    double legacy_n = ring_ns_per_item(legacy, true);
+    double ring_one = ring_ns_per_item(ring, false);
+    double ring_n = ring_ns_per_item(ring, true);
+    printf("ring buffer: push/pop %.2f ns/item (legacy %.2f), push_n/pop_n %.2f ns/item (legacy %.2f)\n", ring_one,
+           legacy_one, ring_n, legacy_n);
+}
+
+int main()
+{
+    test_span_wrap();
+    test_push_pop_n();
+    test_spsc();
+    test_throughput();
+    return erdp_test_result("test_ring_buffer");
+}
@@ -0,0 +1,191 @@
+#include "erdp_test.hpp"
+#include "erdp_timer_wheel.hpp"
+
+using namespace erdp;
+
+/* 3 levels of 4 slots: cascades every 4 and 16 ticks, RANGE is 63 ticks */
+typedef TimerWheel<3, 2> SmallWheel;
+static_assert(SmallWheel::RANGE == 63, "SmallWheel::RANGE");
+
+static SmallWheel *wheel;
+
+// Records the tick of every expiry
+struct Probe
+{
+    WheelTimer timer;
+    uint32_t fired = 0;
+    uint32_t last = 0;
+
+    Probe() : timer([this]() { fired++, last = wheel->now(); }) {}
+};
+
+static void run(uint32_t ticks)
+{
+    for (uint32_t i = 0; i < ticks; i++)
+    {
+        wheel->tick();
+    }
+}
+
+// Every delay up to past RANGE fires exactly on its tick, from any starting phase of the wheel
+static void test_one_shot()
+{
+    const uint32_t DELAYS = 200;
+    const uint32_t offsets[] = {0, 1, 3, 15, 37};
+    static Probe probe[DELAYS];
+    for (uint32_t offset : offsets)
+    {
+        SmallWheel small;
+        wheel = &small;
+        run(offset);
+        for (uint32_t d = 0; d < DELAYS; d++)
+        {
+            probe[d].fired = 0;
+            small.start(probe[d].timer, d + 1);
+        }
+        ERDP_CHECK(small.size() == DELAYS);
+        run(DELAYS + 10);
+        for (uint32_t d = 0; d < DELAYS; d++)
+        {
+            ERDP_CHECK(probe[d].fired == 1 && probe[d].last == offset + d + 1);
+            ERDP_CHECK(!probe[d].timer.pending());
+        }
+        ERDP_CHECK(small.size() == 0);
+    }
+
+    /* Delay 0 counts as 1 */
+    SmallWheel small;
+    wheel = &small;
+    Probe zero;
+    small.start(zero.timer, 0);
+    run(1);
+    ERDP_CHECK(zero.fired == 1 && zero.last == 1);
+}
+
+static void test_periodic()
+{
+    SmallWheel small;
+    wheel = &small;
+    Probe fast, slow;
+    small.start(fast.timer, 3, 5);
+    small.start(slow.timer, 100, 70); // Both beyond RANGE
+    run(250);
+    ERDP_CHECK(fast.fired == 50 && fast.last == 248);
+    ERDP_CHECK(slow.fired == 3 && slow.last == 240);
+    ERDP_CHECK(fast.timer.pending() && slow.timer.pending() && small.size() == 2);
+
+    ERDP_CHECK(small.cancel(fast.timer));
+    ERDP_CHECK(small.cancel(slow.timer));
+    ERDP_CHECK(small.size() == 0);
+    run(100);
+    ERDP_CHECK(fast.fired == 50 && slow.fired == 3);
+}
+
+static void test_cancel_restart()
+{
+    SmallWheel small;
+    wheel = &small;
+    Probe a, b, c;
+    small.start(a.timer, 10);
+    small.start(b.timer, 40);
+    small.start(c.timer, 40);
+    ERDP_CHECK(small.size() == 3);
+
+    /* Cancelled in a higher level slot, next to another timer */
+    run(5);
+    ERDP_CHECK(small.cancel(b.timer));
+    ERDP_CHECK(!small.cancel(b.timer));
+    ERDP_CHECK(small.size() == 2);
+
+    /* Restarting a pending timer counts from now and does not add it twice */
+    small.start(a.timer, 20);
+    ERDP_CHECK(small.size() == 2);
+    run(50);
+    ERDP_CHECK(a.fired == 1 && a.last == 25);
+    ERDP_CHECK(b.fired == 0);
+    ERDP_CHECK(c.fired == 1 && c.last == 40);
+    ERDP_CHECK(small.size() == 0);
+    ERDP_CHECK(!small.cancel(a.timer));
+}
+
+// A callback may start timers, including itself; they never fire in the same tick
+static void test_start_in_callback()
+{
+    SmallWheel small;
+    wheel = &small;
+    static uint32_t count = 0;
+    static uint32_t ticks[4];
+    static WheelTimer self;
+    self.fn = []() {
+        ticks[count] = wheel->now();
+        if (++count < 4)
+        {
+            wheel->start(self, 1);
+        }
+    };
+    small.start(self, 2);
+    run(10);
+    ERDP_CHECK(count == 4);
+    ERDP_CHECK(ticks[0] == 2 && ticks[1] == 3 && ticks[2] == 4 && ticks[3] == 5);
+    ERDP_CHECK(small.size() == 0);
+}
+
+// Host cost of start, tick and cancel on the default geometry with count timers spread over 16k ticks,
+// best of a few rounds so a preempted round does not skew the figure
+static void test_throughput(uint32_t count)
+{
+    static TimerWheel<> big;
+    static WheelTimer timers[10000];
+    static uint32_t fired;
+    erdp_assert(count <= sizeof(timers) / sizeof(timers[0]));
+    const uint32_t TICKS = 4096, ROUNDS = 5;
+    uint32_t *counter = &fired;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        timers[i].fn = [counter]() { (*counter)++; };
+    }
+
+    double start_s = 1e9, tick_s = 1e9, cancel_s = 1e9;
+    for (uint32_t round = 0; round < ROUNDS; round++)
+    {
+        uint32_t seed = count + round;
+        fired = 0;
+        double start = erdp_test_seconds();
+        for (uint32_t i = 0; i < count; i++)
+        {
+            seed = seed * 1664525U + 1013904223U;
+            big.start(timers[i], (seed >> 8) % (4 * TICKS) + 1);
+        }
+        start_s = fmin(start_s, erdp_test_seconds() - start);
+        ERDP_CHECK(big.size() == count);
+
+        start = erdp_test_seconds();
+        for (uint32_t i = 0; i < TICKS; i++)
+        {
+            big.tick();
+        }
+        tick_s = fmin(tick_s, erdp_test_seconds() - start);
+        ERDP_CHECK(fired > 0 && big.size() == count - fired);
+
+        start = erdp_test_seconds();
+        for (uint32_t i = 0; i < count; i++)
+        {
+            big.cancel(timers[i]);
+        }
+        cancel_s = fmin(cancel_s, erdp_test_seconds() - start);
+        ERDP_CHECK(big.size() == 0);
+    }
+    printf("timer wheel, %u timers: start %.1f ns/op, tick %.1f ns/op, cancel %.1f ns/op\n", count,
+           start_s * 1e9 / count, tick_s * 1e9 / TICKS, cancel_s * 1e9 / count);
+}
+
+int main()
+{
+    test_one_shot();
+    test_periodic();
+    test_cancel_restart();
+    test_start_in_callback();
+    test_throughput(1000);
+    test_throughput(10000);
+    return erdp_test_result("test_timer_wheel");
+}